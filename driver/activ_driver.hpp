@@ -224,63 +224,51 @@ int ActivationDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 
     miopenGetActivationDescriptor(activDesc, &activation_mode, &alpha, &beta, &gamma);
 
-    for(int i = 0; i < in_sz; i++)
-    {
+    prng::fill(in.data(), in_sz, [&](auto& gen, std::size_t i) {
         switch(activation_mode)
         {
         case MIOPEN_NEURON_PASTHRU:
-            in[i] = prng::gen_A_to_B(static_cast<Tgpu>(-2), static_cast<Tgpu>(2));
-            break;
         case MIOPEN_NEURON_LOGISTIC:
-            in[i] = prng::gen_A_to_B(static_cast<Tgpu>(-2), static_cast<Tgpu>(2));
-            break;
         case MIOPEN_NEURON_TANH:
-            in[i] = prng::gen_A_to_B(static_cast<Tgpu>(-2), static_cast<Tgpu>(2));
-            break;
         case MIOPEN_NEURON_RELU:
-            in[i] = prng::gen_A_to_B(static_cast<Tgpu>(-2), static_cast<Tgpu>(2));
-            break;
+            return prng::gen_A_to_B(static_cast<Tgpu>(-2), static_cast<Tgpu>(2), gen);
         case MIOPEN_NEURON_SOFTRELU:
-            in[i] = prng::gen_A_to_B(static_cast<Tgpu>(-2.0), static_cast<Tgpu>(2.0));
-            break;
         case MIOPEN_NEURON_ABS:
-            in[i] = prng::gen_A_to_B(static_cast<Tgpu>(-2.0), static_cast<Tgpu>(2.0));
-            break;
+            return prng::gen_A_to_B(static_cast<Tgpu>(-2.0), static_cast<Tgpu>(2.0), gen);
         case MIOPEN_NEURON_POWER: {
             double v = -alpha / beta;
-            in[i]    = i % 2 ? prng::gen_A_to_B(static_cast<Tgpu>((v + 0.005) / beta),
-                                             static_cast<Tgpu>((v + 2.0) / beta))
-                             : prng::gen_A_to_B(static_cast<Tgpu>((v - 2.0) / beta),
-                                             static_cast<Tgpu>((v - 0.005) / beta));
-            break;
+            return i % 2 ? prng::gen_A_to_B(static_cast<Tgpu>((v + 0.005) / beta),
+                                            static_cast<Tgpu>((v + 2.0) / beta),
+                                            gen)
+                         : prng::gen_A_to_B(static_cast<Tgpu>((v - 2.0) / beta),
+                                            static_cast<Tgpu>((v - 0.005) / beta),
+                                            gen);
         }
         case MIOPEN_NEURON_CLIPPED_RELU:
             if(i % 3 == 0)
-                in[i] = prng::gen_A_to_B(static_cast<Tgpu>(-1.0 * alpha),
-                                         static_cast<Tgpu>(-0.005 * alpha));
+                return prng::gen_A_to_B(
+                    static_cast<Tgpu>(-1.0 * alpha), static_cast<Tgpu>(-0.005 * alpha), gen);
             else if(i % 3 == 1)
-                in[i] = prng::gen_A_to_B(static_cast<Tgpu>(0.005 * alpha),
-                                         static_cast<Tgpu>(0.995 * alpha));
+                return prng::gen_A_to_B(
+                    static_cast<Tgpu>(0.005 * alpha), static_cast<Tgpu>(0.995 * alpha), gen);
             else
-                in[i] = prng::gen_A_to_B(static_cast<Tgpu>(1.005 * alpha),
-                                         static_cast<Tgpu>(2.0 * alpha));
-
-            break;
+                return prng::gen_A_to_B(
+                    static_cast<Tgpu>(1.005 * alpha), static_cast<Tgpu>(2.0 * alpha), gen);
         case MIOPEN_NEURON_LEAKY_RELU:
-            in[i] = i % 2 ? prng::gen_A_to_B(static_cast<Tgpu>(-1.0), static_cast<Tgpu>(-0.005))
-                          : prng::gen_A_to_B(static_cast<Tgpu>(-0.005), static_cast<Tgpu>(1.0));
-            break;
+            return i % 2
+                       ? prng::gen_A_to_B(static_cast<Tgpu>(-1.0), static_cast<Tgpu>(-0.005), gen)
+                       : prng::gen_A_to_B(static_cast<Tgpu>(-0.005), static_cast<Tgpu>(1.0), gen);
         case MIOPEN_NEURON_ELU:
-            in[i] = i % 2 ? prng::gen_A_to_B(static_cast<Tgpu>(0.005), static_cast<Tgpu>(2.0))
-                          : prng::gen_A_to_B(static_cast<Tgpu>(-2.0), static_cast<Tgpu>(-0.005));
-            break;
+            return i % 2
+                       ? prng::gen_A_to_B(static_cast<Tgpu>(0.005), static_cast<Tgpu>(2.0), gen)
+                       : prng::gen_A_to_B(static_cast<Tgpu>(-2.0), static_cast<Tgpu>(-0.005), gen);
         }
-    }
+        return static_cast<Tgpu>(0);
+    });
 
-    for(int i = 0; i < out_sz; i++)
-    {
-        dout[i] = prng::gen_A_to_B(static_cast<Tgpu>(-0.5), static_cast<Tgpu>(0.5));
-    }
+    prng::fill(dout.data(), out_sz, [](auto& gen, std::size_t) {
+        return prng::gen_A_to_B(static_cast<Tgpu>(-0.5), static_cast<Tgpu>(0.5), gen);
+    });
 
 #if MIOPEN_BACKEND_OPENCL
     cl_int status;
@@ -0,0 +1,194 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_BATCH_DRIVER_HPP
+#define GUARD_MIOPEN_BATCH_DRIVER_HPP
+
+#include "driver.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// One command line of a batch file, e.g. a line of the perf_models workloads,
+// together with what has been measured while running it.
+struct BatchLayer
+{
+    std::string command;
+    std::vector<std::string> args; // base_arg followed by the layer specific args
+    int status = 0;
+    std::string error;
+    float setup_ms      = -1.0f; // command line parsing, buffer allocation and upload
+    float fwd_cold_ms   = -1.0f; // first run: includes find and kernel compilation
+    float fwd_steady_ms = -1.0f; // second run on the same handle
+    float bwd_cold_ms   = -1.0f;
+    float bwd_steady_ms = -1.0f;
+};
+
+// Reads the commands to run from a file. Empty lines and lines starting with '#' are
+// skipped, and everything up to and including "MIOpenDriver" is dropped, so that the
+// perf_models files which start with "./bin/MIOpenDriver" can be passed as is.
+inline std::vector<BatchLayer> ReadBatchLayers(const std::string& path,
+                                               const std::vector<std::string>& extra_args)
+{
+    std::vector<BatchLayer> layers;
+    std::ifstream file(path);
+    if(!file)
+    {
+        printf("FAILED: Cannot open batch file %s\n", path.c_str());
+        return layers;
+    }
+
+    std::string line;
+    while(std::getline(file, line))
+    {
+        const auto driver_pos = line.find("MIOpenDriver");
+        if(driver_pos != std::string::npos)
+            line = line.substr(driver_pos + std::string("MIOpenDriver").size());
+
+        std::istringstream tokens(line);
+        BatchLayer layer;
+        std::string token;
+        while(tokens >> token)
+            layer.args.push_back(token);
+        if(layer.args.empty() || layer.args.front()[0] == '#')
+            continue;
+
+        layer.args.insert(layer.args.end(), extra_args.begin(), extra_args.end());
+        for(const auto& arg : layer.args)
+            layer.command += (layer.command.empty() ? "" : " ") + arg;
+        layers.push_back(std::move(layer));
+    }
+    return layers;
+}
+
+inline void SynchronizeDriver(Driver& drv)
+{
+#if MIOPEN_BACKEND_OPENCL
+    clFinish(drv.GetStream());
+#elif MIOPEN_BACKEND_HIP
+    hipStreamSynchronize(drv.GetStream());
+#endif
+}
+
+namespace batch_report {
+
+inline std::string EscapeJson(const std::string& str)
+{
+    std::string escaped;
+    for(const auto c : str)
+    {
+        if(c == '"' || c == '\\')
+            escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+inline std::string EscapeCsv(const std::string& str)
+{
+    std::string escaped;
+    for(const auto c : str)
+    {
+        if(c == '"')
+            escaped += '"';
+        escaped += c;
+    }
+    return escaped;
+}
+
+inline void Time(std::ostream& os, float ms, const char* missing)
+{
+    if(ms < 0.0f)
+        os << missing;
+    else
+        os << ms;
+}
+
+} // namespace batch_report
+
+// Writes a per layer report, as JSON when the file name ends with ".json" and as CSV otherwise.
+inline bool WriteBatchReport(const std::string& path, const std::vector<BatchLayer>& layers)
+{
+    std::ofstream file(path);
+    if(!file)
+    {
+        printf("FAILED: Cannot open report file %s\n", path.c_str());
+        return false;
+    }
+    file << std::fixed << std::setprecision(4);
+
+    const auto json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+    if(json)
+    {
+        file << "[\n";
+        for(std::size_t i = 0; i < layers.size(); ++i)
+        {
+            const auto& layer = layers[i];
+            file << "  {\"layer\": " << i << ", \"command\": \""
+                 << batch_report::EscapeJson(layer.command) << "\", \"status\": " << layer.status
+                 << ", \"error\": \"" << batch_report::EscapeJson(layer.error) << "\"";
+            file << ", \"setup_ms\": ";
+            batch_report::Time(file, layer.setup_ms, "null");
+            file << ", \"fwd_cold_ms\": ";
+            batch_report::Time(file, layer.fwd_cold_ms, "null");
+            file << ", \"fwd_steady_ms\": ";
+            batch_report::Time(file, layer.fwd_steady_ms, "null");
+            file << ", \"bwd_cold_ms\": ";
+            batch_report::Time(file, layer.bwd_cold_ms, "null");
+            file << ", \"bwd_steady_ms\": ";
+            batch_report::Time(file, layer.bwd_steady_ms, "null");
+            file << "}" << (i + 1 < layers.size() ? "," : "") << "\n";
+        }
+        file << "]\n";
+    }
+    else
+    {
+        file << "layer,command,status,error,setup_ms,fwd_cold_ms,fwd_steady_ms,bwd_cold_ms,"
+                "bwd_steady_ms\n";
+        for(std::size_t i = 0; i < layers.size(); ++i)
+        {
+            const auto& layer = layers[i];
+            file << i << ",\"" << batch_report::EscapeCsv(layer.command) << "\","
+                 << layer.status << ",\"" << batch_report::EscapeCsv(layer.error) << "\",";
+            batch_report::Time(file, layer.setup_ms, "");
+            file << ",";
+            batch_report::Time(file, layer.fwd_cold_ms, "");
+            file << ",";
+            batch_report::Time(file, layer.fwd_steady_ms, "");
+            file << ",";
+            batch_report::Time(file, layer.bwd_cold_ms, "");
+            file << ",";
+            batch_report::Time(file, layer.bwd_steady_ms, "");
+            file << "\n";
+        }
+    }
+    return true;
+}
+
+#endif // GUARD_MIOPEN_BATCH_DRIVER_HPP
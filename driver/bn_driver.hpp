@@ -569,10 +569,9 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::AllocateBuffersAndCopy()
         bias_host  = std::vector<Tref>(sb_sz, static_cast<Tref>(0));
 
         // Data initialization
-        for(int i = 0; i < in_sz; i++)
-        {
-            in[i] = prng::gen_canonical<Tgpu>();
-        }
+        prng::fill(in.data(), in_sz, [](auto& gen, std::size_t) {
+            return prng::gen_canonical<Tgpu>(gen);
+        });
         status |= in_dev->ToGPU(q, in.data());
 
         // Using random beta and gamma
@@ -633,11 +632,12 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::AllocateBuffersAndCopy()
         status |= dscale_dev->ToGPU(q, dscale.data());
         status |= dbias_dev->ToGPU(q, dbias.data());
 
-        for(int i = 0; i < in_sz; i++)
-        {
-            dyin[i] = prng::gen_canonical<Tgpu>();
-            in[i]   = prng::gen_canonical<Tgpu>();
-        }
+        prng::fill(dyin.data(), in_sz, [](auto& gen, std::size_t) {
+            return prng::gen_canonical<Tgpu>(gen);
+        });
+        prng::fill(in.data(), in_sz, [](auto& gen, std::size_t) {
+            return prng::gen_canonical<Tgpu>(gen);
+        });
         status |= dyin_dev->ToGPU(q, dyin.data());
         status |= in_dev->ToGPU(q, in.data());
         status |= dxout_dev->ToGPU(q, dxout.data());
@@ -1148,24 +1148,24 @@ std::vector<int> ConvDriver<Tgpu, Tref>::GetOutputTensorLengths()
 namespace detail {
 
 template <typename T>
-T RanGenWeights()
+T RanGenWeights(prng::counter_gen& gen)
 {
-    return prng::gen_A_to_B(static_cast<T>(-0.5), static_cast<T>(0.5));
+    return prng::gen_A_to_B(static_cast<T>(-0.5), static_cast<T>(0.5), gen);
 }
 
 // Shift FP16 distribution towards positive numbers,
 // otherwise Winograd FP16 validation fails.
 template <>
-float16 RanGenWeights()
+float16 RanGenWeights(prng::counter_gen& gen)
 {
-    return prng::gen_A_to_B(static_cast<float16>(-1.0 / 3.0), static_cast<float16>(0.5));
+    return prng::gen_A_to_B(static_cast<float16>(-1.0 / 3.0), static_cast<float16>(0.5), gen);
 }
 
 // int8 has it's own range
 template <>
-int8_t RanGenWeights()
+int8_t RanGenWeights(prng::counter_gen& gen)
 {
-    return prng::gen_A_to_B(static_cast<int8_t>(-1), static_cast<int8_t>(1));
+    return prng::gen_A_to_B(static_cast<int8_t>(-1), static_cast<int8_t>(1), gen);
 }
 
 template <typename T>
@@ -1184,26 +1184,26 @@ void RanGenSubnormBuffer(T* buf, size_t size, int percentage)
 }
 
 template <>
-float8 RanGenWeights()
+float8 RanGenWeights(prng::counter_gen& gen)
 {
     const auto tmp =
-        prng::gen_0_to_B(1.0) > 0.5 ? static_cast<float>(0.0) : static_cast<float>(1.0);
+        prng::gen_0_to_B(1.0, gen) > 0.5 ? static_cast<float>(0.0) : static_cast<float>(1.0);
     // 1 in 2 chance of number being positive
     const float sign =
-        (prng::gen_0_to_B(1.0) > 0.5) ? static_cast<float>(-1) : static_cast<float>(1);
+        (prng::gen_0_to_B(1.0, gen) > 0.5) ? static_cast<float>(-1) : static_cast<float>(1);
     const auto tmp2 = static_cast<float>(std::numeric_limits<float8>::epsilon()) *
                       static_cast<float>(2) * sign * static_cast<float>(tmp);
     return static_cast<float8>(tmp2);
 }
 
 template <>
-bfloat8 RanGenWeights()
+bfloat8 RanGenWeights(prng::counter_gen& gen)
 {
     const auto tmp =
-        prng::gen_0_to_B(1.0) > 0.5 ? static_cast<float>(0.0) : static_cast<float>(1.0);
+        prng::gen_0_to_B(1.0, gen) > 0.5 ? static_cast<float>(0.0) : static_cast<float>(1.0);
     // 1 in 2 chance of number being positive
     const float sign =
-        (prng::gen_0_to_B(1.0) > 0.5) ? static_cast<float>(-1) : static_cast<float>(1);
+        (prng::gen_0_to_B(1.0, gen) > 0.5) ? static_cast<float>(-1) : static_cast<float>(1);
     const auto tmp2 = static_cast<float>(std::numeric_limits<float8>::epsilon()) *
                       static_cast<float>(2) * sign * static_cast<float>(tmp);
     return static_cast<bfloat8>(tmp2);
@@ -1474,18 +1474,18 @@ int ConvDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 
         if(!doutRead)
         {
-            for(int i = 0; i < out_sz; i++)
-            {
-                /// \anchor move_rand
-                /// Generate random value, even if buffer is unused. This provides the same
-                /// initialization of input buffers regardless of which kinds of
-                /// convolutions are currently selectedfor testing (see the "-F" option).
-                /// Verification cache would be broken otherwise.
-                auto val =
-                    is_fp8 ? prng::gen_A_to_B(Data_min, Data_max) : prng::gen_0_to_B(Data_scale);
-                if(is_bwd || is_wrw)
-                    dout.data[i] = val;
-            }
+            /// \anchor move_rand
+            /// Take the random stream even if buffer is unused. This provides the same
+            /// initialization of input buffers regardless of which kinds of
+            /// convolutions are currently selectedfor testing (see the "-F" option).
+            /// Verification cache would be broken otherwise.
+            if(is_bwd || is_wrw)
+                prng::fill(dout.data.data(), out_sz, [&](auto& gen, std::size_t) {
+                    return is_fp8 ? prng::gen_A_to_B(Data_min, Data_max, gen)
+                                  : prng::gen_0_to_B(Data_scale, gen);
+                });
+            else
+                prng::skip_fill();
         }
 
         if(is_wrw)
@@ -1520,24 +1520,25 @@ int ConvDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 
     if(!dataRead)
     {
-        for(int i = 0; i < in_sz; i++)
-        {
-            /// \ref move_rand
-            auto val = is_fp8 ? prng::gen_A_to_B(Data_min, Data_max) : prng::gen_0_to_B(Data_scale);
-            if(is_fwd || is_wrw)
-                in.data[i] = val;
-        }
+        /// \ref move_rand
+        if(is_fwd || is_wrw)
+            prng::fill(in.data.data(), in_sz, [&](auto& gen, std::size_t) {
+                return is_fp8 ? prng::gen_A_to_B(Data_min, Data_max, gen)
+                              : prng::gen_0_to_B(Data_scale, gen);
+            });
+        else
+            prng::skip_fill();
     }
 
     if(!weiRead)
     {
-        for(int i = 0; i < wei_sz; i++)
-        {
-            /// \ref move_rand
-            auto w = Data_scale * detail::RanGenWeights<Tgpu>();
-            if(is_fwd || is_bwd)
-                wei.data[i] = w;
-        }
+        /// \ref move_rand
+        if(is_fwd || is_bwd)
+            prng::fill(wei.data.data(), wei_sz, [&](auto& gen, std::size_t) {
+                return static_cast<Tgpu>(Data_scale * detail::RanGenWeights<Tgpu>(gen));
+            });
+        else
+            prng::skip_fill();
     }
 
     if(is_fwd || is_bwd)
@@ -39,6 +39,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cfloat>
+#include <map>
 #include <memory>
 #include <miopen/miopen.h>
 #include <miopen/bfloat16.hpp>
@@ -75,6 +76,70 @@ typedef enum
     EC_VerifyBwdBias = 0x800,
 } errorCode_t;
 
+#if MIOPEN_BACKEND_HIP
+// Keeps device buffers released by GPUMem for reuse by the following allocations.
+// Disabled by default; the batch mode enables it so that the layers of a workload
+// do not pay for hipMalloc/hipFree of same-sized tensors over and over.
+class GPUMemPool
+{
+public:
+    static GPUMemPool& Get()
+    {
+        static GPUMemPool pool;
+        return pool;
+    }
+
+    void Enable() { enabled = true; }
+
+    void* Allocate(size_t size, size_t& capacity)
+    {
+        if(enabled)
+        {
+            // Best fit, but do not let a small tensor hold a buffer more than twice its size.
+            const auto it = free_buffers.lower_bound(size);
+            if(it != free_buffers.end() && it->first <= 2 * size)
+            {
+                capacity  = it->first;
+                auto* ptr = it->second;
+                free_buffers.erase(it);
+                return ptr;
+            }
+        }
+
+        void* ptr = nullptr;
+        if(hipMalloc(&ptr, size) != hipSuccess && !free_buffers.empty())
+        {
+            Release();
+            ptr = nullptr;
+            hipMalloc(&ptr, size);
+        }
+        capacity = size;
+        return ptr;
+    }
+
+    void Free(void* ptr, size_t capacity)
+    {
+        if(ptr == nullptr)
+            return;
+        if(enabled)
+            free_buffers.emplace(capacity, ptr);
+        else
+            hipFree(ptr);
+    }
+
+    void Release()
+    {
+        for(const auto& buffer : free_buffers)
+            hipFree(buffer.second);
+        free_buffers.clear();
+    }
+
+private:
+    bool enabled = false;
+    std::multimap<size_t, void*> free_buffers;
+};
+#endif
+
 struct GPUMem
 {
 
@@ -108,7 +173,7 @@ struct GPUMem
     GPUMem(){};
     GPUMem(uint32_t ctx, size_t psz, size_t pdata_sz) : _ctx(ctx), sz(psz), data_sz(pdata_sz)
     {
-        hipMalloc(static_cast<void**>(&buf), data_sz * sz);
+        buf = GPUMemPool::Get().Allocate(data_sz * sz, capacity);
     }
 
     int ToGPU(hipStream_t q, void* p)
@@ -126,10 +191,11 @@ struct GPUMem
     void* GetMem() { return buf; }
     size_t GetSize() { return sz * data_sz; }
 
-    ~GPUMem() { hipFree(buf); }
+    ~GPUMem() { GPUMemPool::Get().Free(buf, capacity); }
     hipStream_t _q; // Place holder for opencl context
     uint32_t _ctx;
-    void* buf;
+    void* buf       = nullptr;
+    size_t capacity = 0;
     size_t sz;
     size_t data_sz;
 #endif
@@ -151,6 +217,8 @@ inline void PadBufferSize(size_t& sz, int datatype_sz)
            "pool[fp16], lrn[fp16], "
            "activ[fp16], softmax[fp16], bnorm[fp16], rnn[fp16], gemm[fp16], ctc, dropout[fp16], "
            "tensorop[fp16], reduce[fp16|fp64], layernorm[bfp16|fp16], sum[bfp16|fp16]\n");
+    printf("Batch mode: ./driver batch *commands_file* [-o *report.csv|report.json*] "
+           "[*args appended to every command*]\n");
     exit(0); // NOLINT (concurrency-mt-unsafe)
 }
 
@@ -173,7 +241,7 @@ inline std::string ParseBaseArg(int argc, char* argv[])
        arg != "dropout" && arg != "dropoutfp16" && arg != "tensorop" && arg != "tensoropfp16" &&
        arg != "reduce" && arg != "reducefp16" && arg != "reducefp64" && arg != "layernorm" &&
        arg != "layernormfp16" && arg != "layernormbfp16" && arg != "sum" && arg != "sumfp16" &&
-       arg != "sumbfp16" && arg != "--version")
+       arg != "sumbfp16" && arg != "batch" && arg != "--version")
     {
         printf("FAILED: Invalid Base Input Argument\n");
         Usage();
@@ -190,15 +258,40 @@ public:
     Driver()
     {
         data_type = miopenFloat;
+        if(SharedHandle() != nullptr)
+        {
+            handle     = SharedHandle();
+            own_handle = false;
+            // Drivers enable profiling for timing, start each one from a clean handle state.
+            miopenEnableProfiling(handle, false);
+        }
+        else
+        {
+            handle = CreateHandle();
+        }
+
+        miopenGetStream(handle, &q);
+    }
+
+    static miopenHandle_t CreateHandle()
+    {
+        miopenHandle_t h;
 #if MIOPEN_BACKEND_OPENCL
-        miopenCreate(&handle);
+        miopenCreate(&h);
 #elif MIOPEN_BACKEND_HIP
         hipStream_t s;
         hipStreamCreate(&s);
-        miopenCreateWithStream(&handle, s);
+        miopenCreateWithStream(&h, s);
 #endif
+        return h;
+    }
 
-        miopenGetStream(handle, &q);
+    // When set, drivers run on this handle instead of creating their own, which lets
+    // the batch mode share kernels and find results between the layers of a workload.
+    static miopenHandle_t& SharedHandle()
+    {
+        static miopenHandle_t shared = nullptr;
+        return shared;
     }
 
     miopenHandle_t GetHandle() { return handle; }
@@ -209,7 +302,11 @@ public:
 #elif MIOPEN_BACKEND_HIP
     hipStream_t& GetStream() { return q; }
 #endif
-    virtual ~Driver() { miopenDestroy(handle); }
+    virtual ~Driver()
+    {
+        if(own_handle)
+            miopenDestroy(handle);
+    }
 
     // TODO: add timing APIs
     virtual int AddCmdLineArgs()                         = 0;
@@ -226,6 +323,7 @@ protected:
     template <typename Tgpu>
     void InitDataType();
     miopenHandle_t handle;
+    bool own_handle = true;
     miopenDataType_t data_type;
 
 #if MIOPEN_BACKEND_OPENCL
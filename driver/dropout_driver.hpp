@@ -270,15 +270,12 @@ int DropoutDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 
     Tgpu Data_scale = static_cast<Tgpu>(0.01);
 
-    for(int i = 0; i < in_sz; i++)
-    {
-        in.data[i] = prng::gen_0_to_B(Data_scale);
-    }
-
-    for(int i = 0; i < out_sz; i++)
-    {
-        dout.data[i] = prng::gen_0_to_B(Data_scale);
-    }
+    prng::fill(in.data.data(), in_sz, [&](auto& gen, std::size_t) {
+        return prng::gen_0_to_B(Data_scale, gen);
+    });
+    prng::fill(dout.data.data(), out_sz, [&](auto& gen, std::size_t) {
+        return prng::gen_0_to_B(Data_scale, gen);
+    });
 
     if(inflags.GetValueInt("dump_output"))
     {
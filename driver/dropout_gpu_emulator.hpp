@@ -42,6 +42,7 @@
 #include <miopen/float_equal.hpp>
 #include <miopen/precalc_xorwow_skipahead_matrices.hpp>
 #include <miopen/precalc_xorwow_skipahead_sequence_matrices.hpp>
+#include "host_parallel.hpp"
 #include "xorwow_skipahead_generator.hpp"
 
 #define ROCRAND_2POW32_INV (2.3283064e-10f)
@@ -132,19 +133,41 @@ void InitKernelStateEmulator(std::vector<prngStates>& states,
                              const miopenDropoutDescriptor_t dropoutDesc)
 {
     size_t states_num = miopen::deref(dropoutDesc).stateSizeInBytes / sizeof(prngStates);
-    size_t wk_grp_num = std::min(size_t(MAX_PRNG_STATE / 256), (states_num + 255) / 256);
-    size_t glb_sz     = wk_grp_num * 256;
 
-    for(size_t j = 0; j < (states_num + glb_sz - 1) / glb_sz; j++)
-    {
-        for(size_t i = 0; i < glb_sz; i++)
+    // State gid is the seed state skipped ahead by gid subsequences, so consecutive states differ
+    // by a single subsequence jump. Each chunk starts with a full skip-ahead to its first state and
+    // derives the others with one matrix-vector product each.
+    const size_t chunk = 256;
+    HostParFor((states_num + chunk - 1) / chunk, chunk * XORWOW_DIM, [&](size_t c) {
+        size_t first = c * chunk;
+        size_t last  = std::min(states_num, first + chunk);
+
+        unsigned long long seq    = first;
+        unsigned long long offset = 0;
+        xorwow_lite_init_emu(&states[first], miopen::deref(dropoutDesc).seed, seq, offset);
+
+        for(size_t gid = first + 1; gid < last; gid++)
         {
-            size_t gid                = i + j * glb_sz;
-            unsigned long long seq    = gid;
-            unsigned long long offset = 0;
-            xorwow_lite_init_emu(&states[gid], miopen::deref(dropoutDesc).seed, seq, offset);
+            states[gid] = states[gid - 1];
+            mat_vec(precalc_xorwow_skipahead_sequence_matrices[0], &(states[gid].x));
         }
+    });
+}
+
+// Offset of the element with packed index si in a 5D tensor with lengths len and strides str.
+// The innermost dimension is packed.
+inline size_t DropoutElementOffset(size_t si,
+                                   const std::vector<size_t>& len,
+                                   const std::vector<size_t>& str)
+{
+    size_t offset = si % len[4];
+    si /= len[4];
+    for(int d = 3; d >= 0; d--)
+    {
+        offset += (si % len[d]) * str[d];
+        si /= len[d];
     }
+    return offset;
 }
 
 template <typename T>
@@ -252,30 +275,45 @@ void RunDropoutForwardEmulator(miopenHandle_t handle,
             ((in_len[4] * in_len[3] * in_len[2] * in_len[1] * in_len[0] + 255) / 256)) *
         256;
 
-    for(int i0 = 0; i0 < in_len[0]; i0++)
-        for(int i1 = 0; i1 < in_len[1]; i1++)
-            for(int i2 = 0; i2 < in_len[2]; i2++)
-                for(int i3 = 0; i3 < in_len[3]; i3++)
-                    for(int i4 = 0; i4 < in_len[4]; i4++)
-                    {
-                        size_t oi = out_offset + i0 * out_str[0] + i1 * out_str[1] +
-                                    i2 * out_str[2] + i3 * out_str[3] + i4;
-                        size_t ii = in_offset + i0 * in_str[0] + i1 * in_str[1] + i2 * in_str[2] +
-                                    i3 * in_str[3] + i4;
-                        size_t si = i0 * in_len[1] * in_len[2] * in_len[3] * in_len[4] +
-                                    i1 * in_len[2] * in_len[3] * in_len[4] +
-                                    i2 * in_len[3] * in_len[4] + i3 * in_len[4] + i4;
-                        size_t ri = rsvsp_offset + si;
-
-                        if(!use_mask)
-                            reservespace[ri] =
-                                uniform_distribution_emu(xorwow_next(&states[si % glb_sz])) >
-                                dropout_rate;
-
-                        out[oi] = bool(reservespace[ri]) && !miopen::float_equal(dropout_rate, 1.0)
-                                      ? static_cast<Tref>(in[ii] / (1 - dropout_rate))
+    size_t total_work = in_len[4] * in_len[3] * in_len[2] * in_len[1] * in_len[0];
+    if(total_work == 0)
+        return;
+
+    // State s draws for the elements s, s + glb_sz, s + 2 * glb_sz, ... in that order, like the
+    // work-item it emulates. Each thread owns whole work groups of 256 states and walks their
+    // slice of every glb_sz-wide row, which keeps the streams and the final states identical to
+    // the serial walk while the elements of a slice stay contiguous in memory.
+    size_t rows = (total_work + glb_sz - 1) / glb_sz;
+
+    HostParFor(glb_sz / 256, rows * 256, [&](size_t grp) {
+        for(size_t row = 0; row < rows; row++)
+        {
+            size_t first = row * glb_sz + grp * 256;
+            size_t last  = std::min(total_work, first + 256);
+            // the slice is split into runs along the packed innermost dimension
+            for(size_t si = first; si < last;)
+            {
+                size_t run        = std::min(last - si, in_len[4] - si % in_len[4]);
+                size_t oi         = out_offset + DropoutElementOffset(si, in_len, out_str);
+                size_t ii         = in_offset + DropoutElementOffset(si, in_len, in_str);
+                prngStates* state = &states[si % glb_sz];
+
+                for(size_t k = 0; k < run; k++)
+                {
+                    size_t ri = rsvsp_offset + si + k;
+
+                    if(!use_mask)
+                        reservespace[ri] =
+                            uniform_distribution_emu(xorwow_next(state + k)) > dropout_rate;
+
+                    out[oi + k] = bool(reservespace[ri]) && !miopen::float_equal(dropout_rate, 1.0)
+                                      ? static_cast<Tref>(in[ii + k] / (1 - dropout_rate))
                                       : 0;
-                    }
+                }
+                si += run;
+            }
+        }
+    });
 }
 
 template <typename Tgpu, typename Tref = Tgpu>
@@ -328,26 +366,22 @@ void RunDropoutBackwardEmulator(const miopenDropoutDescriptor_t dropoutDesc,
                     out_len,
                     out_str);
 
-    for(int i0 = 0; i0 < in_len[0]; i0++)
-        for(int i1 = 0; i1 < in_len[1]; i1++)
-            for(int i2 = 0; i2 < in_len[2]; i2++)
-                for(int i3 = 0; i3 < in_len[3]; i3++)
-                    for(int i4 = 0; i4 < in_len[4]; i4++)
-                    {
-                        size_t oi = out_offset + i0 * out_str[0] + i1 * out_str[1] +
-                                    i2 * out_str[2] + i3 * out_str[3] + i4;
-                        size_t ii = in_offset + i0 * in_str[0] + i1 * in_str[1] + i2 * in_str[2] +
-                                    i3 * in_str[3] + i4;
-                        size_t ri = rsvsp_offset +
-                                    i0 * in_len[1] * in_len[2] * in_len[3] * in_len[4] +
-                                    i1 * in_len[2] * in_len[3] * in_len[4] +
-                                    i2 * in_len[3] * in_len[4] + i3 * in_len[4] + i4;
-
-                        din[ii] = static_cast<Tref>(bool(reservespace[ri]) &&
-                                                            !miopen::float_equal(dropout_rate, 1.0)
-                                                        ? dout[oi] / (1 - dropout_rate)
-                                                        : 0);
-                    }
+    size_t row_len = in_len[4];
+    size_t rows    = in_len[3] * in_len[2] * in_len[1] * in_len[0];
+
+    HostParFor(rows, row_len, [&](size_t row) {
+        size_t oi = out_offset + DropoutElementOffset(row * row_len, in_len, out_str);
+        size_t ii = in_offset + DropoutElementOffset(row * row_len, in_len, in_str);
+        size_t ri = rsvsp_offset + row * row_len;
+
+        for(size_t i4 = 0; i4 < row_len; i4++)
+        {
+            din[ii + i4] = static_cast<Tref>(bool(reservespace[ri + i4]) &&
+                                                     !miopen::float_equal(dropout_rate, 1.0)
+                                                 ? dout[oi + i4] / (1 - dropout_rate)
+                                                 : 0);
+        }
+    });
 }
 
 #endif // GUARD_MIOPEN_DROPOUT_GPU_EMULATOR_HPP
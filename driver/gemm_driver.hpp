@@ -257,23 +257,18 @@ int GemmDriver<T>::AllocateBuffersAndCopy()
 #endif
     chost = c;
 
-    for(int i = 0; i < a_sz; i++)
-    {
 #if GEMM_DRIVER_DEBUG
+    for(int i = 0; i < a_sz; i++)
         a[i] = static_cast<T>(i);
-#else
-        a[i] = prng::gen_canonical<T>();
-#endif
-    }
 
     for(int i = 0; i < b_sz; i++)
-    {
-#if GEMM_DRIVER_DEBUG
         b[i] = static_cast<T>(i);
 #else
-        b[i] = prng::gen_A_to_B(static_cast<T>(-0.5), static_cast<T>(0.5));
+    prng::fill(a.data(), a_sz, [](auto& gen, std::size_t) { return prng::gen_canonical<T>(gen); });
+    prng::fill(b.data(), b_sz, [](auto& gen, std::size_t) {
+        return prng::gen_A_to_B(static_cast<T>(-0.5), static_cast<T>(0.5), gen);
+    });
 #endif
-    }
 #if MIOPEN_BACKEND_OPENCL
     cl_int status;
 #elif MIOPEN_BACKEND_HIP
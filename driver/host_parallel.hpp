@@ -0,0 +1,235 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DRIVER_HOST_PARALLEL_HPP
+#define GUARD_MIOPEN_DRIVER_HOST_PARALLEL_HPP
+
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Building blocks of the host verification references. The references walk the tensors in
+// memory order, run independent slices (N, C or N*C) on separate threads and use HostSum for
+// the reductions.
+
+// Amount of elements below which a thread costs more than it saves.
+constexpr std::size_t host_par_min_work = std::size_t{1} << 15;
+
+// Calls f(i) for every i in [0, n) on several threads. item_work is the number of elements
+// touched by a single call and is used to keep small tensors single-threaded.
+template <typename F>
+void HostParFor(std::size_t n, std::size_t item_work, F f)
+{
+    const auto min_grain =
+        std::max<std::size_t>(1, host_par_min_work / std::max<std::size_t>(item_work, 1));
+    miopen::par_for(n, min_grain, f);
+}
+
+// Returns the sum of f(i) for i in [0, n). Independent partial sums keep the loop from being
+// bound by the latency of a single accumulator and let the compiler vectorize it.
+template <typename Tacc, typename F>
+Tacc HostSum(std::size_t n, F f)
+{
+    constexpr std::size_t lanes = 8;
+    Tacc partial[lanes]         = {};
+
+    std::size_t i = 0;
+    for(; i + lanes <= n; i += lanes)
+    {
+        for(std::size_t l = 0; l < lanes; ++l)
+            partial[l] += f(i + l);
+    }
+    for(; i < n; ++i)
+        partial[i % lanes] += f(i);
+
+    Tacc result = partial[0];
+    for(std::size_t l = 1; l < lanes; ++l)
+        result += partial[l];
+    return result;
+}
+
+// C = beta * C + alpha * op(A) * op(B) with op(A) of c_rows x inner_loop and op(B) of
+// inner_loop x c_cols. Operands are packed to unit-stride rows, four columns of C share
+// each load of op(A), and tiles of C are computed on several host threads. The inner
+// dimension is accumulated in Tacc in the same order as a naive loop, so results are
+// thread-count independent.
+template <typename Tacc, typename Dtype>
+void HostGemm(const Dtype* a_ptr,
+              std::size_t a_stride,
+              bool a_transposed,
+              const Dtype* b_ptr,
+              std::size_t b_stride,
+              bool b_transposed,
+              Dtype* c_ptr,
+              std::size_t c_cols,
+              std::size_t c_rows,
+              std::size_t c_stride,
+              std::size_t inner_loop,
+              Dtype alpha,
+              Dtype beta)
+{
+    constexpr std::size_t row_tile          = 4;
+    constexpr std::size_t col_tile          = 64;
+    constexpr std::size_t parallel_min_work = 1 << 16;
+
+    std::vector<Dtype> a_packed;
+    const Dtype* a_rows = a_ptr;
+    std::size_t a_ld    = a_stride;
+    if(a_transposed)
+    {
+        a_packed.resize(c_rows * inner_loop);
+        for(std::size_t m = 0; m < inner_loop; ++m)
+            for(std::size_t n = 0; n < c_rows; ++n)
+                a_packed[n * inner_loop + m] = a_ptr[m * a_stride + n];
+        a_rows = a_packed.data();
+        a_ld   = inner_loop;
+    }
+
+    std::vector<Dtype> b_packed;
+    const Dtype* b_cols = b_ptr;
+    std::size_t b_ld    = b_stride;
+    if(!b_transposed)
+    {
+        b_packed.resize(c_cols * inner_loop);
+        for(std::size_t m = 0; m < inner_loop; ++m)
+            for(std::size_t k = 0; k < c_cols; ++k)
+                b_packed[k * inner_loop + m] = b_ptr[m * b_stride + k];
+        b_cols = b_packed.data();
+        b_ld   = inner_loop;
+    }
+
+    const std::size_t col_tiles = (c_cols + col_tile - 1) / col_tile;
+    const std::size_t tiles     = col_tiles * ((c_rows + row_tile - 1) / row_tile);
+
+    auto run_tile = [&](std::size_t tile) {
+        const std::size_t n_begin = (tile / col_tiles) * row_tile;
+        const std::size_t k_begin = (tile % col_tiles) * col_tile;
+        const std::size_t n_end   = std::min(c_rows, n_begin + row_tile);
+        const std::size_t k_end   = std::min(c_cols, k_begin + col_tile);
+
+        for(std::size_t n = n_begin; n < n_end; ++n)
+        {
+            const Dtype* a_row = a_rows + n * a_ld;
+            Dtype* c_row       = c_ptr + n * c_stride;
+
+            std::size_t k = k_begin;
+            for(; k + 4 <= k_end; k += 4)
+            {
+                const Dtype* b0 = b_cols + k * b_ld;
+                const Dtype* b1 = b0 + b_ld;
+                const Dtype* b2 = b1 + b_ld;
+                const Dtype* b3 = b2 + b_ld;
+
+                Tacc mm_e0 = static_cast<Tacc>(0);
+                Tacc mm_e1 = static_cast<Tacc>(0);
+                Tacc mm_e2 = static_cast<Tacc>(0);
+                Tacc mm_e3 = static_cast<Tacc>(0);
+                for(std::size_t m = 0; m < inner_loop; ++m)
+                {
+                    const Dtype a = a_row[m];
+                    mm_e0 += a * b0[m];
+                    mm_e1 += a * b1[m];
+                    mm_e2 += a * b2[m];
+                    mm_e3 += a * b3[m];
+                }
+                c_row[k]     = beta * c_row[k] + alpha * mm_e0;
+                c_row[k + 1] = beta * c_row[k + 1] + alpha * mm_e1;
+                c_row[k + 2] = beta * c_row[k + 2] + alpha * mm_e2;
+                c_row[k + 3] = beta * c_row[k + 3] + alpha * mm_e3;
+            }
+            for(; k < k_end; ++k)
+            {
+                const Dtype* b0 = b_cols + k * b_ld;
+
+                Tacc mm_e = static_cast<Tacc>(0);
+                for(std::size_t m = 0; m < inner_loop; ++m)
+                    mm_e += a_row[m] * b0[m];
+                c_row[k] = beta * c_row[k] + alpha * mm_e;
+            }
+        }
+    };
+
+    if(tiles > 1 && c_rows * c_cols * inner_loop >= parallel_min_work)
+    {
+        miopen::par_for(tiles, 1, run_tile);
+    }
+    else
+    {
+        for(std::size_t tile = 0; tile < tiles; ++tile)
+            run_tile(tile);
+    }
+}
+
+// Updates one packed batch row of the LSTM reserve space for a single direction. gate_off
+// points at the i, f, o and g pre-activations of that direction, cell_off and hid_off at its
+// cell and hidden state. activ_row mirrors row and receives the activated values. c_prev is
+// null when the row starts from a zero cell state.
+template <typename T>
+void LSTMFwdCellCPU(T* row,
+                    T* activ_row,
+                    const T* c_prev,
+                    T* cy,
+                    T* hy,
+                    int hy_h,
+                    int gate_off,
+                    int cell_off,
+                    int hid_off)
+{
+    const auto sigmoid    = [](T x) { return static_cast<T>(1 / (1 + std::exp(-x))); };
+    const auto tanh_activ = [](T x) { return static_cast<T>(std::tanh(x)); };
+
+    const T* gates  = row + gate_off;
+    T* activ_gates  = activ_row + gate_off;
+    const T* i_gate = activ_gates;
+    const T* f_gate = activ_gates + hy_h;
+    const T* o_gate = activ_gates + 2 * hy_h;
+    const T* g_gate = activ_gates + 3 * hy_h;
+
+    // i, f and o are contiguous, so the sigmoids run as one unit-stride pass
+    for(int h = 0; h < 3 * hy_h; h++)
+        activ_gates[h] = sigmoid(gates[h]);
+    for(int h = 3 * hy_h; h < 4 * hy_h; h++)
+        activ_gates[h] = tanh_activ(gates[h]);
+
+    for(int h = 0; h < hy_h; h++)
+    {
+        T c = row[cell_off + h] + i_gate[h] * g_gate[h];
+        if(c_prev != nullptr)
+            c += f_gate[h] * c_prev[h];
+        const T c_activ = tanh_activ(c);
+
+        row[cell_off + h] = c;
+        row[hid_off + h] += o_gate[h] * c_activ;
+        activ_row[cell_off + h] = c_activ;
+
+        cy[h] = c;
+        hy[h] = row[hid_off + h];
+    }
+}
+
+#endif // GUARD_MIOPEN_DRIVER_HOST_PARALLEL_HPP
@@ -257,10 +257,9 @@ int LayerNormDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 
     int status;
 
-    for(int i = 0; i < in_sz; i++)
-    {
-        in[i] = prng::gen_A_to_B<Tgpu>(static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0));
-    }
+    prng::fill(in.data(), in_sz, [](auto& gen, std::size_t) {
+        return prng::gen_A_to_B<Tgpu>(static_cast<Tgpu>(0.0), static_cast<Tgpu>(1.0), gen);
+    });
     status = in_dev->ToGPU(q, in.data());
 
     for(int i = 0; i < weight_sz; i++)
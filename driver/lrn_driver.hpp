@@ -263,16 +263,15 @@ int LRNDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
     dout    = std::vector<Tgpu>(out_sz, static_cast<Tgpu>(0));
     dinhost = std::vector<Tref>(in_sz, static_cast<Tref>(0));
 
-    for(int i = 0; i < in_sz; i++)
-    {
-        in[i] = prng::gen_A_to_B(static_cast<Tgpu>(-1), static_cast<Tgpu>(1));
-    }
+    prng::fill(in.data(), in_sz, [](auto& gen, std::size_t) {
+        return prng::gen_A_to_B(static_cast<Tgpu>(-1), static_cast<Tgpu>(1), gen);
+    });
 
     Tgpu Data_scale = static_cast<Tgpu>(0.001);
-    for(int i = 0; i < out_sz; i++)
-    {
-        dout[i] = Data_scale * prng::gen_A_to_B(static_cast<Tgpu>(-0.5), static_cast<Tgpu>(0.5));
-    }
+    prng::fill(dout.data(), out_sz, [&](auto& gen, std::size_t) {
+        return static_cast<Tgpu>(
+            Data_scale * prng::gen_A_to_B(static_cast<Tgpu>(-0.5), static_cast<Tgpu>(0.5), gen));
+    });
 
 #if MIOPEN_BACKEND_OPENCL
     cl_int status;
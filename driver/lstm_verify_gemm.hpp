@@ -7,6 +7,9 @@
 #include <cassert>
 #include <algorithm>
 #include "dropout_gpu_emulator.hpp"
+#include "host_parallel.hpp"
+
+#include <miopen/par_for.hpp>
 
 template <typename Tgpu, typename Tref>
 void RunLSTMForwardGEMMCPUVerify(miopenHandle_t handle,
@@ -470,170 +473,58 @@ void RunLSTMForwardGEMMCPUVerify(miopenHandle_t handle,
                 }
             }
 
-            for(int bs = 0; bs < in_n.at(ti); bs++)
-            {
-                for(int h = 0; h < hy_h; h++)
+            miopen::par_for(in_n.at(ti), 4, [&](int bs) {
+                Tref* row          = &hid_state[hid_shift + (bacc + bs) * hy_stride];
+                const Tref* c_prev = nullptr;
+                if(ti == 0)
                 {
-                    hid_state.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h) +=
-                        activfunc(hid_state.at(hid_shift + (bacc + bs) * hy_stride + h), 2) *
-                        activfunc(hid_state.at(hid_shift + (bacc + bs) * hy_stride + 3 * hy_h + h),
-                                  1);
-                    if(ti == 0)
-                    {
-                        if(!cx_is_null)
-                        {
-                            hid_state.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h) +=
-                                activfunc(
-                                    hid_state.at(hid_shift + (bacc + bs) * hy_stride + hy_h + h),
-                                    2) *
-                                cx_state.at(hx_shift + bs * uni_stride + h);
-                        }
-                    }
-                    else
-                    {
-                        int prec_shift = li * batch_n * hy_stride +
-                                         (bacc - in_n.at(ti - 1)) * hy_stride + bi * 4 * hy_h;
-
-                        hid_state.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h) +=
-                            activfunc(hid_state.at(hid_shift + (bacc + bs) * hy_stride + hy_h + h),
-                                      2) *
-                            hid_state.at(prec_shift + bs * hy_stride + h);
-                    }
-
-                    hid_state.at(hid_shift + (bacc + bs) * hy_stride + bi * 5 * hy_h + h) +=
-                        activfunc(hid_state.at(hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h),
-                                  2) *
-                        activfunc(
-                            hid_state.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h),
-                            1);
-
-                    hid_state.at(hid_shift + (bacc + bs) * hy_stride + h +
-                                 numlayer * batch_n * hy_stride) =
-                        activfunc(hid_state.at(hid_shift + (bacc + bs) * hy_stride + h), 2);
-                    hid_state.at(hid_shift + (bacc + bs) * hy_stride + hy_h + h +
-                                 numlayer * batch_n * hy_stride) =
-                        activfunc(hid_state.at(hid_shift + (bacc + bs) * hy_stride + hy_h + h), 2);
-                    hid_state.at(hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h +
-                                 numlayer * batch_n * hy_stride) =
-                        activfunc(hid_state.at(hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h),
-                                  2);
-                    hid_state.at(hid_shift + (bacc + bs) * hy_stride + 3 * hy_h + h +
-                                 numlayer * batch_n * hy_stride) =
-                        activfunc(hid_state.at(hid_shift + (bacc + bs) * hy_stride + 3 * hy_h + h),
-                                  1);
-                    hid_state.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h +
-                                 numlayer * batch_n * hy_stride) =
-                        activfunc(
-                            hid_state.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h),
-                            1);
+                    if(!cx_is_null)
+                        c_prev = &cx_state[hx_shift + bs * uni_stride];
+                }
+                else
+                {
+                    const int prev_row = bacc - in_n.at(ti - 1) + bs;
 
-                    cy_state.at(hx_shift + bs * uni_stride + h) =
-                        hid_state.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h);
-                    hy_state.at(hx_shift + bs * uni_stride + h) =
-                        hid_state.at(hid_shift + (bacc + bs) * hy_stride + bi * 5 * hy_h + h);
+                    c_prev = &hid_state[hid_shift + prev_row * hy_stride + bi * 4 * hy_h];
                 }
-            }
+
+                LSTMFwdCellCPU(row,
+                               row + numlayer * batch_n * hy_stride,
+                               c_prev,
+                               &cy_state[hx_shift + bs * uni_stride],
+                               &hy_state[hx_shift + bs * uni_stride],
+                               hy_h,
+                               0,
+                               bi * 4 * hy_h,
+                               bi * 5 * hy_h);
+            });
 
             if(bidirection)
             {
-                for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
-                {
-                    for(int h = 0; h < hy_h; h++)
+                miopen::par_for(in_n.at(seqLength - 1 - ti), 4, [&](int bs) {
+                    Tref* row          = &hid_state[hid_shift + (baccbi + bs) * hy_stride];
+                    const Tref* c_prev = nullptr;
+                    if(ti > 0 && bs < in_n.at(seqLength - ti))
                     {
-                        hid_state.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h + hy_h +
-                                     h) +=
-                            activfunc(
-                                hid_state.at(hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h),
-                                2) *
-                            activfunc(
-                                hid_state.at(hid_shift + (baccbi + bs) * hy_stride + 7 * hy_h + h),
-                                1);
-                        if(ti == 0)
-                        {
-                            if(!cx_is_null)
-                            {
-                                hid_state.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h +
-                                             hy_h + h) +=
-                                    activfunc(hid_state.at(hid_shift + (baccbi + bs) * hy_stride +
-                                                           5 * hy_h + h),
-                                              2) *
-                                    cx_state.at(hx_shift + bs * uni_stride + hy_n * hy_h + h);
-                            }
-                        }
-                        else
-                        {
-
-                            if(!cx_is_null && in_n.at(seqLength - 1 - ti) > in_n.at(seqLength - ti))
-                            {
-                                if(bs >= in_n.at(seqLength - ti))
-                                {
-                                    hid_state.at(hid_shift + (baccbi + bs) * hy_stride +
-                                                 bi * 4 * hy_h + hy_h + h) +=
-                                        activfunc(hid_state.at(hid_shift +
-                                                               (baccbi + bs) * hy_stride +
-                                                               5 * hy_h + h),
-                                                  2) *
-                                        cx_state.at(hx_shift + bs * uni_stride + hy_n * hy_h + h);
-                                }
-                            }
-
-                            if(bs < in_n.at(seqLength - ti))
-                            {
-                                int prec_shift =
-                                    li * batch_n * hy_stride +
-                                    (baccbi + in_n.at(seqLength - 1 - ti)) * hy_stride +
-                                    bi * 4 * hy_h + hy_h;
-
-                                hid_state.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h +
-                                             hy_h + h) +=
-                                    activfunc(hid_state.at(hid_shift + (baccbi + bs) * hy_stride +
-                                                           5 * hy_h + h),
-                                              2) *
-                                    hid_state.at(prec_shift + bs * hy_stride + h);
-                            }
-                        }
-
-                        hid_state[hid_shift + (baccbi + bs) * hy_stride + bi * 5 * hy_h + hy_h +
-                                  h] +=
-                            activfunc(
-                                hid_state[hid_shift + (baccbi + bs) * hy_stride + 6 * hy_h + h],
-                                2) *
-                            activfunc(hid_state[hid_shift + (baccbi + bs) * hy_stride +
-                                                bi * 4 * hy_h + hy_h + h],
-                                      1);
+                        const int prev_row = baccbi + in_n.at(seqLength - 1 - ti) + bs;
 
-                        hid_state.at(hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h +
-                                     numlayer * batch_n * hy_stride) =
-                            activfunc(
-                                hid_state.at(hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h),
-                                2);
-                        hid_state.at(hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h +
-                                     numlayer * batch_n * hy_stride) =
-                            activfunc(
-                                hid_state.at(hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h),
-                                2);
-                        hid_state.at(hid_shift + (baccbi + bs) * hy_stride + 6 * hy_h + h +
-                                     numlayer * batch_n * hy_stride) =
-                            activfunc(
-                                hid_state.at(hid_shift + (baccbi + bs) * hy_stride + 6 * hy_h + h),
-                                2);
-                        hid_state.at(hid_shift + (baccbi + bs) * hy_stride + 7 * hy_h + h +
-                                     numlayer * batch_n * hy_stride) =
-                            activfunc(
-                                hid_state.at(hid_shift + (baccbi + bs) * hy_stride + 7 * hy_h + h),
-                                1);
-                        hid_state.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h + hy_h +
-                                     h + numlayer * batch_n * hy_stride) =
-                            activfunc(hid_state.at(hid_shift + (baccbi + bs) * hy_stride +
-                                                   bi * 4 * hy_h + hy_h + h),
-                                      1);
-
-                        cy_state.at(hx_shift + bs * uni_stride + hy_n * hy_h + h) = hid_state.at(
-                            hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h + hy_h + h);
-                        hy_state.at(hx_shift + bs * uni_stride + hy_n * hy_h + h) = hid_state.at(
-                            hid_shift + (baccbi + bs) * hy_stride + bi * 5 * hy_h + hy_h + h);
+                        c_prev = &hid_state[hid_shift + prev_row * hy_stride + bi * 4 * hy_h + hy_h];
                     }
-                }
+                    else if(!cx_is_null)
+                    {
+                        c_prev = &cx_state[hx_shift + bs * uni_stride + hy_n * hy_h];
+                    }
+
+                    LSTMFwdCellCPU(row,
+                                   row + numlayer * batch_n * hy_stride,
+                                   c_prev,
+                                   &cy_state[hx_shift + bs * uni_stride + hy_n * hy_h],
+                                   &hy_state[hx_shift + bs * uni_stride + hy_n * hy_h],
+                                   hy_h,
+                                   4 * hy_h,
+                                   bi * 4 * hy_h + hy_h,
+                                   bi * 5 * hy_h + hy_h);
+                });
             }
 
             bacc += in_n.at(ti);
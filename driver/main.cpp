@@ -27,6 +27,7 @@
 #include <cstdio>
 
 #include "activ_driver.hpp"
+#include "batch_driver.hpp"
 #include "bn_driver.hpp"
 #include "conv_driver.hpp"
 #include "CBAInferFusion_driver.hpp"
@@ -43,232 +44,356 @@
 #include "reduce_driver.hpp"
 #include "layernorm_driver.hpp"
 #include "sum_driver.hpp"
+#include "timer.hpp"
 #include <miopen/config.h>
 #include <miopen/stringutils.hpp>
 
-int main(int argc, char* argv[])
+Driver* MakeDriver(const std::string& base_arg)
 {
-
-    std::string base_arg = ParseBaseArg(argc, argv);
-
-    if(base_arg == "--version")
-    {
-        size_t major, minor, patch;
-        miopenGetVersion(&major, &minor, &patch);
-        std::cout << "MIOpen (version: " << major << "." << minor << "." << patch << ")"
-                  << std::endl;
-        exit(0); // NOLINT (concurrency-mt-unsafe)
-    }
-
-    // show command
-    std::cout << "MIOpenDriver";
-    for(int i = 1; i < argc; i++)
-        std::cout << " " << argv[i];
-    std::cout << std::endl;
-
-    Driver* drv;
     if(base_arg == "conv")
     {
-        drv = new ConvDriver<float, float>();
+        return new ConvDriver<float, float>();
     }
     else if(base_arg == "convfp16")
     {
-        drv = new ConvDriver<float16, float>();
+        return new ConvDriver<float16, float>();
     }
     else if(base_arg == "convbfp16")
     {
-        drv = new ConvDriver<bfloat16, float>();
+        return new ConvDriver<bfloat16, float>();
     }
     else if(base_arg == "convint8")
     {
-        drv = new ConvDriver<int8_t, int32_t>();
+        return new ConvDriver<int8_t, int32_t>();
     }
     else if(base_arg == "convfp8")
     {
-        drv = new ConvDriver<float8, float>();
+        return new ConvDriver<float8, float>();
     }
     else if(base_arg == "convbfp8")
     {
-        drv = new ConvDriver<bfloat8, float>();
+        return new ConvDriver<bfloat8, float>();
     }
     else if(base_arg == "CBAInfer")
     {
-        drv = new CBAInferFusionDriver<float, double>();
+        return new CBAInferFusionDriver<float, double>();
     }
     else if(base_arg == "CBAInferfp16")
     {
-        drv = new CBAInferFusionDriver<float16, double>();
+        return new CBAInferFusionDriver<float16, double>();
     }
     else if(base_arg == "pool")
     {
-        drv = new PoolDriver<float, double>();
+        return new PoolDriver<float, double>();
     }
     else if(base_arg == "poolfp16")
     {
-        drv = new PoolDriver<float16, double>();
+        return new PoolDriver<float16, double>();
     }
     else if(base_arg == "lrn")
     {
-        drv = new LRNDriver<float, double>();
+        return new LRNDriver<float, double>();
     }
     else if(base_arg == "lrnfp16")
     {
-        drv = new LRNDriver<float16, double>();
+        return new LRNDriver<float16, double>();
     }
     else if(base_arg == "activ")
     {
-        drv = new ActivationDriver<float, double>();
+        return new ActivationDriver<float, double>();
     }
     else if(base_arg == "activfp16")
     {
-        drv = new ActivationDriver<float16, double>();
+        return new ActivationDriver<float16, double>();
     }
     else if(base_arg == "softmax")
     {
-        drv = new SoftmaxDriver<float, double>();
+        return new SoftmaxDriver<float, double>();
     }
     else if(base_arg == "softmaxfp16")
     {
-        drv = new SoftmaxDriver<float16, double>();
+        return new SoftmaxDriver<float16, double>();
     }
 #if MIOPEN_USE_GEMM
     else if(base_arg == "gemm")
     {
-        drv = new GemmDriver<float>();
+        return new GemmDriver<float>();
     }
     else if(base_arg == "gemmfp16")
     {
-        drv = new GemmDriver<float16>();
+        return new GemmDriver<float16>();
     }
 #endif
     else if(base_arg == "bnorm")
     {
-        drv = new BatchNormDriver<float, double>();
+        return new BatchNormDriver<float, double>();
     }
     else if(base_arg == "bnormfp16")
     {
-        drv = new BatchNormDriver<float16, double, float>();
+        return new BatchNormDriver<float16, double, float>();
     }
     else if(base_arg == "rnn_seq")
     {
-        drv = new RNNSeqDriver<float, double>();
+        return new RNNSeqDriver<float, double>();
     }
     else if(base_arg == "rnn_seqfp16")
     {
-        drv = new RNNSeqDriver<float16, double>();
+        return new RNNSeqDriver<float16, double>();
     }
     else if(base_arg == "rnn")
     {
-        drv = new RNNDriver<float, double>();
+        return new RNNDriver<float, double>();
     }
     else if(base_arg == "rnnfp16")
     {
-        drv = new RNNDriver<float16, double>();
+        return new RNNDriver<float16, double>();
     }
     else if(base_arg == "ctc")
     {
-        drv = new CTCDriver<float>();
+        return new CTCDriver<float>();
     }
     else if(base_arg == "dropout")
     {
-        drv = new DropoutDriver<float, float>();
+        return new DropoutDriver<float, float>();
     }
     else if(base_arg == "dropoutfp16")
     {
-        drv = new DropoutDriver<float16, float>();
+        return new DropoutDriver<float16, float>();
     }
     else if(base_arg == "tensorop")
     {
-        drv = new TensorOpDriver<float, float>();
+        return new TensorOpDriver<float, float>();
     }
     else if(base_arg == "tensoropfp16")
     {
-        drv = new TensorOpDriver<float16, float>();
+        return new TensorOpDriver<float16, float>();
     }
     else if(base_arg == "reduce")
     {
-        drv = new ReduceDriver<float, float>();
+        return new ReduceDriver<float, float>();
     }
     else if(base_arg == "reducefp16")
     {
-        drv = new ReduceDriver<float16, float>();
+        return new ReduceDriver<float16, float>();
     }
     else if(base_arg == "reducefp64")
     {
-        drv = new ReduceDriver<double, double>();
+        return new ReduceDriver<double, double>();
     }
     else if(base_arg == "layernorm")
     {
-        drv = new LayerNormDriver<float, float>();
+        return new LayerNormDriver<float, float>();
     }
     else if(base_arg == "layernormfp16")
     {
-        drv = new LayerNormDriver<float16, float>();
+        return new LayerNormDriver<float16, float>();
     }
     else if(base_arg == "layernormbfp16")
     {
-        drv = new LayerNormDriver<bfloat16, float>();
+        return new LayerNormDriver<bfloat16, float>();
     }
     else if(base_arg == "sum")
     {
-        drv = new SumDriver<float, float>();
+        return new SumDriver<float, float>();
     }
     else if(base_arg == "sumfp16")
     {
-        drv = new SumDriver<float16, float>();
+        return new SumDriver<float16, float>();
     }
     else if(base_arg == "sumbfp16")
     {
-        drv = new SumDriver<bfloat16, float>();
-    }
-    else
-    {
-        printf("Incorrect BaseArg\n");
-        exit(0); // NOLINT (concurrency-mt-unsafe)
+        return new SumDriver<bfloat16, float>();
     }
 
-    drv->AddCmdLineArgs();
-    int rc = drv->ParseCmdLineArgs(argc, argv);
+    return nullptr;
+}
+
+// Runs one command line on the driver. When a batch layer is given, every direction is run
+// twice and the wall time of the first (cold) and the second (steady-state) run is recorded.
+// Verification checks the output of the first run.
+int RunDriver(Driver& drv, const std::string& base_arg, int argc, char* argv[], BatchLayer* layer)
+{
+    Timer t;
+    t.start(layer != nullptr);
+    drv.AddCmdLineArgs();
+    int rc = drv.ParseCmdLineArgs(argc, argv);
     if(rc != 0)
     {
         std::cout << "ParseCmdLineArgs() FAILED, rc = " << rc << std::endl;
         return rc;
     }
-    drv->GetandSetData();
-    rc = drv->AllocateBuffersAndCopy();
+    drv.GetandSetData();
+    rc = drv.AllocateBuffersAndCopy();
     if(rc != 0)
     {
         std::cout << "AllocateBuffersAndCopy() FAILED, rc = " << rc << std::endl;
         return rc;
     }
+    if(layer != nullptr)
+    {
+        SynchronizeDriver(drv);
+        t.stop();
+        layer->setup_ms = t.gettime_ms();
+    }
+
+    const auto run = [&](auto&& direction, float* ms) {
+        if(layer == nullptr)
+            return direction();
+        t.start();
+        const auto direction_rc = direction();
+        SynchronizeDriver(drv);
+        t.stop();
+        *ms = t.gettime_ms();
+        return direction_rc;
+    };
 
     int fargval =
-        !miopen::StartsWith(base_arg, "CBAInfer") ? drv->GetInputFlags().GetValueInt("forw") : 1;
+        !miopen::StartsWith(base_arg, "CBAInfer") ? drv.GetInputFlags().GetValueInt("forw") : 1;
     bool bnFwdInVer   = (fargval == 2 && miopen::StartsWith(base_arg, "bnorm"));
-    bool verifyarg    = (drv->GetInputFlags().GetValueInt("verify") == 1);
+    bool verifyarg    = (drv.GetInputFlags().GetValueInt("verify") == 1);
     int cumulative_rc = 0; // Do not stop running tests in case of errors.
 
     if(fargval & 1 || fargval == 0 || bnFwdInVer)
     {
-        rc = drv->RunForwardGPU();
+        rc = run([&]() { return drv.RunForwardGPU(); },
+                 layer != nullptr ? &layer->fwd_cold_ms : nullptr);
         cumulative_rc |= rc;
         if(rc != 0)
             std::cout << "RunForwardGPU() FAILED, rc = "
                       << "0x" << std::hex << rc << std::dec << std::endl;
         if(verifyarg) // Verify even if Run() failed.
-            cumulative_rc |= drv->VerifyForward();
+            cumulative_rc |= drv.VerifyForward();
+        if(layer != nullptr)
+            cumulative_rc |= run([&]() { return drv.RunForwardGPU(); }, &layer->fwd_steady_ms);
     }
 
     if(fargval != 1)
     {
-        rc = drv->RunBackwardGPU();
+        rc = run([&]() { return drv.RunBackwardGPU(); },
+                 layer != nullptr ? &layer->bwd_cold_ms : nullptr);
         cumulative_rc |= rc;
         if(rc != 0)
             std::cout << "RunBackwardGPU() FAILED, rc = "
                       << "0x" << std::hex << rc << std::dec << std::endl;
         if(verifyarg) // Verify even if Run() failed.
-            cumulative_rc |= drv->VerifyBackward();
+            cumulative_rc |= drv.VerifyBackward();
+        if(layer != nullptr)
+            cumulative_rc |= run([&]() { return drv.RunBackwardGPU(); }, &layer->bwd_steady_ms);
     }
 
     return cumulative_rc;
 }
+
+// MIOpenDriver batch <commands_file> [-o <report>] [args appended to every command]
+//
+// Runs all the command lines of a workload in this process, on one handle, so that the
+// layers share compiled kernels and find results, and device buffers are recycled between
+// them instead of being allocated and freed for every layer.
+int RunBatch(int argc, char* argv[])
+{
+    if(argc < 3)
+    {
+        printf("FAILED: Missing batch commands file\n");
+        Usage();
+    }
+
+    const std::string commands_path = argv[2];
+    std::string report_path;
+    std::vector<std::string> extra_args;
+    for(int i = 3; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if(arg == "-o" && i + 1 < argc)
+            report_path = argv[++i];
+        else
+            extra_args.push_back(arg);
+    }
+
+    auto layers = ReadBatchLayers(commands_path, extra_args);
+    if(layers.empty())
+    {
+        printf("FAILED: No commands to run in %s\n", commands_path.c_str());
+        return -1;
+    }
+
+    Driver::SharedHandle() = Driver::CreateHandle();
+#if MIOPEN_BACKEND_HIP
+    GPUMemPool::Get().Enable();
+#endif
+
+    int cumulative_rc = 0;
+    for(auto& layer : layers)
+    {
+        std::cout << "MIOpenDriver " << layer.command << std::endl;
+
+        std::vector<char*> layer_argv{argv[0]};
+        for(auto& arg : layer.args)
+            layer_argv.push_back(&arg[0]);
+        layer_argv.push_back(nullptr);
+
+        const auto& layer_base_arg = layer.args.front();
+        std::unique_ptr<Driver> drv{MakeDriver(layer_base_arg)};
+        if(drv == nullptr)
+        {
+            printf("Incorrect BaseArg\n");
+            layer.status = -1;
+            layer.error  = "Incorrect BaseArg";
+        }
+        else
+        {
+            const auto layer_argc = static_cast<int>(layer.args.size() + 1);
+            layer.status =
+                RunDriver(*drv, layer_base_arg, layer_argc, layer_argv.data(), &layer);
+            if(layer.status != 0)
+            {
+                std::ostringstream ss;
+                ss << "FAILED, rc = 0x" << std::hex << layer.status;
+                layer.error = ss.str();
+            }
+        }
+        cumulative_rc |= layer.status;
+    }
+
+    if(!report_path.empty() && !WriteBatchReport(report_path, layers))
+        cumulative_rc = -1;
+
+#if MIOPEN_BACKEND_HIP
+    GPUMemPool::Get().Release();
+#endif
+    miopenDestroy(Driver::SharedHandle());
+    Driver::SharedHandle() = nullptr;
+    return cumulative_rc;
+}
+
+int main(int argc, char* argv[])
+{
+
+    std::string base_arg = ParseBaseArg(argc, argv);
+
+    if(base_arg == "--version")
+    {
+        size_t major, minor, patch;
+        miopenGetVersion(&major, &minor, &patch);
+        std::cout << "MIOpen (version: " << major << "." << minor << "." << patch << ")"
+                  << std::endl;
+        exit(0); // NOLINT (concurrency-mt-unsafe)
+    }
+
+    // show command
+    std::cout << "MIOpenDriver";
+    for(int i = 1; i < argc; i++)
+        std::cout << " " << argv[i];
+    std::cout << std::endl;
+
+    if(base_arg == "batch")
+        return RunBatch(argc, argv);
+
+    Driver* drv = MakeDriver(base_arg);
+    if(drv == nullptr)
+    {
+        printf("Incorrect BaseArg\n");
+        exit(0); // NOLINT (concurrency-mt-unsafe)
+    }
+
+    return RunDriver(*drv, base_arg, argc, argv, nullptr);
+}
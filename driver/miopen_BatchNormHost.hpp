@@ -27,14 +27,15 @@
 #ifndef MIO_BATCHNORMHOST_H_
 #define MIO_BATCHNORMHOST_H_
 
+#include "host_parallel.hpp"
+
 #include <cmath>
 #include <iomanip>
+#include <vector>
 
-#define MIO_HEIRARCH_SEL 0
-
-#if(MIO_HEIRARCH_SEL == 1)
-#define MIO_BN_DIST 32
-#endif
+// The references process every channel on its own thread. Per-activation variants walk the
+// channel image in memory order for every batch item and keep per-element accumulators, spatial
+// variants reduce the whole N*D*H*W slice of the channel.
 
 template <typename Tgpu, typename Tref>
 int miopenBNFwdTrainPerActivationRunHost(
@@ -62,99 +63,85 @@ int miopenBNFwdTrainPerActivationRunHost(
 {
 
     // C*H*W is also stored as in_nstride, H*W is in_cstride, W is in_hstride.
-    unsigned int index;
-    unsigned int adjIndex;
-    unsigned int in_dstride = height * width;
-    unsigned int in_cstride = depth * in_dstride;
-    unsigned int in_nstride = channels * in_cstride;
-
-    Tref mean_accum     = static_cast<Tref>(0.);
-    Tref variance_accum = static_cast<Tref>(0.);
-    Tref elemStd        = static_cast<Tref>(0.);
-
-    int ret = 0;
-    for(int cidx = 0; cidx < channels; cidx++)
-    { // via channel
-        mean_accum     = static_cast<Tref>(0.);
-        variance_accum = static_cast<Tref>(0.);
-        // process the batch per channel
-        for(int didx = 0; didx < depth; didx++)
-        { // via depth
-            for(int row = 0; row < height; row++)
-            { // via rows
-                for(int column = 0; column < width; column++)
-                { // via columns
-                    mean_accum = static_cast<Tref>(0.);
-                    adjIndex   = in_cstride * cidx + in_dstride * didx + width * row + column;
-                    for(int bidx = 0; bidx < n_batchs; bidx++)
-                    { // via mini_batch
-                        index = in_nstride * bidx + adjIndex;
-                        // #1 calculate the mean
-                        // iterating through the stack of images in the mini_batch
-                        mean_accum += in_ptr[index];
-                    }
-                    mean_accum /= static_cast<Tref>(n_batchs);
-
-                    if(savemeanvar)
-                        saveMean[adjIndex] = mean_accum;
-                    if(runningmeanvar)
-                    {
-                        Tref newRunMean =
-                            runningMean[adjIndex] * (static_cast<Tref>(1) - expAvgFactor);
-                        runningMean[adjIndex] =
-                            mean_accum * expAvgFactor + newRunMean; // newMean*factor + tmp
-                    }
+    std::size_t in_dstride = height * width;
+    std::size_t in_cstride = depth * in_dstride;
+    std::size_t in_nstride = channels * in_cstride;
+
+    HostParFor(channels, n_batchs * in_cstride, [&](int cidx) {
+        const std::size_t c_offset = in_cstride * cidx;
+        std::vector<Tref> mean_accum(in_cstride, static_cast<Tref>(0.));
+        std::vector<Tref> variance_accum(in_cstride, static_cast<Tref>(0.));
+
+        // #1 calculate the mean
+        // iterating through the stack of images in the mini_batch
+        for(int bidx = 0; bidx < n_batchs; bidx++)
+        { // via mini_batch
+            const Tgpu* in = in_ptr + in_nstride * bidx + c_offset;
+            for(std::size_t i = 0; i < in_cstride; i++)
+                mean_accum[i] += in[i];
+        }
+        for(std::size_t i = 0; i < in_cstride; i++)
+            mean_accum[i] /= static_cast<Tref>(n_batchs);
 
-                    elemStd        = static_cast<Tref>(0.);
-                    variance_accum = static_cast<Tref>(0.);
-                    // #2 calculate the variances
-                    // sigma^2 = (1/batch_mean) * sum( (x_i - batch_mean)^2 )
-                    for(int bidx = 0; bidx < n_batchs; bidx++)
-                    { // via mini_batch
-                        // per (x-dims) channel load a block of data into LDS
-                        index   = in_nstride * bidx + adjIndex;
-                        elemStd = in_ptr[index] -
-                                  mean_accum; // (x_i - mean) //this is reused but needs recalc
-                        variance_accum += elemStd * elemStd; // sum{ (x_i - mean)^2 }
-                    }                                        // end for(n)
+        // #2 calculate the variances
+        // sigma^2 = (1/batch_mean) * sum( (x_i - batch_mean)^2 )
+        for(int bidx = 0; bidx < n_batchs; bidx++)
+        { // via mini_batch
+            const Tgpu* in = in_ptr + in_nstride * bidx + c_offset;
+            for(std::size_t i = 0; i < in_cstride; i++)
+            {
+                Tref elemStd = in[i] - mean_accum[i]; // (x_i - mean)
+                variance_accum[i] += elemStd * elemStd; // sum{ (x_i - mean)^2 }
+            }
+        }
 
-                    variance_accum /= static_cast<Tref>(n_batchs); // (1/N)*sum{ (x_i - mean)^2 }
+        for(std::size_t i = 0; i < in_cstride; i++)
+        {
+            const std::size_t adjIndex = c_offset + i;
+            Tref variance = variance_accum[i] / static_cast<Tref>(n_batchs);
 
-                    if(runningmeanvar)
-                    {
-                        // var(n+1) = p * var(n-1) + (1 - p)*(b/b-1)*var(n)
-                        Tref adjust = (n_batchs == 1)
-                                          ? variance_accum
-                                          : (static_cast<Tref>(n_batchs) /
-                                             static_cast<Tref>(n_batchs - 1) * variance_accum);
-                        runningVariance[adjIndex] =
-                            (static_cast<Tref>(1) - expAvgFactor) * runningVariance[cidx] +
-                            expAvgFactor * adjust;
-                    }
+            if(savemeanvar)
+                saveMean[adjIndex] = mean_accum[i];
+            if(runningmeanvar)
+            {
+                Tref newRunMean = runningMean[adjIndex] * (static_cast<Tref>(1) - expAvgFactor);
+                runningMean[adjIndex] =
+                    mean_accum[i] * expAvgFactor + newRunMean; // newMean*factor + tmp
+
+                // var(n+1) = p * var(n-1) + (1 - p)*(b/b-1)*var(n)
+                Tref adjust =
+                    (n_batchs == 1)
+                        ? variance
+                        : (static_cast<Tref>(n_batchs) / static_cast<Tref>(n_batchs - 1) *
+                           variance);
+                runningVariance[adjIndex] =
+                    (static_cast<Tref>(1) - expAvgFactor) * runningVariance[adjIndex] +
+                    expAvgFactor * adjust;
+            }
 
-                    // #3 add epsilon for numeric stability, sqr_root, and invert
-                    Tref elemInvVar = static_cast<Tref>(1.0) / sqrt(variance_accum + epsilon);
+            // #3 add epsilon for numeric stability, sqr_root, and invert
+            variance_accum[i] = static_cast<Tref>(1.0) / sqrt(variance + epsilon);
 
-                    if(savemeanvar)
-                        saveInvVariance[adjIndex] = elemInvVar; /*output only*/
+            if(savemeanvar)
+                saveInvVariance[adjIndex] = variance_accum[i]; /*output only*/
+        }
 
-                    // #4 apply the normalization
-                    // x_hat = (x_i - mean) / sqrt(variance_accum - epsilon)
-                    for(int bidx = 0; bidx < n_batchs; bidx++)
-                    { // via mini_batch
-                        index = in_nstride * bidx + adjIndex;
-                        // per (x-dims) channel load a block of data into LDS
-                        elemStd    = in_ptr[index] - mean_accum; // (x_i - mean)
-                        Tref inhat = elemStd * elemInvVar;
-                        // #5 Gamma and Beta adjust
-                        // y_i = gamma*x_hat + beta
-                        out_ptr[index] = scale_ptr[adjIndex] * inhat + bias_ptr[adjIndex];
-                    } // end for(n_batchs)
-                }     // for (column)
-            }         // for (row)
-        }             // for (depth)
-    }                 // for (channel)
-    return (ret);
+        // #4 apply the normalization
+        // x_hat = (x_i - mean) / sqrt(variance_accum - epsilon)
+        for(int bidx = 0; bidx < n_batchs; bidx++)
+        { // via mini_batch
+            const Tgpu* in = in_ptr + in_nstride * bidx + c_offset;
+            Tref* out      = out_ptr + in_nstride * bidx + c_offset;
+            for(std::size_t i = 0; i < in_cstride; i++)
+            {
+                Tref inhat = (in[i] - mean_accum[i]) * variance_accum[i];
+                // #5 Gamma and Beta adjust
+                // y_i = gamma*x_hat + beta
+                out[i] = scale_ptr[c_offset + i] * inhat + bias_ptr[c_offset + i];
+            }
+        }
+    });
+    return 0;
 }
 
 template <typename Tgpu, typename Tref>
@@ -181,84 +168,24 @@ int miopenBNFwdTrainSpatialRunHost(
     Tref expAvgFactor)
 {
 
-    unsigned int imgIndex;
-    unsigned int index;
-    unsigned int adjIndex;
-    unsigned int in_dstride = height * width;
-    unsigned int in_cstride = depth * in_dstride;
-    unsigned int in_nstride = channels * in_cstride;
-    auto NHW                = static_cast<Tref>(in_cstride * n_batchs);
-
-    Tref elemStd        = static_cast<Tref>(0.);
-    Tref variance_accum = static_cast<Tref>(0.);
-    Tref mean_accum     = static_cast<Tref>(0.);
-
-#if(MIO_HEIRARCH_SEL == 1)
-    Tref variance_accum_arr[MIO_BN_DIST];
-    Tref mean_accum_arr[MIO_BN_DIST];
-#endif
-
-    int ret = 0;
-    for(int cidx = 0; cidx < channels; cidx++)
-    { // via channel
-        mean_accum = static_cast<Tref>(0.);
-#if(MIO_HEIRARCH_SEL == 1)
-        for(int i = 0; i < MIO_BN_DIST; i++)
-        {
-            variance_accum_arr[i] = static_cast<Tref>(0.);
-            mean_accum_arr[i]     = static_cast<Tref>(0.);
-        }
-#endif
-
-#if(MIO_HEIRARCH_SEL == 0)
-        // process the batch per channel
-        for(int didx = 0; didx < depth; didx++)
-        { // depth
-            for(int row = 0; row < height; row++)
-            { // via rows
-                for(int column = 0; column < width; column++)
-                { // via columns
-                    imgIndex = width * row + column;
-                    adjIndex = in_cstride * cidx + in_dstride * didx + imgIndex;
-                    if(imgIndex < in_cstride)
-                    {
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            // #1 calculate the mean
-                            // iterating through the stack of images in the mini_batch
-                            mean_accum += in_ptr[index];
-                            // mean_accum += 1;
-                        } // end for (n)
-                    }
-                } // end for (column)
-            }     // end for (row)
-        }         // end for (depth)
-#else
-        for(int im = 0; im < in_cstride; im += MIO_BN_DIST)
-        {
-            for(int i = 0; i < MIO_BN_DIST; i++)
-            {
-                imgIndex = im + i;
-                adjIndex = in_cstride * cidx + imgIndex;
-                if(imgIndex < in_cstride)
-                {
-                    for(int bidx = 0; bidx < n_batchs; bidx++)
-                    { // via mini_batch
-                        index = in_nstride * bidx + adjIndex;
-                        // #1 calculate the mean
-                        // iterating through the stack of images in the mini_batch
-                        mean_accum_arr[i] += in_ptr[index];
-                    } // end for (n)
-                }
-            }
-        }
-        for(int i = 0; i < MIO_BN_DIST; i++)
-        {
-            mean_accum += mean_accum_arr[i];
+    std::size_t in_dstride = height * width;
+    std::size_t in_cstride = depth * in_dstride;
+    std::size_t in_nstride = channels * in_cstride;
+    auto NHW               = static_cast<Tref>(in_cstride * n_batchs);
+
+    HostParFor(channels, n_batchs * in_cstride, [&](int cidx) {
+        const std::size_t c_offset = in_cstride * cidx;
+
+        // #1 calculate the mean
+        // iterating through the stack of images in the mini_batch
+        Tref mean_accum = static_cast<Tref>(0.);
+        for(int bidx = 0; bidx < n_batchs; bidx++)
+        { // via mini_batch
+            const Tgpu* in = in_ptr + in_nstride * bidx + c_offset;
+            mean_accum +=
+                HostSum<Tref>(in_cstride, [&](std::size_t i) { return static_cast<Tref>(in[i]); });
         }
-#endif
-        mean_accum /= static_cast<Tref>(NHW);
+        mean_accum /= NHW;
 
         if(savemeanvar)
             saveMean[cidx] = mean_accum;
@@ -268,67 +195,20 @@ int miopenBNFwdTrainSpatialRunHost(
             runningMean[cidx] = mean_accum * expAvgFactor + newRunMean; // newMean*factor + tmp
         }
 
-        elemStd        = static_cast<Tref>(0.);
-        variance_accum = static_cast<Tref>(0.);
-#if(MIO_HEIRARCH_SEL == 0)
         // #2 calculate the variances
         // sigma^2 = (1/batch_mean) * sum( (x_i - batch_mean)^2 )
-        for(int didx = 0; didx < depth; didx++)
-        { // depth
-            for(int row = 0; row < height; row++)
-            { // via rows
-                for(int column = 0; column < width; column++)
-                { // via columns
-                    imgIndex = width * row + column;
-                    adjIndex = in_cstride * cidx + imgIndex;
-                    if(imgIndex < in_cstride)
-                    {
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            // per (x-dims) channel load a block of data into LDS
-                            index = in_nstride * bidx + adjIndex;
-
-                            // using out buffer as scratchpad
-                            out_ptr[index] = elemStd =
-                                (in_ptr[index] -
-                                 mean_accum); // (x_i - mean) //this is reused but needs recalc
-                            variance_accum += (elemStd * elemStd); // sum{ (x_i - mean)^2 }
-                        }                                          // end for(n)
-                    }
-                } // end for (column)
-            }     // end for (row)
-        }         // end for (depth)
-
-#else
-        for(int im = 0; im < in_cstride; im += MIO_BN_DIST)
-        {
-            for(int i = 0; i < MIO_BN_DIST; i++)
-            {
-                imgIndex = im + i;
-                adjIndex = in_cstride * cidx + imgIndex;
-                if(imgIndex < in_cstride)
-                {
-                    for(int bidx = 0; bidx < n_batchs; bidx++)
-                    { // via mini_batch
-                        // per (x-dims) channel load a block of data into LDS
-                        index = in_nstride * bidx + adjIndex;
-
-                        // using out buffer as scratchpad
-                        elemStd = (in_ptr[index] -
-                                   mean_accum); // (x_i - mean) //this is reused but needs recalc
-                        variance_accum_arr[i] += (elemStd * elemStd); // sum{ (x_i - mean)^2 }
-                    }
-                }
-            }
-        } // end for (row)
-        for(int i = 0; i < MIO_BN_DIST; i++)
-        {
-            variance_accum += variance_accum_arr[i];
+        Tref variance_accum = static_cast<Tref>(0.);
+        for(int bidx = 0; bidx < n_batchs; bidx++)
+        { // via mini_batch
+            const Tgpu* in = in_ptr + in_nstride * bidx + c_offset;
+            Tref* out      = out_ptr + in_nstride * bidx + c_offset;
+            variance_accum += HostSum<Tref>(in_cstride, [&](std::size_t i) {
+                // using out buffer as scratchpad
+                Tref elemStd = out[i] = in[i] - mean_accum; // (x_i - mean)
+                return elemStd * elemStd;                   // sum{ (x_i - mean)^2 }
+            });
         }
-#endif
-
-        variance_accum /= static_cast<Tref>(NHW); // (1/N)*sum{ (x_i - mean)^2 }
-        // printf("Variance sum on host: %f\n",variance_accum);
+        variance_accum /= NHW; // (1/N)*sum{ (x_i - mean)^2 }
 
         if(runningmeanvar)
         {
@@ -343,41 +223,21 @@ int miopenBNFwdTrainSpatialRunHost(
         // #3 add epsilon for numeric stability, sqr_root, and invert
         Tref invertVar = static_cast<Tref>(1.0) / sqrt(variance_accum + epsilon);
 
-        // printf("invVar on host: %lf\n",invertVar);
-
         if(savemeanvar)
             saveInvVariance[cidx] = invertVar; /*output only*/
 
         // #4 apply the normalization
         // x_hat = (x_i - mean) / sqrt(variance_accum + epsilon)
-        for(int didx = 0; didx < depth; didx++)
-        { // depth
-
-            for(int row = 0; row < height; row++)
-            { // via rows
-                for(int column = 0; column < width; column++)
-                { // via columns
-                    imgIndex = width * row + column;
-                    adjIndex = in_cstride * cidx + imgIndex;
-                    if(imgIndex < in_cstride)
-                    {
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            // per (x-dims) channel load a block of data into LDS
-                            // elemStd =(in_ptr[index] - mean_accum);
-                            // Tref inhat = elemStd*invertVar;
-                            // #5 Gamma and Beta adjust
-                            // y_i = gamma*x_hat + beta
-                            out_ptr[index] =
-                                (scale_ptr[cidx] * (invertVar * out_ptr[index])) + bias_ptr[cidx];
-                        } // end for(n_batchs)
-                    }
-                } // for (column)
-            }     // for (row)
-        }         // for (depth)
-    }             // for (channel)
-    return (ret);
+        for(int bidx = 0; bidx < n_batchs; bidx++)
+        { // via mini_batch
+            Tref* out = out_ptr + in_nstride * bidx + c_offset;
+            // #5 Gamma and Beta adjust
+            // y_i = gamma*x_hat + beta
+            for(std::size_t i = 0; i < in_cstride; i++)
+                out[i] = (scale_ptr[cidx] * (invertVar * out[i])) + bias_ptr[cidx];
+        }
+    });
+    return 0;
 }
 
 //====================== END TRAINING KERNELS =========================
@@ -405,111 +265,78 @@ int miopenBNFwdInferPerActivationRunHost(
 { // use running mean and variance
 
     // C*H*W is also stored as in_nstride, H*W is in_cstride, W is in_hstride.
-    unsigned int index;
-    unsigned int adjIndex;
-    unsigned int in_dstride = height * width;
-    unsigned int in_cstride = depth * in_dstride;
-    unsigned int in_nstride = channels * in_cstride;
-
-    Tref elemStd = static_cast<Tref>(0.);
+    std::size_t in_dstride = height * width;
+    std::size_t in_cstride = depth * in_dstride;
+    std::size_t in_nstride = channels * in_cstride;
 
-    int ret = 0;
     if(estmeanvar)
-    {
-
         printf("Running estimated mean / var inference on CPU.\n");
-        Tref mean     = static_cast<Tref>(0.);
-        Tref variance = static_cast<Tref>(0.);
-        for(int cidx = 0; cidx < channels; cidx++)
-        { // via channel
-            // process the batch per channel
-            for(int didx = 0; didx < depth; didx++)
-            { // via depth
-                for(int row = 0; row < height; row++)
-                { // via rows
-                    for(int column = 0; column < width; column++)
-                    { // via columns
-                        adjIndex = in_cstride * cidx + in_dstride * didx + width * row + column;
-                        mean     = estimatedMean[adjIndex];
-                        variance = estimatedVariance[adjIndex];
-                        Tref elemInvVar =
-                            static_cast<Tref>(1.0) / static_cast<Tref>(sqrt(variance + epsilon));
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            // per (x-dims) channel load a block of data into LDS
-                            elemStd    = in_ptr[index] - mean; // (x_i - mean)
-                            Tref inhat = elemStd * elemInvVar;
-                            // #5 Gamma and Beta adjust
-                            // y_i = gamma*x_hat + beta
-                            out_ptr[index] = scale_ptr[adjIndex] * inhat + bias_ptr[adjIndex];
-                        } // end for(n_batchs)
-                    }     // for (column)
-                }
+
+    HostParFor(channels, n_batchs * in_cstride, [&](int cidx) {
+        const std::size_t c_offset = in_cstride * cidx;
+        std::vector<Tref> mean(in_cstride, static_cast<Tref>(0.));
+        std::vector<Tref> elemInvVar(in_cstride, static_cast<Tref>(0.));
+
+        if(estmeanvar)
+        {
+            for(std::size_t i = 0; i < in_cstride; i++)
+            {
+                mean[i]       = estimatedMean[c_offset + i];
+                elemInvVar[i] = static_cast<Tref>(1.0) /
+                                static_cast<Tref>(sqrt(estimatedVariance[c_offset + i] + epsilon));
             }
         }
-    }
-    else
-    {
-
-        Tref mean_accum     = static_cast<Tref>(0.);
-        Tref variance_accum = static_cast<Tref>(0.);
-        for(int cidx = 0; cidx < channels; cidx++)
-        { // via channel
-            // process the batch per channel
-            for(int didx = 0; didx < depth; didx++)
-            { // via depth
-                for(int row = 0; row < height; row++)
-                { // via rows
-                    for(int column = 0; column < width; column++)
-                    { // via columns
-                        mean_accum = static_cast<Tref>(0.);
-                        adjIndex   = in_cstride * cidx + in_dstride * didx + width * row + column;
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            // #1 calculate the mean
-                            // iterating through the stack of images in the mini_batch
-                            mean_accum += in_ptr[index];
-                        }
-                        mean_accum /= static_cast<Tref>(n_batchs);
+        else
+        {
+            // #1 calculate the mean
+            // iterating through the stack of images in the mini_batch
+            for(int bidx = 0; bidx < n_batchs; bidx++)
+            { // via mini_batch
+                const Tgpu* in = in_ptr + in_nstride * bidx + c_offset;
+                for(std::size_t i = 0; i < in_cstride; i++)
+                    mean[i] += in[i];
+            }
+            for(std::size_t i = 0; i < in_cstride; i++)
+                mean[i] /= static_cast<Tref>(n_batchs);
 
-                        elemStd        = static_cast<Tref>(0.);
-                        variance_accum = static_cast<Tref>(0.);
-                        // #2 calculate the variances
-                        // sigma^2 = (1/batch_mean) * sum( (x_i - batch_mean)^2 )
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            // per (x-dims) channel load a block of data into LDS
-                            index   = in_nstride * bidx + adjIndex;
-                            elemStd = in_ptr[index] - mean_accum; // (x_i - mean)
-                            variance_accum += elemStd * elemStd;  // sum{ (x_i - mean)^2 }
-                        }                                         // end for(n)
-                        variance_accum /=
-                            static_cast<Tref>(n_batchs); // (1/N)*sum{ (x_i - mean)^2 }
+            // #2 calculate the variances
+            // sigma^2 = (1/batch_mean) * sum( (x_i - batch_mean)^2 )
+            for(int bidx = 0; bidx < n_batchs; bidx++)
+            { // via mini_batch
+                const Tgpu* in = in_ptr + in_nstride * bidx + c_offset;
+                for(std::size_t i = 0; i < in_cstride; i++)
+                {
+                    Tref elemStd = in[i] - mean[i]; // (x_i - mean)
+                    elemInvVar[i] += elemStd * elemStd; // sum{ (x_i - mean)^2 }
+                }
+            }
 
-                        // #3 add epsilon for numeric stability, sqr_root, and invert
-                        Tref elemInvVar = static_cast<Tref>(1.0) /
-                                          static_cast<Tref>(sqrt(variance_accum + epsilon));
+            // #3 add epsilon for numeric stability, sqr_root, and invert
+            for(std::size_t i = 0; i < in_cstride; i++)
+            {
+                Tref variance =
+                    elemInvVar[i] / static_cast<Tref>(n_batchs); // (1/N)*sum{ (x_i - mean)^2 }
+                elemInvVar[i] =
+                    static_cast<Tref>(1.0) / static_cast<Tref>(sqrt(variance + epsilon));
+            }
+        }
 
-                        // #4 apply the normalization
-                        // x_hat = (x_i - mean) / sqrt(variance_accum - epsilon)
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            // per (x-dims) channel load a block of data into LDS
-                            elemStd    = in_ptr[index] - mean_accum; // (x_i - mean)
-                            Tref inhat = elemStd * elemInvVar;
-                            // #5 Gamma and Beta adjust
-                            // y_i = gamma*x_hat + beta
-                            out_ptr[index] = scale_ptr[adjIndex] * inhat + bias_ptr[adjIndex];
-                        } // end for(n_batchs)
-                    }     // for (column)
-                }         // for (row)
+        // #4 apply the normalization
+        // x_hat = (x_i - mean) / sqrt(variance_accum - epsilon)
+        for(int bidx = 0; bidx < n_batchs; bidx++)
+        { // via mini_batch
+            const Tgpu* in = in_ptr + in_nstride * bidx + c_offset;
+            Tref* out      = out_ptr + in_nstride * bidx + c_offset;
+            for(std::size_t i = 0; i < in_cstride; i++)
+            {
+                Tref inhat = (in[i] - mean[i]) * elemInvVar[i];
+                // #5 Gamma and Beta adjust
+                // y_i = gamma*x_hat + beta
+                out[i] = scale_ptr[c_offset + i] * inhat + bias_ptr[c_offset + i];
             }
-        } // for (channel)
-    }
-    return (ret);
+        }
+    });
+    return 0;
 }
 
 template <typename Tgpu, typename Tref>
@@ -532,191 +359,68 @@ int miopenBNFwdInferSpatialRunHost(
     Tref* estimatedVariance)
 {
 
-    unsigned int index;
-    unsigned int adjIndex;
-    unsigned int in_dstride = height * width;
-    unsigned int in_cstride = depth * in_dstride;
-    unsigned int in_nstride = channels * in_cstride;
-
-    Tref elemStd = static_cast<Tref>(0.);
-    int ret      = 0;
+    std::size_t in_dstride = height * width;
+    std::size_t in_cstride = depth * in_dstride;
+    std::size_t in_nstride = channels * in_cstride;
+    auto NHW               = static_cast<Tref>(in_cstride * n_batchs);
 
-    if(estmeanvar)
-    {
+    HostParFor(channels, n_batchs * in_cstride, [&](int cidx) {
+        const std::size_t c_offset = in_cstride * cidx;
+        Tref mean                  = static_cast<Tref>(0.);
+        Tref invertVar             = static_cast<Tref>(0.);
 
-        Tref variance = static_cast<Tref>(0.);
-        Tref mean     = static_cast<Tref>(0.);
-        Tref inhat    = static_cast<Tref>(0.);
-        for(int cidx = 0; cidx < channels; cidx++)
-        { // via channel
-            mean           = estimatedMean[cidx];
-            variance       = estimatedVariance[cidx];
-            Tref invertVar = static_cast<Tref>(1.0) / static_cast<Tref>(sqrt(variance + epsilon));
-            // process the batch per channel
-            for(int didx = 0; didx < depth; didx++)
-            { // via depth
-                for(int row = 0; row < height; row++)
-                { // via rows
-                    for(int column = 0; column < width; column++)
-                    { // via columns
-                        adjIndex = in_cstride * cidx + in_dstride * didx + width * row + column;
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index          = in_nstride * bidx + adjIndex;
-                            elemStd        = in_ptr[index] - mean;
-                            inhat          = elemStd * invertVar;
-                            out_ptr[index] = scale_ptr[cidx] * inhat + bias_ptr[cidx];
-                        } // end for (n)
-                    }
-                }
-            }
+        if(estmeanvar)
+        {
+            mean      = estimatedMean[cidx];
+            invertVar = static_cast<Tref>(1.0) /
+                        static_cast<Tref>(sqrt(estimatedVariance[cidx] + epsilon));
         }
-    }
-    else
-    {
-
-#if(MIO_HEIRARCH_SEL == 1)
-        Tref variance_accum_arr[MIO_BN_DIST];
-        Tref mean_accum_arr[MIO_BN_DIST];
-#endif
-
-        Tref variance_accum = static_cast<Tref>(0.);
-        Tref mean_accum     = static_cast<Tref>(0.);
-        for(int cidx = 0; cidx < channels; cidx++)
-        { // via channel
-#if(MIO_HEIRARCH_SEL == 1)
-            for(int i = 0; i < MIO_BN_DIST; i++)
-            {
-                variance_accum_arr[i] = static_cast<Tref>(0.);
-                mean_accum_arr[i]     = static_cast<Tref>(0.);
-            }
-#endif
-
-            mean_accum = static_cast<Tref>(0.);
-#if(MIO_HEIRARCH_SEL == 0)
-            // process the batch per channel
-            for(int didx = 0; didx < depth; didx++)
-            { // via depth
-                for(int row = 0; row < height; row++)
-                { // via rows
-                    for(int column = 0; column < width; column++)
-                    { // via columns
-                        adjIndex = in_cstride * cidx + in_dstride * didx + width * row + column;
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            // #1 calculate the mean
-                            // iterating through the stack of images in the mini_batch
-                            mean_accum += in_ptr[index];
-                        } // end for (n)
-                    }     // end for (column)
-                }         // end for (row)
-            }             // end for (depth)
-#else
-            int imgIndex = 0;
-            // process the batch per channel
-            for(int im = 0; im < in_cstride; im += MIO_BN_DIST)
-            {
-                for(int i = 0; i < MIO_BN_DIST; i++)
-                {
-                    imgIndex = im + i;
-                    adjIndex = in_cstride * cidx + imgIndex;
-                    for(int bidx = 0; bidx < n_batchs; bidx++)
-                    { // via mini_batch
-                        index = in_nstride * bidx + adjIndex;
-                        // #1 calculate the mean
-                        // iterating through the stack of images in the mini_batch
-                        mean_accum_arr[i] += in_ptr[index];
-                    } // end for (n)
-                }     // end for (column)
-            }         // end for (row)
-            for(int i = 0; i < MIO_BN_DIST; i++)
-            {
-                mean_accum += mean_accum_arr[i];
+        else
+        {
+            // #1 calculate the mean
+            // iterating through the stack of images in the mini_batch
+            for(int bidx = 0; bidx < n_batchs; bidx++)
+            { // via mini_batch
+                const Tgpu* in = in_ptr + in_nstride * bidx + c_offset;
+                mean += HostSum<Tref>(in_cstride,
+                                      [&](std::size_t i) { return static_cast<Tref>(in[i]); });
             }
-#endif
-            mean_accum /= static_cast<Tref>(in_cstride * n_batchs);
+            mean /= NHW;
 
-            elemStd        = static_cast<Tref>(0.);
-            variance_accum = static_cast<Tref>(0.);
-#if(MIO_HEIRARCH_SEL == 0)
             // #2 calculate the variances
             // sigma^2 = (1/batch_mean) * sum( (x_i - batch_mean)^2 )
-            for(int didx = 0; didx < depth; didx++)
-            { // via depth
-                for(int row = 0; row < height; row++)
-                { // via rows
-                    for(int column = 0; column < width; column++)
-                    { // via columns
-                        adjIndex = in_cstride * cidx + in_dstride * didx + width * row + column;
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            // per (x-dims) channel load a block of data into LDS
-                            index = in_nstride * bidx + adjIndex;
-
-                            // using out buffer as scratchpad
-                            out_ptr[index] = elemStd = (in_ptr[index] - mean_accum); // (x_i - mean)
-                            variance_accum += (elemStd * elemStd); // sum{ (x_i - mean)^2 }
-                        }                                          // end for(n)
-                    }                                              // end for (column)
-                }                                                  // end for (row)
-            }
-#else
-            for(int im = 0; im < in_cstride; im += MIO_BN_DIST)
-            {
-                for(int i = 0; i < MIO_BN_DIST; i++)
-                {
-                    imgIndex = im + i;
-                    adjIndex = in_cstride * cidx + imgIndex;
-                    for(int bidx = 0; bidx < n_batchs; bidx++)
-                    { // via mini_batch
-                        // per (x-dims) channel load a block of data into LDS
-                        index = in_nstride * bidx + adjIndex;
-
-                        // using out buffer as scratchpad
-                        out_ptr[index] = elemStd = (in_ptr[index] - mean_accum); // (x_i - mean)
-                        variance_accum_arr[i] += (elemStd * elemStd); // sum{ (x_i - mean)^2 }
-                    }                                                 // end for(n)
-                }                                                     // end for
-            }                                                         // end for
-            for(int i = 0; i < MIO_BN_DIST; i++)
-            {
-                variance_accum += variance_accum_arr[i];
+            Tref variance_accum = static_cast<Tref>(0.);
+            for(int bidx = 0; bidx < n_batchs; bidx++)
+            { // via mini_batch
+                const Tgpu* in = in_ptr + in_nstride * bidx + c_offset;
+                variance_accum += HostSum<Tref>(in_cstride, [&](std::size_t i) {
+                    Tref elemStd = in[i] - mean; // (x_i - mean)
+                    return elemStd * elemStd;    // sum{ (x_i - mean)^2 }
+                });
             }
-#endif
-            variance_accum /=
-                static_cast<Tref>(in_cstride * n_batchs); // (1/N)*sum{ (x_i - mean)^2 }
+            variance_accum /= NHW; // (1/N)*sum{ (x_i - mean)^2 }
 
             // #3 add epsilon for numeric stability, sqr_root, and invert
-            Tref invertVar =
+            invertVar =
                 static_cast<Tref>(1.0) / static_cast<Tref>(sqrt(variance_accum + epsilon));
+        }
 
-            // #4 apply the normalization
-            // x_hat = (x_i - mean) / sqrt(variance_accum - epsilon)
-            for(int didx = 0; didx < depth; didx++)
-            { // via depth
-                for(int row = 0; row < height; row++)
-                { // via rows
-                    for(int column = 0; column < width; column++)
-                    { // via columns
-                        adjIndex = in_cstride * cidx + in_dstride * didx + width * row + column;
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            // per (x-dims) channel load a block of data into LDS
-                            // elemStd = in_ptr[index] - mean_accum;// (x_i - mean)
-                            elemStd    = out_ptr[index]; // using saved values from output tensor
-                            Tref inhat = elemStd * invertVar;
-                            // #5 Gamma and Beta adjust
-                            // y_i = gamma*x_hat + beta
-                            out_ptr[index] = scale_ptr[cidx] * inhat + bias_ptr[cidx];
-                        } // end for(n_batchs)
-                    }     // for (column)
-                }         // for (row)
-            }             // for
-        }                 // for (channel)
-    }                     // end if
-    return (ret);
+        // #4 apply the normalization
+        // x_hat = (x_i - mean) / sqrt(variance_accum - epsilon)
+        for(int bidx = 0; bidx < n_batchs; bidx++)
+        { // via mini_batch
+            const Tgpu* in = in_ptr + in_nstride * bidx + c_offset;
+            Tref* out      = out_ptr + in_nstride * bidx + c_offset;
+            for(std::size_t i = 0; i < in_cstride; i++)
+            {
+                Tref inhat = (in[i] - mean) * invertVar;
+                // #5 Gamma and Beta adjust
+                // y_i = gamma*x_hat + beta
+                out[i] = scale_ptr[cidx] * inhat + bias_ptr[cidx];
+            }
+        }
+    });
+    return 0;
 }
 
 //================ END FWD INFERENCE ========================
@@ -748,149 +452,93 @@ int miopenBNBwdPerActivationRunHost(
 {
 
     // C*H*W is also stored as in_nstride, H*W is in_cstride, W is in_hstride.
-    unsigned int index, xhat_index;
-    unsigned int adjIndex;
-    unsigned int in_dstride = height * width;
-    unsigned int in_cstride = depth * in_dstride;
-    unsigned int in_nstride = channels * in_cstride;
-    Tref elemStd            = static_cast<Tref>(0.);
-    Tref mean               = static_cast<Tref>(0.);
-    Tref elemInvVar         = static_cast<Tref>(0.);
-    Tref dyelem             = static_cast<Tref>(0.);
-    Tref dxhat              = static_cast<Tref>(0.);
-    Tref dxhathat           = static_cast<Tref>(0.);
-    Tref tmp1, tmp2, tmp3;
-
-    std::vector<Tref> xhat(n_batchs * in_cstride);
-    // When depth is present, flatten depth and height as height
-    if(depth)
-        height *= depth;
-
-    if(savedmeanvar)
-    {
-        for(int cidx = 0; cidx < channels; cidx++)
-        { // via channel
-            for(int didx = 0; didx < depth; didx++)
-            { // via depth
-                // process the batch per channel
-                for(int row = 0; row < height; row++)
-                { // via rows
-                    for(int column = 0; column < width; column++)
-                    { // via columns
-
-                        adjIndex = in_cstride * cidx + in_dstride * didx + width * row + column;
-
-                        mean       = savedMean[adjIndex];        // HxW elements
-                        elemInvVar = savedInvVariance[adjIndex]; // HxW elements
-
-                        dxhat    = static_cast<Tref>(0.);
-                        dxhathat = static_cast<Tref>(0.);
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            xhat_index =
-                                in_cstride * bidx + in_dstride * didx + width * row + column;
-                            // per (x-dims) channel load a block of data into LDS
-                            elemStd          = x_ptr[index] - mean; // (x_i - mean)
-                            xhat[xhat_index] = elemStd * elemInvVar;
-                            dyelem           = dy_ptr[index];
-                            dbias_ptr[adjIndex] += dyelem;
-                            dscale_ptr[adjIndex] += xhat[xhat_index] * dyelem;
-                            tmp1 = scale_ptr[adjIndex] * dyelem;
-                            dxhat += tmp1;
-                            dxhathat += tmp1 * xhat[xhat_index];
-                        } // end for(n_batchs)
-
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            xhat_index =
-                                in_cstride * bidx + in_dstride * didx + width * row + column;
-                            tmp1          = xhat[xhat_index] * dxhathat + dxhat;
-                            tmp2          = n_batchs * (dy_ptr[index] * scale_ptr[adjIndex]) - tmp1;
-                            tmp3          = elemInvVar / static_cast<Tref>(n_batchs);
-                            dx_ptr[index] = tmp3 * tmp2;
-                        } // end for(n_batchs)
-                    }     // for (column)
-                }         // for (row)
-            }             // for (didx)
-        }                 // for (cidx)
-    }
-    else
-    {
-
-        Tref variance = static_cast<Tref>(0.);
-        for(int cidx = 0; cidx < channels; cidx++)
-        { // via channel
-            for(int didx = 0; didx < depth; didx++)
-            { // via depth
-                // process the batch per channel
-                for(int row = 0; row < height; row++)
-                { // via rows
-                    for(int column = 0; column < width; column++)
-                    { // via columns
-                        mean     = static_cast<Tref>(0.);
-                        adjIndex = in_cstride * cidx + in_dstride * didx + width * row + column;
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            // #1 calculate the mean
-                            // iterating through the stack of images in the mini_batch
-                            mean += x_ptr[index];
-                        }
-                        mean /= static_cast<Tref>(n_batchs);
-
-                        elemStd  = static_cast<Tref>(0.);
-                        variance = static_cast<Tref>(0.);
-                        // #2 calculate the variances
-                        // sigma^2 = (1/batch_mean) * sum( (x_i - batch_mean)^2 )
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            // per (x-dims) channel load a block of data into LDS
-                            index   = in_nstride * bidx + adjIndex;
-                            elemStd = x_ptr[index] - mean;       // (x_i - mean)
-                            variance += elemStd * elemStd;       // sum{ (x_i - mean)^2 }
-                        }                                        // end for(n)
-                        variance /= static_cast<Tref>(n_batchs); // (1/N)*sum{ (x_i - mean)^2 }
+    std::size_t in_dstride = height * width;
+    std::size_t in_cstride = depth * in_dstride;
+    std::size_t in_nstride = channels * in_cstride;
+
+    HostParFor(channels, n_batchs * in_cstride, [&](int cidx) {
+        const std::size_t c_offset = in_cstride * cidx;
+        std::vector<Tref> mean(in_cstride, static_cast<Tref>(0.));
+        std::vector<Tref> elemInvVar(in_cstride, static_cast<Tref>(0.));
+        std::vector<Tref> dxhat(in_cstride, static_cast<Tref>(0.));
+        std::vector<Tref> dxhathat(in_cstride, static_cast<Tref>(0.));
+
+        if(savedmeanvar)
+        {
+            for(std::size_t i = 0; i < in_cstride; i++)
+            {
+                mean[i]       = savedMean[c_offset + i];        // HxW elements
+                elemInvVar[i] = savedInvVariance[c_offset + i]; // HxW elements
+            }
+        }
+        else
+        {
+            // #1 calculate the mean
+            // iterating through the stack of images in the mini_batch
+            for(int bidx = 0; bidx < n_batchs; bidx++)
+            { // via mini_batch
+                const Tgpu* x = x_ptr + in_nstride * bidx + c_offset;
+                for(std::size_t i = 0; i < in_cstride; i++)
+                    mean[i] += x[i];
+            }
+            for(std::size_t i = 0; i < in_cstride; i++)
+                mean[i] /= static_cast<Tref>(n_batchs);
 
-                        // #3 add epsilon for numeric stability, sqr_root, and invert
-                        elemInvVar =
-                            static_cast<Tref>(1.0) / static_cast<Tref>(sqrt(variance + epsilon));
+            // #2 calculate the variances
+            // sigma^2 = (1/batch_mean) * sum( (x_i - batch_mean)^2 )
+            for(int bidx = 0; bidx < n_batchs; bidx++)
+            { // via mini_batch
+                const Tgpu* x = x_ptr + in_nstride * bidx + c_offset;
+                for(std::size_t i = 0; i < in_cstride; i++)
+                {
+                    Tref elemStd = x[i] - mean[i]; // (x_i - mean)
+                    elemInvVar[i] += elemStd * elemStd; // sum{ (x_i - mean)^2 }
+                }
+            }
 
-                        dxhat    = static_cast<Tref>(0.);
-                        dxhathat = static_cast<Tref>(0.);
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            xhat_index =
-                                in_cstride * bidx + in_dstride * didx + width * row + column;
-                            // per (x-dims) channel load a block of data into LDS
-                            elemStd          = x_ptr[index] - mean; // (x_i - mean)
-                            xhat[xhat_index] = elemStd * elemInvVar;
-                            dyelem           = dy_ptr[index];
-                            dbias_ptr[adjIndex] += dyelem;
-                            dscale_ptr[adjIndex] += xhat[xhat_index] * dyelem;
-                            tmp1 = scale_ptr[adjIndex] * dyelem;
-                            dxhat += tmp1;
-                            dxhathat += tmp1 * xhat[xhat_index];
-                        } // end for(n_batchs)
+            // #3 add epsilon for numeric stability, sqr_root, and invert
+            for(std::size_t i = 0; i < in_cstride; i++)
+            {
+                Tref variance =
+                    elemInvVar[i] / static_cast<Tref>(n_batchs); // (1/N)*sum{ (x_i - mean)^2 }
+                elemInvVar[i] =
+                    static_cast<Tref>(1.0) / static_cast<Tref>(sqrt(variance + epsilon));
+            }
+        }
 
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            xhat_index =
-                                in_cstride * bidx + in_dstride * didx + width * row + column;
-                            tmp1          = xhat[xhat_index] * dxhathat + dxhat;
-                            tmp2          = n_batchs * dxhat - tmp1;
-                            tmp3          = elemInvVar / static_cast<Tref>(n_batchs);
-                            dx_ptr[index] = tmp3 * tmp2;
-                        } // end for(n_batchs)
-                    }     // for (column)
-                }         // for (row)
-            }             // for (depth)
-        }                 // for (channel)
-    }                     // end else
+        for(int bidx = 0; bidx < n_batchs; bidx++)
+        { // via mini_batch
+            const Tgpu* x  = x_ptr + in_nstride * bidx + c_offset;
+            const Tgpu* dy = dy_ptr + in_nstride * bidx + c_offset;
+            for(std::size_t i = 0; i < in_cstride; i++)
+            {
+                const std::size_t adjIndex = c_offset + i;
+                Tref xhat                  = (x[i] - mean[i]) * elemInvVar[i];
+                Tref dyelem                = dy[i];
+                dbias_ptr[adjIndex] += dyelem;
+                dscale_ptr[adjIndex] += xhat * dyelem;
+                Tref tmp1 = scale_ptr[adjIndex] * dyelem;
+                dxhat[i] += tmp1;
+                dxhathat[i] += tmp1 * xhat;
+            }
+        }
 
+        for(int bidx = 0; bidx < n_batchs; bidx++)
+        { // via mini_batch
+            const Tgpu* x  = x_ptr + in_nstride * bidx + c_offset;
+            const Tgpu* dy = dy_ptr + in_nstride * bidx + c_offset;
+            Tref* dx       = dx_ptr + in_nstride * bidx + c_offset;
+            for(std::size_t i = 0; i < in_cstride; i++)
+            {
+                Tref xhat = (x[i] - mean[i]) * elemInvVar[i];
+                Tref tmp1 = xhat * dxhathat[i] + dxhat[i];
+                Tref tmp2 = savedmeanvar ? n_batchs * (dy[i] * scale_ptr[c_offset + i]) - tmp1
+                                         : n_batchs * dxhat[i] - tmp1;
+                Tref tmp3 = elemInvVar[i] / static_cast<Tref>(n_batchs);
+                dx[i]     = tmp3 * tmp2;
+            }
+        }
+    });
     return 0;
 }
 
@@ -919,301 +567,84 @@ int miopenBNBwdSpatialRunHost(
 {
 
     // C*H*W is also stored as in_nstride, H*W is in_cstride, W is in_hstride.
-    unsigned int index;
-    unsigned int adjIndex;
-    unsigned int in_dstride = height * width;
-    unsigned int in_cstride = depth * in_dstride;
-    unsigned int in_nstride = channels * in_cstride;
-    unsigned int Csubindex  = 0;
-    Tref elemStd            = static_cast<Tref>(0.);
-    Tref mean               = static_cast<Tref>(0.);
-    Tref invVar             = static_cast<Tref>(0.);
-    Tref dyelem             = static_cast<Tref>(0.);
-    Tref NHW                = static_cast<Tref>(n_batchs * in_cstride);
-
-    if(savedmeanvar)
-    {
-        for(int cidx = 0; cidx < channels; cidx++)
-        { // via channel
-            Csubindex = in_cstride * cidx;
-            for(int didx = 0; didx < depth; didx++)
-            { // via depth
-                for(int row = 0; row < height; row++)
-                { // via rows
-                    for(int column = 0; column < width; column++)
-                    { // via columns
-                        adjIndex = Csubindex + in_dstride * didx + width * row + column;
-
-                        mean   = savedMean[cidx];        // 1xCx1x1 elements
-                        invVar = savedInvVariance[cidx]; // 1xCx1x1 elements
-
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            // per (x-dims) channel load a block of data into LDS
-                            elemStd = x_ptr[index] - mean; // (x_i - mean)
-                            dyelem  = dy_ptr[index];
-                            dbias_ptr[cidx] += dyelem;
-                            dscale_ptr[cidx] += elemStd * invVar * dyelem;
-                        } // end for(n_batchs)
-                    }     // for (column)
-                }         // for (row)
-            }
-
-            // process the batch per channel
-            for(int didx = 0; didx < depth; didx++)
-            { // via depth
-                for(int row = 0; row < height; row++)
-                { // via rows
-                    for(int column = 0; column < width; column++)
-                    { // via columns
-                        adjIndex = Csubindex + in_dstride * didx + width * row + column;
+    std::size_t in_dstride = height * width;
+    std::size_t in_cstride = depth * in_dstride;
+    std::size_t in_nstride = channels * in_cstride;
+    Tref NHW               = static_cast<Tref>(n_batchs * in_cstride);
 
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
+    HostParFor(channels, n_batchs * in_cstride, [&](int cidx) {
+        const std::size_t c_offset = in_cstride * cidx;
+        Tref mean                  = static_cast<Tref>(0.);
+        Tref invVar                = static_cast<Tref>(0.);
 
-                            index     = in_nstride * bidx + adjIndex;
-                            elemStd   = x_ptr[index] - mean; // (x_i - mean)
-                            Tref tmp1 = static_cast<Tref>(NHW) * dy_ptr[index] - dbias_ptr[cidx];
-                            Tref tmp2 = -elemStd * invVar * dscale_ptr[cidx];
-                            Tref tmp3 = (scale_ptr[cidx] * invVar) / static_cast<Tref>(NHW);
-                            dx_ptr[index] = tmp3 * (tmp2 + tmp1);
-                        } // end for(n_batchs)
-                    }     // for (column)
-                }         // for (row)
-            }             // for (depth)
-        }                 // for (cidx)
-    }
-    else
-    {
-
-#if(MIO_HEIRARCH_SEL == 1)
-        Tref variance_accum_arr[MIO_BN_DIST];
-        Tref mean_accum_arr[MIO_BN_DIST];
-        Tref dbias_accum_arr[MIO_BN_DIST];
-        Tref dscale_accum_arr[MIO_BN_DIST];
-#else
-        std::vector<Tref> xhat(n_batchs * in_cstride);
-        unsigned int xhat_index;
-#endif
-
-        Tref variance = static_cast<Tref>(0.);
-        for(int cidx = 0; cidx < channels; cidx++)
-        { // via channel
-#if(MIO_HEIRARCH_SEL == 1)
-            for(int i = 0; i < MIO_BN_DIST; i++)
-            {
-                variance_accum_arr[i] = static_cast<Tref>(0.);
-                mean_accum_arr[i]     = static_cast<Tref>(0.);
-                dbias_accum_arr[i]    = static_cast<Tref>(0.);
-                dscale_accum_arr[i]   = static_cast<Tref>(0.);
+        if(savedmeanvar)
+        {
+            mean   = savedMean[cidx];        // 1xCx1x1 elements
+            invVar = savedInvVariance[cidx]; // 1xCx1x1 elements
+        }
+        else
+        {
+            // #1 calculate the mean
+            // iterating through the stack of images in the mini_batch
+            for(int bidx = 0; bidx < n_batchs; bidx++)
+            { // via mini_batch
+                const Tgpu* x = x_ptr + in_nstride * bidx + c_offset;
+                mean += HostSum<Tref>(in_cstride,
+                                      [&](std::size_t i) { return static_cast<Tref>(x[i]); });
             }
-#endif
-            Csubindex = in_cstride * cidx;
-
-            // process the batch per channel
-            mean = static_cast<Tref>(0.);
-#if(MIO_HEIRARCH_SEL == 0)
-            for(int didx = 0; didx < depth; didx++)
-            { // via depth
-                for(int row = 0; row < height; row++)
-                { // via rows
-                    for(int column = 0; column < width; column++)
-                    { // via columns
-                        adjIndex = Csubindex + in_dstride * didx + width * row + column;
+            mean /= NHW;
 
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            // #1 calculate the mean
-                            // iterating through the stack of images in the mini_batch
-                            mean += x_ptr[index];
-                        }
-                    } // for (column)
-                }     // for (row)
-            }         // for (depth)
-#else
-            int imgIndex = 0;
-            for(int im = 0; im < in_cstride; im += MIO_BN_DIST)
-            {
-                for(int i = 0; i < MIO_BN_DIST; i++)
-                {
-                    imgIndex = im + i;
-                    adjIndex = in_cstride * cidx + imgIndex;
-                    if(imgIndex < in_cstride)
-                    {
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            // #1 calculate the mean
-                            // iterating through the stack of images in the mini_batch
-                            mean_accum_arr[i] += x_ptr[index];
-                        }
-                    }
-                } // end for
-            }     // end for
-            for(int i = 0; i < MIO_BN_DIST; i++)
-            {
-                mean += mean_accum_arr[i];
+            // #2 calculate the variances
+            // sigma^2 = (1/batch_mean) * sum( (x_i - batch_mean)^2 )
+            Tref variance = static_cast<Tref>(0.);
+            for(int bidx = 0; bidx < n_batchs; bidx++)
+            { // via mini_batch
+                const Tgpu* x = x_ptr + in_nstride * bidx + c_offset;
+                variance += HostSum<Tref>(in_cstride, [&](std::size_t i) {
+                    Tref elemStd = x[i] - mean; // (x_i - mean)
+                    return elemStd * elemStd;   // sum{ (x_i - mean)^2 }
+                });
             }
-#endif
-            mean /= static_cast<Tref>(NHW);
-            // printf("MEAN: %f\n",mean);
-            elemStd  = static_cast<Tref>(0.);
-            variance = static_cast<Tref>(0.);
-#if(MIO_HEIRARCH_SEL == 0)
-            for(int didx = 0; didx < depth; didx++)
-            { // via depth
-                for(int row = 0; row < height; row++)
-                { // via rows
-                    for(int column = 0; column < width; column++)
-                    { // via columns
-                        adjIndex = Csubindex + in_dstride * didx + width * row + column;
+            variance /= NHW; // (1/(N*H*W))*sum{ (x_i - mean)^2 }
 
-                        // #2 calculate the variances
-                        // sigma^2 = (1/batch_mean) * sum( (x_i - batch_mean)^2 )
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            // per (x-dims) channel load a block of data into LDS
-                            index   = in_nstride * bidx + adjIndex;
-                            elemStd = x_ptr[index] - mean; // (x_i - mean)
-                            variance += elemStd * elemStd; // sum{ (x_i - mean)^2 }
-                        }                                  // end for(n)
-                    }                                      // for (column)
-                }                                          // for (row)
-            }                                              // for (depth)
-#else
-            for(int im = 0; im < in_cstride; im += MIO_BN_DIST)
-            {
-                for(int i = 0; i < MIO_BN_DIST; i++)
-                {
-                    imgIndex = im + i;
-                    adjIndex = in_cstride * cidx + imgIndex;
-                    // #2 calculate the variances
-                    // sigma^2 = (1/batch_mean) * sum( (x_i - batch_mean)^2 )
-                    for(int bidx = 0; bidx < n_batchs; bidx++)
-                    { // via mini_batch
-                        // per (x-dims) channel load a block of data into LDS
-                        index = in_nstride * bidx + adjIndex;
-                        if(imgIndex < in_cstride)
-                        {
-                            elemStd = x_ptr[index] - mean;              // (x_i - mean)
-                            variance_accum_arr[i] += elemStd * elemStd; // sum{ (x_i - mean)^2 }
-                        }
-                    } // end for
-                }     // end for
-            }
-            for(int i = 0; i < MIO_BN_DIST; i++)
-            {
-                variance += variance_accum_arr[i];
-            }
-#endif
-            variance /= static_cast<Tref>(NHW); // (1/(N*H*W))*sum{ (x_i - mean)^2 }
-            // printf("VARIANCE: %f\n",variance);
             // #3 add epsilon for numeric stability, sqr_root, and invert
             invVar = 1. / sqrt(variance + epsilon);
-            // printf("invVar: %f\n",invVar);
 
             dscale_ptr[cidx] = static_cast<Tref>(0.);
             dbias_ptr[cidx]  = static_cast<Tref>(0.);
-#if(MIO_HEIRARCH_SEL == 0)
-            for(int didx = 0; didx < depth; didx++)
-            { // via depth
-                for(int row = 0; row < height; row++)
-                { // via rows
-                    for(int column = 0; column < width; column++)
-                    { // via columns
-                        adjIndex = Csubindex + in_dstride * didx + width * row + column;
+        }
 
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            xhat_index =
-                                in_cstride * bidx + in_dstride * didx + width * row + column;
-                            // per (x-dims) channel load a block of data into LDS
-                            elemStd          = x_ptr[index] - mean; // (x_i - mean)
-                            xhat[xhat_index] = elemStd * invVar;
-                            dyelem           = dy_ptr[index];
-                            dbias_ptr[cidx] += dyelem;
-                            dscale_ptr[cidx] += xhat[xhat_index] * dyelem;
-                        } // end for(n_batchs)
-                    }     // for (column)
-                }         // for (row)
-            }             // for (depth)
-#else
-            for(int im = 0; im < in_cstride; im += MIO_BN_DIST)
-            {
-                for(int i = 0; i < MIO_BN_DIST; i++)
-                {
-                    imgIndex = im + i;
-                    adjIndex = in_cstride * cidx + imgIndex;
-                    for(int bidx = 0; bidx < n_batchs; bidx++)
-                    { // via mini_batch
-                        index = in_nstride * bidx + adjIndex;
-                        // per (x-dims) channel load a block of data into LDS
-                        if(imgIndex < in_cstride)
-                        {
-                            elemStd = x_ptr[index] - mean; // (x_i - mean)
-                            dyelem  = dy_ptr[index];
-                            dbias_accum_arr[i] += dyelem;
-                            dscale_accum_arr[i] += elemStd * invVar * dyelem;
-                        }
-                    } // end for(n_batchs)
-                }     // for (column)
-            }         // for (row)
-            for(int i = 0; i < MIO_BN_DIST; i++)
+        Tref dbias  = static_cast<Tref>(0.);
+        Tref dscale = static_cast<Tref>(0.);
+        for(int bidx = 0; bidx < n_batchs; bidx++)
+        { // via mini_batch
+            const Tgpu* x  = x_ptr + in_nstride * bidx + c_offset;
+            const Tgpu* dy = dy_ptr + in_nstride * bidx + c_offset;
+            dbias += HostSum<Tref>(in_cstride,
+                                   [&](std::size_t i) { return static_cast<Tref>(dy[i]); });
+            dscale += HostSum<Tref>(in_cstride, [&](std::size_t i) {
+                Tref elemStd = x[i] - mean; // (x_i - mean)
+                return elemStd * invVar * dy[i];
+            });
+        }
+        dbias_ptr[cidx] += dbias;
+        dscale_ptr[cidx] += dscale;
+
+        for(int bidx = 0; bidx < n_batchs; bidx++)
+        { // via mini_batch
+            const Tgpu* x  = x_ptr + in_nstride * bidx + c_offset;
+            const Tgpu* dy = dy_ptr + in_nstride * bidx + c_offset;
+            Tref* dx       = dx_ptr + in_nstride * bidx + c_offset;
+            Tref tmp3      = (scale_ptr[cidx] * invVar) / static_cast<Tref>(NHW);
+            for(std::size_t i = 0; i < in_cstride; i++)
             {
-                dbias_ptr[cidx] += dbias_accum_arr[i];
-                dscale_ptr[cidx] += dscale_accum_arr[i];
+                Tref elemStd = x[i] - mean; // (x_i - mean)
+                Tref tmp1    = static_cast<Tref>(NHW) * dy[i] - dbias_ptr[cidx];
+                Tref tmp2    = -elemStd * invVar * dscale_ptr[cidx];
+                dx[i]        = tmp3 * (tmp2 + tmp1);
             }
-#endif
-
-#if(MIO_HEIRARCH_SEL == 0)
-            for(int didx = 0; didx < depth; didx++)
-            { // via depth
-                for(int row = 0; row < height; row++)
-                { // via rows
-                    for(int column = 0; column < width; column++)
-                    { // via columns
-                        adjIndex = Csubindex + in_dstride * didx + width * row + column;
-                        for(int bidx = 0; bidx < n_batchs; bidx++)
-                        { // via mini_batch
-                            index = in_nstride * bidx + adjIndex;
-                            xhat_index =
-                                in_cstride * bidx + in_dstride * didx + width * row + column;
-                            Tref tmp1 = static_cast<Tref>(NHW) * dy_ptr[index] - dbias_ptr[cidx];
-                            Tref tmp2 = -xhat[xhat_index] * dscale_ptr[cidx];
-                            Tref tmp3 = (scale_ptr[cidx] * invVar) / static_cast<Tref>(NHW);
-                            dx_ptr[index] = tmp3 * (tmp2 + tmp1);
-                        } // end for(n_batchs)
-                    }     // for (column)
-                }         // for (row)
-            }             // for (depth)
-#else
-            for(int im = 0; im < in_cstride; im += MIO_BN_DIST)
-            {
-                for(int i = 0; i < MIO_BN_DIST; i++)
-                {
-                    imgIndex = im + i;
-                    adjIndex = in_cstride * cidx + imgIndex;
-                    for(int bidx = 0; bidx < n_batchs; bidx++)
-                    { // via mini_batch
-                        index = in_nstride * bidx + adjIndex;
-                        if(imgIndex < in_cstride)
-                        {
-                            elemStd   = x_ptr[index] - mean; // (x_i - mean)
-                            Tref tmp1 = static_cast<Tref>(NHW) * dy_ptr[index] - dbias_ptr[cidx];
-                            Tref tmp2 = -elemStd * invVar * dscale_ptr[cidx];
-                            Tref tmp3 = (scale_ptr[cidx] * invVar) / static_cast<Tref>(NHW);
-                            dx_ptr[index] = tmp3 * (tmp2 + tmp1);
-                        }
-                    } // end for(n_batchs)
-                }     // for (column)
-            }         // for (row)
-#endif
-        } // for (channel)
-    }     // end else
-
+        }
+    });
     return 0;
 }
 
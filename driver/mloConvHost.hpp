@@ -27,13 +27,16 @@
 #ifndef MLO_CONVHOST_H_
 #define MLO_CONVHOST_H_
 
+#include <miopen/par_for.hpp>
 #include <miopen/tensor.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
 
 #include "calcerr.hpp"
+#include "host_parallel.hpp"
 
 //#if 0 // disable functions
 #if 1
@@ -41,6 +44,7 @@
 //
 ///////////////////////////////////////////////////////////
 #define ADNN_MM_TRANSPOSE 1
+
 template <typename Dtype>
 void ADNN_mm_cpu(const Dtype* a_ptr,
                  size_t a_cols,
@@ -88,90 +92,19 @@ void ADNN_mm_cpu(const Dtype* a_ptr,
 
     size_t inner_loop = (!(a_flags & ADNN_MM_TRANSPOSE)) ? a_cols : a_rows;
 
-    if(!(a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[m * b_stride + k];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if((a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[m * a_stride + n] * b_ptr[m * b_stride + k];
-#if 0
-                    if (
-                        (n == 0 && k == 33
-                        || n == 1 && k == 32
-                        || n == 3 && k == 1
-                        || n == 4 && k == 0
-
-                        )
-                        && a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k] != 0
-                        )
-                    {
-                        printf("C:mm:%d %d %d   %11.9f %11.9f %11.9f %11.9f\n",
-                            n, k, m,
-                            mm_e, a_ptr[m*a_stride + n], b_ptr[m*b_stride + k], a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k]);
-                    }
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if(!(a_flags & ADNN_MM_TRANSPOSE) && (b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[k * b_stride + m];
-#if 0
-                    if (n == 0 && k == 6 && a_ptr[n*a_stride + m] * b_ptr[k*b_stride + m] != 0)
-                    {
-                        printf("%4d  %11.9f %11.9f %11.9f\n", m, mm_e, a_ptr[n*a_stride + m], b_ptr[k*b_stride + m]);
-                    }
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    c_ptr[n * c_stride + k] += a_ptr[m * a_stride + n] * b_ptr[k * b_stride + m];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
+    HostGemm<Dtype>(a_ptr,
+                    a_stride,
+                    (a_flags & ADNN_MM_TRANSPOSE) != 0,
+                    b_ptr,
+                    b_stride,
+                    (b_flags & ADNN_MM_TRANSPOSE) != 0,
+                    c_ptr,
+                    c_cols,
+                    c_rows,
+                    c_stride,
+                    inner_loop,
+                    alpha,
+                    beta);
 }
 
 template <typename Dtype>
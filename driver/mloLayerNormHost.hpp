@@ -26,6 +26,8 @@
 #ifndef MLO_LAYERNORMHOST_H_
 #define MLO_LAYERNORMHOST_H_
 
+#include "host_parallel.hpp"
+
 ////////////////////////////////////////////////////////////
 //
 ///////////////////////////////////////////////////////////
@@ -56,16 +58,16 @@ int32_t mloLayerNormForwardRunHost(miopenTensorDescriptor_t inputDesc,
 
     int32_t ret = 0;
 
-    for(int32_t o = 0; o < outer_size; o++)
-    {
-        Tcheck pmean = 0.0f;
-        Tcheck pvar  = 0.0f;
-        for(int32_t i = 0; i < inner_size; i++)
-        {
-            Tcheck tmp = static_cast<Tcheck>(input[o * inner_size + i]);
-            pmean += tmp;
-            pvar += tmp * tmp;
-        }
+    // Rows are normalized independently, one row per thread.
+    HostParFor(outer_size, inner_size, [&](size_t o) {
+        const Tgpu* in = input + o * inner_size;
+
+        Tcheck pmean =
+            HostSum<Tcheck>(inner_size, [&](size_t i) { return static_cast<Tcheck>(in[i]); });
+        Tcheck pvar = HostSum<Tcheck>(inner_size, [&](size_t i) {
+            Tcheck tmp = static_cast<Tcheck>(in[i]);
+            return tmp * tmp;
+        });
 
         pmean        = pmean / inner_size;
         pvar         = pvar / inner_size - pmean * pmean;
@@ -74,14 +76,14 @@ int32_t mloLayerNormForwardRunHost(miopenTensorDescriptor_t inputDesc,
         meanhost[o] = pmean;
         rstdhost[o] = prstd;
 
-        for(int32_t i = 0; i < inner_size; i++)
+        for(size_t i = 0; i < inner_size; i++)
         {
             Tcheck pweight = mode ? static_cast<Tcheck>(weight[i]) : 1;
             Tcheck pbias   = mode ? static_cast<Tcheck>(bias[i]) : 0;
             outputhost[o * inner_size + i] =
-                (static_cast<Tcheck>(input[o * inner_size + i]) - pmean) * prstd * pweight + pbias;
+                (static_cast<Tcheck>(in[i]) - pmean) * prstd * pweight + pbias;
         }
-    }
+    });
     return ret;
 }
 #endif
@@ -29,6 +29,9 @@
 
 #include <cmath>
 #include <iomanip>
+#include <vector>
+
+#include "host_parallel.hpp"
 
 ////////////////////////////////////////////////////////////
 //
@@ -79,186 +82,117 @@ int mloLRNForwardRunHost(bool do_scale,
 
     if(norm_region == MLO_LRN_ACROSS_CHANNELS)
     {
-        for(int b = 0; b < n_batchs; b++)
-        {
-            for(int j = 0; j < top_height; j++)
+        // Every image row is processed by a single thread. The window slides over the channels
+        // while the row is walked in memory order, one accumulator per column.
+        const int n_heads = std::max(local_area, n_inputs + pad);
+        HostParFor(n_batchs * top_height, n_heads * top_width, [&](int row) {
+            const int b = row / top_height;
+            const int j = row % top_height;
+
+            const int bot_off   = b * bot_batch_stride + j * bot_stride;
+            const int scale_off = b * scale_v_batch_stride + j * scale_v_stride;
+            const int top_off   = b * top_v_batch_stride + j * top_v_stride;
+
+            // c-emulator
+            std::vector<Tcheck_> accum_scale(top_width, Tcheck_{0});
+            for(int head = 0; head < n_heads; ++head)
             {
-                for(int i = 0; i < top_width; i++)
+                // the channel entering the window
+                if(head < n_inputs)
                 {
-                    // c-emulator
-                    Tcheck_ accum_scale = Tcheck_{0};
-                    int head            = 0;
-                    Tcheck_ bot_val;
-                    while(head < pad)
+                    const Tgpu_* bot = bot_ptr + bot_off + head * bot_channel_stride;
+                    for(int i = 0; i < top_width; i++)
                     {
-                        bot_val = (head < n_inputs)
-                                      ? static_cast<Tcheck_>(
-                                            bot_ptr[b * bot_batch_stride +
-                                                    head * bot_channel_stride + j * bot_stride + i])
-                                      : static_cast<Tcheck_>(0);
-                        accum_scale += bot_val * bot_val;
-                        ++head;
+                        Tcheck_ bot_val = static_cast<Tcheck_>(bot[i]);
+                        accum_scale[i] += bot_val * bot_val;
                     }
-                    // until we reach size, nothing needs to be subtracted
-                    while(head < local_area)
-                    {
-                        bot_val = (head < n_inputs)
-                                      ? static_cast<Tcheck_>(
-                                            bot_ptr[b * bot_batch_stride +
-                                                    head * bot_channel_stride + j * bot_stride + i])
-                                      : static_cast<Tcheck_>(0);
-                        accum_scale += bot_val * bot_val;
-                        Tcheck_ scale = K + accum_scale * alphaoverarea;
-                        if((head - pad) >= 0 && (head - pad) < n_outputs && do_scale)
-                        {
-                            scale_v_ptr[b * scale_v_batch_stride +
-                                        (head - pad) * scale_v_channel_stride + j * scale_v_stride +
-                                        i] = scale;
-                        }
-                        bot_val =
-                            ((head - pad) >= 0 && (head - pad) < n_inputs)
-                                ? static_cast<Tcheck_>(bot_ptr[b * bot_batch_stride +
-                                                               (head - pad) * bot_channel_stride +
-                                                               j * bot_stride + i])
-                                : static_cast<Tcheck_>(0);
-                        Tcheck_ s     = pow(scale, -beta);
-                        Tcheck_ c_val = bot_val * s;
-                        if((head - pad) >= 0 && (head - pad) < n_outputs)
-                        {
-                            top_v_ptr[b * top_v_batch_stride + (head - pad) * top_v_channel_stride +
-                                      j * top_v_stride + i] = c_val;
-                        }
-                        ++head;
-                    }
-                    // both add and subtract
-                    while(head < n_inputs)
-                    {
-                        bot_val = static_cast<Tcheck_>(
-                            bot_ptr[b * bot_batch_stride + head * bot_channel_stride +
-                                    j * bot_stride + i]);
-                        accum_scale += bot_val * bot_val;
-                        bot_val = ((head - local_area) >= 0)
-                                      ? static_cast<Tcheck_>(
-                                            bot_ptr[b * bot_batch_stride +
-                                                    (head - local_area) * bot_channel_stride +
-                                                    j * bot_stride + i])
-                                      : static_cast<Tcheck_>(0);
-                        accum_scale -= bot_val * bot_val;
-                        Tcheck_ scale = K + accum_scale * alphaoverarea;
-                        if((head - pad) >= 0 && do_scale)
-                        {
-                            scale_v_ptr[b * scale_v_batch_stride +
-                                        (head - pad) * scale_v_channel_stride + j * scale_v_stride +
-                                        i] = scale;
-                        }
-                        Tcheck_ s = pow(scale, -beta);
-                        bot_val =
-                            ((head - pad) >= 0)
-                                ? static_cast<Tcheck_>(bot_ptr[b * bot_batch_stride +
-                                                               (head - pad) * bot_channel_stride +
-                                                               j * bot_stride + i])
-                                : static_cast<Tcheck_>(0);
-                        Tcheck_ c_val = bot_val * s;
-                        if((head - pad) >= 0)
-                        {
-                            top_v_ptr[b * top_v_batch_stride + (head - pad) * top_v_channel_stride +
-                                      j * top_v_stride + i] = c_val;
-                        }
-                        ++head;
-                    }
-                    // subtract only
-                    while(head < n_inputs + pad)
+                }
+                // the channel leaving the window
+                if(head >= local_area && head - local_area < n_inputs)
+                {
+                    const Tgpu_* bot = bot_ptr + bot_off + (head - local_area) * bot_channel_stride;
+                    for(int i = 0; i < top_width; i++)
                     {
-                        bot_val = ((head - local_area) >= 0 && (head - local_area) < n_inputs)
-                                      ? static_cast<Tcheck_>(
-                                            bot_ptr[b * bot_batch_stride +
-                                                    (head - local_area) * bot_channel_stride +
-                                                    j * bot_stride + i])
-                                      : static_cast<Tcheck_>(0);
-                        accum_scale -= bot_val * bot_val;
-                        Tcheck_ scale = K + accum_scale * alphaoverarea;
-                        if((head - pad) >= 0 && (head - pad) < n_outputs && do_scale)
-                        {
-                            scale_v_ptr[b * scale_v_batch_stride +
-                                        (head - pad) * scale_v_channel_stride + j * scale_v_stride +
-                                        i] = scale;
-                        }
-                        bot_val =
-                            ((head - pad) >= 0 && (head - pad) < n_inputs)
-                                ? static_cast<Tcheck_>(bot_ptr[b * bot_batch_stride +
-                                                               (head - pad) * bot_channel_stride +
-                                                               j * bot_stride + i])
-                                : static_cast<Tcheck_>(0);
-                        Tcheck_ s     = pow(scale, -beta);
-                        Tcheck_ c_val = bot_val * s;
-                        if((head - pad) >= 0 && (head - pad) < n_outputs)
-                        {
-                            top_v_ptr[b * top_v_batch_stride + (head - pad) * top_v_channel_stride +
-                                      j * top_v_stride + i] = c_val;
-                        }
-                        ++head;
+                        Tcheck_ bot_val = static_cast<Tcheck_>(bot[i]);
+                        accum_scale[i] -= bot_val * bot_val;
                     }
+                }
+                // until we reach pad, nothing is written
+                if(head < pad)
+                    continue;
 
-                } // for (int i = 0; i < top_width; i++)
-            }     // for (int j = 0; j < top_height; j++)
-        }         // for (int b = 0; b < batch; b++)
+                const int o = head - pad;
+                for(int i = 0; i < top_width; i++)
+                {
+                    Tcheck_ scale = K + accum_scale[i] * alphaoverarea;
+                    if(o < n_outputs && do_scale)
+                        scale_v_ptr[scale_off + o * scale_v_channel_stride + i] = scale;
+                    Tcheck_ bot_val =
+                        (o < n_inputs)
+                            ? static_cast<Tcheck_>(bot_ptr[bot_off + o * bot_channel_stride + i])
+                            : static_cast<Tcheck_>(0);
+                    Tcheck_ s     = pow(scale, -beta);
+                    Tcheck_ c_val = bot_val * s;
+                    if(o < n_outputs)
+                        top_v_ptr[top_off + o * top_v_channel_stride + i] = c_val;
+                }
+            }
+        });
     }
     else
     {
-        for(int b = 0; b < n_batchs; b++)
-        {
-            for(int o = 0; o < n_outputs; o++)
+        HostParFor(n_batchs * n_outputs, top_height * top_width * local_area, [&](int slice) {
+            const int b = slice / n_outputs;
+            const int o = slice % n_outputs;
+
+            for(int j = 0; j < top_height; j++)
             {
-                for(int j = 0; j < top_height; j++)
+                for(int i = 0; i < top_width; i++)
                 {
-                    for(int i = 0; i < top_width; i++)
+                    // c-emulator
+                    Tcheck_ scale     = static_cast<Tcheck_>(0);
+                    int hstart        = j - (local_area - 1 - pad);
+                    int wstart        = i - (local_area - 1 - pad);
+                    int hend          = std::min(hstart + local_area, bot_height + pad);
+                    int wend          = std::min(wstart + local_area, bot_width + pad);
+                    int adj_area_size = (hend - hstart) * (wend - wstart);
+                    hstart            = std::max(hstart, 0);
+                    wstart            = std::max(wstart, 0);
+                    hend              = std::min(hend, bot_height);
+                    wend              = std::min(wend, bot_width);
+                    Tcheck_ accum     = static_cast<Tcheck_>(0);
+                    for(int h = hstart; h < hend; ++h)
                     {
-                        // c-emulator
-                        Tcheck_ scale     = static_cast<Tcheck_>(0);
-                        int hstart        = j - (local_area - 1 - pad);
-                        int wstart        = i - (local_area - 1 - pad);
-                        int hend          = std::min(hstart + local_area, bot_height + pad);
-                        int wend          = std::min(wstart + local_area, bot_width + pad);
-                        int adj_area_size = (hend - hstart) * (wend - wstart);
-                        hstart            = std::max(hstart, 0);
-                        wstart            = std::max(wstart, 0);
-                        hend              = std::min(hend, bot_height);
-                        wend              = std::min(wend, bot_width);
-                        Tcheck_ accum     = static_cast<Tcheck_>(0);
-                        for(int h = hstart; h < hend; ++h)
+                        const Tgpu_* bot = bot_ptr + b * bot_batch_stride + o * bot_channel_stride +
+                                           h * bot_stride;
+                        for(int w = wstart; w < wend; ++w)
                         {
-                            for(int w = wstart; w < wend; ++w)
-                            {
-
-                                Tcheck_ bot_val = static_cast<Tcheck_>(
-                                    bot_ptr[b * bot_batch_stride + o * bot_channel_stride +
-                                            h * bot_stride + w]);
-                                accum += bot_val * bot_val;
-                            }
+                            Tcheck_ bot_val = static_cast<Tcheck_>(bot[w]);
+                            accum += bot_val * bot_val;
                         }
+                    }
 
-                        alphaoverarea = alpha / adj_area_size;
-                        scale         = K + accum * alphaoverarea;
-                        if(do_scale)
-                        {
-                            scale_v_ptr[b * scale_v_batch_stride + o * scale_v_channel_stride +
-                                        j * scale_v_stride + i] = scale;
-                        }
+                    Tcheck_ adj_alphaoverarea = alpha / adj_area_size;
+                    scale                     = K + accum * adj_alphaoverarea;
+                    if(do_scale)
+                    {
+                        scale_v_ptr[b * scale_v_batch_stride + o * scale_v_channel_stride +
+                                    j * scale_v_stride + i] = scale;
+                    }
 
-                        Tcheck_ s       = pow(scale, -beta);
-                        Tcheck_ bot_val = static_cast<Tcheck_>(
-                            bot_ptr[b * bot_batch_stride + o * bot_channel_stride + j * bot_stride +
-                                    i]);
-                        Tcheck_ c_val = bot_val * s;
+                    Tcheck_ s       = pow(scale, -beta);
+                    Tcheck_ bot_val = static_cast<Tcheck_>(
+                        bot_ptr[b * bot_batch_stride + o * bot_channel_stride + j * bot_stride +
+                                i]);
+                    Tcheck_ c_val = bot_val * s;
 
-                        top_v_ptr[b * top_v_batch_stride + o * top_v_channel_stride +
-                                  j * top_v_stride + i] = c_val;
+                    top_v_ptr[b * top_v_batch_stride + o * top_v_channel_stride +
+                              j * top_v_stride + i] = c_val;
 
-                    } // for (int i = 0; i < top_width; i++)
-                }     // for (int j = 0; j < top_height; j++)
-            }         // for (int o = 0; o < outputs; o++)
-        }             // for (int b = 0; b < batch; b++)
-    }                 // (norm_region == ACROSS_CHANNELS)
+                } // for (int i = 0; i < top_width; i++)
+            }     // for (int j = 0; j < top_height; j++)
+        });
+    } // (norm_region == ACROSS_CHANNELS)
 
     return (ret);
 }
@@ -316,254 +250,123 @@ int mloLRNBackwardRunHost(int norm_region,
         Tcheck_ ratio_dta_bwd =
             static_cast<Tcheck_>(2.) * alpha * beta / static_cast<Tcheck_>(local_area);
 
-        for(int b = 0; b < n_batchs; b++)
-        {
-            for(int j = 0; j < bot_height; j++)
+        // Same traversal as the forward pass: one thread per image row, the window slides over
+        // the channels and the row is walked in memory order.
+        const int n_heads = std::max(local_area, n_inputs + pre_pad);
+        HostParFor(n_batchs * bot_height, n_heads * bot_width, [&](int row) {
+            const int b = row / bot_height;
+            const int j = row % bot_height;
+
+            const int top_df_off = b * top_df_batch_stride + j * top_df_stride;
+            const int top_off    = b * top_batch_stride + j * top_stride;
+            const int scale_off  = b * scale_batch_stride + j * scale_stride;
+            const int bot_off    = b * bot_batch_stride + j * bot_stride;
+            const int bot_df_off = b * bot_df_v_batch_stride + j * bot_df_v_stride;
+
+            const auto ratio = [&](int c, int i) {
+                return static_cast<Tcheck_>(
+                           top_df_ptr[top_df_off + c * top_df_channel_stride + i]) *
+                       static_cast<Tcheck_>(top_ptr[top_off + c * top_channel_stride + i]) /
+                       static_cast<Tcheck_>(scale_ptr[scale_off + c * scale_channel_stride + i]);
+            };
+
+            // c-emulator
+            std::vector<Tcheck_> accum_ratio(bot_width, static_cast<Tcheck_>(0));
+            for(int head = 0; head < n_heads; ++head)
             {
+                // the channel entering the window
+                if(head < n_inputs)
+                {
+                    for(int i = 0; i < bot_width; i++)
+                        accum_ratio[i] += ratio(head, i);
+                }
+                // the channel leaving the window
+                if(head >= local_area && head - local_area < n_inputs)
+                {
+                    for(int i = 0; i < bot_width; i++)
+                        accum_ratio[i] -= ratio(head - local_area, i);
+                }
+                // until we reach pre_pad, nothing is written
+                if(head < pre_pad || head - pre_pad >= n_inputs)
+                    continue;
+
+                const int o = head - pre_pad;
                 for(int i = 0; i < bot_width; i++)
                 {
+                    bot_df_v_ptr[bot_df_off + o * bot_df_v_channel_stride + i] =
+                        static_cast<Tcheck_>(
+                            top_df_ptr[top_df_off + o * top_df_channel_stride + i]) *
+                            pow(static_cast<Tcheck_>(
+                                    scale_ptr[scale_off + o * scale_channel_stride + i]),
+                                negative_beta) -
+                        ratio_dta_bwd *
+                            static_cast<Tcheck_>(bot_ptr[bot_off + o * bot_channel_stride + i]) *
+                            accum_ratio[i];
+                }
+            }
+        });
+    } // if (norm_region == MLO_LRN_ACROSS_CHANNELS)
+    else
+    {
+        HostParFor(n_batchs * n_inputs, bot_height * bot_width * local_area, [&](int slice) {
+            const int b = slice / n_inputs;
+            const int o = slice % n_inputs;
 
-                    // c-emulator
-                    int head            = 0;
+            for(int j = 0; j < bot_height; j++)
+            {
+
+                for(int i = 0; i < bot_width; i++)
+                {
                     Tcheck_ accum_ratio = static_cast<Tcheck_>(0);
 
-                    // accumulate values
-                    while(head < pre_pad)
+                    int hstart        = j - pad;
+                    int wstart        = i - pad;
+                    int hend          = std::min(hstart + local_area, top_height + pre_pad);
+                    int wend          = std::min(wstart + local_area, top_width + pre_pad);
+                    int adj_area_size = (hend - hstart) * (wend - wstart);
+                    hstart            = std::max(hstart, 0);
+                    wstart            = std::max(wstart, 0);
+                    hend              = std::min(hend, top_height);
+                    wend              = std::min(wend, top_width);
+                    for(int h = hstart; h < hend; ++h)
                     {
-                        if(head < n_inputs)
+                        for(int w = wstart; w < wend; ++w)
                         {
                             Tcheck_ adder =
-                                (static_cast<Tcheck_>(top_df_ptr[b * top_df_batch_stride +
-                                                                 head * top_df_channel_stride +
-                                                                 j * top_df_stride + i]) *
-                                 static_cast<Tcheck_>(
-                                     top_ptr[b * top_batch_stride + head * top_channel_stride +
-                                             j * top_stride + i])) /
+                                static_cast<Tcheck_>(top_df_ptr[b * top_df_batch_stride +
+                                                                o * top_df_channel_stride +
+                                                                h * top_df_stride + w]) *
                                 static_cast<Tcheck_>(
-                                    scale_ptr[b * scale_batch_stride + head * scale_channel_stride +
-                                              j * scale_stride + i]);
-
-                            accum_ratio += adder;
-                        }
-
-                        ++head;
-                    }
-
-                    // until we reach size, nothing needs to be subtracted
-                    while(head < local_area)
-                    {
-
-                        if(head < n_inputs)
-                        {
-                            Tcheck_ adder =
-                                (static_cast<Tcheck_>(top_df_ptr[b * top_df_batch_stride +
-                                                                 head * top_df_channel_stride +
-                                                                 j * top_df_stride + i]) *
-                                 static_cast<Tcheck_>(
-                                     top_ptr[b * top_batch_stride + head * top_channel_stride +
-                                             j * top_stride + i])) /
+                                    top_ptr[b * top_batch_stride + o * top_channel_stride +
+                                            h * top_stride + w]) /
                                 static_cast<Tcheck_>(
-                                    scale_ptr[b * scale_batch_stride + head * scale_channel_stride +
-                                              j * scale_stride + i]);
+                                    scale_ptr[b * scale_batch_stride + o * scale_channel_stride +
+                                              h * scale_stride + w]);
 
                             accum_ratio += adder;
                         }
-
-                        if(head - pre_pad >= 0 && head - pre_pad < n_inputs)
-                        {
-                            bot_df_v_ptr[b * bot_df_v_batch_stride +
-                                         (head - pre_pad) * bot_df_v_channel_stride +
-                                         j * bot_df_v_stride + i] =
-                                static_cast<Tcheck_>(
-                                    top_df_ptr[b * top_df_batch_stride +
-                                               (head - pre_pad) * top_df_channel_stride +
-                                               j * top_df_stride + i]) *
-                                    pow(static_cast<Tcheck_>(
-                                            scale_ptr[b * scale_batch_stride +
-                                                      (head - pre_pad) * scale_channel_stride +
-                                                      j * scale_stride + i]),
-                                        negative_beta) -
-                                ratio_dta_bwd *
-                                    static_cast<Tcheck_>(
-                                        bot_ptr[b * bot_batch_stride +
-                                                (head - pre_pad) * bot_channel_stride +
-                                                j * bot_stride + i]) *
-                                    accum_ratio;
-                        }
-                        ++head;
-                    }
-
-                    // both add and subtract
-                    while(head < n_inputs)
-                    {
-
-                        Tcheck_ adder =
-                            static_cast<Tcheck_>(
-                                top_df_ptr[b * top_df_batch_stride + head * top_df_channel_stride +
-                                           j * top_df_stride + i]) *
-                            static_cast<Tcheck_>(
-                                top_ptr[b * top_batch_stride + head * top_channel_stride +
-                                        j * top_stride + i]) /
-                            static_cast<Tcheck_>(
-                                scale_ptr[b * scale_batch_stride + head * scale_channel_stride +
-                                          j * scale_stride + i]);
-
-                        accum_ratio += adder;
-
-                        if(head - local_area >= 0)
-                        {
-                            Tcheck_ subs =
-                                (static_cast<Tcheck_>(
-                                     top_df_ptr[b * top_df_batch_stride +
-                                                (head - local_area) * top_df_channel_stride +
-                                                j * top_df_stride + i]) *
-                                 static_cast<Tcheck_>(
-                                     top_ptr[b * top_batch_stride +
-                                             (head - local_area) * top_channel_stride +
-                                             j * top_stride + i])) /
-                                static_cast<Tcheck_>(
-                                    scale_ptr[b * scale_batch_stride +
-                                              (head - local_area) * scale_channel_stride +
-                                              j * scale_stride + i]);
-
-                            accum_ratio -= subs;
-                        }
-                        if(head - pre_pad >= 0)
-                        {
-                            bot_df_v_ptr[b * bot_df_v_batch_stride +
-                                         (head - pre_pad) * bot_df_v_channel_stride +
-                                         j * bot_df_v_stride + i] =
-                                static_cast<Tcheck_>(
-                                    top_df_ptr[b * top_df_batch_stride +
-                                               (head - pre_pad) * top_df_channel_stride +
-                                               j * top_df_stride + i]) *
-                                    pow(static_cast<Tcheck_>(
-                                            scale_ptr[b * scale_batch_stride +
-                                                      (head - pre_pad) * scale_channel_stride +
-                                                      j * scale_stride + i]),
-                                        negative_beta) -
-                                ratio_dta_bwd *
-                                    static_cast<Tcheck_>(
-                                        bot_ptr[b * bot_batch_stride +
-                                                (head - pre_pad) * bot_channel_stride +
-                                                j * bot_stride + i]) *
-                                    accum_ratio;
-                        }
-
-                        ++head;
                     }
-                    // subtract only
-                    while(head < n_inputs + pre_pad)
-                    {
-                        if(head - local_area >= 0 && head - local_area < n_inputs)
-                        {
-                            Tcheck_ subs =
-                                (static_cast<Tcheck_>(
-                                     top_df_ptr[b * top_df_batch_stride +
-                                                (head - local_area) * top_df_channel_stride +
-                                                j * top_df_stride + i]) *
-                                 static_cast<Tcheck_>(
-                                     top_ptr[b * top_batch_stride +
-                                             (head - local_area) * top_channel_stride +
-                                             j * top_stride + i])) /
-                                static_cast<Tcheck_>(
-                                    scale_ptr[b * scale_batch_stride +
-                                              (head - local_area) * scale_channel_stride +
-                                              j * scale_stride + i]);
 
-                            accum_ratio -= subs;
-                        }
-                        if(head - pre_pad >= 0 && head - pre_pad < n_inputs)
-                        {
-                            bot_df_v_ptr[b * bot_df_v_batch_stride +
-                                         (head - pre_pad) * bot_df_v_channel_stride +
-                                         j * bot_df_v_stride + i] =
-                                static_cast<Tcheck_>(
-                                    top_df_ptr[b * top_df_batch_stride +
-                                               (head - pre_pad) * top_df_channel_stride +
-                                               j * top_df_stride + i]) *
-                                    pow(static_cast<Tcheck_>(
-                                            scale_ptr[b * scale_batch_stride +
-                                                      (head - pre_pad) * scale_channel_stride +
-                                                      j * scale_stride + i]),
-                                        negative_beta) -
-                                ratio_dta_bwd *
-                                    static_cast<Tcheck_>(
-                                        bot_ptr[b * bot_batch_stride +
-                                                (head - pre_pad) * bot_channel_stride +
-                                                j * bot_stride + i]) *
-                                    accum_ratio;
-                        }
-
-                        ++head;
-                    }
-
-                } // for (int i = 0; i < bot_width; i++)
-            }     // for (int j = 0; j < bot_height; j++)
-        }         // for (int b = 0; b < n_batchs; b++)
-    }             // if (norm_region == MLO_LRN_ACROSS_CHANNELS)
-    else
-    {
-        for(int b = 0; b < n_batchs; b++)
-        {
-            for(int o = 0; o < n_inputs; o++)
-            {
-                for(int j = 0; j < bot_height; j++)
-                {
-
-                    for(int i = 0; i < bot_width; i++)
-                    {
-                        Tcheck_ accum_ratio = static_cast<Tcheck_>(0);
-
-                        int hstart        = j - pad;
-                        int wstart        = i - pad;
-                        int hend          = std::min(hstart + local_area, top_height + pre_pad);
-                        int wend          = std::min(wstart + local_area, top_width + pre_pad);
-                        int adj_area_size = (hend - hstart) * (wend - wstart);
-                        hstart            = std::max(hstart, 0);
-                        wstart            = std::max(wstart, 0);
-                        hend              = std::min(hend, top_height);
-                        wend              = std::min(wend, top_width);
-                        for(int h = hstart; h < hend; ++h)
-                        {
-                            for(int w = wstart; w < wend; ++w)
-                            {
-                                Tcheck_ adder =
-                                    static_cast<Tcheck_>(top_df_ptr[b * top_df_batch_stride +
-                                                                    o * top_df_channel_stride +
-                                                                    h * top_df_stride + w]) *
-                                    static_cast<Tcheck_>(
-                                        top_ptr[b * top_batch_stride + o * top_channel_stride +
-                                                h * top_stride + w]) /
-                                    static_cast<Tcheck_>(
-                                        scale_ptr[b * scale_batch_stride +
-                                                  o * scale_channel_stride + h * scale_stride + w]);
-
-                                accum_ratio += adder;
-                            }
-                        }
-
-                        Tcheck_ ratio_dta_bwd = static_cast<Tcheck_>(2.) * alpha * beta /
-                                                static_cast<Tcheck_>(adj_area_size);
-
-                        bot_df_v_ptr[b * bot_df_v_batch_stride + o * bot_df_v_channel_stride +
-                                     j * bot_df_v_stride + i] =
+                    Tcheck_ ratio_dta_bwd = static_cast<Tcheck_>(2.) * alpha * beta /
+                                            static_cast<Tcheck_>(adj_area_size);
+
+                    bot_df_v_ptr[b * bot_df_v_batch_stride + o * bot_df_v_channel_stride +
+                                 j * bot_df_v_stride + i] =
+                        static_cast<Tcheck_>(
+                            top_df_ptr[b * top_df_batch_stride + o * top_df_channel_stride +
+                                       j * top_df_stride + i]) *
+                            pow(static_cast<Tcheck_>(
+                                    scale_ptr[b * scale_batch_stride + o * scale_channel_stride +
+                                              j * scale_stride + i]),
+                                negative_beta) -
+                        ratio_dta_bwd *
                             static_cast<Tcheck_>(
-                                top_df_ptr[b * top_df_batch_stride + o * top_df_channel_stride +
-                                           j * top_df_stride + i]) *
-                                pow(static_cast<Tcheck_>(
-                                        scale_ptr[b * scale_batch_stride +
-                                                  o * scale_channel_stride + j * scale_stride + i]),
-                                    negative_beta) -
-                            ratio_dta_bwd *
-                                static_cast<Tcheck_>(
-                                    bot_ptr[b * bot_batch_stride + o * bot_channel_stride +
-                                            j * bot_stride + i]) *
-                                accum_ratio;
-                    }
+                                bot_ptr[b * bot_batch_stride + o * bot_channel_stride +
+                                        j * bot_stride + i]) *
+                            accum_ratio;
                 }
             }
-        }
+        });
 
     } // if (norm_region == MLO_LRN_ACROSS_CHANNELS)
 
@@ -33,11 +33,15 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstring>
 #include <iomanip>
+#include <mutex>
+#include <vector>
 
 #include "calcerr.hpp"
+#include "host_parallel.hpp"
 
 #if 0
 template<typename _T>
@@ -138,173 +142,177 @@ bool mloPoolingForwardRunHostAndVerify(int pooling_method,
     const int mask_c_stride           = mask_d_stride * top_depth;
     const int mask_n_stride           = mask_c_stride * n_outputs;
 
-    bool match = true;
     Tcheck_ MAX_VAL(3.402823466e+38);
     Tgpu_ G_MAX_VAL = (sizeof(Tgpu_) == 4 || sizeof(Tgpu_) == 8)
                           ? static_cast<Tgpu_>(3.402823466e+38)
                           : static_cast<Tgpu_>(65504);
-    // c-emulator
-    Tcheck_ res = static_cast<Tcheck_>(0);
 
-    for(int b = 0; b < n_batchs && match; b++)
+    if(pooling_method != MLO_POOLING_OP_MAX && pooling_method != MLO_POOLING_OP_AVE &&
+       pooling_method != MLO_POOLING_OP_AVE_INCLUSIVE)
     {
-        for(int o = 0; o < n_outputs && match; o++)
+        std::cout << "ERROR: unknown operator : layer: pooling." << std::endl;
+        return false;
+    }
+
+    // Every (batch, channel) slice is verified on its own thread, the first mismatch stops the
+    // remaining ones.
+    std::atomic<bool> match(true);
+    std::mutex log_mutex;
+    std::vector<pooling_math_stats> slice_stats(static_cast<std::size_t>(n_batchs) * n_outputs);
+    const std::size_t slice_work = static_cast<std::size_t>(top_depth) * top_height * top_width *
+                                   filter_size_d * filter_size_h * filter_size_w;
+
+    HostParFor(slice_stats.size(), slice_work, [&](std::size_t slice) {
+        const int b               = slice / n_outputs;
+        const int o               = slice % n_outputs;
+        pooling_math_stats& local = slice_stats[slice];
+
+        for(int k = 0; k < top_depth && match; k++)
         {
-            for(int k = 0; k < top_depth && match; k++)
+            for(int j = 0; j < top_height && match; j++)
             {
-                for(int j = 0; j < top_height && match; j++)
+                for(int i = 0; i < top_width && match; i++)
                 {
-                    for(int i = 0; i < top_width && match; i++)
+                    // c-emulator
+                    Tcheck_ res = pooling_method == MLO_POOLING_OP_MAX ? -MAX_VAL
+                                                                       : static_cast<Tcheck_>(0);
+                    int num_flops_per_res = 0;
+
+                    int dstart = k * pool_stride_d - pad_d;
+                    int hstart = j * pool_stride_h - pad_h;
+                    int wstart = i * pool_stride_w - pad_w;
+                    int dend   = std::min(dstart + filter_size_d, bot_depth);
+                    int hend   = std::min(hstart + filter_size_h, bot_height);
+                    int wend   = std::min(wstart + filter_size_w, bot_width);
+                    dstart     = std::max(dstart, 0);
+                    hstart     = std::max(hstart, 0);
+                    wstart     = std::max(wstart, 0);
+
+                    int pool_size;
+                    if(pooling_method == MLO_POOLING_OP_AVE)
+                        pool_size = (dend - dstart) * (hend - hstart) * (wend - wstart);
+                    else
+                        pool_size = filter_size_w * filter_size_h * filter_size_d;
+                    pool_size            = (pool_size == 0) ? 1 : pool_size;
+                    size_t res_index     = 0;
+                    size_t res_index_gpu = 0;
+                    bool found           = false;
+                    for(int d = dstart; d < dend; ++d)
                     {
-                        // c-emulator
-                        if(pooling_method == MLO_POOLING_OP_MAX)
-                        {
-                            res = -MAX_VAL;
-                        }
-                        else if(pooling_method == MLO_POOLING_OP_AVE ||
-                                pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
+                        for(int h = hstart; h < hend; ++h)
                         {
-                            res = static_cast<Tcheck_>(0);
-                        }
-                        int num_flops_per_res = 0;
-
-                        int dstart = k * pool_stride_d - pad_d;
-                        int hstart = j * pool_stride_h - pad_h;
-                        int wstart = i * pool_stride_w - pad_w;
-                        int dend   = std::min(dstart + filter_size_d, bot_depth);
-                        int hend   = std::min(hstart + filter_size_h, bot_height);
-                        int wend   = std::min(wstart + filter_size_w, bot_width);
-                        dstart     = std::max(dstart, 0);
-                        hstart     = std::max(hstart, 0);
-                        wstart     = std::max(wstart, 0);
-
-                        int pool_size;
-                        if(pooling_method == MLO_POOLING_OP_AVE)
-                            pool_size = (dend - dstart) * (hend - hstart) * (wend - wstart);
-                        else
-                            pool_size = filter_size_w * filter_size_h * filter_size_d;
-                        pool_size            = (pool_size == 0) ? 1 : pool_size;
-                        size_t res_index     = 0;
-                        size_t res_index_gpu = 0;
-                        bool found           = false;
-                        for(int d = dstart; d < dend; ++d)
-                        {
-                            for(int h = hstart; h < hend; ++h)
+                            const size_t row_index = b * bot_n_stride + o * bot_c_stride +
+                                                     d * bot_d_stride + h * bot_h_stride;
+                            for(int w = wstart; w < wend; ++w)
                             {
-                                for(int w = wstart; w < wend; ++w)
+                                size_t bot_index = row_index + w * bot_w_stride;
+                                if(pooling_method == MLO_POOLING_OP_MAX)
                                 {
-                                    size_t bot_index = b * bot_n_stride + o * bot_c_stride +
-                                                       d * bot_d_stride + h * bot_h_stride +
-                                                       w * bot_w_stride;
-                                    if(pooling_method == MLO_POOLING_OP_MAX)
+                                    if(static_cast<Tcheck_>(bot_ptr[bot_index]) > res)
                                     {
-                                        if(static_cast<Tcheck_>(bot_ptr[bot_index]) > res)
-                                        {
-                                            res = static_cast<Tcheck_>(bot_ptr[bot_index]);
-                                            num_flops_per_res = 0;
-                                            res_index         = bot_index;
-                                            res_index_gpu =
-                                                index_position == 1
-                                                    ? (d * bot_height * bot_width + h * bot_width +
-                                                       w)
-                                                    : ((d - k * pool_stride_d + pad_d) *
-                                                       filter_size_w * filter_size_h) +
-                                                          ((h - j * pool_stride_h + pad_h) *
-                                                           filter_size_w) +
-                                                          (w - i * pool_stride_w + pad_w);
-                                            found = true;
-                                        }
+                                        res = static_cast<Tcheck_>(bot_ptr[bot_index]);
+                                        num_flops_per_res = 0;
+                                        res_index         = bot_index;
+                                        res_index_gpu =
+                                            index_position == 1
+                                                ? (d * bot_height * bot_width + h * bot_width + w)
+                                                : ((d - k * pool_stride_d + pad_d) *
+                                                   filter_size_w * filter_size_h) +
+                                                      ((h - j * pool_stride_h + pad_h) *
+                                                       filter_size_w) +
+                                                      (w - i * pool_stride_w + pad_w);
+                                        found = true;
                                     }
-                                    else if(pooling_method == MLO_POOLING_OP_AVE ||
-                                            pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
-                                    {
+                                }
+                                else
+                                {
 #if MLO_POOLING_EMULATE_VALIDATION_FAILURE
-                                        if(num_flops_per_res %
-                                               MLO_POOLING_EMULATE_VALIDATION_FAILURE !=
-                                           0)
+                                    if(num_flops_per_res % MLO_POOLING_EMULATE_VALIDATION_FAILURE !=
+                                       0)
 #endif
-                                            res += static_cast<Tcheck_>(bot_ptr[bot_index]);
-                                        ++num_flops_per_res;
-                                    }
-                                    else
-                                    {
-                                        std::cout << "ERROR: unknown operator : layer: pooling."
-                                                  << std::endl;
-                                        match = false;
-                                        continue;
-                                    }
+                                        res += static_cast<Tcheck_>(bot_ptr[bot_index]);
+                                    ++num_flops_per_res;
                                 }
                             }
                         }
-                        // special index value is used to mark top points which has no associated
-                        // bottom
-                        // points
-                        if(!found)
-                        {
-                            res_index     = std::numeric_limits<size_t>::max();
-                            res_index_gpu = std::numeric_limits<uint8_t>::max();
-                        }
+                    }
+                    // special index value is used to mark top points which has no associated
+                    // bottom
+                    // points
+                    if(!found)
+                    {
+                        res_index     = std::numeric_limits<size_t>::max();
+                        res_index_gpu = std::numeric_limits<uint8_t>::max();
+                    }
 
-                        size_t top_index = b * top_n_stride + o * top_c_stride + k * top_d_stride +
-                                           j * top_h_stride + i * top_w_stride;
-                        size_t mask_gpu_index = b * mask_n_stride + o * mask_c_stride +
-                                                k * mask_d_stride + j * mask_h_stride +
-                                                i * mask_w_stride;
-                        if(pooling_method == MLO_POOLING_OP_MAX)
+                    size_t top_index = b * top_n_stride + o * top_c_stride + k * top_d_stride +
+                                       j * top_h_stride + i * top_w_stride;
+                    size_t mask_gpu_index = b * mask_n_stride + o * mask_c_stride +
+                                            k * mask_d_stride + j * mask_h_stride +
+                                            i * mask_w_stride;
+                    if(pooling_method == MLO_POOLING_OP_MAX)
+                    {
+                        // the case with the odd input, the even kernel size and 2*pad == kernel
+                        // size
+                        mask_ptr[top_index] = res_index;
+                        if(do_backward)
                         {
-                            // the case with the odd input, the even kernel size and 2*pad == kernel
-                            // size
-                            mask_ptr[top_index] = res_index;
-                            if(do_backward)
+                            size_t mg = mask_gpu[mask_gpu_index];
+                            if(mg != res_index_gpu)
                             {
-                                size_t mg = mask_gpu[mask_gpu_index];
-                                if(mg != res_index_gpu)
-                                {
-                                    std::cout << "Mask mismatch, gpu " << mg << " cpu "
-                                              << res_index_gpu << "(" << res_index << ")"
-                                              << std::endl;
-                                    match = false;
-                                }
+                                std::lock_guard<std::mutex> lock(log_mutex);
+                                std::cout << "Mask mismatch, gpu " << mg << " cpu "
+                                          << res_index_gpu << "(" << res_index << ")"
+                                          << std::endl;
+                                match = false;
                             }
                         }
-                        if(pooling_method == MLO_POOLING_OP_AVE ||
-                           pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
-                        {
-                            res /= pool_size;
-                            ++num_flops_per_res;
-                        }
-                        Tcheck_ c_val = res;
-
-                        Tgpu_ gg_val = (top_ptr[top_index]);
+                    }
+                    else
+                    {
+                        res /= pool_size;
+                        ++num_flops_per_res;
+                    }
+                    Tcheck_ c_val = res;
 
-                        gg_val = (Tgpu_(gg_val) == Tgpu_(-G_MAX_VAL)) ? Tgpu_(0) : Tgpu_(gg_val);
+                    Tgpu_ gg_val = (top_ptr[top_index]);
 
-                        c_val = (c_val == -MAX_VAL) ? 0 : c_val;
+                    gg_val = (Tgpu_(gg_val) == Tgpu_(-G_MAX_VAL)) ? Tgpu_(0) : Tgpu_(gg_val);
 
-                        Tcheck_ g_val(gg_val);
+                    c_val = (c_val == -MAX_VAL) ? 0 : c_val;
 
-                        double err = std::abs(c_val - g_val);
+                    Tcheck_ g_val(gg_val);
 
-                        if(err > allowedEps || std::isnan(c_val) || std::isnan(g_val) ||
-                           !std::isfinite(c_val) || !std::isfinite(g_val))
-                        {
-                            std::cout << "Difference " << err << " too large (> " << allowedEps
-                                      << ") at {" << b << ',' << o << ',' << j << ',' << i
-                                      << "}, cpu_val = " << c_val << " vs gpu_val = " << g_val
-                                      << std::endl;
-                            std::cout << "Number of flops used: " << num_flops_per_res
-                                      << ", pool_size: " << pool_size << std::endl;
-                            match = false;
-                        }
+                    double err = std::abs(c_val - g_val);
 
-                        if(err > stats.max_error)
-                            stats.max_error = err;
-                        if(num_flops_per_res > stats.max_num_flops_per_res)
-                            stats.max_num_flops_per_res = num_flops_per_res;
+                    if(err > allowedEps || std::isnan(c_val) || std::isnan(g_val) ||
+                       !std::isfinite(c_val) || !std::isfinite(g_val))
+                    {
+                        std::lock_guard<std::mutex> lock(log_mutex);
+                        std::cout << "Difference " << err << " too large (> " << allowedEps
+                                  << ") at {" << b << ',' << o << ',' << j << ',' << i
+                                  << "}, cpu_val = " << c_val << " vs gpu_val = " << g_val
+                                  << std::endl;
+                        std::cout << "Number of flops used: " << num_flops_per_res
+                                  << ", pool_size: " << pool_size << std::endl;
+                        match = false;
                     }
+
+                    if(err > local.max_error)
+                        local.max_error = err;
+                    if(num_flops_per_res > local.max_num_flops_per_res)
+                        local.max_num_flops_per_res = num_flops_per_res;
                 }
             }
         }
+    });
+
+    for(const auto& local : slice_stats)
+    {
+        if(local.max_error > stats.max_error)
+            stats.max_error = local.max_error;
+        if(local.max_num_flops_per_res > stats.max_num_flops_per_res)
+            stats.max_num_flops_per_res = local.max_num_flops_per_res;
     }
 
     return (match);
@@ -355,119 +363,120 @@ void mloPoolingBackwardRunHost(
 
     std::vector<int> num_flops(bot_df.GetElementSize(), 0);
 
-    for(int b = 0; b < n_batchs; b++)
+    if(pooling_method != MLO_POOLING_OP_MAX && pooling_method != MLO_POOLING_OP_AVE &&
+       pooling_method != MLO_POOLING_OP_AVE_INCLUSIVE)
     {
-        for(int o = 0; o < n_outputs; o++)
-        {
-            int bot_df_v_off = b * bot_df_n_stride + o * bot_df_c_stride;
-            int top_df_off   = b * top_df_n_stride + o * top_df_c_stride;
+        std::cout << "ERROR: unknown operator : layer: pooling back-propagation." << std::endl;
+        return;
+    }
+
+    // Max pooling scatters through the mask of the forward pass, which only references the same
+    // (batch, channel) slice, so the slices are independent.
+    const std::size_t slice_work = static_cast<std::size_t>(bot_d) * bot_h * bot_w;
+    HostParFor(static_cast<std::size_t>(n_batchs) * n_outputs, slice_work, [&](std::size_t slice) {
+        const int b = slice / n_outputs;
+        const int o = slice % n_outputs;
+
+        int bot_df_v_off = b * bot_df_n_stride + o * bot_df_c_stride;
+        int top_df_off   = b * top_df_n_stride + o * top_df_c_stride;
 
-            if(pooling_method == MLO_POOLING_OP_MAX)
+        if(pooling_method == MLO_POOLING_OP_MAX)
+        {
+            for(int k = 0; k < top_d; k++)
             {
-                for(int k = 0; k < top_d; k++)
+                for(int j = 0; j < top_h; j++)
                 {
-                    for(int j = 0; j < top_h; j++)
+                    for(int i = 0; i < top_w; i++)
                     {
-                        for(int i = 0; i < top_w; i++)
-                        {
-                            size_t top_idx = top_df_off + k * top_df_d_stride +
-                                             j * top_df_h_stride + i * top_df_w_stride;
-                            size_t bot_idx = mask_ptr[top_idx];
-                            // skip top points that don't have associated bottom points
-                            if(bot_idx == std::numeric_limits<size_t>::max())
-                                continue;
-                            bot_df_v_ptr[bot_idx] += static_cast<Tcheck_>(top_df_ptr[top_idx]);
-                            ++num_flops[bot_idx];
-                        }
+                        size_t top_idx = top_df_off + k * top_df_d_stride + j * top_df_h_stride +
+                                         i * top_df_w_stride;
+                        size_t bot_idx = mask_ptr[top_idx];
+                        // skip top points that don't have associated bottom points
+                        if(bot_idx == std::numeric_limits<size_t>::max())
+                            continue;
+                        bot_df_v_ptr[bot_idx] += static_cast<Tcheck_>(top_df_ptr[top_idx]);
+                        ++num_flops[bot_idx];
                     }
                 }
             }
-            else if(pooling_method == MLO_POOLING_OP_AVE ||
-                    pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
+        }
+        else
+        {
+            for(int k = 0; k < bot_d; k++)
             {
-
-                for(int k = 0; k < bot_d; k++)
+                for(int j = 0; j < bot_h; j++)
                 {
-                    for(int j = 0; j < bot_h; j++)
+                    for(int i = 0; i < bot_w; i++)
                     {
-                        for(int i = 0; i < bot_w; i++)
+                        // c-emulator
+                        const auto bot_idx = bot_df_v_off + k * bot_df_d_stride +
+                                             j * bot_df_h_stride + i * bot_df_w_stride;
+                        bot_df_v_ptr[bot_idx] = static_cast<Tcheck_>(0);
+                        num_flops[bot_idx]    = 0;
+
+                        int d = k + pad_d;
+                        int h = j + pad_h;
+                        int w = i + pad_w;
+                        int pdstart =
+                            (d < filter_size_d) ? 0 : (d - filter_size_d) / pool_stride_d + 1;
+                        int pdend = std::min(d / pool_stride_d + 1, top_d);
+                        int phstart =
+                            (h < filter_size_h) ? 0 : (h - filter_size_h) / pool_stride_h + 1;
+                        int phend = std::min(h / pool_stride_h + 1, top_h);
+                        int pwstart =
+                            (w < filter_size_w) ? 0 : (w - filter_size_w) / pool_stride_w + 1;
+                        int pwend            = std::min(w / pool_stride_w + 1, top_w);
+                        Tcheck_ gradient     = static_cast<Tcheck_>(0);
+                        int gradient_n_flops = 0;
+                        for(int pd = pdstart; pd < pdend; ++pd)
                         {
-                            // c-emulator
-                            const auto bot_idx = bot_df_v_off + k * bot_df_d_stride +
-                                                 j * bot_df_h_stride + i * bot_df_w_stride;
-                            bot_df_v_ptr[bot_idx] = static_cast<Tcheck_>(0);
-                            num_flops[bot_idx]    = 0;
-
-                            int d = k + pad_d;
-                            int h = j + pad_h;
-                            int w = i + pad_w;
-                            int pdstart =
-                                (d < filter_size_d) ? 0 : (d - filter_size_d) / pool_stride_d + 1;
-                            int pdend = std::min(d / pool_stride_d + 1, top_d);
-                            int phstart =
-                                (h < filter_size_h) ? 0 : (h - filter_size_h) / pool_stride_h + 1;
-                            int phend = std::min(h / pool_stride_h + 1, top_h);
-                            int pwstart =
-                                (w < filter_size_w) ? 0 : (w - filter_size_w) / pool_stride_w + 1;
-                            int pwend            = std::min(w / pool_stride_w + 1, top_w);
-                            Tcheck_ gradient     = static_cast<Tcheck_>(0);
-                            int gradient_n_flops = 0;
-                            for(int pd = pdstart; pd < pdend; ++pd)
+                            for(int ph = phstart; ph < phend; ++ph)
                             {
-                                for(int ph = phstart; ph < phend; ++ph)
+                                for(int pw = pwstart; pw < pwend; ++pw)
                                 {
-                                    for(int pw = pwstart; pw < pwend; ++pw)
-                                    {
-                                        // figure out the pooling size
-                                        int dstart = pd * pool_stride_d - pad_d;
-                                        int hstart = ph * pool_stride_h - pad_h;
-                                        int wstart = pw * pool_stride_w - pad_w;
-                                        int dend   = std::min(dstart + filter_size_d, bot_d);
-                                        int hend   = std::min(hstart + filter_size_h, bot_h);
-                                        int wend   = std::min(wstart + filter_size_w, bot_w);
-                                        dstart     = std::max(dstart, 0);
-                                        hstart     = std::max(hstart, 0);
-                                        wstart     = std::max(wstart, 0);
-
-                                        int pool_size;
-                                        if(pooling_method == MLO_POOLING_OP_AVE)
-                                            pool_size = ((dend - dstart) * (hend - hstart) *
-                                                             (wend - wstart) ==
-                                                         0)
-                                                            ? 1
-                                                            : (dend - dstart) * (hend - hstart) *
-                                                                  (wend - wstart);
-                                        else
-                                            pool_size =
-                                                (filter_size_w * filter_size_h * filter_size_d == 0)
-                                                    ? 1
-                                                    : filter_size_w * filter_size_h * filter_size_d;
-
-                                        const auto top_idx = top_df_off + pd * top_df_d_stride +
-                                                             ph * top_df_h_stride +
-                                                             pw * top_df_w_stride;
-
-                                        gradient += static_cast<Tcheck_>(top_df_ptr[top_idx]) /
-                                                    static_cast<Tcheck_>(pool_size);
-                                        gradient_n_flops += 2; // pool_size is computed using
-                                                               // integer ops, do not count those.
-                                    }
+                                    // figure out the pooling size
+                                    int dstart = pd * pool_stride_d - pad_d;
+                                    int hstart = ph * pool_stride_h - pad_h;
+                                    int wstart = pw * pool_stride_w - pad_w;
+                                    int dend   = std::min(dstart + filter_size_d, bot_d);
+                                    int hend   = std::min(hstart + filter_size_h, bot_h);
+                                    int wend   = std::min(wstart + filter_size_w, bot_w);
+                                    dstart     = std::max(dstart, 0);
+                                    hstart     = std::max(hstart, 0);
+                                    wstart     = std::max(wstart, 0);
+
+                                    int pool_size;
+                                    if(pooling_method == MLO_POOLING_OP_AVE)
+                                        pool_size = ((dend - dstart) * (hend - hstart) *
+                                                         (wend - wstart) ==
+                                                     0)
+                                                        ? 1
+                                                        : (dend - dstart) * (hend - hstart) *
+                                                              (wend - wstart);
+                                    else
+                                        pool_size =
+                                            (filter_size_w * filter_size_h * filter_size_d == 0)
+                                                ? 1
+                                                : filter_size_w * filter_size_h * filter_size_d;
+
+                                    const auto top_idx = top_df_off + pd * top_df_d_stride +
+                                                         ph * top_df_h_stride +
+                                                         pw * top_df_w_stride;
+
+                                    gradient += static_cast<Tcheck_>(top_df_ptr[top_idx]) /
+                                                static_cast<Tcheck_>(pool_size);
+                                    gradient_n_flops += 2; // pool_size is computed using
+                                                           // integer ops, do not count those.
                                 }
                             }
-                            bot_df_v_ptr[bot_idx] = gradient;
-                            num_flops[bot_idx]    = gradient_n_flops;
                         }
+                        bot_df_v_ptr[bot_idx] = gradient;
+                        num_flops[bot_idx]    = gradient_n_flops;
                     }
                 }
             }
-            else
-            {
-                std::cout << "ERROR: unknown operator : layer: pooling back-propagation."
-                          << std::endl;
-                continue;
-            }
         }
-    }
+    });
     stats.max_num_flops_per_res = *(std::max_element(num_flops.begin(), num_flops.end()));
 }
 
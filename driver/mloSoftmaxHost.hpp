@@ -25,6 +25,12 @@ POSSIBILITY OF SUCH DAMAGE.
 #ifndef MLO_SOFTMAXHOST_H_
 #define MLO_SOFTMAXHOST_H_
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "host_parallel.hpp"
+
 ////////////////////////////////////////////////////////////
 //
 ///////////////////////////////////////////////////////////
@@ -42,6 +48,10 @@ T logaddexp(T x, T y, T neg_inf)
     return c <= neg_inf ? std::max(a, neg_inf) : std::max(T(a + log(T(1) + exp(b - a))), neg_inf);
 }
 
+// Instance mode reduces a whole image and runs one image per thread. Channel mode reduces over the
+// channels of every pixel, so a thread takes an image row and walks it in memory order for every
+// channel with one accumulator per pixel.
+
 template <typename Tgpu, typename Tcheck /* the data type used in CPU checkings (usually double) */>
 int mloSoftmaxForwardRunHost(miopenTensorDescriptor_t inputTensor,
                              miopenTensorDescriptor_t outputTensor,
@@ -61,175 +71,124 @@ int mloSoftmaxForwardRunHost(miopenTensorDescriptor_t inputTensor,
     (void)out_wstr;
 
     Tcheck max_val = (sizeof(Tgpu) == 4) ? 3.402823466e+38f : 65504.;
-    std::vector<Tcheck> channel_max((mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? n : n * h * w),
-                                    static_cast<Tcheck>(-max_val));
+    Tcheck neg_inf = static_cast<Tcheck>(
+        miopen::deref(inputTensor).GetType() == miopenHalf ? NEGATIVE_INF_FP16 : NEGATIVE_INF_FP32);
     std::vector<Tcheck> results(n * c * h * w, static_cast<Tcheck>(0.0));
 
     int ret = 0;
 
     if(mode == MIOPEN_SOFTMAX_MODE_INSTANCE)
     {
-        for(int i = 0; i < n; i++)
-        {
-            if(algo == MIOPEN_SOFTMAX_FAST)
+        HostParFor(n, c * h * w, [&](int i) {
+            Tcheck* res = results.data() + i * c * h * w;
+
+            Tcheck channel_max = static_cast<Tcheck>(-max_val);
+            if(algo != MIOPEN_SOFTMAX_FAST)
             {
                 for(int j = 0; j < c; j++)
                     for(int s0 = 0; s0 < h; s0++)
+                    {
+                        const Tgpu* src = in + i * in_nstr + j * in_cstr + s0 * in_hstr;
                         for(int s1 = 0; s1 < w; s1++)
-                        {
-                            results[(i * c + j) * h * w + s0 * w + s1] = static_cast<Tcheck>(
-                                in[i * in_nstr + j * in_cstr + s0 * in_hstr + s1]);
-                        }
+                            channel_max = std::max(static_cast<Tcheck>(src[s1]), channel_max);
+                    }
             }
             else
             {
-                for(int j = 0; j < c; j++)
-                    for(int s0 = 0; s0 < h; s0++)
-                        for(int s1 = 0; s1 < w; s1++)
-                        {
-                            channel_max[i] =
-                                std::max(static_cast<Tcheck>(
-                                             in[i * in_nstr + j * in_cstr + s0 * in_hstr + s1]),
-                                         channel_max[i]);
-                        }
-
-                for(int j = 0; j < c; j++)
-                    for(int s0 = 0; s0 < h; s0++)
-                        for(int s1 = 0; s1 < w; s1++)
-                        {
-                            results[(i * c + j) * h * w + s0 * w + s1] =
-                                static_cast<Tcheck>(
-                                    in[i * in_nstr + j * in_cstr + s0 * in_hstr + s1]) -
-                                channel_max[i];
-                        }
+                channel_max = static_cast<Tcheck>(0.0);
             }
 
+            for(int j = 0; j < c; j++)
+                for(int s0 = 0; s0 < h; s0++)
+                {
+                    const Tgpu* src = in + i * in_nstr + j * in_cstr + s0 * in_hstr;
+                    Tcheck* dst     = res + (j * h + s0) * w;
+                    for(int s1 = 0; s1 < w; s1++)
+                        dst[s1] = static_cast<Tcheck>(src[s1]) - channel_max;
+                }
+
+            Tcheck denom;
             if(algo == MIOPEN_SOFTMAX_LOG)
             {
-                Tcheck neg_inf = static_cast<Tcheck>(
-                    miopen::deref(inputTensor).GetType() == miopenHalf ? NEGATIVE_INF_FP16
-                                                                       : NEGATIVE_INF_FP32);
-                channel_max[i] = neg_inf;
-                for(int j = 0; j < c; j++)
-                    for(int s0 = 0; s0 < h; s0++)
-                        for(int s1 = 0; s1 < w; s1++)
-                        {
-                            channel_max[i] = logaddexp(results[(i * c + j) * h * w + s0 * w + s1],
-                                                       channel_max[i],
-                                                       neg_inf);
-                        }
-
-                for(int j = 0; j < c; j++)
-                    for(int s0 = 0; s0 < h; s0++)
-                        for(int s1 = 0; s1 < w; s1++)
-                        {
-                            outhost[i * out_nstr + j * out_cstr + s0 * out_hstr + s1] =
-                                alpha *
-                                    (results[(i * c + j) * h * w + s0 * w + s1] - channel_max[i]) +
-                                beta * outhost[i * out_nstr + j * out_cstr + s0 * out_hstr + s1];
-                        }
+                denom = neg_inf;
+                for(int k = 0; k < c * h * w; k++)
+                    denom = logaddexp(res[k], denom, neg_inf);
             }
             else
             {
-                channel_max[i] = 0.0;
-                for(int j = 0; j < c; j++)
-                    for(int s0 = 0; s0 < h; s0++)
-                        for(int s1 = 0; s1 < w; s1++)
-                        {
-                            results[(i * c + j) * h * w + s0 * w + s1] =
-                                exp(results[(i * c + j) * h * w + s0 * w + s1]);
-                            channel_max[i] += results[(i * c + j) * h * w + s0 * w + s1];
-                        }
-
-                for(int j = 0; j < c; j++)
-                    for(int s0 = 0; s0 < h; s0++)
-                        for(int s1 = 0; s1 < w; s1++)
-                        {
-                            outhost[i * out_nstr + j * out_cstr + s0 * out_hstr + s1] =
-                                alpha *
-                                    (results[(i * c + j) * h * w + s0 * w + s1] / channel_max[i]) +
-                                beta * outhost[i * out_nstr + j * out_cstr + s0 * out_hstr + s1];
-                        }
+                for(int k = 0; k < c * h * w; k++)
+                    res[k] = exp(res[k]);
+                denom = HostSum<Tcheck>(c * h * w, [&](int k) { return res[k]; });
             }
-        }
+
+            for(int j = 0; j < c; j++)
+                for(int s0 = 0; s0 < h; s0++)
+                {
+                    const Tcheck* src = res + (j * h + s0) * w;
+                    Tcheck* dst       = outhost + i * out_nstr + j * out_cstr + s0 * out_hstr;
+                    for(int s1 = 0; s1 < w; s1++)
+                    {
+                        Tcheck val = algo == MIOPEN_SOFTMAX_LOG ? src[s1] - denom : src[s1] / denom;
+                        dst[s1]    = alpha * val + beta * dst[s1];
+                    }
+                }
+        });
     }
     else
     {
-        for(int i = 0; i < n; i++)
-        {
-            for(int s0 = 0; s0 < h; s0++)
+        HostParFor(n * h, c * w, [&](int row) {
+            const int i  = row / h;
+            const int s0 = row % h;
+
+            const auto src = [&](int j) { return in + i * in_nstr + j * in_cstr + s0 * in_hstr; };
+            const auto res = [&](int j) { return results.data() + ((i * c + j) * h + s0) * w; };
+            const auto dst = [&](int j) {
+                return outhost + i * out_nstr + j * out_cstr + s0 * out_hstr;
+            };
+
+            std::vector<Tcheck> channel_max(w, static_cast<Tcheck>(-max_val));
+            if(algo == MIOPEN_SOFTMAX_FAST)
+            {
+                std::fill(channel_max.begin(), channel_max.end(), static_cast<Tcheck>(0.0));
+            }
+            else
+            {
+                for(int j = 0; j < c; j++)
+                    for(int s1 = 0; s1 < w; s1++)
+                        channel_max[s1] =
+                            std::max(static_cast<Tcheck>(src(j)[s1]), channel_max[s1]);
+            }
+
+            for(int j = 0; j < c; j++)
                 for(int s1 = 0; s1 < w; s1++)
-                {
-                    if(algo == MIOPEN_SOFTMAX_FAST)
-                    {
-                        for(int j = 0; j < c; j++)
-                        {
-                            results[(i * c + j) * h * w + s0 * w + s1] = static_cast<Tcheck>(
-                                in[i * in_nstr + j * in_cstr + s0 * in_hstr + s1]);
-                        }
-                    }
-                    else
-                    {
-                        for(int j = 0; j < c; j++)
-                        {
-                            channel_max[i * h * w + s0 * w + s1] =
-                                std::max(static_cast<Tcheck>(
-                                             in[i * in_nstr + j * in_cstr + s0 * in_hstr + s1]),
-                                         channel_max[i * h * w + s0 * w + s1]);
-                        }
-
-                        for(int j = 0; j < c; j++)
-                        {
-                            results[(i * c + j) * h * w + s0 * w + s1] =
-                                static_cast<Tcheck>(
-                                    in[i * in_nstr + j * in_cstr + s0 * in_hstr + s1]) -
-                                channel_max[i * h * w + s0 * w + s1];
-                        }
-                    }
+                    res(j)[s1] = static_cast<Tcheck>(src(j)[s1]) - channel_max[s1];
 
-                    if(algo == MIOPEN_SOFTMAX_LOG)
-                    {
-                        Tcheck neg_inf = static_cast<Tcheck>(
-                            miopen::deref(inputTensor).GetType() == miopenHalf ? NEGATIVE_INF_FP16
-                                                                               : NEGATIVE_INF_FP32);
-                        channel_max[i * h * w + s0 * w + s1] = results[i * c * h * w + s0 * w + s1];
-                        for(int j = 1; j < c; j++)
-                        {
-                            channel_max[i * h * w + s0 * w + s1] =
-                                logaddexp(results[(i * c + j) * h * w + s0 * w + s1],
-                                          channel_max[i * h * w + s0 * w + s1],
-                                          neg_inf);
-                        }
-
-                        for(int j = 0; j < c; j++)
-                        {
-                            outhost[i * out_nstr + j * out_cstr + s0 * out_hstr + s1] =
-                                alpha * (results[(i * c + j) * h * w + s0 * w + s1] -
-                                         channel_max[i * h * w + s0 * w + s1]) +
-                                beta * outhost[i * out_nstr + j * out_cstr + s0 * out_hstr + s1];
-                        }
-                    }
-                    else
+            std::vector<Tcheck> denom(w);
+            if(algo == MIOPEN_SOFTMAX_LOG)
+            {
+                std::copy(res(0), res(0) + w, denom.begin());
+                for(int j = 1; j < c; j++)
+                    for(int s1 = 0; s1 < w; s1++)
+                        denom[s1] = logaddexp(res(j)[s1], denom[s1], neg_inf);
+            }
+            else
+            {
+                for(int j = 0; j < c; j++)
+                    for(int s1 = 0; s1 < w; s1++)
                     {
-                        channel_max[i * h * w + s0 * w + s1] = 0.0;
-                        for(int j = 0; j < c; j++)
-                        {
-                            results[(i * c + j) * h * w + s0 * w + s1] =
-                                exp(results[(i * c + j) * h * w + s0 * w + s1]);
-                            channel_max[i * h * w + s0 * w + s1] +=
-                                results[(i * c + j) * h * w + s0 * w + s1];
-                        }
-
-                        for(int j = 0; j < c; j++)
-                        {
-                            outhost[i * out_nstr + j * out_cstr + s0 * out_hstr + s1] =
-                                alpha * (results[(i * c + j) * h * w + s0 * w + s1] /
-                                         channel_max[i * h * w + s0 * w + s1]) +
-                                beta * outhost[i * out_nstr + j * out_cstr + s0 * out_hstr + s1];
-                        }
+                        res(j)[s1] = exp(res(j)[s1]);
+                        denom[s1] += res(j)[s1];
                     }
+            }
+
+            for(int j = 0; j < c; j++)
+                for(int s1 = 0; s1 < w; s1++)
+                {
+                    Tcheck val = algo == MIOPEN_SOFTMAX_LOG ? res(j)[s1] - denom[s1]
+                                                            : res(j)[s1] / denom[s1];
+                    dst(j)[s1] = alpha * val + beta * dst(j)[s1];
                 }
-        }
+        });
     }
 
     return ret;
@@ -255,110 +214,65 @@ int mloSoftmaxBackwardRunHost(miopenTensorDescriptor_t dInputTensor,
     (void)in_wstr;
     (void)out_wstr;
 
-    std::vector<Tcheck> channel_dot((mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? n : n * h * w),
-                                    static_cast<Tcheck>(0.0));
-    std::vector<Tcheck> results(n * c * h * w, static_cast<Tcheck>(0.0));
-
     int ret = 0;
 
-    for(int i = 0; i < n; i++)
+    // d(in) = y * (dy - sum(y * dy)) for softmax and dy - exp(y) * sum(dy) for log-softmax
+    const auto dot_term = [&](const Tgpu* y, const Tgpu* dy, int k) {
+        return algo == MIOPEN_SOFTMAX_LOG ? static_cast<Tcheck>(dy[k])
+                                          : static_cast<Tcheck>(y[k]) * static_cast<Tcheck>(dy[k]);
+    };
+    const auto result = [&](const Tgpu* y, const Tgpu* dy, int k, Tcheck channel_dot) {
+        if(algo == MIOPEN_SOFTMAX_LOG)
+            return static_cast<Tcheck>(dy[k]) - channel_dot * std::exp(y[k]);
+        return (static_cast<Tcheck>(dy[k]) - channel_dot) * static_cast<Tcheck>(y[k]);
+    };
+
+    if(mode == MIOPEN_SOFTMAX_MODE_INSTANCE)
     {
-        if(mode == MIOPEN_SOFTMAX_MODE_INSTANCE)
-        {
+        HostParFor(n, c * h * w, [&](int i) {
+            Tcheck channel_dot = static_cast<Tcheck>(0.0);
             for(int j = 0; j < c; j++)
                 for(int s0 = 0; s0 < h; s0++)
-                    for(int s1 = 0; s1 < w; s1++)
-                    {
-                        if(algo == MIOPEN_SOFTMAX_LOG)
-                        {
-                            channel_dot[i] += static_cast<Tcheck>(
-                                dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
-                        }
-                        else
-                        {
-                            channel_dot[i] +=
-                                static_cast<Tcheck>(
-                                    out[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]) *
-                                static_cast<Tcheck>(
-                                    dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
-                        }
-                    }
+                {
+                    const int off = i * out_nstr + j * out_cstr + s0 * out_hstr;
+                    channel_dot += HostSum<Tcheck>(
+                        w, [&](int s1) { return dot_term(out + off, dout + off, s1); });
+                }
 
             for(int j = 0; j < c; j++)
                 for(int s0 = 0; s0 < h; s0++)
+                {
+                    const int off = i * out_nstr + j * out_cstr + s0 * out_hstr;
+                    Tcheck* dst   = dinhost + i * in_nstr + j * in_cstr + s0 * in_hstr;
                     for(int s1 = 0; s1 < w; s1++)
-                    {
-                        if(algo == MIOPEN_SOFTMAX_LOG)
-                        {
-                            results[(i * c + j) * h * w + s0 * w + s1] =
-                                static_cast<Tcheck>(
-                                    dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]) -
-                                channel_dot[i] *
-                                    std::exp(out[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
-                        }
-                        else
-                        {
-                            results[(i * c + j) * h * w + s0 * w + s1] =
-                                static_cast<Tcheck>(
-                                    dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]) -
-                                channel_dot[i];
-
-                            results[(i * c + j) * h * w + s0 * w + s1] *= static_cast<Tcheck>(
-                                out[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
-                        }
-                        dinhost[i * in_nstr + j * in_cstr + s0 * in_hstr + s1] =
-                            alpha * results[(i * c + j) * h * w + s0 * w + s1] +
-                            beta * dinhost[i * in_nstr + j * in_cstr + s0 * in_hstr + s1];
-                    }
-        }
-        else
-        {
-            for(int s0 = 0; s0 < h; s0++)
+                        dst[s1] =
+                            alpha * result(out + off, dout + off, s1, channel_dot) + beta * dst[s1];
+                }
+        });
+    }
+    else
+    {
+        HostParFor(n * h, c * w, [&](int row) {
+            const int i  = row / h;
+            const int s0 = row % h;
+
+            std::vector<Tcheck> channel_dot(w, static_cast<Tcheck>(0.0));
+            for(int j = 0; j < c; j++)
+            {
+                const int off = i * out_nstr + j * out_cstr + s0 * out_hstr;
                 for(int s1 = 0; s1 < w; s1++)
-                {
-                    for(int j = 0; j < c; j++)
-                    {
-                        if(algo == MIOPEN_SOFTMAX_LOG)
-                        {
-                            channel_dot[i * h * w + s0 * w + s1] += static_cast<Tcheck>(
-                                dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
-                        }
-                        else
-                        {
-                            channel_dot[i * h * w + s0 * w + s1] +=
-                                static_cast<Tcheck>(
-                                    out[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]) *
-                                static_cast<Tcheck>(
-                                    dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
-                        }
-                    }
+                    channel_dot[s1] += dot_term(out + off, dout + off, s1);
+            }
 
-                    for(int j = 0; j < c; j++)
-                    {
-                        if(algo == MIOPEN_SOFTMAX_LOG)
-                        {
-                            results[(i * c + j) * h * w + s0 * w + s1] =
-                                static_cast<Tcheck>(
-                                    dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]) -
-                                channel_dot[i * h * w + s0 * w + s1] *
-                                    std::exp(out[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
-                        }
-                        else
-                        {
-                            results[(i * c + j) * h * w + s0 * w + s1] =
-                                static_cast<Tcheck>(
-                                    dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]) -
-                                channel_dot[i * h * w + s0 * w + s1];
-
-                            results[(i * c + j) * h * w + s0 * w + s1] *= static_cast<Tcheck>(
-                                out[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
-                        }
-                        dinhost[i * in_nstr + j * in_cstr + s0 * in_hstr + s1] =
-                            alpha * results[(i * c + j) * h * w + s0 * w + s1] +
-                            beta * dinhost[i * in_nstr + j * in_cstr + s0 * in_hstr + s1];
-                    }
-                }
-        }
+            for(int j = 0; j < c; j++)
+            {
+                const int off = i * out_nstr + j * out_cstr + s0 * out_hstr;
+                Tcheck* dst   = dinhost + i * in_nstr + j * in_cstr + s0 * in_hstr;
+                for(int s1 = 0; s1 < w; s1++)
+                    dst[s1] =
+                        alpha * result(out + off, dout + off, s1, channel_dot[s1]) + beta * dst[s1];
+            }
+        });
     }
 
     return ret;
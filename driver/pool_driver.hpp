@@ -327,9 +327,9 @@ std::vector<int> PoolDriver_impl<Tgpu, Tref, Index>::GetOutputTensorLengths()
 
 namespace detail {
 template <typename T>
-T RanGenInput()
+T RanGenInput(prng::counter_gen& gen)
 {
-    return prng::gen_canonical<T>();
+    return prng::gen_canonical<T>(gen);
 }
 
 #define FP16IN_NORMAL 1
@@ -338,23 +338,23 @@ T RanGenInput()
 #define FP16IN_SPARSE_X 0 // non-zero value defines "sparsity"
 
 template <>
-float16 RanGenInput()
+float16 RanGenInput(prng::counter_gen& gen)
 {
     using T = float16;
 #if FP16IN_NORMAL
-    return prng::gen_canonical<T>();
+    return prng::gen_canonical<T>(gen);
 #endif
 #if FP16IN_CONST_SMALLEST_NORMALIZED
     return static_cast<T>(+1.0p - eh) // (6.103515625E-05);
 #endif
 #if FP16IN_5VALUES_0_TO_1
-           const int r = prng::gen_0_to_B(4); // values from 0 to 4
+           const int r = prng::gen_0_to_B(4, gen); // values from 0 to 4
     return static_cast<T>(r * 0.25);          // { 0.0, 0.25, 0.5, 0.75, 1.0 }
 #endif
 #if FP16IN_SPARSE_X
-    if(prng::gen_0_to_B(FP16IN_SPARSE_X) != 0) // produce 9 zeros in ~ each 10 values
+    if(prng::gen_0_to_B(FP16IN_SPARSE_X, gen) != 0) // produce 9 zeros in ~ each 10 values
         return static_cast<T>(0.0);
-    return prng::gen_canonical<T>();
+    return prng::gen_canonical<T>(gen);
 #endif
 }
 } // namespace detail
@@ -398,10 +398,9 @@ int PoolDriver_impl<Tgpu, Tref, Index>::AllocateBuffersAndCopy()
 
     if(in_filename.empty() || !readBufferFromFile<Tgpu>(in.data(), in_sz, in_filename.c_str()))
     {
-        for(int i = 0; i < in_sz; i++)
-        {
-            in[i] = detail::RanGenInput<Tgpu>();
-        }
+        prng::fill(in.data(), in_sz, [](auto& gen, std::size_t) {
+            return detail::RanGenInput<Tgpu>(gen);
+        });
 
         if(!dump_root.empty())
             dumpBufferToFile<Tgpu>((dump_root + "/dump_in.bin").c_str(), in.data(), in_sz);
@@ -410,11 +409,11 @@ int PoolDriver_impl<Tgpu, Tref, Index>::AllocateBuffersAndCopy()
     if(out_filename.empty() || !readBufferFromFile<Tgpu>(dout.data(), out_sz, out_filename.c_str()))
     {
         Tgpu Data_scale = static_cast<Tgpu>(0.001);
-        for(int i = 0; i < out_sz; i++)
-        {
-            dout[i] =
-                Data_scale * prng::gen_A_to_B(static_cast<Tgpu>(-0.5), static_cast<Tgpu>(0.5));
-        }
+        prng::fill(dout.data(), out_sz, [&](auto& gen, std::size_t) {
+            return static_cast<Tgpu>(
+                Data_scale *
+                prng::gen_A_to_B(static_cast<Tgpu>(-0.5), static_cast<Tgpu>(0.5), gen));
+        });
 
         if(!dump_root.empty())
             dumpBufferToFile<Tgpu>((dump_root + "/dump_dout.bin").c_str(), dout.data(), out_sz);
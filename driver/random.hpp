@@ -2,6 +2,9 @@
 #define GUARD_RANDOM_GEN_
 
 #include <miopen/env.hpp>
+#include <miopen/par_for.hpp>
+#include <array>
+#include <atomic>
 #include <iostream>
 #include <random>
 
@@ -30,6 +33,40 @@ inline glibc_gen& get_prng()
     return gen;
 }
 
+// Philox4x32-10 block function (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+inline std::array<std::uint32_t, 4> philox4x32(std::array<std::uint32_t, 4> ctr,
+                                               std::array<std::uint32_t, 2> key)
+{
+    constexpr std::uint64_t mul0 = 0xD2511F53;
+    constexpr std::uint64_t mul1 = 0xCD9E8D57;
+    for(int round = 0; round < 10; ++round)
+    {
+        const std::uint64_t p0 = mul0 * ctr[0];
+        const std::uint64_t p1 = mul1 * ctr[2];
+        ctr = {static_cast<std::uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0],
+               static_cast<std::uint32_t>(p1),
+               static_cast<std::uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1],
+               static_cast<std::uint32_t>(p0)};
+        key[0] += 0x9E3779B9;
+        key[1] += 0xBB67AE85;
+    }
+    return ctr;
+}
+
+// Number of fills done since the last reset_seed(), used as the stream of the next fill.
+inline std::atomic<std::uint64_t>& get_fill_stream()
+{
+    static std::atomic<std::uint64_t> stream{0};
+    return stream;
+}
+
+// Seed of the last reset_seed(), part of the key of every fill.
+inline std::atomic<std::uint32_t>& get_fill_seed()
+{
+    static std::atomic<std::uint32_t> seed{0};
+    return seed;
+}
+
 template <class, class = void>
 struct has_digits : std::false_type
 {
@@ -45,54 +82,125 @@ struct has_digits<T, std::void_t<decltype(std::numeric_limits<T>::digits)>> : st
 inline void reset_seed(std::random_device::result_type seed = 0)
 {
     details::get_prng().seed(seed + details::get_default_seed());
+    details::get_fill_seed()   = static_cast<std::uint32_t>(seed);
+    details::get_fill_stream() = 0;
 }
 
+// Counter-based generator. The values drawn for an element are a pure function of the seed,
+// the stream and the element index, so elements can be generated in any order and on any thread.
+// Draw k of element i is the word i % 4 of the Philox block of counter (i / 4, k), hence four
+// neighbouring elements share a block. The output range matches glibc_gen, the gen_* helpers
+// give the same distributions with both.
+class counter_gen
+{
+public:
+    using result_type = std::uint32_t;
+    using key_type    = std::array<std::uint32_t, 2>;
+    using block_type  = std::array<std::uint32_t, 4>;
+
+    static constexpr std::size_t lanes = std::tuple_size<block_type>::value;
+
+    counter_gen(const key_type& key_, std::uint64_t index_, const block_type* first_ = nullptr)
+        : key(key_), index(index_), first(first_)
+    {
+    }
+
+    static constexpr result_type min() { return details::glibc_gen::min(); }
+    static constexpr result_type max() { return details::glibc_gen::max(); }
+
+    result_type operator()()
+    {
+        const auto draw = draws++;
+        if(draw == 0 && first != nullptr)
+            return (*first)[index % lanes] & max();
+        return make_block(key, index / lanes, draw)[index % lanes] & max();
+    }
+
+    // The seed and the stream each take one word of the key, so distinct (seed, stream) pairs
+    // get distinct keys for the first 2^32 fills after a reset.
+    static key_type make_key(std::uint32_t seed, std::uint64_t stream)
+    {
+        return {seed + static_cast<std::uint32_t>(details::get_default_seed()) +
+                    static_cast<std::uint32_t>(stream >> 32),
+                static_cast<std::uint32_t>(stream)};
+    }
+
+    static block_type make_block(const key_type& key, std::uint64_t group, std::uint32_t draw)
+    {
+        return details::philox4x32(
+            {static_cast<std::uint32_t>(group), static_cast<std::uint32_t>(group >> 32), draw, 0},
+            key);
+    }
+
+private:
+    key_type key;
+    std::uint64_t index;
+    const block_type* first;
+    std::uint32_t draws = 0;
+};
+
 // similar to std::generate_canonical, but simpler and faster
-template <typename T>
-inline T gen_canonical()
+template <typename T, typename Gen>
+inline T gen_canonical(Gen& gen)
 {
     if constexpr(std::is_floating_point_v<T>) // native fp
     {
-        static constexpr T range =
-            static_cast<T>(1) /
-            static_cast<T>(details::glibc_gen::max() - details::glibc_gen::min() + 1);
-        return range * static_cast<T>(details::get_prng()() - details::glibc_gen::min());
+        static constexpr T range = static_cast<T>(1) / static_cast<T>(Gen::max() - Gen::min() + 1);
+        return range * static_cast<T>(gen() - Gen::min());
     }
     else if constexpr(std::is_integral_v<T>)
     {
-        auto val = details::get_prng()();
+        auto val = gen();
         return static_cast<T>(((val >> 4) + (val >> 16)) & 0x1);
     }
     else
     {
-        return static_cast<T>(gen_canonical<float>());
+        return static_cast<T>(gen_canonical<float>(gen));
     }
 }
 
 template <typename T>
-inline T gen_0_to_B(T B)
+inline T gen_canonical()
+{
+    return gen_canonical<T>(details::get_prng());
+}
+
+template <typename T, typename Gen>
+inline T gen_0_to_B(T B, Gen& gen)
 {
     if constexpr(std::is_floating_point_v<T>) // native fp
     {
-        return gen_canonical<T>() * B;
+        return gen_canonical<T>(gen) * B;
     }
     else if constexpr(std::is_integral_v<T>)
     {
         // can only generate 27bit range, so it may not be suitable
         // for huge 64 bit ranges, but we do not expect such ranges
-        return static_cast<T>((details::get_prng()() >> 4) % B);
+        return static_cast<T>((gen() >> 4) % B);
     }
     else // half/bfloat/etc
     {
-        return static_cast<T>(gen_0_to_B(static_cast<float>(B)));
+        return static_cast<T>(gen_0_to_B(static_cast<float>(B), gen));
     }
 }
 
 template <typename T>
-inline T gen_A_to_B(T A, T B)
+inline T gen_0_to_B(T B)
+{
+    return gen_0_to_B(B, details::get_prng());
+}
+
+template <typename T, typename Gen>
+inline T gen_A_to_B(T A, T B, Gen& gen)
 {
     assert(B > A);
-    return gen_0_to_B(B - A) + A;
+    return gen_0_to_B(B - A, gen) + A;
+}
+
+template <typename T>
+inline T gen_A_to_B(T A, T B)
+{
+    return gen_A_to_B(A, B, details::get_prng());
 }
 
 template <typename T>
@@ -102,8 +210,8 @@ inline T gen_off_range(T offset, T range)
     return prng::gen_0_to_B(range) + offset;
 }
 
-template <typename T, bool Signed = false>
-inline T gen_subnorm()
+template <typename T, bool Signed = false, typename Gen>
+inline T gen_subnorm(Gen& gen)
 {
     T denorm_val = static_cast<T>(0);
     if constexpr(!std::is_integral_v<T> && !std::is_same_v<T, double> &&
@@ -117,13 +225,43 @@ inline T gen_subnorm()
         // -1 because ::digits counts the first implicit digit
         static constexpr auto mantissa_bits = std::numeric_limits<T>::digits - 1;
 
-        BitType denorm_bits = static_cast<BitType>(gen_0_to_B(1 << mantissa_bits));
-        denorm_bits |= Signed ? (gen_canonical<BitType>() << (sizeof(T) * 8 - 1)) : 0;
+        BitType denorm_bits = static_cast<BitType>(gen_0_to_B(1 << mantissa_bits, gen));
+        denorm_bits |= Signed ? (gen_canonical<BitType>(gen) << (sizeof(T) * 8 - 1)) : 0;
 
         // the proper way to do a type punning
         std::memcpy(&denorm_val, &denorm_bits, sizeof(T));
     }
     return denorm_val;
 }
+
+template <typename T, bool Signed = false>
+inline T gen_subnorm()
+{
+    return gen_subnorm<T, Signed>(details::get_prng());
+}
+
+// Assigns first[i] = f(gen, i) for i in [0, n) on several threads, gen being the counter_gen of
+// element i. Each call takes the next stream, so the contents only depend on the seed and on the
+// order of the fill calls, not on the number of threads.
+template <typename T, typename F>
+inline void fill(T* first, std::size_t n, F f)
+{
+    constexpr auto lanes = counter_gen::lanes;
+    const auto seed      = details::get_fill_seed().load();
+    const auto key       = counter_gen::make_key(seed, details::get_fill_stream()++);
+    const auto groups    = (n + lanes - 1) / lanes;
+    miopen::par_for(groups, std::size_t{1} << 14, [&](std::size_t group) {
+        const auto block = counter_gen::make_block(key, group, 0);
+        const auto last  = std::min(n, (group + 1) * lanes);
+        for(auto i = group * lanes; i < last; ++i)
+        {
+            counter_gen gen{key, i, &block};
+            first[i] = f(gen, i);
+        }
+    });
+}
+
+// Takes the stream of a fill which is not needed, so the following fills do not depend on it.
+inline void skip_fill() { ++details::get_fill_stream(); }
 } // namespace prng
 #endif // GUARD_RANDOM_GEN_
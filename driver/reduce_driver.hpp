@@ -350,10 +350,9 @@ int ReduceDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 
     if(!rdResult)
     {
-        for(int i = 0; i < in_nelem; i++)
-        {
-            in[i] = prng::gen_canonical<Tgpu>();
-        };
+        prng::fill(in.data(), in_nelem, [](auto& gen, std::size_t) {
+            return prng::gen_canonical<Tgpu>(gen);
+        });
     };
 
 #if MIOPEN_BACKEND_OPENCL
@@ -76,13 +76,13 @@ inline void mat_vec(const unsigned int* matrix, unsigned int* vector)
     {
         for(unsigned int j = 0; j < XORWOW_BITS; j++)
         {
-            if(bool(vector[i] & (1U << j)))
+            // all ones if bit j is set: accumulating the row without a branch keeps the loop free
+            // of mispredictions and lets the compiler vectorize the XORs
+            const unsigned int mask = 0U - ((vector[i] >> j) & 1U);
+            const unsigned int* row = matrix + XORWOW_DIM * (i * XORWOW_BITS + j);
+            for(unsigned int k = 0; k < XORWOW_DIM; k++)
             {
-                std::transform(result,
-                               result + XORWOW_DIM,
-                               matrix + (XORWOW_DIM * (i * XORWOW_BITS + j)),
-                               result,
-                               std::bit_xor<unsigned int>{});
+                result[k] ^= row[k] & mask;
             }
         }
     }
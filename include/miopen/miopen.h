@@ -65,6 +65,7 @@
  * @defgroup TensorReduce
  * @defgroup find2
  * @defgroup sum
+ * @defgroup capture
  *
  */
 
@@ -5413,6 +5414,30 @@ MIOPEN_EXPORT miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
                                                  size_t* numSolutions,
                                                  size_t maxSolutions);
 
+/*! @brief Finds solutions to several problems at once.
+ *
+ * Problems with equal network configs are searched once and share the results. Kernels of all
+ * remaining convolution problems are compiled together before the search. Problems that differ
+ * only in the batch size are not merged, because the best solution may depend on it.
+ *
+ * @param handle       Handle to execute the kernels
+ * @param numProblems  Number of problems
+ * @param problems     Problems to solve
+ * @param options      Find options. When null default values would be used
+ * @param solutions    Array of numProblems * maxSolutions results. Results of the i-th problem
+ *                     start at solutions + i * maxSolutions. Must not be null
+ * @param numSolutions Array of numProblems amounts of results. Ignored if null
+ * @param maxSolutions Limits the amount of results per problem
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenFindSolutionsBatch(miopenHandle_t handle,
+                                                      size_t numProblems,
+                                                      const miopenProblem_t* problems,
+                                                      miopenFindOptions_t options,
+                                                      miopenSolution_t* solutions,
+                                                      size_t* numSolutions,
+                                                      size_t maxSolutions);
+
 /*! @brief Values of a tensor argument for the miopenRunSolution function.
  */
 struct miopenTensorArgument_t
@@ -5564,6 +5589,20 @@ MIOPEN_EXPORT miopenStatus_t miopenFuseProblems(miopenProblem_t problem1, miopen
 MIOPEN_EXPORT miopenStatus_t miopenCreateBiasProblem(miopenProblem_t* problem,
                                                      miopenProblemDirection_t direction);
 
+/*! @brief Embeds the code objects of the solution kernels into the solution.
+ *
+ * Solutions saved after this call carry the compiled kernels along with a fingerprint of the
+ * device and the library build they are compatible with. A loaded solution with a matching
+ * fingerprint is run without compiling kernels or looking them up in the kernel cache, otherwise
+ * the embedded code objects are ignored. Only convolution solutions are supported.
+ *
+ * @param handle     Handle to get the code objects with
+ * @param solution   Solution to embed the code objects into
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenEmbedSolutionCodeObjects(miopenHandle_t handle,
+                                                            miopenSolution_t solution);
+
 #endif
 
 /** @} */
@@ -5629,6 +5668,82 @@ MIOPEN_EXPORT miopenStatus_t miopenSumForward(miopenHandle_t handle,
 // CLOSEOUT SUM DOXYGEN GROUP
 #endif
 
+#ifdef MIOPEN_BETA_API
+
+/** @addtogroup capture
+ *
+ *  @{
+ */
+
+/*! @brief The miopenExecutionPlan object holds a sequence of kernel launches captured on a handle.
+ */
+MIOPEN_DECLARE_OBJECT(miopenExecutionPlan);
+
+/*! @brief Starts capturing the kernels launched on the handle into an execution plan.
+ *
+ * Operations issued on the handle until miopenEndCapture are executed as usual, and their
+ * kernels are recorded together with the packed arguments. Pointers into the listed buffers
+ * become bindings of the plan and are replaced when the plan is run. Any other buffer used by the
+ * captured operations, e.g. a workspace, is referenced as is and must stay valid while the plan
+ * is used. Operations which are not kernel launches, like buffer reads or rocBLAS calls, make
+ * miopenEndCapture fail.
+ *
+ * @param handle       MIOpen handle (input)
+ * @param numBuffers   Number of bound buffers (input)
+ * @param buffers      Bound buffers (input)
+ * @param sizes        Sizes of the bound buffers in bytes (input)
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenBeginCapture(miopenHandle_t handle,
+                                                size_t numBuffers,
+                                                const void* const* buffers,
+                                                const size_t* sizes);
+
+/*! @brief Finishes capturing and returns the execution plan.
+ *
+ * @param handle   MIOpen handle (input)
+ * @param plan     Captured plan (output)
+ * @return         miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenEndCapture(miopenHandle_t handle, miopenExecutionPlan_t* plan);
+
+/*! @brief Replays the captured kernels on the current stream of the handle.
+ *
+ * The handle does not have to be the one the plan was captured on, which may have been destroyed
+ * already. It has to use the same device. Kernel times are reported to this handle when profiling
+ * is enabled on it.
+ *
+ * @param handle       MIOpen handle (input)
+ * @param plan         Plan to run (input)
+ * @param numBuffers   Number of buffers, must match the number of bindings (input)
+ * @param buffers      Buffers substituted for the bindings, in the capture order (input)
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenRunExecutionPlan(miopenHandle_t handle,
+                                                    const miopenExecutionPlan_t plan,
+                                                    size_t numBuffers,
+                                                    void* const* buffers);
+
+/*! @brief Returns the number of kernel launches in the plan.
+ *
+ * @param plan    Execution plan (input)
+ * @param count   Number of launches (output)
+ * @return        miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetExecutionPlanLaunchCount(const miopenExecutionPlan_t plan,
+                                                               size_t* count);
+
+/*! @brief Destroys the execution plan.
+ *
+ * @param plan   Execution plan to destroy
+ * @return       miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenDestroyExecutionPlan(miopenExecutionPlan_t plan);
+
+/** @} */
+// CLOSEOUT CAPTURE DOXYGEN GROUP
+#endif
+
 #ifdef __cplusplus
 }
 #endif
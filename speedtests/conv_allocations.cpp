@@ -0,0 +1,137 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/miopen.h>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+#include <get_handle.hpp>
+
+#include "speedtest.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace miopen {
+namespace conv_allocations {
+
+using speedtest::Check;
+
+// Number of heap allocations and host time of a miopenConvolutionForward call on a small
+// convolution, once find has registered the invoker. Everything done per call (validating the
+// descriptors, building the problem description and its network config, looking the invoker up
+// and launching it) shows up here.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver() { add(iterations, "iterations"); }
+
+    void run()
+    {
+        auto&& handle = get_handle();
+
+        auto x_desc = TensorDescriptor{miopenFloat, {1, 16, 14, 14}};
+        auto w_desc = TensorDescriptor{miopenFloat, {16, 16, 3, 3}};
+        auto conv_desc =
+            ConvolutionDescriptor{2, miopenConvolution, miopenPaddingDefault, {1, 1}, {1, 1}};
+        auto y_desc = conv_desc.GetForwardOutputTensor(x_desc, w_desc);
+
+        const auto x_dev = handle.Create(x_desc.GetElementSpace() * sizeof(float));
+        const auto w_dev = handle.Create(w_desc.GetElementSpace() * sizeof(float));
+        const auto y_dev = handle.Create(y_desc.GetElementSpace() * sizeof(float));
+
+        std::size_t workspace_size;
+        Check(miopenConvolutionForwardGetWorkSpaceSize(
+            &handle, &w_desc, &x_desc, &conv_desc, &y_desc, &workspace_size));
+        const auto workspace =
+            workspace_size != 0 ? handle.Create(workspace_size) : Allocator::ManageDataPtr{};
+
+        miopenConvAlgoPerf_t perf;
+        int found = 0;
+        Check(miopenFindConvolutionForwardAlgorithm(&handle,
+                                                    &x_desc,
+                                                    x_dev.get(),
+                                                    &w_desc,
+                                                    w_dev.get(),
+                                                    &conv_desc,
+                                                    &y_desc,
+                                                    y_dev.get(),
+                                                    1,
+                                                    &found,
+                                                    &perf,
+                                                    workspace.get(),
+                                                    workspace_size,
+                                                    false));
+        if(found == 0)
+        {
+            std::cerr << "No algorithms found." << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        const float alpha = 1.f;
+        const float beta  = 0.f;
+
+        const auto run_forward = [&]() {
+            Check(miopenConvolutionForward(&handle,
+                                           &alpha,
+                                           &x_desc,
+                                           x_dev.get(),
+                                           &w_desc,
+                                           w_dev.get(),
+                                           &conv_desc,
+                                           perf.fwd_algo,
+                                           &beta,
+                                           &y_desc,
+                                           y_dev.get(),
+                                           workspace.get(),
+                                           workspace_size));
+        };
+
+        // The first call may still initialize something lazily
+        run_forward();
+        handle.Finish();
+
+        const auto measurement = speedtest::MeasurePerCall(iterations, run_forward);
+
+        handle.Finish();
+
+        std::cout << "Heap allocations per call: " << measurement.allocations << std::endl;
+        std::cout << "Host time per call: " << measurement.microseconds << " microseconds"
+                  << std::endl;
+    }
+
+private:
+    int iterations = 10000;
+};
+} // namespace conv_allocations
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::conv_allocations::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,214 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/miopen.h>
+#include <miopen/any_solver.hpp>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/find_db.hpp>
+#include <miopen/fusion.hpp>
+#include <miopen/fusion_plan.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/solution.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+#include <get_handle.hpp>
+
+#include "speedtest.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace miopen {
+namespace host_overhead {
+
+// Host time and heap allocations per call of the library paths which run on the host for every
+// primitive call or find, on a convolution small enough for none of them to depend on its size.
+// Nothing here needs a GPU: on a HIPNOGPU build the whole suite runs on a CPU-only machine,
+// with MIOPEN_NOGPU_HOST_EXECUTION=1 run_solution launches the host implementation of the
+// naive convolution kernel. An operation which cannot run with the current handle is reported
+// as skipped. --op selects a single operation.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(op, "op");
+    }
+
+    void run()
+    {
+        auto&& handle = get_handle();
+
+        const auto x_desc = TensorDescriptor{miopenFloat, {1, 4, 4, 4}};
+        const auto w_desc = TensorDescriptor{miopenFloat, {4, 4, 1, 1}};
+        const auto b_desc = TensorDescriptor{miopenFloat, {1, 4, 1, 1}};
+        const auto conv_desc =
+            ConvolutionDescriptor{2, miopenConvolution, miopenPaddingDefault, {1, 1}, {1, 1}};
+        const auto y_desc = conv_desc.GetForwardOutputTensor(x_desc, w_desc);
+
+        const auto problem =
+            conv::ProblemDescription{x_desc, w_desc, y_desc, conv_desc, conv::Direction::Forward};
+        auto ctx = ExecutionContext{&handle};
+        problem.SetupFloats(ctx);
+
+        Measure("tensor_descriptor", [&]() {
+            const auto desc = TensorDescriptor{miopenFloat, {1, 4, 4, 4}};
+            const auto copy = desc;
+            return copy.GetElementSize();
+        });
+
+        Measure("problem_description", [&]() {
+            const auto desc = conv::ProblemDescription{
+                x_desc, w_desc, y_desc, conv_desc, conv::Direction::Forward};
+            return desc.GetBias() + 1u;
+        });
+
+        Measure("network_config", [&]() { return problem.MakeNetworkConfig().ToString().size(); });
+
+        Measure("perf_db_lookup", [&]() {
+            auto db = GetDb(ctx);
+            return db.FindRecord(problem) ? 1 : 0;
+        });
+
+        Measure("find_db_lookup", [&]() {
+            const auto record = FindDbRecord{handle, problem};
+            return record.empty() ? 0 : 1;
+        });
+
+        Measure("applicability", [&]() {
+            std::size_t applicable = 0;
+            for(const auto& id : solver::GetSolversByPrimitive(solver::Primitive::Convolution))
+            {
+                if(id.GetSolver().IsApplicable(ctx, problem))
+                    ++applicable;
+            }
+            return applicable;
+        });
+
+        // The no-op invoker is registered for a solver the solution below does not use, so that
+        // run_solution still runs a real kernel.
+        const auto lookup_id = solver::Id{"ConvDirectNaiveConvBwd"};
+        const auto config    = problem.MakeNetworkConfig();
+        handle.RegisterInvoker(
+            [](const Handle&, const AnyInvokeParams&) {}, config, lookup_id.ToString());
+        Measure("invoker_lookup", [&]() { return handle.GetInvoker(config, lookup_id) ? 1 : 0; });
+        Measure("invoker_lookup_by_config", [&]() {
+            return handle.GetInvoker(problem.MakeNetworkConfig(), lookup_id) ? 1 : 0;
+        });
+        Measure("invoker_lookup_by_problem",
+                [&]() { return handle.GetInvoker(problem, lookup_id) ? 1 : 0; });
+
+        const auto naive_id = solver::Id{"ConvDirectNaiveConvFwd"};
+
+        const auto x_dev = handle.Create(x_desc.GetElementSpace() * sizeof(float));
+        const auto w_dev = handle.Create(w_desc.GetElementSpace() * sizeof(float));
+        const auto y_dev = handle.Create(y_desc.GetElementSpace() * sizeof(float));
+
+        auto solution_problem = Problem{};
+        solution_problem.SetOperatorDescriptor(conv_desc);
+        solution_problem.SetDirection(miopenProblemDirectionForward);
+        solution_problem.RegisterTensorDescriptor(miopenTensorConvolutionX, x_desc);
+        solution_problem.RegisterTensorDescriptor(miopenTensorConvolutionW, w_desc);
+        solution_problem.RegisterTensorDescriptor(miopenTensorConvolutionY, y_desc);
+
+        auto solution = Solution{};
+        solution.SetSolver(naive_id);
+        solution.SetProblem(ProblemContainer::Item{solution_problem});
+        const std::unordered_map<miopenTensorArgumentId_t, Solution::RunInput> solution_inputs = {
+            {miopenTensorConvolutionX, x_dev.get()},
+            {miopenTensorConvolutionW, w_dev.get()},
+            {miopenTensorConvolutionY, y_dev.get()},
+        };
+
+        Measure("run_solution", [&]() {
+            solution.Run(handle, solution_inputs, nullptr, 0);
+            return 0;
+        });
+
+        Measure("fusion_compile", [&]() {
+            auto plan = FusionPlanDescriptor{miopenVerticalFusion, x_desc};
+            plan.AddOp(std::make_shared<ConvForwardOpDescriptor>(conv_desc, w_desc));
+            plan.AddOp(std::make_shared<BiasFusionOpDescriptor>(b_desc));
+            plan.AddOp(std::make_shared<ActivFwdFusionOpDescriptor>(miopenActivationRELU));
+            const auto status = plan.Compile(handle);
+            if(status != miopenStatusSuccess)
+                MIOPEN_THROW(status, "The fusion plan has not compiled");
+            return 0;
+        });
+
+        handle.Finish();
+    }
+
+private:
+    int iterations              = 10000;
+    std::string op              = "all";
+    std::size_t dead_code_saver = 0;
+
+    // The first call is made before the measurement: it fills the caches a repeated call hits
+    // and tells whether the operation is supported at all.
+    template <class TOperation>
+    void Measure(const std::string& name, const TOperation& operation)
+    {
+        if(op != "all" && op != name)
+            return;
+
+        try
+        {
+            dead_code_saver += operation();
+        }
+        catch(const Exception& ex)
+        {
+            std::cout << std::left << std::setw(28) << name << "skipped: " << ex.what()
+                      << std::endl;
+            return;
+        }
+
+        const auto measurement = speedtest::MeasurePerCall(
+            iterations, [&]() { dead_code_saver += operation(); });
+
+        std::cout << std::left << std::setw(28) << name << measurement.microseconds
+                  << " microseconds, " << measurement.allocations << " heap allocations per call"
+                  << std::endl;
+    }
+};
+} // namespace host_overhead
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::host_overhead::SpeedTestDriver>(argc, argv);
+    return 0;
+}
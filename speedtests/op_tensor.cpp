@@ -0,0 +1,118 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+#include <get_handle.hpp>
+
+#include "speedtest.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace op_tensor {
+
+using speedtest::Check;
+
+// Time per miopenOpTensor call, including the wait for the kernel, and the bandwidth it reaches
+// on the shapes whose kernel depends on how the op is coalesced: packed tensors of several ranks
+// and bias adds. MIOPEN_DEBUG_TENSOR_OP_COALESCE=0 runs every op on the kernel of its original
+// descriptors, which gives the times to compare against.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver() { add(iterations, "iterations"); }
+
+    void run()
+    {
+        Measure("packed_2d", {4096, 2048}, {4096, 2048});
+        Measure("packed_3d", {64, 256, 512}, {64, 256, 512});
+        Measure("packed_4d", {16, 64, 56, 56}, {16, 64, 56, 56});
+        Measure("packed_5d", {16, 32, 16, 28, 28}, {16, 32, 16, 28, 28});
+        Measure("bias_4d", {16, 64, 56, 56}, {1, 64, 1, 1});
+        Measure("bias_5d", {16, 32, 16, 28, 28}, {1, 32, 1, 1, 1});
+        Measure("scalar_5d", {16, 32, 16, 28, 28}, {1, 1, 1, 1, 1});
+    }
+
+private:
+    int iterations = 100;
+
+    void Measure(const std::string& name,
+                 const std::vector<std::size_t>& clens,
+                 const std::vector<std::size_t>& blens) const
+    {
+        auto&& handle = get_handle();
+
+        auto c_desc = TensorDescriptor{miopenFloat, clens};
+        auto b_desc = TensorDescriptor{miopenFloat, blens};
+
+        const auto a_dev = handle.Create(c_desc.GetElementSpace() * sizeof(float));
+        const auto b_dev = handle.Create(b_desc.GetElementSpace() * sizeof(float));
+        const auto c_dev = handle.Create(c_desc.GetElementSpace() * sizeof(float));
+
+        const auto alpha0 = 1.f, alpha1 = 1.f, beta = 0.f;
+        const auto op_tensor = [&]() {
+            Check(miopenOpTensor(&handle,
+                                 miopenTensorOpAdd,
+                                 &alpha0,
+                                 &c_desc,
+                                 a_dev.get(),
+                                 &alpha1,
+                                 &b_desc,
+                                 b_dev.get(),
+                                 &beta,
+                                 &c_desc,
+                                 c_dev.get()));
+        };
+
+        // The first call builds the kernel
+        op_tensor();
+        handle.Finish();
+
+        const auto measurement =
+            speedtest::MeasurePerCall(iterations, op_tensor, [&]() { handle.Finish(); });
+
+        // Bytes the op has to move at least: A and B are read, C is written
+        const auto bytes =
+            (2 * c_desc.GetElementSpace() + b_desc.GetElementSpace()) * sizeof(float);
+
+        std::cout << std::left << std::setw(12) << name << measurement.microseconds
+                  << " microseconds, " << bytes / measurement.microseconds * 1e-3 << " GB/s"
+                  << std::endl;
+    }
+};
+} // namespace op_tensor
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::op_tensor::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/miopen.h>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/perf_db_neighbors.hpp>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+#include <get_handle.hpp>
+
+#include "speedtest.hpp"
+
+#include <iostream>
+#include <vector>
+
+namespace miopen {
+namespace perf_db_neighbors {
+
+using speedtest::Check;
+
+// Compares the kernel time of every immediate mode solution of a convolution missing from the
+// perf-db with the default performance config and with the config transferred from the nearest
+// perf-db record, and reports how often the transferred one is faster. Each mode uses a handle of
+// its own, so that the invokers prepared for the other one are not reused.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(batch, "batch");
+        add(channels, "channels");
+        add(size, "size");
+        add(filters, "filters");
+        add(filter_size, "filter-size");
+    }
+
+    void run()
+    {
+        auto&& handle        = get_handle();
+        auto neighbor_handle = Handle{};
+
+        const auto pad = filter_size / 2;
+
+        auto x_desc = TensorDescriptor{miopenFloat, {batch, channels, size, size}};
+        auto w_desc = TensorDescriptor{miopenFloat, {filters, channels, filter_size, filter_size}};
+        auto conv_desc =
+            ConvolutionDescriptor{2, miopenConvolution, miopenPaddingDefault, {pad, pad}, {1, 1}};
+        auto y_desc = conv_desc.GetForwardOutputTensor(x_desc, w_desc);
+
+        auto solutions    = std::vector<miopenConvSolution_t>(32);
+        std::size_t found = 0;
+        Check(miopenConvolutionForwardGetSolution(&handle,
+                                                  &w_desc,
+                                                  &x_desc,
+                                                  &conv_desc,
+                                                  &y_desc,
+                                                  solutions.size(),
+                                                  &found,
+                                                  solutions.data()));
+        solutions.resize(found);
+
+        const auto x_dev = handle.Create(x_desc.GetElementSpace() * sizeof(float));
+        const auto w_dev = handle.Create(w_desc.GetElementSpace() * sizeof(float));
+        const auto y_dev = handle.Create(y_desc.GetElementSpace() * sizeof(float));
+
+        const auto time_solution = [&](Handle& h, const miopenConvSolution_t& solution) {
+            Check(miopenConvolutionForwardCompileSolution(
+                &h, &w_desc, &x_desc, &conv_desc, &y_desc, solution.solution_id));
+
+            const auto workspace = solution.workspace_size != 0
+                                       ? h.Create(solution.workspace_size)
+                                       : Allocator::ManageDataPtr{};
+            const auto run = [&]() {
+                Check(miopenConvolutionForwardImmediate(&h,
+                                                        &w_desc,
+                                                        w_dev.get(),
+                                                        &x_desc,
+                                                        x_dev.get(),
+                                                        &conv_desc,
+                                                        &y_desc,
+                                                        y_dev.get(),
+                                                        workspace.get(),
+                                                        solution.workspace_size,
+                                                        solution.solution_id));
+            };
+
+            run();
+            h.Finish();
+            return speedtest::MeasurePerCall(iterations, run, [&]() { h.Finish(); }).microseconds;
+        };
+
+        auto transferred = 0;
+        auto faster      = 0;
+
+        for(const auto& solution : solutions)
+        {
+            debug::perf_db_neighbors_override() = false;
+            const auto default_time             = time_solution(handle, solution);
+
+            debug::perf_db_neighbors_override() = true;
+            const auto before                   = GetPerfDbNeighborStatistics().transfers;
+            const auto neighbor_time            = time_solution(neighbor_handle, solution);
+            if(GetPerfDbNeighborStatistics().transfers == before)
+                continue;
+
+            ++transferred;
+            if(neighbor_time < default_time)
+                ++faster;
+
+            std::cout << solver::Id{solution.solution_id}.ToString()
+                      << ": default config: " << default_time
+                      << " us, neighbor config: " << neighbor_time << " us" << std::endl;
+        }
+
+        debug::perf_db_neighbors_override() = boost::none;
+        std::cout << "Neighbor config is faster for " << faster << " of " << transferred
+                  << " solvers it has been transferred to" << std::endl;
+    }
+
+private:
+    int iterations  = 100;
+    int batch       = 16;
+    int channels    = 64;
+    int size        = 40;
+    int filters     = 64;
+    int filter_size = 3;
+};
+} // namespace perf_db_neighbors
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::perf_db_neighbors::SpeedTestDriver>(argc, argv);
+    return 0;
+}
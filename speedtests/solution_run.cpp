@@ -0,0 +1,146 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+#include <get_handle.hpp>
+
+#include "speedtest.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace miopen {
+namespace solution_run {
+
+using speedtest::Check;
+
+// Host time of miopenRunSolution on a small convolution, where launching the kernel is cheap
+// enough for the overhead of the call to show. Repeated runs of a solution reuse the invoker it
+// has been bound to on the first one. MIOPEN_DEBUG_SOLUTION_BOUND_INVOKER=0 makes every run
+// rebuild the problem and look the invoker up instead, which gives the time to compare against.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(direction, "direction");
+    }
+
+    void run()
+    {
+        auto&& handle = get_handle();
+
+        auto x_desc = TensorDescriptor{miopenFloat, {1, 16, 14, 14}};
+        auto w_desc = TensorDescriptor{miopenFloat, {16, 16, 3, 3}};
+        auto conv_desc =
+            ConvolutionDescriptor{2, miopenConvolution, miopenPaddingDefault, {1, 1}, {1, 1}};
+        auto y_desc = conv_desc.GetForwardOutputTensor(x_desc, w_desc);
+
+        miopenProblem_t problem;
+        Check(miopenCreateConvProblem(&problem, &conv_desc, ParseDirection(direction)));
+        Check(miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionX, &x_desc));
+        Check(miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionW, &w_desc));
+        Check(miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionY, &y_desc));
+
+        miopenSolution_t solution;
+        std::size_t found = 0;
+        Check(miopenFindSolutions(&handle, problem, nullptr, &solution, &found, 1));
+        if(found == 0)
+        {
+            std::cerr << "No solutions found." << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        std::size_t workspace_size;
+        Check(miopenGetSolutionWorkspaceSize(solution, &workspace_size));
+
+        const auto x_dev     = handle.Create(x_desc.GetElementSpace() * sizeof(float));
+        const auto w_dev     = handle.Create(w_desc.GetElementSpace() * sizeof(float));
+        const auto y_dev     = handle.Create(y_desc.GetElementSpace() * sizeof(float));
+        const auto workspace =
+            workspace_size != 0 ? handle.Create(workspace_size) : Allocator::ManageDataPtr{};
+
+        const miopenTensorArgument_t arguments[] = {
+            {miopenTensorConvolutionX, nullptr, x_dev.get()},
+            {miopenTensorConvolutionW, nullptr, w_dev.get()},
+            {miopenTensorConvolutionY, nullptr, y_dev.get()},
+        };
+
+        const auto run_solution = [&]() {
+            Check(miopenRunSolution(
+                &handle, solution, 3, arguments, workspace.get(), workspace_size));
+        };
+
+        // The first run prepares the invoker
+        run_solution();
+        handle.Finish();
+
+        const auto measurement = speedtest::MeasurePerCall(iterations, run_solution);
+
+        handle.Finish();
+
+        std::cout << "Host time per run: " << measurement.microseconds << " microseconds"
+                  << std::endl;
+        std::cout << "Heap allocations per run: " << measurement.allocations << std::endl;
+
+        Check(miopenDestroySolution(solution));
+        Check(miopenDestroyProblem(problem));
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Permitted directions: fwd, bwd, wrw" << std::endl;
+    }
+
+private:
+    int iterations        = 10000;
+    std::string direction = "fwd";
+
+    static miopenProblemDirection_t ParseDirection(const std::string& str)
+    {
+        if(str == "fwd")
+            return miopenProblemDirectionForward;
+        if(str == "bwd")
+            return miopenProblemDirectionBackward;
+        if(str == "wrw")
+            return miopenProblemDirectionBackwardWeights;
+        std::cerr << "Unknown direction." << std::endl;
+        std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+    }
+};
+} // namespace solution_run
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::solution_run::SpeedTestDriver>(argc, argv);
+    return 0;
+}
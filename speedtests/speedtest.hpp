@@ -0,0 +1,109 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SPEEDTEST_HPP
+#define GUARD_MIOPEN_SPEEDTEST_HPP
+
+#include <miopen/miopen.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+// Scaffolding shared by the speed tests. The header replaces the global allocation functions,
+// so it has to be included in a single translation unit of a speed test.
+
+namespace miopen {
+namespace speedtest {
+
+// Counts every heap allocation of the process, including the ones made inside the library
+inline std::atomic<std::size_t>& AllocationCount()
+{
+    static std::atomic<std::size_t> count{0};
+    return count;
+}
+
+inline void Check(miopenStatus_t status)
+{
+    if(status != miopenStatusSuccess)
+    {
+        std::cerr << "MIOpen call failed with status " << status << "." << std::endl;
+        std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+    }
+}
+
+struct Measurement
+{
+    double microseconds; // Host time per call
+    double allocations;  // Heap allocations per call
+};
+
+// Calls call() the given number of times and then finish(), which waits for the work the calls
+// have queued when it is a part of what is measured.
+template <class TCall, class TFinish>
+Measurement MeasurePerCall(int iterations, const TCall& call, const TFinish& finish)
+{
+    const auto allocations_before = AllocationCount().load();
+    const auto start              = std::chrono::steady_clock::now();
+
+    for(auto i = 0; i < iterations; i++)
+        call();
+    finish();
+
+    const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - start)
+                          .count() *
+                      .001 / iterations;
+    const auto allocations =
+        static_cast<double>(AllocationCount().load() - allocations_before) / iterations;
+    return {time, allocations};
+}
+
+template <class TCall>
+Measurement MeasurePerCall(int iterations, const TCall& call)
+{
+    return MeasurePerCall(iterations, call, []() {});
+}
+
+} // namespace speedtest
+} // namespace miopen
+
+void* operator new(std::size_t size)
+{
+    miopen::speedtest::AllocationCount().fetch_add(1, std::memory_order_relaxed);
+    if(auto* ptr = std::malloc(size == 0 ? 1 : size)) // NOLINT (cppcoreguidelines-no-malloc)
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); } // NOLINT (cppcoreguidelines-no-malloc)
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr); // NOLINT (cppcoreguidelines-no-malloc)
+}
+
+#endif // GUARD_MIOPEN_SPEEDTEST_HPP
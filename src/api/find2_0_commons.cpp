@@ -38,6 +38,8 @@
 #include <nlohmann/json.hpp>
 #include <boost/hof/match.hpp>
 
+#include <memory>
+
 template <class OperationDescriptor>
 static miopenStatus_t MakeProblem(miopenProblem_t* problem,
                                   OperationDescriptor operatorDesc,
@@ -249,6 +251,61 @@ miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
     });
 }
 
+miopenStatus_t miopenFindSolutionsBatch(miopenHandle_t handle,
+                                        size_t numProblems,
+                                        const miopenProblem_t* problems,
+                                        miopenFindOptions_t options,
+                                        miopenSolution_t* solutions,
+                                        size_t* numSolutions,
+                                        size_t maxSolutions)
+{
+    MIOPEN_LOG_FUNCTION(
+        handle, numProblems, problems, options, solutions, numSolutions, maxSolutions);
+
+    return miopen::try_([&] {
+        if(numProblems != 0 && problems == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Problems parameter should not be a nullptr.");
+        if(numProblems != 0 && solutions == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Solutions parameter should not be a nullptr.");
+
+        auto& handle_deref  = miopen::deref(handle);
+        auto problems_deref = std::vector<const miopen::ProblemContainer*>{};
+        problems_deref.reserve(numProblems);
+
+        for(auto i = 0; i < numProblems; ++i)
+        {
+            const auto& problem = miopen::deref(problems[i]);
+            boost::apply_visitor([](auto&& item) { item.LogDriverCommand(); }, problem.item);
+            problems_deref.push_back(&problem);
+        }
+
+        const auto& options_deref =
+            options == nullptr ? miopen::FindOptions{} : miopen::deref(options);
+
+        auto solutions_deref =
+            miopen::FindSolutions(handle_deref, problems_deref, options_deref, maxSolutions);
+
+        // All the results are allocated before any is handed out, so nothing leaks on a throw.
+        auto owned = std::vector<std::vector<std::unique_ptr<miopen::Solution>>>(numProblems);
+
+        for(auto i = 0; i < numProblems; ++i)
+        {
+            owned[i].reserve(solutions_deref[i].size());
+            for(auto& found : solutions_deref[i])
+                owned[i].emplace_back(std::make_unique<miopen::Solution>(std::move(found)));
+        }
+
+        for(auto i = 0; i < numProblems; ++i)
+        {
+            for(auto j = 0; j < owned[i].size(); ++j)
+                solutions[i * maxSolutions + j] = owned[i][j].release();
+
+            if(numSolutions != nullptr)
+                numSolutions[i] = owned[i].size();
+        }
+    });
+}
+
 inline std::ostream& operator<<(std::ostream& stream, const miopenTensorArgument_t& tensor)
 {
     switch(tensor.id)
@@ -278,6 +335,23 @@ inline std::ostream& operator<<(std::ostream& stream, const miopenTensorArgument
     return stream;
 }
 
+namespace {
+// Logs the tensor arguments of miopenRunSolution without copying them
+struct TensorArguments
+{
+    const miopenTensorArgument_t* first;
+    std::size_t count;
+};
+
+inline std::ostream& operator<<(std::ostream& stream, const TensorArguments& tensors)
+{
+    stream << "{ ";
+    for(std::size_t i = 0; i < tensors.count; ++i)
+        stream << tensors.first[i] << ' ';
+    return stream << '}';
+}
+} // namespace
+
 miopenStatus_t miopenRunSolution(miopenHandle_t handle,
                                  miopenSolution_t solution,
                                  size_t nInputs,
@@ -285,26 +359,15 @@ miopenStatus_t miopenRunSolution(miopenHandle_t handle,
                                  void* workspace,
                                  size_t workspaceSize)
 {
-    const auto tensors_vector = std::vector<miopenTensorArgument_t>{tensors, tensors + nInputs};
-    MIOPEN_LOG_FUNCTION(handle, solution, nInputs, tensors_vector, workspace, workspaceSize);
+    const auto tensor_arguments = TensorArguments{tensors, nInputs};
+    MIOPEN_LOG_FUNCTION(handle, solution, nInputs, tensor_arguments, workspace, workspaceSize);
 
     return miopen::try_([&] {
         auto& handle_deref   = miopen::deref(handle);
         auto& solution_deref = miopen::deref(solution);
 
         solution_deref.LogDriverCommand();
-
-        const auto inputs_deref = [&]() {
-            auto ret = std::unordered_map<miopenTensorArgumentId_t, miopen::Solution::RunInput>{};
-
-            ret.reserve(tensors_vector.size());
-            for(auto&& tensor : tensors_vector)
-                ret.emplace(std::make_pair(tensor.id, miopen::Solution::RunInput{tensor}));
-
-            return ret;
-        }();
-
-        solution_deref.Run(handle_deref, inputs_deref, DataCast(workspace), workspaceSize);
+        solution_deref.Run(handle_deref, tensors, nInputs, DataCast(workspace), workspaceSize);
     });
 }
 
@@ -372,6 +435,17 @@ miopenStatus_t miopenGetSolutionSize(miopenSolution_t solution, size_t* size)
     });
 }
 
+miopenStatus_t miopenEmbedSolutionCodeObjects(miopenHandle_t handle, miopenSolution_t solution)
+{
+    MIOPEN_LOG_FUNCTION(handle, solution);
+
+    return miopen::try_([&] {
+        auto& handle_deref   = miopen::deref(handle);
+        auto& solution_deref = miopen::deref(solution);
+        solution_deref.EmbedCodeObjects(handle_deref);
+    });
+}
+
 miopenStatus_t miopenGetSolutionWorkspaceSize(miopenSolution_t solution, size_t* workspaceSize)
 {
     MIOPEN_LOG_FUNCTION(solution);
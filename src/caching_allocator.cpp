@@ -0,0 +1,260 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/caching_allocator.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_CACHING_ALLOCATOR)
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_CACHING_ALLOCATOR_LIMIT)
+
+namespace miopen {
+
+void CachingAllocator::Detach::operator()(CachingAllocator* allocator) const
+{
+    auto unused = false;
+    {
+        std::lock_guard<std::mutex> lock(allocator->mutex);
+        allocator->TrimUnlocked();
+        allocator->detached = true;
+        unused              = allocator->live.empty();
+    }
+    if(unused)
+        delete allocator;
+}
+
+CachingAllocator::CachingAllocator(miopenAllocatorFunction allocator_,
+                                   miopenDeallocatorFunction deallocator_,
+                                   void* context_,
+                                   std::size_t max_cached_bytes_)
+    : upstream_allocator(allocator_),
+      upstream_deallocator(deallocator_),
+      upstream_context(context_),
+      max_cached_bytes(max_cached_bytes_)
+{
+}
+
+CachingAllocator::Ptr CachingAllocator::Create(miopenAllocatorFunction allocator,
+                                               miopenDeallocatorFunction deallocator,
+                                               void* context,
+                                               std::size_t max_cached_bytes)
+{
+    if(allocator == nullptr || deallocator == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "Caching allocator requires both callbacks");
+    return Ptr{new CachingAllocator(allocator, deallocator, context, max_cached_bytes)};
+}
+
+CachingAllocator::Ptr CachingAllocator::CreateIfEnabled(miopenAllocatorFunction allocator,
+                                                        miopenDeallocatorFunction deallocator,
+                                                        void* context)
+{
+    if(!miopen::IsEnabled(ENV(MIOPEN_CACHING_ALLOCATOR)))
+        return nullptr;
+    return Create(allocator, deallocator, context, Value(ENV(MIOPEN_CACHING_ALLOCATOR_LIMIT)));
+}
+
+void* CachingAllocator::Allocate(void* self, std::size_t size)
+{
+    return static_cast<CachingAllocator*>(self)->AllocateImpl(size);
+}
+
+void CachingAllocator::Deallocate(void* self, void* mem)
+{
+    auto allocator = static_cast<CachingAllocator*>(self);
+    if(allocator->DeallocateImpl(mem))
+        delete allocator;
+}
+
+void CachingAllocator::SetStream(const void* stream_)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    stream = stream_;
+}
+
+void CachingAllocator::Trim()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    TrimUnlocked();
+}
+
+CachingAllocator::Statistics CachingAllocator::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+std::size_t CachingAllocator::GetSizeClass(std::size_t size)
+{
+    constexpr std::size_t granularity = 256;
+    if(size <= granularity)
+        return granularity;
+
+    auto power = granularity;
+    while(power <= size / 2)
+        power <<= 1;
+    const auto step = std::max(power / 4, granularity);
+    return (size + step - 1) / step * step;
+}
+
+void* CachingAllocator::AllocateImpl(std::size_t size)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ++stats.allocations;
+
+    if(size == 0)
+        return upstream_allocator(upstream_context, 0);
+
+    const auto size_class = GetSizeClass(size);
+    void* mem             = nullptr;
+    const auto bin        = bins.find({stream, size_class});
+
+    if(bin != bins.end())
+    {
+        mem = bin->second.back();
+        bin->second.pop_back();
+        if(bin->second.empty())
+            bins.erase(bin);
+        stats.bytes_cached -= size_class;
+        ++stats.cache_hits;
+    }
+    else
+    {
+        mem = AllocateUpstream(size_class);
+        if(mem == nullptr)
+            return nullptr;
+    }
+
+    live.emplace(mem, Block{size_class, stream});
+    stats.bytes_in_use += size_class;
+    stats.peak_bytes_in_use = std::max(stats.peak_bytes_in_use, stats.bytes_in_use);
+    return mem;
+}
+
+bool CachingAllocator::DeallocateImpl(void* mem)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto block = live.find(mem);
+
+    if(block == live.end())
+    {
+        // Zero-sized allocations are not tracked and go straight to the underlying allocator.
+        upstream_deallocator(upstream_context, mem);
+        ++stats.upstream_deallocations;
+        return detached && live.empty();
+    }
+
+    const auto size = block->second.size;
+    const auto key  = BinKey{block->second.stream, size};
+    live.erase(block);
+    stats.bytes_in_use -= size;
+
+    if(detached || (max_cached_bytes != 0 && stats.bytes_cached + size > max_cached_bytes))
+    {
+        upstream_deallocator(upstream_context, mem);
+        ++stats.upstream_deallocations;
+    }
+    else
+    {
+        bins[key].push_back(mem);
+        stats.bytes_cached += size;
+    }
+
+    return detached && live.empty();
+}
+
+void* CachingAllocator::AllocateUpstream(std::size_t size)
+{
+    void* mem = nullptr;
+
+    try
+    {
+        mem = upstream_allocator(upstream_context, size);
+    }
+    catch(...)
+    {
+        if(stats.bytes_cached == 0)
+            throw;
+    }
+
+    if(mem == nullptr && stats.bytes_cached != 0)
+    {
+        MIOPEN_LOG_I2("Allocation of " << size << " bytes failed, releasing "
+                                       << stats.bytes_cached << " cached bytes");
+        TrimUnlocked();
+        mem = upstream_allocator(upstream_context, size);
+    }
+
+    if(mem == nullptr)
+        return nullptr;
+
+    ++stats.upstream_allocations;
+    stats.peak_bytes_reserved =
+        std::max(stats.peak_bytes_reserved, stats.bytes_in_use + stats.bytes_cached + size);
+    return mem;
+}
+
+void CachingAllocator::TrimUnlocked()
+{
+    if(bins.empty())
+        return;
+
+    for(const auto& bin : bins)
+    {
+        for(const auto mem : bin.second)
+        {
+            upstream_deallocator(upstream_context, mem);
+            ++stats.upstream_deallocations;
+        }
+    }
+
+    bins.clear();
+    stats.bytes_cached = 0;
+    ++stats.trims;
+}
+
+Data_t WorkspaceArena::Get(const Allocator& allocator, std::size_t size)
+{
+    if(size > capacity)
+    {
+        // Release first so a caching allocator underneath may reuse the memory.
+        buffer.reset();
+        capacity = 0;
+        buffer   = allocator(size);
+        capacity = size;
+    }
+    return buffer.get();
+}
+
+void WorkspaceArena::Release()
+{
+    buffer.reset();
+    capacity = 0;
+}
+
+} // namespace miopen
@@ -0,0 +1,342 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/async_find.hpp>
+
+#include <miopen/config.h>
+#include <miopen/convolution.hpp>
+#include <miopen/datatype.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/find_controls.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor_ops.hpp>
+#include <miopen/visit_float.hpp>
+#include <miopen/conv/problem_description.hpp>
+
+#if MIOPEN_BACKEND_HIP && !MIOPEN_MODE_NOGPU
+#include <hip/hip_runtime_api.h>
+#endif
+
+#include <map>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+namespace miopen {
+namespace conv {
+
+AsyncFindQueue::~AsyncFindQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobs.clear();
+    }
+    job_added.notify_all();
+    if(worker.joinable())
+        worker.join();
+}
+
+bool AsyncFindQueue::Submit(const std::string& key, Job job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(stopping || !submitted.insert(key).second)
+            return false;
+        jobs.emplace_back(std::move(job));
+        if(!worker.joinable())
+            worker = std::thread{[this]() { Loop(); }};
+    }
+    job_added.notify_one();
+    return true;
+}
+
+void AsyncFindQueue::Wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    job_done.wait(lock, [&]() { return jobs.empty() && running == 0; });
+}
+
+std::size_t AsyncFindQueue::GetPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return jobs.size() + running;
+}
+
+void AsyncFindQueue::Loop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while(true)
+    {
+        job_added.wait(lock, [&]() { return stopping || !jobs.empty(); });
+        if(stopping)
+            break;
+
+        auto job = std::move(jobs.front());
+        jobs.pop_front();
+        ++running;
+        lock.unlock();
+
+        try
+        {
+            job();
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_W("Background find has failed: " << ex.what());
+        }
+
+        lock.lock();
+        --running;
+        job_done.notify_all();
+    }
+
+    running = 0;
+    job_done.notify_all();
+}
+
+namespace {
+
+int GetCurrentDevice()
+{
+#if MIOPEN_BACKEND_HIP && !MIOPEN_MODE_NOGPU
+    auto device = 0;
+    if(hipGetDevice(&device) != hipSuccess)
+        MIOPEN_THROW("No device");
+    return device;
+#else
+    return 0;
+#endif
+}
+
+void SetCurrentDevice([[maybe_unused]] int device)
+{
+#if MIOPEN_BACKEND_HIP && !MIOPEN_MODE_NOGPU
+    if(hipSetDevice(device) != hipSuccess)
+        MIOPEN_THROW("Error setting device");
+#endif
+}
+
+struct AsyncFindWorker
+{
+    explicit AsyncFindWorker(int device_) : device(device_) {}
+
+    // Device of the first caller.
+    const int device;
+    // Only touched by the jobs, i.e. on the queue thread. The handle is created there, because
+    // its constructor resets the thread local stream index of the thread it runs on. The queue
+    // is declared after the handle to be stopped before the handle is destroyed.
+    std::unique_ptr<Handle> handle;
+    AsyncFindQueue queue;
+    // Handles which queued finds to this worker, guarded by the mutex of AsyncFindWorkers.
+    std::unordered_set<const Handle*> clients;
+
+    Handle& GetHandle()
+    {
+        if(!handle)
+        {
+            SetCurrentDevice(device);
+            handle = std::make_unique<Handle>();
+        }
+        return *handle;
+    }
+};
+
+struct AsyncFindWorkers
+{
+    std::mutex mutex;
+    // Find-db records are shared by all devices of the same type, so one worker per type is enough.
+    std::map<std::string, std::shared_ptr<AsyncFindWorker>> workers;
+};
+
+AsyncFindWorkers& GetAsyncFindWorkers()
+{
+    // Leaked on purpose. Workers are stopped by ReleaseAsyncFinds() when their last client handle
+    // is destroyed, not by static destructors, which may run after the GPU runtime is gone.
+    static auto* const workers = new AsyncFindWorkers{};
+    return *workers;
+}
+
+std::shared_ptr<AsyncFindWorker> GetAsyncFindWorker(const Handle& handle)
+{
+    auto& workers = GetAsyncFindWorkers();
+    std::lock_guard<std::mutex> lock(workers.mutex);
+    auto& worker = workers.workers[handle.GetDbBasename()];
+    if(!worker)
+        worker = std::make_shared<AsyncFindWorker>(GetCurrentDevice());
+    worker->clients.insert(&handle);
+    return worker;
+}
+
+Allocator::ManageDataPtr AllocateZeroed(Handle& handle, const TensorDescriptor& descriptor)
+{
+    auto buffer = handle.Create(descriptor.GetElementSpace() * get_data_size(descriptor.GetType()));
+
+    visit_float(descriptor.GetType(), [&](auto as_float) {
+        const auto zero = as_float(0.f);
+        SetTensor(handle, descriptor, buffer.get(), &zero);
+    });
+
+    return buffer;
+}
+
+void RunFind(Handle& handle, const ProblemDescription& problem)
+{
+    // The benchmarks go to a non-blocking stream to not serialize with the application's work.
+    handle.ReserveExtraStreamsInPool(1);
+    handle.SetStreamFromPool(1);
+
+    auto conv = problem.GetConv();
+    conv.findMode.Set(FindMode::Values::Normal);
+
+    const auto in      = AllocateZeroed(handle, problem.GetIn());
+    const auto weights = AllocateZeroed(handle, problem.GetWeights());
+    const auto out     = AllocateZeroed(handle, problem.GetOut());
+
+    auto ctx = ExecutionContext{&handle};
+    problem.SetupFloats(ctx);
+    const auto workspace_size = conv.GetWorkSpaceSize(ctx, problem);
+    auto workspace            = Allocator::ManageDataPtr{};
+    if(workspace_size != 0)
+        workspace = handle.Create(workspace_size);
+
+    auto perf  = miopenConvAlgoPerf_t{};
+    auto found = 0;
+
+    switch(problem.GetDirection())
+    {
+    case Direction::Forward:
+        conv.FindConvFwdAlgorithm(handle,
+                                  problem.GetIn(),
+                                  in.get(),
+                                  problem.GetWeights(),
+                                  weights.get(),
+                                  problem.GetOut(),
+                                  out.get(),
+                                  1,
+                                  &found,
+                                  &perf,
+                                  workspace.get(),
+                                  workspace_size,
+                                  false);
+        break;
+    case Direction::BackwardData:
+        conv.FindConvBwdDataAlgorithm(handle,
+                                      problem.GetIn(),
+                                      in.get(),
+                                      problem.GetWeights(),
+                                      weights.get(),
+                                      problem.GetOut(),
+                                      out.get(),
+                                      1,
+                                      &found,
+                                      &perf,
+                                      workspace.get(),
+                                      workspace_size,
+                                      false);
+        break;
+    case Direction::BackwardWeights:
+        conv.FindConvBwdWeightsAlgorithm(handle,
+                                         problem.GetIn(),
+                                         in.get(),
+                                         problem.GetOut(),
+                                         out.get(),
+                                         problem.GetWeights(),
+                                         weights.get(),
+                                         1,
+                                         &found,
+                                         &perf,
+                                         workspace.get(),
+                                         workspace_size,
+                                         false);
+        break;
+    }
+
+    handle.Finish();
+}
+
+} // namespace
+
+bool QueueAsyncFind(const ExecutionContext& ctx, const ProblemDescription& problem)
+{
+    const auto worker = GetAsyncFindWorker(ctx.GetStream());
+    const auto key    = problem.MakeNetworkConfig().ToString();
+
+    // The worker outlives its jobs, as it is destroyed only after the queue has stopped.
+    const auto queued = worker->queue.Submit(key, [worker = worker.get(), problem, key]() {
+        RunFind(worker->GetHandle(), problem);
+        MIOPEN_LOG_I("Background find is done: " << key);
+    });
+
+    if(queued)
+        MIOPEN_LOG_I("Background find is queued: " << key);
+    return queued;
+}
+
+void WaitForAsyncFinds()
+{
+    auto& workers = GetAsyncFindWorkers();
+    auto waited   = std::vector<std::shared_ptr<AsyncFindWorker>>{};
+
+    {
+        std::lock_guard<std::mutex> lock(workers.mutex);
+        for(const auto& worker : workers.workers)
+            waited.push_back(worker.second);
+    }
+
+    for(const auto& worker : waited)
+        worker->queue.Wait();
+}
+
+void ReleaseAsyncFinds(const Handle& handle)
+{
+    auto& workers = GetAsyncFindWorkers();
+    auto stopped  = std::vector<std::shared_ptr<AsyncFindWorker>>{};
+
+    {
+        std::lock_guard<std::mutex> lock(workers.mutex);
+        for(auto it = workers.workers.begin(); it != workers.workers.end();)
+        {
+            auto& clients = it->second->clients;
+            if(clients.erase(&handle) == 0 || !clients.empty())
+            {
+                ++it;
+                continue;
+            }
+            stopped.push_back(std::move(it->second));
+            it = workers.workers.erase(it);
+        }
+    }
+
+    // Joins the worker threads outside of the lock. Destroying the worker handles calls this
+    // function again, which finds nothing to release.
+    stopped.clear();
+}
+
+} // namespace conv
+} // namespace miopen
@@ -28,11 +28,25 @@
 #if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK || MIOPEN_ENABLE_AI_KERNEL_TUNING
 #include <fdeep/fdeep.hpp>
 #include <boost/filesystem.hpp>
+#include <miopen/env.hpp>
+#include <miopen/timer.hpp>
+#include <memory>
+#include <mutex>
+
+/// Models are verified against the test cases stored in the model files while loading.
+/// This takes much longer than parsing, so it is done only on request.
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_AI_MODEL_VERIFY)
 
 namespace miopen {
 namespace ai {
 namespace common {
 
+fdeep::model LoadModel(const std::string& path)
+{
+    return fdeep::load_model(
+        path, miopen::IsEnabled(ENV(MIOPEN_DEBUG_AI_MODEL_VERIFY)), fdeep::dev_null_logger);
+}
+
 nlohmann::json LoadJSON(const std::string& path)
 {
     if(!boost::filesystem::exists(path))
@@ -114,7 +128,7 @@ public:
     Metadata metadata;
     Model(const std::string& arch)
         : metadata(Metadata(arch)),
-          model(fdeep::load_model(ModelPath(arch), true, fdeep::dev_null_logger)),
+          model(common::LoadModel(ModelPath(arch))),
           input_shape(fdeep::tensor_shape(metadata.num_inputs)),
           offset(metadata.num_outputs - metadata.num_solvers)
     {
@@ -130,6 +144,24 @@ public:
         std::vector<float> res(output_vector.begin() + offset, output_vector.end());
         return res;
     }
+    std::vector<std::vector<float>>
+    Forward(const std::vector<const conv::ProblemDescription*>& problems) const
+    {
+        std::vector<fdeep::tensors> inputs;
+        inputs.reserve(problems.size());
+        for(const auto problem : problems)
+            inputs.push_back({fdeep::tensor(input_shape, ToFeatures(*problem))});
+
+        const auto outputs = model.predict_multi(inputs, true);
+        std::vector<std::vector<float>> res;
+        res.reserve(outputs.size());
+        for(const auto& output : outputs)
+        {
+            std::vector<float> output_vector = output.front().to_vector();
+            res.emplace_back(output_vector.begin() + offset, output_vector.end());
+        }
+        return res;
+    }
 
 protected:
     const fdeep::model model;
@@ -348,7 +380,7 @@ protected:
     }
 };
 
-std::unique_ptr<Model> GetModel(const std::string& device)
+std::unique_ptr<Model> CreateModel(const std::string& device)
 {
     if(device == "gfx90a")
         return std::make_unique<Gfx90aModel>();
@@ -356,38 +388,51 @@ std::unique_ptr<Model> GetModel(const std::string& device)
         return std::make_unique<Gfx908Model>();
 }
 
-std::vector<uint64_t> PredictSolver(const conv::ProblemDescription& problem,
-                                    const ExecutionContext& ctx,
-                                    const std::string& device)
+std::shared_ptr<Model> GetModel(const std::string& device)
 {
-    const static std::unique_ptr<Model> model = GetModel(device);
-    if(!model || !model->IsProblemSupported(problem, ctx))
-        return {};
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::shared_ptr<Model>> models;
 
-    std::string est_name = ":memory:" + device;
-    auto& db             = AnyRamDb::GetCached(est_name);
-    auto db_res          = db.FindRecord(problem);
-    if(db_res)
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& model = models[device];
+    if(!model)
     {
-        MIOPEN_LOG_I2("Cached heuristic (TunaNet) result found");
-        std::vector<uint64_t> db_sol(db_res->size());
-        // cast returned record to solver ids
-        std::transform(db_res->begin(), db_res->end(), db_sol.begin(), [](boost::any id) {
-            return boost::any_cast<uint64_t>(id);
-        });
-        if(miopen::IsLogging(LoggingLevel::Info2))
-        {
-            std::stringstream ss;
-            for(auto& id : db_sol)
-                ss << solver::Id{id}.ToString() << " ID:" << id << ", ";
-            MIOPEN_LOG_I2("Cached solvers: " << ss.str());
-        }
-        return db_sol;
+        Timer timer;
+        timer.start();
+        model = CreateModel(device);
+        MIOPEN_LOG_I2("TunaNet model for " << device << " loaded, ms: " << timer.elapsed_ms());
     }
+    return model;
+}
 
-    MIOPEN_LOG_I2("Evaluating TunaNet");
+boost::optional<std::vector<uint64_t>> LoadCachedSolvers(AnyRamDb& db,
+                                                         const conv::ProblemDescription& problem)
+{
+    auto db_res = db.FindRecord(problem);
+    if(!db_res)
+        return boost::none;
+
+    MIOPEN_LOG_I2("Cached heuristic (TunaNet) result found");
+    std::vector<uint64_t> db_sol(db_res->size());
+    // cast returned record to solver ids
+    std::transform(db_res->begin(), db_res->end(), db_sol.begin(), [](boost::any id) {
+        return boost::any_cast<uint64_t>(id);
+    });
+    if(miopen::IsLogging(LoggingLevel::Info2))
+    {
+        std::stringstream ss;
+        for(auto& id : db_sol)
+            ss << solver::Id{id}.ToString() << " ID:" << id << ", ";
+        MIOPEN_LOG_I2("Cached solvers: " << ss.str());
+    }
+    return db_sol;
+}
 
-    std::vector<float> res = model->Forward(problem);
+std::vector<uint64_t> RankSolvers(const Model& model,
+                                  const std::vector<float>& res,
+                                  AnyRamDb& db,
+                                  const conv::ProblemDescription& problem)
+{
     std::vector<std::pair<int, float>> sort_res(res.size());
     // sorts result based upon magnitude of result in vector, returned from Model,
     // paired with original index (idx). Sort magnitudes in descending order.
@@ -406,10 +451,10 @@ std::vector<uint64_t> PredictSolver(const conv::ProblemDescription& problem,
     for(const auto& kinder : sort_res)
     {
         const auto id     = kinder.first;
-        const auto sol_id = solver::Id{model->metadata.solver_map.at(id)};
+        const auto sol_id = solver::Id{model.metadata.solver_map.at(id)};
         if(!sol_id.IsValid())
         {
-            MIOPEN_LOG_I2("Invalid solver " << model->metadata.solver_map.at(id) << " removed");
+            MIOPEN_LOG_I2("Invalid solver " << model.metadata.solver_map.at(id) << " removed");
             continue;
         }
         sol.push_back(sol_id.Value());
@@ -425,6 +470,70 @@ std::vector<uint64_t> PredictSolver(const conv::ProblemDescription& problem,
     }
     return sol;
 }
+
+std::vector<uint64_t> PredictSolver(const conv::ProblemDescription& problem,
+                                    const ExecutionContext& ctx,
+                                    const std::string& device)
+{
+    const auto model = GetModel(device);
+    if(!model || !model->IsProblemSupported(problem, ctx))
+        return {};
+
+    std::string est_name = ":memory:" + device;
+    auto& db             = AnyRamDb::GetCached(est_name);
+    if(auto cached = LoadCachedSolvers(db, problem))
+        return *cached;
+
+    MIOPEN_LOG_I2("Evaluating TunaNet");
+
+    Timer timer;
+    timer.start();
+    const auto res = model->Forward(problem);
+    MIOPEN_LOG_I2("TunaNet predict, ms: " << timer.elapsed_ms());
+    return RankSolvers(*model, res, db, problem);
+}
+
+std::vector<std::vector<uint64_t>>
+PredictSolvers(const std::vector<conv::ProblemDescription>& problems,
+               const ExecutionContext& ctx,
+               const std::string& device)
+{
+    auto ret         = std::vector<std::vector<uint64_t>>(problems.size());
+    const auto model = GetModel(device);
+    if(!model)
+        return ret;
+
+    std::string est_name = ":memory:" + device;
+    auto& db             = AnyRamDb::GetCached(est_name);
+    auto pending         = std::vector<std::size_t>{};
+    auto batch           = std::vector<const conv::ProblemDescription*>{};
+
+    for(auto i = 0; i < problems.size(); ++i)
+    {
+        if(!model->IsProblemSupported(problems[i], ctx))
+            continue;
+        if(auto cached = LoadCachedSolvers(db, problems[i]))
+        {
+            ret[i] = std::move(*cached);
+            continue;
+        }
+        pending.push_back(i);
+        batch.push_back(&problems[i]);
+    }
+
+    if(batch.empty())
+        return ret;
+
+    Timer timer;
+    timer.start();
+    const auto res = model->Forward(batch);
+    MIOPEN_LOG_I2("TunaNet predict of " << batch.size() << " problems, ms: "
+                                        << timer.elapsed_ms());
+
+    for(auto i = 0; i < pending.size(); ++i)
+        ret[pending[i]] = RankSolvers(*model, res[i], db, problems[pending[i]]);
+    return ret;
+}
 } // namespace immed_mode
 #endif // MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
 
@@ -446,8 +555,8 @@ public:
     Metadata metadata;
     Model(const std::string& arch, const std::string& solver)
         : metadata(Metadata(arch, solver)),
-          encoder(fdeep::load_model(EncoderPath(arch, solver), true, fdeep::dev_null_logger)),
-          decoder(fdeep::load_model(DecoderPath(arch, solver), true, fdeep::dev_null_logger))
+          encoder(common::LoadModel(EncoderPath(arch, solver))),
+          decoder(common::LoadModel(DecoderPath(arch, solver)))
     {
     }
     virtual ~Model() = default;
@@ -491,19 +600,64 @@ private:
 
 std::shared_ptr<Model> GetModel(const std::string& arch, const std::string& solver)
 {
+    static std::mutex mutex;
     static std::map<std::string, std::shared_ptr<Model>> models;
-    auto it = models.find(solver);
-    if(it == models.end())
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& model = models[arch + "_" + solver];
+    if(!model)
     {
-        std::shared_ptr<Model> model = std::make_shared<Model>(arch, solver);
-        models[solver]               = model;
-        return model;
+        Timer timer;
+        timer.start();
+        model = std::make_shared<Model>(arch, solver);
+        MIOPEN_LOG_I2("Tuning model for " << arch << " " << solver
+                                          << " loaded, ms: " << timer.elapsed_ms());
     }
-    else
+    return model;
+}
+
+/// Tokens of the successful predictions by arch, solver and features. The validators check more
+/// of the problem than the features hold, so a hit is replayed through the validator and thrown
+/// away if a token is rejected. For the same reason failures are not stored: they may be caused
+/// by a part of the problem, which is not in the key.
+class PredictionCache
+{
+public:
+    static PredictionCache& Get()
+    {
+        static PredictionCache cache;
+        return cache;
+    }
+
+    static std::string MakeKey(const std::string& arch,
+                               const std::string& solver,
+                               const std::vector<float>& features)
     {
+        auto key = arch + "_" + solver + ":";
+        key.append(reinterpret_cast<const char*>(features.data()),
+                   features.size() * sizeof(float));
+        return key;
+    }
+
+    boost::optional<std::vector<std::string>> Find(const std::string& key) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = predictions.find(key);
+        if(it == predictions.end())
+            return boost::none;
         return it->second;
     }
-}
+
+    void Store(const std::string& key, std::vector<std::string> values)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        predictions[key] = std::move(values);
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::vector<std::string>> predictions;
+};
 
 bool ModelSetParams(const std::string& arch,
                     const std::string& solver,
@@ -511,12 +665,32 @@ bool ModelSetParams(const std::string& arch,
                     bool transform_features,
                     std::function<bool(std::size_t, std::string)> validator)
 {
+    const auto key    = PredictionCache::MakeKey(arch, solver, features);
+    const auto cached = PredictionCache::Get().Find(key);
+    if(cached)
+    {
+        // The validators set the parameters as a side effect, so the tokens are replayed.
+        std::size_t i = 0;
+        while(i < cached->size() && validator(i, (*cached)[i]))
+            ++i;
+        if(i == cached->size())
+        {
+            MIOPEN_LOG_I2("Cached tuning prediction used for " << solver);
+            return true;
+        }
+    }
+
     auto model = GetModel(arch, solver);
     int dim    = 0;
     if(transform_features)
         dim = std::sqrt(features.size());
     else
         dim = features.size();
+
+    Timer timer;
+    timer.start();
+    auto values            = std::vector<std::string>{};
+    auto cacheable         = true;
     fdeep::tensors context = model->Encode(features, dim, transform_features);
     float decoder_input    = 0.0;
     for(std::size_t i = 0; i < model->metadata.num_tuning_params; ++i)
@@ -541,12 +715,19 @@ bool ModelSetParams(const std::string& arch,
             {
                 output_token_index =
                     token; // index with largest value that is valid = predicted index
+                values.push_back(value);
                 break;
             }
         }
+        if(output_token_index == -1)
+            cacheable = false; // no token to replay for this parameter
         decoder_input = float(output_token_index);
         context       = {decoder_output.begin() + 1, decoder_output.end()};
     }
+    MIOPEN_LOG_I2("Tuning model predict for " << solver << ", ms: " << timer.elapsed_ms());
+
+    if(cacheable)
+        PredictionCache::Get().Store(key, std::move(values));
     return true;
 }
 
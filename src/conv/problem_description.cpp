@@ -32,8 +32,6 @@
 #include <miopen/execution_context.hpp>
 #include <miopen/tensor_layout.hpp>
 
-#include <sstream>
-
 namespace miopen {
 
 std::string
@@ -45,25 +43,6 @@ EncodeDataTypesForKey(miopenDataType_t in, miopenDataType_t weights, miopenDataT
 }
 
 namespace conv {
-namespace {
-
-std::function<void(std::ostream&)>
-PrintDHW(char sep, unsigned spatial_dims, int depth, int height, int width)
-{
-    return [=](std::ostream& stream) {
-        if(spatial_dims > 2)
-            stream << depth << sep;
-        stream << height << sep << width;
-    };
-}
-
-std::ostream& operator<<(std::ostream& stream, std::function<void(std::ostream&)>&& manipulator)
-{
-    manipulator(stream);
-    return stream;
-}
-
-} // namespace
 
 std::string ProblemDescription::GetDirectionStr() const
 {
@@ -103,104 +82,58 @@ void ProblemDescription::HeuristicUpdateLayouts()
     // If we did not find consistent layout, leave them as-is
 }
 
-void ProblemDescription::MakeNetworkConfig(std::string& conf_key) const
+ProblemKey ProblemDescription::MakeKey() const
 {
-    std::ostringstream ss;
-
-    ss << GetInChannels_();
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetInDepth_(), GetInHeight_(), GetInWidth_());
-    ss << 'x'
-       << PrintDHW(
-              'x', GetSpatialDims(), GetWeightsDepth_(), GetWeightsHeight_(), GetWeightsWidth_());
-    ss << 'x' << GetOutChannels_();
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetOutDepth_(), GetOutHeight_(), GetOutWidth_());
-    ss << 'x' << GetInBatchSize_();
-    if((GetInLayout() == "NCHW" && GetWeightsLayout() == "NCHW" && GetOutLayout() == "NCHW") ||
-       (GetInLayout() == "NCDHW" && GetWeightsLayout() == "NCDHW" && GetOutLayout() == "NCDHW"))
-    {
-        ss << 'x' << GetInLayout();
-    }
-    else
-    {
-        ss << 'x' << GetInLayout();
-        ss << 'x' << GetWeightsLayout();
-        ss << 'x' << GetOutLayout();
-    }
-    ss << 'x' << EncodeDataTypesForKey(GetInDataType(), GetWeightsDataType(), GetOutDataType());
-
-    std::ostringstream optional;
-    if(const auto ct = GetInCastType())
-        optional << "ci" << GetDataTypeName(*ct);
-    if(const auto ct = GetWeightsCastType())
-        optional << "cw" << GetDataTypeName(*ct);
-    if(const auto ct = GetOutCastType())
-        optional << "co" << GetDataTypeName(*ct);
-    if(!optional.str().empty())
-    {
-        ss << 'x' << optional.str();
-    }
+    const auto cast_type = [](const std::optional<miopenDataType_t>& type) {
+        return type ? static_cast<std::int32_t>(*type) : ProblemKey::no_cast_type;
+    };
 
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetPadD(), GetPadH(), GetPadW());
-    ss << 'x'
-       << PrintDHW(
-              'x', GetSpatialDims(), GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW());
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetDilationD(), GetDilationH(), GetDilationW());
-    ss << 'x' << GetGroupCount();
-    ss << 'x' << GetDirectionStr();
+    auto key              = ProblemKey{};
+    key.spatial_dims      = GetSpatialDims();
+    key.in_channels       = GetInChannels_();
+    key.in_depth          = GetInDepth_();
+    key.in_height         = GetInHeight_();
+    key.in_width          = GetInWidth_();
+    key.weights_depth     = GetWeightsDepth_();
+    key.weights_height    = GetWeightsHeight_();
+    key.weights_width     = GetWeightsWidth_();
+    key.out_channels      = GetOutChannels_();
+    key.out_depth         = GetOutDepth_();
+    key.out_height        = GetOutHeight_();
+    key.out_width         = GetOutWidth_();
+    key.batch_size        = GetInBatchSize_();
+    key.pad_d             = GetPadD();
+    key.pad_h             = GetPadH();
+    key.pad_w             = GetPadW();
+    key.stride_d          = GetKernelStrideD();
+    key.stride_h          = GetKernelStrideH();
+    key.stride_w          = GetKernelStrideW();
+    key.dilation_d        = GetDilationD();
+    key.dilation_h        = GetDilationH();
+    key.dilation_w        = GetDilationW();
+    key.group_count       = GetGroupCount();
+    key.bias              = GetBias();
+    key.direction         = GetDirection();
+    key.in_type           = GetInDataType();
+    key.weights_type      = GetWeightsDataType();
+    key.out_type          = GetOutDataType();
+    key.in_cast_type      = cast_type(GetInCastType());
+    key.weights_cast_type = cast_type(GetWeightsCastType());
+    key.out_cast_type     = cast_type(GetOutCastType());
+    key.in_layout         = ProblemKey::MakeLayout(in_layout);
+    key.weights_layout    = ProblemKey::MakeLayout(weights_layout);
+    key.out_layout        = ProblemKey::MakeLayout(out_layout);
+    return key;
+}
 
-    conf_key = ss.str();
+void ProblemDescription::MakeNetworkConfig(std::string& conf_key) const
+{
+    MakeKey().MakeNetworkConfig(conf_key, {in_layout, weights_layout, out_layout});
 }
 
 void ProblemDescription::Serialize(std::ostream& stream) const
 {
-    const auto sep = '-';
-    // Problem description with default layout
-    // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F
-    // Problem description with non-default layout
-    // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NHWC-NCHW-NCHW-FP32-F
-    // clang-format off
-    stream << GetInChannels_();
-    stream << sep << PrintDHW(sep, GetSpatialDims(), GetInDepth_(), GetInHeight_(), GetInWidth_());
-    stream << sep << PrintDHW('x', GetSpatialDims(), GetWeightsDepth_(), GetWeightsHeight_(), GetWeightsWidth_());
-    stream << sep << GetOutChannels_();
-    stream << sep << PrintDHW(sep, GetSpatialDims(), GetOutDepth_(), GetOutHeight_(), GetOutWidth_());
-    stream << sep << GetInBatchSize_();
-    stream << sep << PrintDHW('x', GetSpatialDims(), GetPadD(), GetPadH(), GetPadW());
-    stream << sep << PrintDHW('x', GetSpatialDims(), GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW());
-    stream << sep << PrintDHW('x', GetSpatialDims(), GetDilationD(), GetDilationH(), GetDilationW());
-    stream << sep << GetBias();
-    if ((GetInLayout() == "NCHW" && GetWeightsLayout() == "NCHW" && GetOutLayout() == "NCHW")
-        || (GetInLayout() == "NCDHW" && GetWeightsLayout() == "NCDHW" && GetOutLayout() == "NCDHW"))
-    {
-        stream << sep << GetInLayout();
-    } else {
-        stream << sep << GetInLayout();
-        stream << sep << GetWeightsLayout();
-        stream << sep << GetOutLayout();
-    }
-    stream << sep << EncodeDataTypesForKey(GetInDataType(), GetWeightsDataType(), GetOutDataType());
-    stream << sep << GetDirectionStr();
-
-    // clang-format on
-    // New performance config entries shall come into variable/optional part of db key.
-    // This is to support backward compatibility with previous versions of databases.
-    std::ostringstream optional;
-    {
-        // Group count > 1 identifies Group/Depthwise modes.
-        if(GetGroupCount() != 1)
-            optional << "_g" << GetGroupCount();
-
-        if(const auto ct = GetInCastType())
-            optional << "_ci" << GetDataTypeName(*ct);
-        if(const auto ct = GetWeightsCastType())
-            optional << "_cw" << GetDataTypeName(*ct);
-        if(const auto ct = GetOutCastType())
-            optional << "_co" << GetDataTypeName(*ct);
-    }
-    if(!optional.str().empty())
-    {
-        stream << optional.str();
-    }
+    MakeKey().Serialize(stream, {in_layout, weights_layout, out_layout});
 }
 
 bool ProblemDescription::IsLayoutDefault() const
@@ -0,0 +1,200 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/problem_key.hpp>
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/errors.hpp>
+
+#include <string_view>
+
+namespace miopen {
+namespace conv {
+namespace {
+
+template <class T>
+void AppendDHW(std::string& key, char sep, unsigned spatial_dims, T depth, T height, T width)
+{
+    if(spatial_dims > 2)
+    {
+        key += std::to_string(depth);
+        key += sep;
+    }
+    key += std::to_string(height);
+    key += sep;
+    key += std::to_string(width);
+}
+
+bool IsLayoutDefault(const ProblemKey::LayoutNames& layouts)
+{
+    return (layouts.in == "NCHW" || layouts.in == "NCDHW") && layouts.in == layouts.weights &&
+           layouts.in == layouts.out;
+}
+
+void AppendLayouts(std::string& key, char sep, const ProblemKey::LayoutNames& layouts)
+{
+    key += layouts.in;
+    if(IsLayoutDefault(layouts))
+        return;
+    key += sep;
+    key += layouts.weights;
+    key += sep;
+    key += layouts.out;
+}
+
+void AppendCastType(std::string& key, const char* prefix, std::int32_t cast_type)
+{
+    if(cast_type == ProblemKey::no_cast_type)
+        return;
+    key += prefix;
+    key += GetDataTypeName(static_cast<miopenDataType_t>(cast_type));
+}
+
+char GetDirectionChar(Direction direction)
+{
+    switch(direction)
+    {
+    case Direction::Forward: return 'F';
+    case Direction::BackwardData: return 'B';
+    case Direction::BackwardWeights: return 'W';
+    default: MIOPEN_THROW(miopenStatusInternalError);
+    }
+}
+
+} // namespace
+
+ProblemKey::Layout ProblemKey::MakeLayout(std::string_view layout)
+{
+    auto ret = Layout{};
+    if(layout.size() < ret.size())
+    {
+        std::copy(layout.begin(), layout.end(), ret.begin());
+        return ret;
+    }
+
+    // Too long to be stored, the leading zero tells the hash apart from any layout text
+    const auto hash = Hash64(layout.data(), layout.size());
+    std::memcpy(ret.data() + 1, &hash, ret.size() - 1);
+    return ret;
+}
+
+void ProblemKey::MakeNetworkConfig(std::string& conf_key, const LayoutNames& layouts) const
+{
+    conf_key.clear();
+    conf_key.reserve(96);
+
+    conf_key += std::to_string(in_channels);
+    conf_key += 'x';
+    AppendDHW(conf_key, 'x', spatial_dims, in_depth, in_height, in_width);
+    conf_key += 'x';
+    AppendDHW(conf_key, 'x', spatial_dims, weights_depth, weights_height, weights_width);
+    conf_key += 'x';
+    conf_key += std::to_string(out_channels);
+    conf_key += 'x';
+    AppendDHW(conf_key, 'x', spatial_dims, out_depth, out_height, out_width);
+    conf_key += 'x';
+    conf_key += std::to_string(batch_size);
+    conf_key += 'x';
+    AppendLayouts(conf_key, 'x', layouts);
+    conf_key += 'x';
+    conf_key += EncodeDataTypesForKey(in_type, weights_type, out_type);
+
+    if(in_cast_type != no_cast_type || weights_cast_type != no_cast_type ||
+       out_cast_type != no_cast_type)
+    {
+        conf_key += 'x';
+        AppendCastType(conf_key, "ci", in_cast_type);
+        AppendCastType(conf_key, "cw", weights_cast_type);
+        AppendCastType(conf_key, "co", out_cast_type);
+    }
+
+    conf_key += 'x';
+    AppendDHW(conf_key, 'x', spatial_dims, pad_d, pad_h, pad_w);
+    conf_key += 'x';
+    AppendDHW(conf_key, 'x', spatial_dims, stride_d, stride_h, stride_w);
+    conf_key += 'x';
+    AppendDHW(conf_key, 'x', spatial_dims, dilation_d, dilation_h, dilation_w);
+    conf_key += 'x';
+    conf_key += std::to_string(group_count);
+    conf_key += 'x';
+    conf_key += GetDirectionChar(direction);
+}
+
+void ProblemKey::Serialize(std::string& db_key, const LayoutNames& layouts) const
+{
+    const auto sep = '-';
+
+    db_key.clear();
+    db_key.reserve(96);
+
+    db_key += std::to_string(in_channels);
+    db_key += sep;
+    AppendDHW(db_key, sep, spatial_dims, in_depth, in_height, in_width);
+    db_key += sep;
+    AppendDHW(db_key, 'x', spatial_dims, weights_depth, weights_height, weights_width);
+    db_key += sep;
+    db_key += std::to_string(out_channels);
+    db_key += sep;
+    AppendDHW(db_key, sep, spatial_dims, out_depth, out_height, out_width);
+    db_key += sep;
+    db_key += std::to_string(batch_size);
+    db_key += sep;
+    AppendDHW(db_key, 'x', spatial_dims, pad_d, pad_h, pad_w);
+    db_key += sep;
+    AppendDHW(db_key, 'x', spatial_dims, stride_d, stride_h, stride_w);
+    db_key += sep;
+    AppendDHW(db_key, 'x', spatial_dims, dilation_d, dilation_h, dilation_w);
+    db_key += sep;
+    db_key += std::to_string(bias);
+    db_key += sep;
+    AppendLayouts(db_key, sep, layouts);
+    db_key += sep;
+    db_key += EncodeDataTypesForKey(in_type, weights_type, out_type);
+    db_key += sep;
+    db_key += GetDirectionChar(direction);
+
+    // New performance config entries shall come into variable/optional part of db key.
+    // This is to support backward compatibility with previous versions of databases.
+    // Group count > 1 identifies Group/Depthwise modes.
+    if(group_count != 1)
+    {
+        db_key += "_g";
+        db_key += std::to_string(group_count);
+    }
+    AppendCastType(db_key, "_ci", in_cast_type);
+    AppendCastType(db_key, "_cw", weights_cast_type);
+    AppendCastType(db_key, "_co", out_cast_type);
+}
+
+void ProblemKey::Serialize(std::ostream& stream, const LayoutNames& layouts) const
+{
+    std::string db_key;
+    Serialize(db_key, layouts);
+    stream << db_key;
+}
+
+} // namespace conv
+} // namespace miopen
@@ -28,9 +28,11 @@
 
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/config.h>
+#include <miopen/find_db.hpp>
 #include <miopen/mlo_internal.hpp>
 #include <miopen/perf_field.hpp>
 #include <miopen/conv/problem_description.hpp>
+#include <miopen/conv/heuristics/ai_heuristics.hpp>
 
 MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_DEVICE_ARCH)
 
@@ -39,6 +41,8 @@ MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_CONV_DIRECT)
 MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_CONV_WINOGRAD)
 MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM)
 MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_CONV_FFT)
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_CONV_IMMED_FALLBACK)
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_ENABLE_AI_IMMED_MODE_FALLBACK)
 
 namespace miopen {
 
@@ -331,6 +335,57 @@ void FindCore(const AnyInvokeParams& invoke_ctx,
 
 namespace conv {
 
+void PrecompileFind(Handle& handle, const std::vector<ProblemDescription>& problems)
+{
+    auto solutions = std::vector<solver::ConvSolution>{};
+    // Problems which are going to take the immediate mode fallback.
+    auto fallbacks = std::vector<ProblemDescription>{};
+
+    for(const auto& problem : problems)
+    {
+        auto ctx = ExecutionContext{&handle};
+        problem.SetupFloats(ctx);
+
+        // Same conditions as in FindConvolution() for taking the normal find path.
+        const auto& find_mode = problem.GetConv().findMode;
+        if(find_mode.IsFast(ctx) || find_mode.IsAsyncHybrid(ctx))
+        {
+            if(FindDbRecord{handle, problem}.empty())
+                fallbacks.push_back(problem);
+            continue;
+        }
+        if(find_mode.IsHybrid(ctx))
+            continue;
+        if(!UserFindDbRecord{handle, problem}.empty())
+            continue;
+
+        ctx.use_dynamic_solutions_only = find_mode.IsDynamicHybrid(ctx);
+        const auto params =
+            ConvFindParameters{problem.GetConv().IsWinograd3x3SupportedAndFast(ctx, problem)};
+
+        for(const auto& finder : GetConvSolverFinders())
+        {
+            auto found = finder->Find(ctx, problem, AnyInvokeParams{}, params, std::nullopt);
+            std::move(found.begin(), found.end(), std::back_inserter(solutions));
+        }
+    }
+
+#if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
+    // Fills the TunaNet cache for the fallback in one model call instead of one per problem.
+    if(fallbacks.size() > 1 && !miopen::IsDisabled(ENV(MIOPEN_DEBUG_CONV_IMMED_FALLBACK)) &&
+       !miopen::IsDisabled(ENV(MIOPEN_DEBUG_ENABLE_AI_IMMED_MODE_FALLBACK)))
+    {
+        ai::immed_mode::PredictSolvers(
+            fallbacks, ExecutionContext{&handle}, handle.GetDeviceName());
+    }
+#endif
+
+    auto all = std::vector<const solver::ConvSolution*>{};
+    all.reserve(solutions.size());
+    AppendPointersToElements(solutions, all);
+    PrecompileSolutions(handle, all);
+}
+
 bool IsAlgorithmDisabled(miopenConvAlgorithm_t algo)
 {
     switch(algo)
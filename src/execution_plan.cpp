@@ -0,0 +1,157 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/execution_plan.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace miopen {
+
+void ExecutionPlan::Run(const Handle& handle, void* const* buffers, std::size_t count) const
+{
+#if MIOPEN_BACKEND_HIP
+    if(count != binding_count)
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Execution plan expects " + std::to_string(binding_count) +
+                         " buffers, got " + std::to_string(count));
+    }
+
+    auto scratch = std::vector<char>{};
+
+    for(const auto& launch : launches)
+    {
+        // The launch only reads the argument block.
+        // NOLINTNEXTLINE (cppcoreguidelines-pro-type-const-cast)
+        auto args = const_cast<char*>(launch.args.data());
+
+        if(!launch.patches.empty())
+        {
+            scratch.resize(max_args_size);
+            std::copy(launch.args.begin(), launch.args.end(), scratch.begin());
+            for(const auto& patch : launch.patches)
+            {
+                const auto pointer = static_cast<char*>(buffers[patch.binding]) + patch.delta;
+                std::memcpy(scratch.data() + patch.offset, &pointer, sizeof(pointer));
+            }
+            args = scratch.data();
+        }
+
+        handle.Run(*launch.kernel).run(args, launch.args.size());
+    }
+#else
+    std::ignore = handle;
+    std::ignore = buffers;
+    std::ignore = count;
+    MIOPEN_THROW(miopenStatusNotImplemented);
+#endif
+}
+
+ExecutionPlanRecorder::ExecutionPlanRecorder(std::vector<ExecutionPlan::Binding> bindings_)
+    : bindings(std::move(bindings_))
+{
+}
+
+void ExecutionPlanRecorder::Record(const KernelInvoke& invoke,
+                                   const void* args,
+                                   std::size_t size,
+                                   const std::size_t* pointer_offsets,
+                                   std::size_t pointer_count)
+{
+#if MIOPEN_BACKEND_HIP
+    if(invoke.kernel == nullptr)
+    {
+        MarkUnsupported("Launch of " + invoke.GetName() + " without a kernel");
+        return;
+    }
+
+    auto launch = ExecutionPlan::Launch{invoke.kernel, {}, {}};
+
+    const auto bytes = static_cast<const char*>(args);
+    launch.args.assign(bytes, bytes + size);
+
+    // Only the pointer arguments are patch sites, an integer argument may equal a buffer address.
+    for(std::size_t p = 0; p < pointer_count; ++p)
+    {
+        const auto offset = pointer_offsets[p];
+        if(offset + sizeof(std::uintptr_t) > size)
+            MIOPEN_THROW("Pointer argument is out of the argument block of " + invoke.GetName());
+
+        std::uintptr_t value;
+        std::memcpy(&value, bytes + offset, sizeof(value));
+
+        for(std::size_t i = 0; i < bindings.size(); ++i)
+        {
+            const auto begin = reinterpret_cast<std::uintptr_t>(bindings[i].buffer);
+            const auto end   = begin + std::max<std::size_t>(bindings[i].size, 1);
+
+            if(begin != 0 && value >= begin && value < end)
+            {
+                launch.patches.push_back({offset, i, static_cast<std::ptrdiff_t>(value - begin)});
+                break;
+            }
+        }
+    }
+
+    MIOPEN_LOG_I2("Captured " << invoke.GetName() << " with " << launch.patches.size()
+                              << " patch sites");
+    plan.max_args_size = std::max(plan.max_args_size, size);
+    plan.launches.push_back(std::move(launch));
+#else
+    std::ignore = invoke;
+    std::ignore = args;
+    std::ignore = size;
+    std::ignore = pointer_offsets;
+    std::ignore = pointer_count;
+    MarkUnsupported("OpenCL kernel launch");
+#endif
+}
+
+void ExecutionPlanRecorder::MarkUnsupported(const std::string& operation)
+{
+    if(unsupported.empty())
+        unsupported = operation;
+}
+
+ExecutionPlan ExecutionPlanRecorder::Finish()
+{
+    if(!unsupported.empty())
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     unsupported + " can not be captured into an execution plan");
+    }
+
+    plan.binding_count = bindings.size();
+    return std::move(plan);
+}
+
+} // namespace miopen
@@ -0,0 +1,88 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/execution_plan.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+
+extern "C" miopenStatus_t miopenBeginCapture(miopenHandle_t handle,
+                                             size_t numBuffers,
+                                             const void* const* buffers,
+                                             const size_t* sizes)
+{
+    MIOPEN_LOG_FUNCTION(handle, numBuffers, buffers, sizes);
+
+    return miopen::try_([&] {
+        if(numBuffers != 0 && (buffers == nullptr || sizes == nullptr))
+            MIOPEN_THROW(miopenStatusBadParm, "Buffers and sizes should not be nullptr.");
+
+        auto bindings = std::vector<miopen::ExecutionPlan::Binding>{};
+        bindings.reserve(numBuffers);
+        for(std::size_t i = 0; i < numBuffers; ++i)
+            bindings.push_back({buffers[i], sizes[i]});
+
+        miopen::deref(handle).BeginCapture(std::move(bindings));
+    });
+}
+
+extern "C" miopenStatus_t miopenEndCapture(miopenHandle_t handle, miopenExecutionPlan_t* plan)
+{
+    MIOPEN_LOG_FUNCTION(handle, plan);
+
+    return miopen::try_([&] {
+        auto captured       = miopen::deref(handle).EndCapture();
+        miopen::deref(plan) = new miopen::ExecutionPlan(std::move(captured));
+    });
+}
+
+extern "C" miopenStatus_t miopenRunExecutionPlan(miopenHandle_t handle,
+                                                 const miopenExecutionPlan_t plan,
+                                                 size_t numBuffers,
+                                                 void* const* buffers)
+{
+    MIOPEN_LOG_FUNCTION(handle, plan, numBuffers, buffers);
+
+    return miopen::try_([&] {
+        if(numBuffers != 0 && buffers == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Buffers should not be nullptr.");
+
+        miopen::deref(plan).Run(miopen::deref(handle), buffers, numBuffers);
+    });
+}
+
+extern "C" miopenStatus_t miopenGetExecutionPlanLaunchCount(const miopenExecutionPlan_t plan,
+                                                            size_t* count)
+{
+    MIOPEN_LOG_FUNCTION(plan, count);
+    return miopen::try_([&] { miopen::deref(count) = miopen::deref(plan).GetLaunches().size(); });
+}
+
+extern "C" miopenStatus_t miopenDestroyExecutionPlan(miopenExecutionPlan_t plan)
+{
+    MIOPEN_LOG_FUNCTION(plan);
+    return miopen::try_([&] { miopen_destroy_object(plan); });
+}
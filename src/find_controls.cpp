@@ -186,6 +186,7 @@ const char* ToCString(const FindMode::Values mode)
     case FindMode::Values::Hybrid: return "HYBRID";
     case FindMode::Values::DeprecatedFastHybrid: break;
     case FindMode::Values::DynamicHybrid: return "DYNAMIC_HYBRID";
+    case FindMode::Values::AsyncHybrid: return "ASYNC_HYBRID";
     case FindMode::Values::End_: break;
     }
     return "<Unknown>";
@@ -219,6 +220,10 @@ FindMode::Values GetFindModeValueImpl2()
     {
         return FindMode::Values::DynamicHybrid;
     }
+    else if(str == "ASYNC_HYBRID")
+    {
+        return FindMode::Values::AsyncHybrid;
+    }
     else
     { // Nop. Fall down & try numerics.
     }
@@ -259,5 +264,8 @@ static_assert(miopenConvolutionFindModeHybrid ==
 static_assert(miopenConvolutionFindModeDynamicHybrid ==
                   static_cast<miopenConvolutionFindMode_t>(FindMode::Values::DynamicHybrid),
               "API is not in sync with the implementation.");
+static_assert(miopenConvolutionFindModeAsyncHybrid ==
+                  static_cast<miopenConvolutionFindMode_t>(FindMode::Values::AsyncHybrid),
+              "API is not in sync with the implementation.");
 
 } // namespace miopen
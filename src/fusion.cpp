@@ -565,8 +565,7 @@ miopenStatus_t ConvForwardOpDescriptor::SetArgs(OperatorArgs& args,
 {
     float falpha = alpha != nullptr ? *reinterpret_cast<const float*>(alpha) : 1.0f;
     float fbeta  = beta != nullptr ? *reinterpret_cast<const float*>(beta) : 0.0f;
-    auto op_args = std::make_unique<fusion::ConvolutionOpInvokeParam>(falpha, fbeta, w);
-    args.SetArg(GetIdx(), std::move(op_args));
+    args.EmplaceArg<fusion::ConvolutionOpInvokeParam>(GetIdx(), falpha, fbeta, w);
     return miopenStatusSuccess;
 }
 
@@ -579,9 +578,7 @@ miopenStatus_t ActivFwdFusionOpDescriptor::SetArgs(OperatorArgs& args,
                                                    double activBeta,
                                                    double activGamma)
 {
-    auto op_args =
-        std::make_unique<fusion::ActivationOpInvokeParam>(activAlpha, activBeta, activGamma);
-    args.SetArg(GetIdx(), std::move(op_args));
+    args.EmplaceArg<fusion::ActivationOpInvokeParam>(GetIdx(), activAlpha, activBeta, activGamma);
     return miopenStatusSuccess;
 }
 
@@ -601,9 +598,8 @@ miopenStatus_t ActivBwdFusionOpDescriptor::SetArgs(OperatorArgs& args,
                                                    double activBeta,
                                                    double activGamma)
 {
-    auto op_args = std::make_unique<fusion::ActivationBwdOpInvokeParam>(
-        y, x, activAlpha, activBeta, activGamma);
-    args.SetArg(GetIdx(), std::move(op_args));
+    args.EmplaceArg<fusion::ActivationBwdOpInvokeParam>(
+        GetIdx(), y, x, activAlpha, activBeta, activGamma);
     return miopenStatusSuccess;
 }
 
@@ -624,9 +620,8 @@ miopenStatus_t BatchNormInferenceFusionOpDescriptor::SetArgs(OperatorArgs& args,
                                                              ConstData_t estimatedVariance,
                                                              double epsilon) const
 {
-    auto op_args = std::make_unique<fusion::BatchNormInferenceOpInvokeParam>(
-        bnScale, bnBias, estimatedMean, estimatedVariance, epsilon);
-    args.SetArg(GetIdx(), std::move(op_args));
+    args.EmplaceArg<fusion::BatchNormInferenceOpInvokeParam>(
+        GetIdx(), bnScale, bnBias, estimatedMean, estimatedVariance, epsilon);
     return miopenStatusSuccess;
 }
 
@@ -656,15 +651,15 @@ miopenStatus_t BatchNormFwdTrainFusionOpDescriptor::SetArgs(OperatorArgs& args,
                      "Save batch statistics was turned on at op creation time "
                      "but runningMean or runningVariance is set to nullptr");
     }
-    auto op_args = std::make_unique<fusion::BatchNormFwdTrainingOpInvokeParam>(runningMean,
-                                                                               runningVariance,
-                                                                               savedMean,
-                                                                               savedInvVariance,
-                                                                               bnScale,
-                                                                               bnBias,
-                                                                               expAvgFactor,
-                                                                               epsilon);
-    args.SetArg(GetIdx(), std::move(op_args));
+    args.EmplaceArg<fusion::BatchNormFwdTrainingOpInvokeParam>(GetIdx(),
+                                                              runningMean,
+                                                              runningVariance,
+                                                              savedMean,
+                                                              savedInvVariance,
+                                                              bnScale,
+                                                              bnBias,
+                                                              expAvgFactor,
+                                                              epsilon);
     return miopenStatusSuccess;
 }
 
@@ -689,9 +684,8 @@ miopenStatus_t BatchNormBwdTrainFusionOpDescriptor::SetArgs(OperatorArgs& args,
                                                             ConstData_t savedMean,
                                                             ConstData_t savedInvVariance) const
 {
-    auto op_args = std::make_unique<fusion::BatchNormBwdTrainingOpInvokeParam>(
-        x, bnScale, bnBias, resBnScaleDiff, resBnBiasDiff, savedMean, savedInvVariance);
-    args.SetArg(GetIdx(), std::move(op_args));
+    args.EmplaceArg<fusion::BatchNormBwdTrainingOpInvokeParam>(
+        GetIdx(), x, bnScale, bnBias, resBnScaleDiff, resBnBiasDiff, savedMean, savedInvVariance);
     return miopenStatusSuccess;
 }
 miopenStatus_t
@@ -715,8 +709,7 @@ miopenStatus_t BiasFusionOpDescriptor::SetArgs(OperatorArgs& args,
                                                const void* /*beta*/,
                                                ConstData_t bdata)
 {
-    auto op_args = std::make_unique<fusion::BiasOpInvokeParam>(bdata);
-    args.SetArg(GetIdx(), std::move(op_args));
+    args.EmplaceArg<fusion::BiasOpInvokeParam>(GetIdx(), bdata);
     return miopenStatusSuccess;
 }
 
@@ -729,8 +722,7 @@ miopenStatus_t TensorScaleAddOpDescriptor::GetOutputDesc(TensorDescriptor& outpu
 miopenStatus_t
 TensorScaleAddOpDescriptor::SetArgs(OperatorArgs& args, float alpha, ConstData_t tensor_ptr)
 {
-    auto op_args = std::make_unique<fusion::TensorScaleAddOpInvokeParam>(alpha, tensor_ptr);
-    args.SetArg(GetIdx(), std::move(op_args));
+    args.EmplaceArg<fusion::TensorScaleAddOpInvokeParam>(GetIdx(), alpha, tensor_ptr);
     return miopenStatusSuccess;
 }
 
@@ -878,8 +870,40 @@ FindFusion(const ExecutionContext& ctx,
         "fusion");
 }
 
+bool FusionPlanDescriptor::IsSupported(Handle& handle) const
+{
+    const auto ctx = FusionContext{handle};
+    return GetAllFusionSolvers().IsAnySolverApplicable(ctx, FusionDescription{this});
+}
+
+NetworkConfig FusionPlanDescriptor::GetPlanConfig() const
+{
+    const auto network_config = FusionDescription{this}.MakeNetworkConfig();
+    if(!conv_fwd_algo)
+        return network_config;
+    return NetworkConfig{network_config.ToString() + "-algo" +
+                         std::to_string(static_cast<int>(*conv_fwd_algo))};
+}
+
 miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
 {
+    bound.reset();
+
+    // Identical plans, e.g. of the same layer in each rebuild of a graph, share the invokers. When
+    // find is enforced, the usual path is taken to let it do its job.
+    const auto plan_config    = GetPlanConfig();
+    const auto use_plan_cache = !FindEnforce{}.IsSomethingEnforced(ExecutionContext{&handle});
+
+    if(use_plan_cache)
+    {
+        if(auto cached = handle.GetFusionPlanInvokers(plan_config))
+        {
+            MIOPEN_LOG_I2("Fusion plan invokers found in the cache");
+            invokers = std::move(*cached);
+            return miopenStatusSuccess;
+        }
+    }
+
     std::vector<Allocator::ManageDataPtr> invoke_bufs;
     miopen::OperatorArgs params;
 
@@ -915,6 +939,8 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
         return miopenStatusUnsupportedOp;
     }
 
+    if(use_plan_cache)
+        handle.RegisterFusionPlanInvokers(plan_config, invokers);
     return miopenStatusSuccess;
 }
 
@@ -933,8 +959,6 @@ miopenStatus_t FusionPlanDescriptor::Execute(const Handle& handle,
                                              Data_t output,
                                              const OperatorArgs& op_args)
 {
-    miopen::debug::LogCmdFusion(this);
-
     if(output_desc != outputDesc)
     {
         MIOPEN_THROW(miopenStatusBadParm, "The output descriptors dont match.");
@@ -948,11 +972,36 @@ miopenStatus_t FusionPlanDescriptor::Execute(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "The Fusion Plan was not compiled successfully");
     }
 
-    const auto plan_params =
-        fusion::FusionInvokeParams{op_args, inputDesc, input, outputDesc, output, false};
-    invokers[0](handle, plan_params);
+    // Applications keep passing the same arguments object, whose values they update with SetArgs.
+    if(!bound || !bound->IsBoundTo(*this, op_args))
+        bound = std::make_shared<BoundFusionPlan>(*this, op_args);
+    bound->Execute(handle, input, output);
 
     return miopenStatusSuccess;
 }
 
+BoundFusionPlan::BoundFusionPlan(FusionPlanDescriptor& plan_) : BoundFusionPlan(plan_, args)
+{
+}
+
+BoundFusionPlan::BoundFusionPlan(FusionPlanDescriptor& plan_, const OperatorArgs& args_)
+    : plan(plan_),
+      invoker(plan_.invokers.empty() ? Invoker{} : plan_.invokers[0]),
+      params(fusion::FusionInvokeParams{
+          args_, plan_.input_desc, nullptr, plan_.output_desc, nullptr, false}),
+      fusion_params(params.CastTo<fusion::FusionInvokeParams>())
+{
+    if(plan.invokers.empty())
+        MIOPEN_THROW(miopenStatusBadParm, "The Fusion Plan was not compiled successfully");
+}
+
+void BoundFusionPlan::Execute(const Handle& handle, ConstData_t input, Data_t output)
+{
+    miopen::debug::LogCmdFusion(&plan);
+
+    fusion_params.in  = input;
+    fusion_params.out = output;
+    invoker(handle, params);
+}
+
 } // namespace miopen
@@ -0,0 +1,175 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/fusion/planner.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/fusion_plan.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+
+namespace miopen {
+namespace fusion {
+
+namespace {
+
+void CheckNodes(const Graph& graph)
+{
+    for(auto i = 0; i < static_cast<int>(graph.nodes.size()); ++i)
+    {
+        const auto& node = graph.nodes[i];
+        if(!node.op)
+            MIOPEN_THROW(miopenStatusBadParm, "Fusion graph node has no op: " + std::to_string(i));
+        if(node.input < -1 || node.input >= i || node.side_input < -1 || node.side_input >= i)
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "Fusion graph nodes are not in topological order: " + std::to_string(i));
+    }
+}
+
+std::shared_ptr<FusionPlanDescriptor> MakePlan(const Graph& graph,
+                                               const std::vector<TensorDescriptor>& inputs,
+                                               std::vector<int>::const_iterator begin,
+                                               std::vector<int>::const_iterator end)
+{
+    auto plan = std::make_shared<FusionPlanDescriptor>(miopenVerticalFusion, inputs[*begin]);
+    for(auto it = begin; it != end; ++it)
+        plan->AddOp(graph.nodes[*it].op);
+    return plan;
+}
+
+} // namespace
+
+Partition PartitionGraph(const Graph& graph,
+                         const IsPlanSupported& is_supported,
+                         const CompilePlan& compile)
+{
+    CheckNodes(graph);
+
+    const auto node_count = static_cast<int>(graph.nodes.size());
+    auto consumers        = std::vector<int>(node_count, 0);
+    auto next             = std::vector<int>(node_count, -1);
+    auto inputs           = std::vector<TensorDescriptor>(node_count);
+    auto outputs          = std::vector<TensorDescriptor>(node_count);
+
+    for(auto i = 0; i < node_count; ++i)
+    {
+        const auto& node = graph.nodes[i];
+        if(node.input >= 0)
+        {
+            ++consumers[node.input];
+            next[node.input] = i;
+        }
+        if(node.side_input >= 0)
+            ++consumers[node.side_input];
+
+        inputs[i] = node.input >= 0 ? outputs[node.input] : graph.input_desc;
+        node.op->SetInputDesc(inputs[i]);
+        node.op->GetOutputDesc(outputs[i]);
+    }
+
+    // The output of a node may be kept in registers only if the next op of the plan is its only
+    // consumer.
+    const auto can_chain = [&](int i) {
+        return !graph.nodes[i].keep_output && consumers[i] == 1 && next[i] >= 0;
+    };
+
+    Partition partition;
+    auto visited = std::vector<bool>(node_count, false);
+
+    for(auto head = 0; head < node_count; ++head)
+    {
+        if(visited[head])
+            continue;
+
+        auto chain = std::vector<int>{head};
+        while(can_chain(chain.back()))
+            chain.push_back(next[chain.back()]);
+        for(const auto i : chain)
+            visited[i] = true;
+
+        for(auto begin = chain.cbegin(); begin != chain.cend();)
+        {
+            auto end = chain.cend();
+            for(; end - begin >= 2; --end)
+            {
+                const auto plan = MakePlan(graph, inputs, begin, end);
+                if(!is_supported(*plan) || !compile(*plan))
+                    continue;
+                MIOPEN_LOG_I2("Fused nodes " << *begin << ".." << *(end - 1));
+                partition.groups.push_back({{begin, end}, plan});
+                break;
+            }
+
+            if(end - begin < 2)
+            {
+                end = begin + 1;
+                partition.groups.push_back({{*begin}, nullptr});
+                partition.unfused.push_back(*begin);
+            }
+            begin = end;
+        }
+    }
+
+    // Inputs of a chain come from the nodes which end their chains, so finishing the groups in
+    // the order of their last nodes satisfies all the dependencies.
+    std::stable_sort(partition.groups.begin(),
+                     partition.groups.end(),
+                     [](const auto& l, const auto& r) { return l.nodes.back() < r.nodes.back(); });
+    std::sort(partition.unfused.begin(), partition.unfused.end());
+    return partition;
+}
+
+Partition PartitionGraph(Handle& handle, const Graph& graph)
+{
+    const auto is_supported = [&](const FusionPlanDescriptor& plan) {
+        try
+        {
+            return plan.IsSupported(handle);
+        }
+        catch(const Exception& ex)
+        {
+            MIOPEN_LOG_I2(ex.what());
+            return false;
+        }
+    };
+
+    const auto compile = [&](FusionPlanDescriptor& plan) {
+        try
+        {
+            return plan.Compile(handle) == miopenStatusSuccess;
+        }
+        catch(const Exception& ex)
+        {
+            MIOPEN_LOG_W("Compilation of a supported fusion plan failed: " << ex.what());
+            return false;
+        }
+    };
+
+    return PartitionGraph(graph, is_supported, compile);
+}
+
+} // namespace fusion
+} // namespace miopen
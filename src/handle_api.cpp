@@ -27,6 +27,7 @@
 #include <miopen/version.h>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/miopen_internal.h>
 
 extern "C" const char* miopenGetErrorString(miopenStatus_t error)
 {
@@ -114,3 +115,8 @@ extern "C" miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enab
 {
     return miopen::try_([&] { miopen::deref(handle).EnableProfiling(enable); });
 }
+
+extern "C" miopenStatus_t miopenSetHostExecution(miopenHandle_t handle, bool enable)
+{
+    return miopen::try_([&] { miopen::deref(handle).SetHostExecution(enable); });
+}
@@ -28,9 +28,11 @@
 #include <miopen/handle.hpp>
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/conv/async_find.hpp>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle_lock.hpp>
+#include <miopen/hipoc_program_impl.hpp>
 #include <miopen/invoker.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
@@ -274,6 +276,9 @@ struct HandleImpl
     float profiling_result = 0.0;
     int device             = -1;
     Allocator allocator{};
+    CachingAllocator::Ptr caching_allocator;
+    WorkspaceArena workspace;
+    std::unique_ptr<ExecutionPlanRecorder> recorder;
     KernelCache cache;
     TargetProperties target_properties;
 };
@@ -325,7 +330,7 @@ Handle::Handle() : impl(std::make_unique<HandleImpl>())
     MIOPEN_LOG_NQI(*this);
 }
 
-Handle::~Handle() {}
+Handle::~Handle() { conv::ReleaseAsyncFinds(*this); }
 
 // not MT safe
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
@@ -381,10 +386,25 @@ void Handle::SetAllocator(miopenAllocatorFunction allocator,
                           miopenDeallocatorFunction deallocator,
                           void* allocatorContext) const
 {
-    this->impl->allocator.allocator   = allocator == nullptr ? default_allocator : allocator;
-    this->impl->allocator.deallocator = deallocator == nullptr ? default_deallocator : deallocator;
+    if(allocator == nullptr)
+        allocator = default_allocator;
+    if(deallocator == nullptr)
+        deallocator = default_deallocator;
 
-    this->impl->allocator.context = allocatorContext;
+    this->impl->workspace.Release();
+    this->impl->caching_allocator =
+        CachingAllocator::CreateIfEnabled(allocator, deallocator, allocatorContext);
+
+    if(this->impl->caching_allocator)
+        this->impl->allocator = this->impl->caching_allocator->AsAllocator();
+    else
+        this->impl->allocator = Allocator{allocator, deallocator, allocatorContext};
+}
+
+void Handle::SetHostExecution(bool enable)
+{
+    if(enable)
+        MIOPEN_THROW(miopenStatusNotImplemented, "Host execution requires a HIPNOGPU build");
 }
 
 void Handle::EnableProfiling(bool enable) const { this->impl->enable_profiling = enable; }
@@ -395,13 +415,68 @@ Allocator::ManageDataPtr Handle::Create(std::size_t sz) const
 {
     MIOPEN_HANDLE_LOCK
     this->Finish();
+    if(this->impl->caching_allocator)
+        this->impl->caching_allocator->SetStream(this->GetStream());
     return this->impl->allocator(sz);
 }
 
+Data_t Handle::GetWorkspace(std::size_t sz) const
+{
+    MIOPEN_HANDLE_LOCK
+    if(sz > this->impl->workspace.GetCapacity())
+    {
+        this->Finish();
+        if(this->impl->caching_allocator)
+            this->impl->caching_allocator->SetStream(this->GetStream());
+    }
+    return this->impl->workspace.Get(this->impl->allocator, sz);
+}
+
+void Handle::TrimMemory() const
+{
+    MIOPEN_HANDLE_LOCK
+    this->Finish();
+    this->impl->workspace.Release();
+    if(this->impl->caching_allocator)
+        this->impl->caching_allocator->Trim();
+}
+
+bool Handle::IsAllocatorCaching() const { return this->impl->caching_allocator != nullptr; }
+
+CachingAllocator::Statistics Handle::GetAllocatorStatistics() const
+{
+    if(this->impl->caching_allocator)
+        return this->impl->caching_allocator->GetStatistics();
+    return {};
+}
+
+void Handle::BeginCapture(std::vector<ExecutionPlan::Binding> bindings) const
+{
+    if(this->impl->recorder)
+        MIOPEN_THROW(miopenStatusBadParm, "The handle is already capturing");
+    this->impl->recorder = std::make_unique<ExecutionPlanRecorder>(std::move(bindings));
+}
+
+ExecutionPlan Handle::EndCapture() const
+{
+    if(!this->impl->recorder)
+        MIOPEN_THROW(miopenStatusBadParm, "The handle is not capturing");
+    const auto recorder = std::move(this->impl->recorder);
+    return recorder->Finish();
+}
+
+void Handle::MarkCaptureUnsupported(const char* operation) const
+{
+    if(this->impl->recorder)
+        this->impl->recorder->MarkUnsupported(operation);
+}
+
 Allocator::ManageDataPtr&
 Handle::WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t sz) const
 {
     MIOPEN_HANDLE_LOCK
+    if(this->impl->recorder)
+        this->impl->recorder->MarkUnsupported("Buffer write");
     this->Finish();
     auto status = hipMemcpy(ddata.get(), data, sz, hipMemcpyHostToDevice);
     if(status != hipSuccess)
@@ -417,6 +492,8 @@ void Handle::ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size
 void Handle::ReadTo(void* data, ConstData_t ddata, std::size_t sz) const
 {
     MIOPEN_HANDLE_LOCK
+    if(this->impl->recorder)
+        this->impl->recorder->MarkUnsupported("Buffer read");
     this->Finish();
     auto status = hipMemcpy(data, ddata, sz, hipMemcpyDeviceToHost);
     if(status != hipSuccess)
@@ -426,6 +503,8 @@ void Handle::ReadTo(void* data, ConstData_t ddata, std::size_t sz) const
 void Handle::Copy(ConstData_t src, Data_t dest, std::size_t size) const
 {
     MIOPEN_HANDLE_LOCK
+    if(this->impl->recorder)
+        this->impl->recorder->MarkUnsupported("Buffer copy");
     this->impl->set_ctx();
     auto status = hipMemcpy(dest, src, size, hipMemcpyDeviceToDevice);
     if(status != hipSuccess)
@@ -487,13 +566,16 @@ const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
 
-KernelInvoke Handle::Run(Kernel k) const
+KernelInvoke Handle::Run(const Kernel& k) const
 {
     this->impl->set_ctx();
-    if(this->impl->enable_profiling || MIOPEN_GPU_SYNC)
-        return k.Invoke(this->GetStream(), this->impl->elapsed_time_handler());
-    else
-        return k.Invoke(this->GetStream());
+    auto invoke = this->impl->enable_profiling || MIOPEN_GPU_SYNC
+                      ? k.Invoke(this->GetStream(), this->impl->elapsed_time_handler())
+                      : k.Invoke(this->GetStream());
+    invoke.recorder = this->impl->recorder.get();
+    if(invoke.recorder != nullptr)
+        invoke.kernel = std::make_shared<const Kernel>(k);
+    return invoke;
 }
 
 Program Handle::LoadProgram(const std::string& program_name,
@@ -563,6 +645,8 @@ bool Handle::HasProgram(const std::string& program_name, const std::string& para
     return this->impl->cache.HasProgram(program_name, params);
 }
 
+std::size_t Handle::GetProgramLoadCount() const { return this->impl->cache.GetProgramLoadCount(); }
+
 void Handle::AddProgram(Program prog,
                         const std::string& program_name,
                         const std::string& params) const
@@ -575,6 +659,33 @@ void Handle::ClearProgram(const std::string& program_name, const std::string& pa
     this->impl->cache.ClearProgram(program_name, params);
 }
 
+std::string Handle::GetProgramBinary(const std::string& program_name,
+                                     const std::string& params) const
+{
+    auto program = this->impl->cache.GetProgram(program_name, params);
+    if(program.impl == nullptr)
+    {
+        program = this->LoadProgram(program_name, params, "");
+        this->impl->cache.AddProgram(program, program_name, params);
+    }
+    else if(!program.IsCodeObjectInMemory() && program.impl->hsaco_file.empty())
+    {
+        // Code objects built into a file are only kept in the kernel cache, take them from there
+        program = this->LoadProgram(program_name, params, "");
+    }
+    if(program.IsCodeObjectInMemory())
+        return program.GetCodeObjectBlob();
+    return miopen::LoadFile(program.GetCodeObjectPathname());
+}
+
+void Handle::AddProgramBinary(const std::string& program_name,
+                              const std::string& params,
+                              const std::string& binary) const
+{
+    this->impl->set_ctx();
+    this->impl->cache.AddProgram(HIPOCProgram{program_name, binary}, program_name, params);
+}
+
 void Handle::Finish() const
 {
     this->impl->set_ctx();
@@ -682,6 +793,12 @@ std::string Handle::GetDeviceNameImpl() const { return this->impl->get_device_na
 
 std::string Handle::GetDeviceName() const { return this->impl->target_properties.Name(); }
 
+std::string Handle::GetDeviceKey() const
+{
+    // Modules are loaded to the primary context of the device, which all the streams share.
+    return "hip:" + std::to_string(this->impl->device);
+}
+
 const TargetProperties& Handle::GetTargetProperties() const
 {
     return this->impl->target_properties;
@@ -709,6 +826,8 @@ shared<ConstData_t> Handle::CreateSubBuffer(ConstData_t data, std::size_t offset
 
 const rocblas_handle_ptr& Handle::rhandle() const
 {
+    if(this->impl->recorder)
+        this->impl->recorder->MarkUnsupported("rocBLAS call");
     if(meopenHandle_current_stream_id == 0)
         return this->impl->rhandle_;
     // locking only if handle in multistream mode
@@ -26,9 +26,11 @@
 
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/execution_plan.hpp>
 #include <miopen/hipoc_kernel.hpp>
 #include <miopen/handle_lock.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/tracer.hpp>
 
 #include <hip/hip_ext.h>
 #include <hip/hip_runtime.h>
@@ -56,12 +58,25 @@ static std::string DimToFormattedString(const size_t* dims, size_t count)
     return ss.str();
 }
 
-void HIPOCKernelInvoke::run(void* args, std::size_t size) const
+void HIPOCKernelInvoke::run(void* args,
+                            std::size_t size,
+                            const std::size_t* pointer_offsets,
+                            std::size_t pointer_count) const
 {
+    const trace::Scope trace_scope{"launch", trace_name};
     MIOPEN_LOG_I2("kernel_name = "
                   << GetName() << ", global_work_dim = " << DimToFormattedString(gdims.data(), 3)
                   << ", local_work_dim = " << DimToFormattedString(ldims.data(), 3));
 
+    if(recorder != nullptr)
+        recorder->Record(*this, args, size, pointer_offsets, pointer_count);
+
+    if(host_fun)
+    {
+        host_fun(args, size);
+        return;
+    }
+
     HipEventPtr start = nullptr;
     HipEventPtr stop  = nullptr;
     void* config[]    = {// HIP_LAUNCH_PARAM_* are macros that do horrible things
@@ -126,6 +141,6 @@ void HIPOCKernelInvoke::run(void* args, std::size_t size) const
 HIPOCKernelInvoke HIPOCKernel::Invoke(hipStream_t stream,
                                       std::function<void(hipEvent_t, hipEvent_t)> callback) const
 {
-    return HIPOCKernelInvoke{stream, fun, ldims, gdims, name, callback};
+    return HIPOCKernelInvoke{stream, fun, ldims, gdims, name, trace_name, callback};
 }
 } // namespace miopen
@@ -36,11 +36,13 @@
 #include <miopen/stringutils.hpp>
 #include <miopen/target_properties.hpp>
 #include <miopen/temp_file.hpp>
+#include <miopen/tracer.hpp>
 #include <miopen/write_file.hpp>
 #include <miopen/env.hpp>
 #include <miopen/comgr.hpp>
 #include <boost/optional.hpp>
 
+#include <atomic>
 #include <cstring>
 #include <mutex>
 #include <sstream>
@@ -193,12 +195,12 @@ HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name,
 }
 
 HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name, const std::string& blob)
-    : program(program_name) ///, module(CreateModuleInMem(blob))
+    : program(program_name), binary(blob.begin(), blob.end())
 {
     const auto& arch = miopen::GetStringEnv(ENV(MIOPEN_DEVICE_ARCH));
     if(!arch.empty())
         return;
-    module = CreateModuleInMem(blob);
+    module = CreateModuleInMem(binary);
 }
 
 HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name,
@@ -317,6 +319,11 @@ void HIPOCProgramImpl::BuildCodeObjectInMemory(const std::string& params,
 
 void HIPOCProgramImpl::BuildCodeObject(std::string params, const std::string& kernel_src)
 {
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::atomic<std::int64_t> built_count{0};
+    const trace::Scope trace_scope{"compile", program};
+    trace::Counter("compile", "Code objects built", ++built_count);
+
     std::string filename = program;
     const auto src       = [&]() -> std::string {
         if(miopen::EndsWith(filename, ".mlir"))
@@ -0,0 +1,149 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/allocator.hpp>
+#include <miopen/common.hpp>
+#include <miopen/miopen.h>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+/// Sub-allocator which keeps released blocks in size-class bins and hands them out again instead
+/// of returning them to the underlying allocator. It is layered over a pair of
+/// miopenAllocatorFunction/miopenDeallocatorFunction callbacks and exposes the same interface, so
+/// it can be installed into a Handle in place of them, or be driven by host-memory callbacks.
+///
+/// Blocks remember the stream they were allocated on and are only reused on that stream: work
+/// enqueued after the reuse is ordered after the work which used the block before, so no
+/// synchronization is needed. When the underlying allocator fails, all cached blocks are released
+/// and the request is retried once.
+class CachingAllocator
+{
+public:
+    struct Statistics
+    {
+        std::size_t allocations            = 0;
+        std::size_t cache_hits             = 0;
+        std::size_t upstream_allocations   = 0;
+        std::size_t upstream_deallocations = 0;
+        std::size_t trims                  = 0;
+        std::size_t bytes_in_use           = 0;
+        std::size_t bytes_cached           = 0;
+        std::size_t peak_bytes_in_use      = 0;
+        std::size_t peak_bytes_reserved    = 0;
+    };
+
+    struct Detach
+    {
+        void operator()(CachingAllocator* allocator) const;
+    };
+
+    /// The object is owned through Ptr. Releasing the owner trims the cache, blocks still in use
+    /// stay valid and the object is destroyed when the last of them is returned.
+    using Ptr = std::unique_ptr<CachingAllocator, Detach>;
+
+    /// max_cached_bytes limits the amount of memory kept in the bins, 0 means no limit.
+    static Ptr Create(miopenAllocatorFunction allocator,
+                      miopenDeallocatorFunction deallocator,
+                      void* context,
+                      std::size_t max_cached_bytes = 0);
+    /// Returns nullptr unless MIOPEN_CACHING_ALLOCATOR is set. The cache size is limited by
+    /// MIOPEN_CACHING_ALLOCATOR_LIMIT bytes.
+    static Ptr CreateIfEnabled(miopenAllocatorFunction allocator,
+                               miopenDeallocatorFunction deallocator,
+                               void* context);
+
+    static void* Allocate(void* self, std::size_t size);
+    static void Deallocate(void* self, void* mem);
+
+    /// Returns the callbacks routing through this object.
+    Allocator AsAllocator() { return {&Allocate, &Deallocate, this}; }
+
+    /// Sets the stream new blocks are associated with.
+    void SetStream(const void* stream);
+    /// Returns all cached blocks to the underlying allocator.
+    void Trim();
+    Statistics GetStatistics() const;
+
+    /// Sizes are rounded up to one of four classes per power of two, with 256 bytes granularity.
+    static std::size_t GetSizeClass(std::size_t size);
+
+private:
+    struct Block
+    {
+        std::size_t size;
+        const void* stream;
+    };
+
+    using BinKey = std::pair<const void*, std::size_t>;
+
+    CachingAllocator(miopenAllocatorFunction allocator_,
+                     miopenDeallocatorFunction deallocator_,
+                     void* context_,
+                     std::size_t max_cached_bytes_);
+
+    void* AllocateImpl(std::size_t size);
+    bool DeallocateImpl(void* mem);
+    void* AllocateUpstream(std::size_t size);
+    void TrimUnlocked();
+
+    miopenAllocatorFunction upstream_allocator;
+    miopenDeallocatorFunction upstream_deallocator;
+    void* upstream_context;
+    std::size_t max_cached_bytes;
+
+    mutable std::mutex mutex;
+    const void* stream = nullptr;
+    bool detached      = false;
+    std::map<BinKey, std::vector<void*>> bins;
+    std::unordered_map<void*, Block> live;
+    Statistics stats;
+};
+
+/// Scratch buffer owned by a Handle. The buffer grows to the high-water mark of the requested
+/// sizes and is kept between requests, so repeated calls do not allocate.
+class WorkspaceArena
+{
+public:
+    /// The returned pointer is valid until the next call requesting more memory or Release().
+    Data_t Get(const Allocator& allocator, std::size_t size);
+    void Release();
+    std::size_t GetCapacity() const { return capacity; }
+
+private:
+    Allocator::ManageDataPtr buffer;
+    std::size_t capacity = 0;
+};
+
+} // namespace miopen
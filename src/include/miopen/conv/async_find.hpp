@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+namespace miopen {
+
+struct ExecutionContext;
+struct Handle;
+
+namespace conv {
+
+struct ProblemDescription;
+
+/// Runs jobs one by one on a dedicated thread, which is started on the first submission.
+/// Each key is accepted only once per queue lifetime, so a problem that is being searched or
+/// whose search has failed is not queued again on every call.
+class AsyncFindQueue
+{
+public:
+    using Job = std::function<void()>;
+
+    AsyncFindQueue() = default;
+    AsyncFindQueue(const AsyncFindQueue&) = delete;
+    AsyncFindQueue& operator=(const AsyncFindQueue&) = delete;
+    /// Drops the jobs which have not started yet and waits for the running one.
+    ~AsyncFindQueue();
+
+    /// Returns false if a job with the same key has been submitted before.
+    bool Submit(const std::string& key, Job job);
+    /// Blocks until all submitted jobs are finished.
+    void Wait();
+    std::size_t GetPendingCount() const;
+
+private:
+    void Loop();
+
+    mutable std::mutex mutex;
+    std::condition_variable job_added;
+    std::condition_variable job_done;
+    std::deque<Job> jobs;
+    std::unordered_set<std::string> submitted;
+    std::size_t running = 0;
+    bool stopping       = false;
+    std::thread worker;
+};
+
+/// Queues a normal find of the problem to the background worker of the device type, unless it is
+/// already queued. The worker uses a handle and buffers of its own, so the caller's buffers may be
+/// released at once. Results are stored to the user find-db, where the next find picks them up.
+bool QueueAsyncFind(const ExecutionContext& ctx, const ProblemDescription& problem);
+
+/// Blocks until every queued background find is finished.
+void WaitForAsyncFinds();
+
+/// Called when a handle is destroyed. Stops the workers no other handle has queued finds to,
+/// dropping their pending jobs and waiting for the running ones.
+void ReleaseAsyncFinds(const Handle& handle);
+
+} // namespace conv
+} // namespace miopen
@@ -73,6 +73,12 @@ class Model;
 std::vector<uint64_t> PredictSolver(const conv::ProblemDescription& problem,
                                     const ExecutionContext& ctx,
                                     const std::string& device);
+/// Same as PredictSolver() for many problems at once. The problems missing from the cache are
+/// evaluated in a single model call. Unsupported problems get no solvers.
+std::vector<std::vector<uint64_t>>
+PredictSolvers(const std::vector<conv::ProblemDescription>& problems,
+               const ExecutionContext& ctx,
+               const std::string& device);
 } // namespace immed_mode
 
 #endif // MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
@@ -28,6 +28,7 @@
 
 #include <boost/any.hpp>
 #include <miopen/conv_algo_name.hpp>
+#include <miopen/conv/problem_key.hpp>
 #include <miopen/names.hpp>
 
 #include <miopen/problem_description_base.hpp>
@@ -384,6 +385,8 @@ struct ProblemDescription : ProblemDescriptionBase
 
     void HeuristicUpdateLayouts();
 
+    ProblemKey MakeKey() const;
+
     void MakeNetworkConfig(std::string& conf_key) const;
 
     NetworkConfig MakeNetworkConfig() const override
@@ -0,0 +1,134 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/conv_algo_name.hpp>
+#include <miopen/miopen.h>
+#include <miopen/simple_hash.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace miopen {
+namespace conv {
+
+/// Fixed-size identity of a convolution problem: everything its network config and its db key
+/// are made of. It is compared and hashed as plain memory. ProblemDescription formats the text
+/// keys from it, producing exactly what it always has. The invoker cache looks convolutions up by
+/// the key; the dbs and the kernel cache are still keyed by the text.
+struct ProblemKey
+{
+    using Layout = std::array<char, 8>;
+
+    /// Text of the layouts, which a key can only hold if they are short enough
+    struct LayoutNames
+    {
+        std::string_view in;
+        std::string_view weights;
+        std::string_view out;
+    };
+
+    std::uint32_t spatial_dims;
+    std::uint32_t in_channels;
+    std::uint32_t in_depth;
+    std::uint32_t in_height;
+    std::uint32_t in_width;
+    std::uint32_t weights_depth;
+    std::uint32_t weights_height;
+    std::uint32_t weights_width;
+    std::uint32_t out_channels;
+    std::uint32_t out_depth;
+    std::uint32_t out_height;
+    std::uint32_t out_width;
+    std::uint32_t batch_size;
+    std::int32_t pad_d;
+    std::int32_t pad_h;
+    std::int32_t pad_w;
+    std::int32_t stride_d;
+    std::int32_t stride_h;
+    std::int32_t stride_w;
+    std::int32_t dilation_d;
+    std::int32_t dilation_h;
+    std::int32_t dilation_w;
+    std::int32_t group_count;
+    std::int32_t bias;
+    Direction direction;
+    miopenDataType_t in_type;
+    miopenDataType_t weights_type;
+    miopenDataType_t out_type;
+    // no_cast_type if the tensor has none
+    std::int32_t in_cast_type;
+    std::int32_t weights_cast_type;
+    std::int32_t out_cast_type;
+    // Zero-terminated and zero-padded, so that equal layouts have equal bytes. A layout of
+    // 8 characters or more is a zero byte followed by 7 bytes of its hash instead.
+    Layout in_layout;
+    Layout weights_layout;
+    Layout out_layout;
+
+    static constexpr std::int32_t no_cast_type = -1;
+
+    static Layout MakeLayout(std::string_view layout);
+
+    std::uint64_t Hash() const { return Hash64(this, sizeof(*this)); }
+
+    /// Formats the network config, e.g. 576x4x4x1x1x192x4x4x8xNCHWxFP32x0x0x1x1x1x1x1xF.
+    /// The layouts are taken from the names, which must be the ones the key has been made of.
+    void MakeNetworkConfig(std::string& conf_key, const LayoutNames& layouts) const;
+    /// Formats the db key, e.g. 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F
+    void Serialize(std::string& db_key, const LayoutNames& layouts) const;
+    void Serialize(std::ostream& stream, const LayoutNames& layouts) const;
+
+    friend bool operator==(const ProblemKey& l, const ProblemKey& r)
+    {
+        return std::memcmp(&l, &r, sizeof(ProblemKey)) == 0;
+    }
+    friend bool operator!=(const ProblemKey& l, const ProblemKey& r) { return !(l == r); }
+};
+
+static_assert(std::is_trivially_copyable_v<ProblemKey>);
+static_assert(std::has_unique_object_representations_v<ProblemKey>,
+              "ProblemKey is compared and hashed as memory and must not have padding");
+
+} // namespace conv
+} // namespace miopen
+
+namespace std {
+
+template <>
+struct hash<miopen::conv::ProblemKey>
+{
+    std::size_t operator()(const miopen::conv::ProblemKey& key) const { return key.Hash(); }
+};
+
+} // namespace std
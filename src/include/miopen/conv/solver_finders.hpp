@@ -159,8 +159,14 @@ void FindCore(const AnyInvokeParams& invoke_ctx,
 
 namespace conv {
 
+struct ProblemDescription;
+
 bool IsAlgorithmDisabled(miopenConvAlgorithm_t algo);
 
+/// Compiles the kernels the normal find would evaluate for the problems lacking find-db records.
+/// The kernels of all the problems are built on a single thread pool.
+void PrecompileFind(Handle& handle, const std::vector<ProblemDescription>& problems);
+
 struct ConvFindParameters : PrimitiveFindParameters
 {
     bool use_winograd_only;
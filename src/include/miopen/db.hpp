@@ -28,6 +28,7 @@
 
 #include <miopen/db_record.hpp>
 #include <miopen/rank.hpp>
+#include <miopen/tracer.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
 #include <boost/none.hpp>
@@ -341,8 +342,9 @@ private:
     TInnerDb inner;
 
     template <class TFunc>
-    static auto Measure(const std::string& funcName, TFunc&& func)
+    static auto Measure(const char* funcName, TFunc&& func)
     {
+        MIOPEN_TRACE_SCOPE("db", funcName);
         if(!miopen::IsLogging(LoggingLevel::Info2))
             return func();
 
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/miopen.h>
+
+#include <miopen/kernel.hpp>
+#include <miopen/object.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Immutable sequence of kernel launches captured on a handle. Every launch keeps the resolved
+/// kernel, the program it was loaded from and its packed argument block. Pointer arguments
+/// pointing into the buffers bound at capture time are recorded as patch sites, so the plan can
+/// be run on other buffers by rewriting only those pointers. All other pointers, e.g.
+/// workspaces, are baked in and have to stay valid. The plan does not refer to the handle it was
+/// captured on, it may be run on any handle of the same device.
+struct ExecutionPlan : miopenExecutionPlan
+{
+    struct Binding
+    {
+        const void* buffer;
+        std::size_t size;
+    };
+
+    struct Patch
+    {
+        std::size_t offset;
+        std::size_t binding;
+        std::ptrdiff_t delta;
+    };
+
+    struct Launch
+    {
+        std::shared_ptr<const Kernel> kernel;
+        std::vector<char> args;
+        std::vector<Patch> patches;
+    };
+
+    std::size_t GetBindingCount() const { return binding_count; }
+    const std::vector<Launch>& GetLaunches() const { return launches; }
+
+    /// Replays the launches through the handle with buffers[i] substituted for the i-th binding.
+    /// The stream, the profiling and the host execution are the ones of this handle.
+    void Run(const Handle& handle, void* const* buffers, std::size_t count) const;
+
+private:
+    friend class ExecutionPlanRecorder;
+
+    std::size_t binding_count = 0;
+    std::size_t max_args_size = 0;
+    std::vector<Launch> launches;
+};
+
+/// Collects the launches reported by kernel invokes while a handle captures.
+class ExecutionPlanRecorder
+{
+public:
+    explicit ExecutionPlanRecorder(std::vector<ExecutionPlan::Binding> bindings_);
+
+    /// pointer_offsets are the offsets of the pointer arguments in the args block.
+    void Record(const KernelInvoke& invoke,
+                const void* args,
+                std::size_t size,
+                const std::size_t* pointer_offsets,
+                std::size_t pointer_count);
+    /// Operations other than kernel launches can not be replayed and fail the capture.
+    void MarkUnsupported(const std::string& operation);
+    ExecutionPlan Finish();
+
+private:
+    std::vector<ExecutionPlan::Binding> bindings;
+    ExecutionPlan plan;
+    std::string unsupported;
+};
+
+} // namespace miopen
+
+inline std::ostream& operator<<(std::ostream& stream, const miopen::ExecutionPlan& plan)
+{
+    stream << &plan;
+    return stream;
+}
+
+MIOPEN_DEFINE_OBJECT(miopenExecutionPlan, miopen::ExecutionPlan);
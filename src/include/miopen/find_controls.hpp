@@ -118,6 +118,7 @@ public:
         Hybrid,
         DeprecatedFastHybrid,
         DynamicHybrid,
+        AsyncHybrid,
         End_,
         Default_ = MIOPEN_DEFAULT_FIND_MODE,
     };
@@ -159,6 +160,12 @@ public:
         return value == Values::DynamicHybrid && IsEnabled(context);
     }
 
+    template <class Context>
+    bool IsAsyncHybrid(const Context& context) const
+    {
+        return value == Values::AsyncHybrid && IsEnabled(context);
+    }
+
     friend std::ostream& operator<<(std::ostream&, const FindMode&);
 };
 
@@ -32,6 +32,7 @@
 #include <miopen/execution_context.hpp>
 #include <miopen/find_controls.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/perf_db_neighbors.hpp>
 #include <miopen/search_options.hpp>
 #include <miopen/solver_id.hpp>
 #include <miopen/solver.hpp>
@@ -45,6 +46,21 @@ struct AnyInvokeParams;
 
 namespace solver {
 
+/// Takes the config tuned for the nearest perf-db problem which is valid for this one.
+template <class Solver, class Context, class Problem, class PerformanceConfig>
+bool LoadPerfDbNeighbor(const Solver& s,
+                        const Context& context,
+                        const Problem& problem,
+                        PerformanceConfig& config)
+{
+    if(!IsPerfDbNeighborsEnabled())
+        return false;
+
+    const auto neighbors =
+        FindPerfDbNeighbors(context, GetPerfDbFeatures(problem), s.SolverDbId());
+    return ApplyPerfDbNeighbor(s, context, problem, neighbors, config);
+}
+
 template <class Solver, class Context, class Problem, class Db>
 auto FindSolutionImpl(rank<1>,
                       Solver s,
@@ -115,6 +131,11 @@ auto FindSolutionImpl(rank<1>,
             else
             {
                 MIOPEN_LOG_I("Perf Db: record not found for: " << s.SolverDbId());
+                if(!(context.do_search || enforce.IsSearch(context)) &&
+                   LoadPerfDbNeighbor(s, context, problem, config))
+                {
+                    return s.GetSolution(context, problem, config);
+                }
             }
         }
 
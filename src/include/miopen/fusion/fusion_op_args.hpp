@@ -28,6 +28,10 @@
 
 #include <miopen/miopen.h>
 
+#include <memory>
+#include <typeinfo>
+#include <vector>
+
 namespace miopen {
 
 namespace fusion {
@@ -44,6 +48,20 @@ struct OperatorArgs : miopenOperatorArgs
             params.resize(idx + 1);
         params[idx] = std::move(arg);
     }
+
+    /// Updates the param of the same type in place, so setting the arguments of a plan again
+    /// does not allocate. TParam must be complete at the point of instantiation.
+    template <class TParam, class... Args>
+    void EmplaceArg(size_t idx, Args&&... args)
+    {
+        if(params.size() < (idx + 1))
+            params.resize(idx + 1);
+        auto& param = params[idx];
+        if(param != nullptr && typeid(*param) == typeid(TParam))
+            static_cast<TParam&>(*param) = TParam(std::forward<Args>(args)...);
+        else
+            param = std::make_unique<TParam>(std::forward<Args>(args)...);
+    }
 };
 
 } // namespace miopen
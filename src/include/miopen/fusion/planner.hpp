@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/fusion_plan.hpp>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+namespace fusion {
+
+/// An operation of the graph to be partitioned into fusion plans.
+struct GraphNode
+{
+    std::shared_ptr<FusionOpDescriptor> op;
+    /// Node producing the input of the op, -1 for the input of the graph.
+    int input = -1;
+    /// Node producing the second operand of a TensorScaleAdd (residual add), -1 if external.
+    int side_input = -1;
+    /// The output is used outside of the graph, so it has to be written into memory.
+    bool keep_output = false;
+};
+
+/// Forward DAG of operations. Nodes must be in topological order, i.e. every node refers to
+/// preceding nodes only. A linear sequence is a graph where every node consumes the previous one.
+struct Graph
+{
+    TensorDescriptor input_desc;
+    std::vector<GraphNode> nodes;
+};
+
+struct Group
+{
+    /// Nodes of the graph, each one consumes the output of the previous one.
+    std::vector<int> nodes;
+    /// Compiled plan, nullptr if the node shall be executed with the regular API.
+    std::shared_ptr<FusionPlanDescriptor> plan;
+};
+
+struct Partition
+{
+    /// In an order of execution which respects dependencies between groups.
+    std::vector<Group> groups;
+    /// Nodes which have not been fused with anything.
+    std::vector<int> unfused;
+};
+
+/// Returns true if the plan can be compiled. Called for every candidate plan, so should be cheap.
+using IsPlanSupported = std::function<bool(const FusionPlanDescriptor&)>;
+/// Compiles the plan, returns false on failure.
+using CompilePlan = std::function<bool(FusionPlanDescriptor&)>;
+
+/// Splits the graph into chains of operations, whose intermediate results are not used anywhere
+/// else, and greedily partitions every chain into the longest supported plans.
+/// Nodes which do not fit into any plan of two or more operations are left unfused.
+MIOPEN_EXPORT Partition PartitionGraph(const Graph& graph,
+                                       const IsPlanSupported& is_supported,
+                                       const CompilePlan& compile);
+
+/// Uses applicability of the fused solvers to find candidate plans and compiles the chosen ones.
+MIOPEN_EXPORT Partition PartitionGraph(Handle& handle, const Graph& graph);
+
+} // namespace fusion
+} // namespace miopen
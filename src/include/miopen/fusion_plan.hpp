@@ -5,6 +5,7 @@
 #include <miopen/miopen.h>
 #include <miopen/tensor.hpp>
 #include <miopen/fusion.hpp>
+#include <miopen/names.hpp>
 #include <miopen/search_options.hpp>
 
 #include <boost/optional.hpp>
@@ -42,6 +43,7 @@ struct Exec_arg_t
 };
 
 struct FusionContext;
+struct BoundFusionPlan;
 struct FusionPlanDescriptor : miopenFusionPlanDescriptor
 {
     FusionPlanDescriptor() {}
@@ -57,7 +59,11 @@ struct FusionPlanDescriptor : miopenFusionPlanDescriptor
                            const TensorDescriptor& outputDesc,
                            Data_t output,
                            const OperatorArgs& op_args);
+    /// Cheap check whether any of the fused solvers is applicable, does not compile anything.
+    bool IsSupported(Handle& handle) const;
     miopenStatus_t Compile(Handle& handle);
+    /// Key of the plan in the compiled plan cache, equal for identical plans.
+    NetworkConfig GetPlanConfig() const;
     std::vector<struct PerfField>
     Find(Handle& handle,
          const std::function<fusion::FusionInvokeParams()>& invoke_params,
@@ -84,6 +90,38 @@ struct FusionPlanDescriptor : miopenFusionPlanDescriptor
     std::vector<Exec_arg_t> arg_list;
     std::vector<Invoker> invokers;
     std::optional<miopenConvFwdAlgorithm_t> conv_fwd_algo;
+    /// Plan bound to the arguments of the last Execute. It is reused while the plan is executed
+    /// with the same arguments object, and dropped by Compile.
+    std::shared_ptr<BoundFusionPlan> bound;
+};
+
+/// Compiled plan bound to the resolved invoker and to its arguments. The arguments are set with
+/// SetArgs of the ops, which update them in place, and Execute only patches the buffer pointers,
+/// so repeated execution does not allocate on the host. FusionPlanDescriptor::Execute runs
+/// through a bound plan as well.
+struct BoundFusionPlan
+{
+    /// Bound to arguments of its own, which are set into GetArgs().
+    explicit BoundFusionPlan(FusionPlanDescriptor& plan_);
+    /// Bound to the arguments of the caller, which have to outlive it.
+    BoundFusionPlan(FusionPlanDescriptor& plan_, const OperatorArgs& args_);
+    BoundFusionPlan(const BoundFusionPlan&) = delete;
+    BoundFusionPlan& operator=(const BoundFusionPlan&) = delete;
+
+    OperatorArgs& GetArgs() { return args; }
+    bool IsBoundTo(const FusionPlanDescriptor& plan_, const OperatorArgs& args_) const
+    {
+        return &plan_ == &plan && &args_ == &fusion_params.op_args;
+    }
+    void Execute(const Handle& handle, ConstData_t input, Data_t output);
+
+private:
+    FusionPlanDescriptor& plan;
+    OperatorArgs args;
+    Invoker invoker;
+    // Type-erased once, the conversion copies the descriptors.
+    AnyInvokeParams params;
+    fusion::FusionInvokeParams& fusion_params;
 };
 
 } // namespace miopen
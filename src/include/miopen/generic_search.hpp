@@ -36,6 +36,7 @@
 #include <miopen/invoke_params.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/timer.hpp>
+#include <miopen/tracer.hpp>
 #include <miopen/type_traits.hpp>
 #include <miopen/mt_queue.hpp>
 #include <miopen/generic_search_controls.hpp>
@@ -372,6 +373,7 @@ auto GenericSearch(const Solver s,
           HasMember<RunAndMeasure_t, Solver, Data_t, ConstData_t>{}),
         "RunAndMeasure is obsolete. Solvers should implement auto-tune evaluation in invoker");
 
+    const trace::Scope trace_scope{"tuning", s.SolverDbId()};
     auto context                  = context_;
     context.is_for_generic_search = true;
 
@@ -29,12 +29,14 @@
 #include <miopen/config.h>
 #include <miopen/kernel_info.hpp>
 #include <miopen/common.hpp>
+#include <miopen/execution_plan.hpp>
 #include <miopen/invoker_cache.hpp>
 #include <miopen/kernel.hpp>
 #include <miopen/miopen.h>
 #include <miopen/names.hpp>
 #include <miopen/object.hpp>
 #include <miopen/allocator.hpp>
+#include <miopen/caching_allocator.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/solver_id.hpp>
 #include <miopen/stringutils.hpp>
@@ -91,6 +93,10 @@ struct MIOPEN_EXPORT Handle : miopenHandle
                       miopenDeallocatorFunction deallocator,
                       void* allocatorContext) const;
 
+    /// Runs kernels on the host on HIPNOGPU builds, see MIOPEN_NOGPU_HOST_EXECUTION. Kernels and
+    /// invokers prepared before the call are dropped. Other backends only accept false.
+    void SetHostExecution(bool enable);
+
     void EnableProfiling(bool enable = true) const;
 
     void ResetKernelTime() const;
@@ -127,7 +133,7 @@ struct MIOPEN_EXPORT Handle : miopenHandle
         return this->Run(ks.front());
     }
 
-    KernelInvoke Run(Kernel k) const;
+    KernelInvoke Run(const Kernel& k) const;
     const std::vector<Kernel>& GetKernelsImpl(const std::string& algorithm,
                                               const std::string& network_config) const;
 
@@ -148,6 +154,14 @@ struct MIOPEN_EXPORT Handle : miopenHandle
     bool HasProgram(const std::string& program_name, const std::string& params) const;
     void ClearProgram(const std::string& program_name, const std::string& params) const;
     void AddProgram(Program prog, const std::string& program_name, const std::string& params) const;
+    /// Code object of the program, loading it the same way as LoadProgram if not yet cached.
+    std::string GetProgramBinary(const std::string& program_name, const std::string& params) const;
+    /// Caches the program created from the code object, without compiling or looking it up.
+    void AddProgramBinary(const std::string& program_name,
+                          const std::string& params,
+                          const std::string& binary) const;
+    /// Number of programs loaded from the kernel cache or compiled to build kernels on the handle.
+    std::size_t GetProgramLoadCount() const;
 
     void Finish() const;
     void Flush() const;
@@ -169,6 +183,9 @@ struct MIOPEN_EXPORT Handle : miopenHandle
 
     std::string GetDeviceName() const;
     const TargetProperties& GetTargetProperties() const;
+    /// Equal for the handles which can run the kernels loaded by each other: the device ordinal on
+    /// HIP, the context on OpenCL and the execution mode on HIPNOGPU.
+    std::string GetDeviceKey() const;
 
 private:
     std::string GetDeviceNameImpl() const;
@@ -178,6 +195,22 @@ public:
     void Copy(ConstData_t src, Data_t dest, std::size_t size) const;
 
     Allocator::ManageDataPtr Create(std::size_t sz) const;
+    /// Returns a scratch buffer of at least sz bytes owned by the handle. The buffer is kept at
+    /// the high-water mark of the requests, its contents are valid until the next call.
+    Data_t GetWorkspace(std::size_t sz) const;
+    /// Releases the workspace and the blocks cached by the caching allocator.
+    void TrimMemory() const;
+    /// True if MIOPEN_CACHING_ALLOCATOR is set and allocations go through CachingAllocator.
+    bool IsAllocatorCaching() const;
+    CachingAllocator::Statistics GetAllocatorStatistics() const;
+
+    /// Records the kernels launched on the handle until EndCapture() into an execution plan.
+    /// Kernels still run while captured. Operations other than kernel launches fail the capture.
+    void BeginCapture(std::vector<ExecutionPlan::Binding> bindings) const;
+    ExecutionPlan EndCapture() const;
+    /// Fails the capture, if any, for operations issued on the stream without going through
+    /// Run(), e.g. composable kernel launches or memory copies made with the HIP API directly.
+    void MarkCaptureUnsupported(const char* operation) const;
     Allocator::ManageDataPtr&
     WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t sz) const;
     void ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size_t sz) const;
@@ -256,19 +289,50 @@ public:
         {
             MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and solver "
                                                               << solver->ToString());
-            return invokers[std::make_pair(config.ToString(), solver->ToString())];
+            return invokers.Get(config, solver->ToString());
         }
         MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and algorithm "
                                                           << algo->ToString());
         return invokers.GetFound1_0(config, *algo);
     }
 
+    boost::optional<const Invoker&>
+    GetInvoker(const conv::ProblemDescription& problem,
+               const boost::optional<solver::Id>& solver,
+               const boost::optional<AlgorithmName>& algo = boost::none) const
+    {
+        assert(solver || algo);
+        assert(!(solver && algo));
+        if(solver)
+        {
+            MIOPEN_LOG_I2("Returning an invoker for a convolution and solver "
+                          << solver->ToString());
+            return invokers.Get(problem, solver->ToString());
+        }
+        MIOPEN_LOG_I2("Returning an invoker for a convolution and algorithm " << algo->ToString());
+        return invokers.GetFound1_0(problem, *algo);
+    }
+
     boost::optional<const std::string&> GetFound1_0SolverId(const NetworkConfig& config,
                                                             const AlgorithmName& algo) const
     {
         return invokers.GetFound1_0SolverId(config, algo);
     }
 
+    /// Compiled fusion plans are shared by all the handles with the same device key.
+    boost::optional<std::vector<Invoker>> GetFusionPlanInvokers(const NetworkConfig& config) const
+    {
+        return FusionPlanCache::Instance().Get(GetDeviceKey(), config);
+    }
+
+    void RegisterFusionPlanInvokers(const NetworkConfig& config,
+                                    const std::vector<Invoker>& plan_invokers)
+    {
+        FusionPlanCache::Instance().Register(GetDeviceKey(), config, plan_invokers);
+    }
+
+    std::uint64_t GetInvokerCacheId() const { return invokers.GetId(); }
+
 #if MIOPEN_USE_ROCBLAS
     const rocblas_handle_ptr& rhandle() const;
 
@@ -30,14 +30,19 @@
 #include <miopen/hipoc_program.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/op_kernel_args.hpp>
+#include <miopen/tracer.hpp>
 
 #include <array>
 #include <cassert>
 #include <cstring>
+#include <memory>
+#include <type_traits>
 #include <vector>
 
 namespace miopen {
 
+class ExecutionPlanRecorder;
+
 using HipEventPtr = MIOPEN_MANAGE_PTR(hipEvent_t, hipEventDestroy);
 inline HipEventPtr make_hip_event()
 {
@@ -106,8 +111,31 @@ struct KernelArgs
     KernelArgs(Ts... xs) : pack(xs...) { std::fill(std::begin(hidden), std::end(hidden), 0); }
     KernelArgsPack<Ts...> pack;
     uint64_t hidden[6] = {};
+
+    /// Offsets of the pointer arguments in the pack, each argument being placed at the first
+    /// offset aligned for it after the previous one.
+    static constexpr auto PointerOffsets()
+    {
+        constexpr std::size_t sizes[]  = {sizeof(Ts)..., 0};
+        constexpr std::size_t aligns[] = {alignof(Ts)..., 1};
+        constexpr bool pointers[]      = {std::is_pointer<Ts>{}..., false};
+
+        auto ret    = std::array<std::size_t, (std::size_t{0} + ... + std::is_pointer<Ts>{})>{};
+        auto offset = std::size_t{0};
+        auto found  = std::size_t{0};
+        for(std::size_t i = 0; i < sizeof...(Ts); ++i)
+        {
+            offset = (offset + aligns[i] - 1) / aligns[i] * aligns[i];
+            if(pointers[i])
+                ret[found++] = offset;
+            offset += sizes[i];
+        }
+        return ret;
+    }
 };
 
+struct HIPOCKernel;
+
 struct HIPOCKernelInvoke
 {
     hipStream_t stream          = nullptr;
@@ -115,7 +143,17 @@ struct HIPOCKernelInvoke
     std::array<size_t, 3> ldims = {};
     std::array<size_t, 3> gdims = {};
     std::string name;
+    // Interned name, so that tracing a launch only stores a pointer.
+    const char* trace_name = "";
     std::function<void(hipEvent_t, hipEvent_t)> callback;
+    // Set by the HIPNOGPU handle when kernels are executed on the host. Receives the packed
+    // argument block instead of launching the kernel on a device.
+    std::function<void(const void*, std::size_t)> host_fun;
+    // Set by the handle while an execution plan is captured. Every launch is reported to it.
+    ExecutionPlanRecorder* recorder = nullptr;
+    // Set along with the recorder. The plan keeps the kernel, which keeps the module of fun
+    // loaded, and replays it through the handle the plan is run on.
+    std::shared_ptr<const HIPOCKernel> kernel;
 
     // Workaround for aggregate types in c++11
     HIPOCKernelInvoke() {}
@@ -124,8 +162,15 @@ struct HIPOCKernelInvoke
                       std::array<size_t, 3> pldims,
                       std::array<size_t, 3> pgdims,
                       std::string pname,
+                      const char* ptrace_name,
                       std::function<void(hipEvent_t, hipEvent_t)> pcallback)
-        : stream(pstream), fun(pfun), ldims(pldims), gdims(pgdims), name(pname), callback(pcallback)
+        : stream(pstream),
+          fun(pfun),
+          ldims(pldims),
+          gdims(pgdims),
+          name(pname),
+          trace_name(ptrace_name),
+          callback(pcallback)
     {
     }
     void operator()(std::vector<OpKernelArg>& any_args) const
@@ -133,6 +178,11 @@ struct HIPOCKernelInvoke
         char hip_args[256] = {0};
         auto sz_left       = any_args[0].size();
 
+        std::size_t pointer_offsets[sizeof(hip_args) / sizeof(void*)];
+        std::size_t pointer_count = 0;
+        if(any_args[0].is_ptr)
+            pointer_offsets[pointer_count++] = 0;
+
         memcpy(hip_args, &(any_args[0].buffer[0]), any_args[0].size());
         //        copy_arg(any_args[0], hip_args, 0);
 
@@ -144,19 +194,27 @@ struct HIPOCKernelInvoke
             std::size_t second_index = sz_left + padding;
             memcpy(hip_args + second_index, &(any_arg.buffer[0]), any_arg.size());
             // copy_arg(any_arg, hip_args, second_index);
+            if(any_arg.is_ptr)
+                pointer_offsets[pointer_count++] = second_index;
             sz_left = second_index + alignment;
         }
-        run(hip_args, sz_left);
+        run(hip_args, sz_left, pointer_offsets, pointer_count);
     }
 
     template <class... Ts>
     void operator()(Ts... xs) const
     {
+        static constexpr auto pointer_offsets = KernelArgs<Ts...>::PointerOffsets();
         KernelArgs<Ts...> args{xs...};
-        run(&args, sizeof(args));
+        run(&args, sizeof(args), pointer_offsets.data(), pointer_offsets.size());
     }
 
-    void run(void* args, std::size_t size) const;
+    /// pointer_offsets lists where the pointer arguments are in the packed block, for the
+    /// execution plan recorder.
+    void run(void* args,
+             std::size_t size,
+             const std::size_t* pointer_offsets = nullptr,
+             std::size_t pointer_count          = 0) const;
 
     const std::string& GetName() const { return name; }
 };
@@ -165,18 +223,26 @@ struct HIPOCKernel
 {
     HIPOCProgram program;
     std::string name;
+    // Interned once here instead of on every traced launch.
+    const char* trace_name = "";
     std::array<size_t, 3> ldims = {};
     std::array<size_t, 3> gdims = {};
     std::string kernel_module;
     hipFunction_t fun = nullptr;
+    // Build options of a kernel executed on the host by the HIPNOGPU handle, where there is no
+    // program to compile them into.
+    std::string host_params;
 
     HIPOCKernel() {}
-    HIPOCKernel(HIPOCProgram p, const std::string kernel_name) : program(p), name(kernel_name) {}
+    HIPOCKernel(HIPOCProgram p, const std::string kernel_name)
+        : program(p), name(kernel_name), trace_name(trace::Intern(name))
+    {
+    }
     HIPOCKernel(HIPOCProgram p,
                 const std::string kernel_name,
                 std::vector<size_t> local_dims,
                 std::vector<size_t> global_dims)
-        : program(p), name(kernel_name)
+        : program(p), name(kernel_name), trace_name(trace::Intern(name))
     {
         assert(!local_dims.empty() && local_dims.size() <= 3);
         assert(!global_dims.empty() && global_dims.size() <= 3);
@@ -26,34 +26,62 @@
 
 #pragma once
 
+#include <miopen/conv/problem_key.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/invoker.hpp>
+#include <miopen/names.hpp>
 
 #include <boost/optional.hpp>
 
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace miopen {
 
+namespace conv {
+struct ProblemDescription;
+} // namespace conv
+
 class InvokerCache
 {
 public:
     // network_config, solver_id
-    using Key = std::pair<std::string, std::string>;
+    using Key = std::pair<NetworkConfig, std::string>;
+
+    InvokerCache();
+    // The binary key index points into the cache, which is why it cannot be copied.
+    InvokerCache(const InvokerCache&) = delete;
+    InvokerCache(InvokerCache&&)      = default;
+    InvokerCache& operator=(const InvokerCache&) = delete;
+    InvokerCache& operator=(InvokerCache&&) = default;
+
+    // Unique within the process, unlike the address of the cache which may be reused once the
+    // owning handle is destroyed.
+    std::uint64_t GetId() const { return id; }
 
-    boost::optional<const Invoker&> operator[](const Key& key) const;
+    boost::optional<const Invoker&> Get(const NetworkConfig& network_config,
+                                        const std::string& solver_id) const;
     // For find 1.0
-    boost::optional<const Invoker&> GetFound1_0(const std::string& network_config,
+    boost::optional<const Invoker&> GetFound1_0(const NetworkConfig& network_config,
                                                 const std::string& algorithm) const;
-    boost::optional<const std::string&> GetFound1_0SolverId(const std::string& network_config,
+    boost::optional<const std::string&> GetFound1_0SolverId(const NetworkConfig& network_config,
                                                             const std::string& algorithm) const;
+    // Convolutions are looked up by their binary key, so that the network config of a problem
+    // is only formatted the first time its invokers are asked for.
+    boost::optional<const Invoker&> Get(const conv::ProblemDescription& problem,
+                                        const std::string& solver_id) const;
+    boost::optional<const Invoker&> GetFound1_0(const conv::ProblemDescription& problem,
+                                                const std::string& algorithm) const;
 
     void Register(const Key& key, const Invoker& invoker);
     // For find 1.0
-    void SetAsFound1_0(const std::string& network_config,
+    void SetAsFound1_0(const NetworkConfig& network_config,
                        const std::string& algorithm,
                        const std::string& solver_id);
 
@@ -67,8 +95,35 @@ private:
         std::map<std::string, Invoker> invokers;
     };
 
-    // network_config -> Item
-    std::map<std::string, Item> invokers;
+    const Item* FindItem(const conv::ProblemDescription& problem) const;
+
+    std::uint64_t id;
+    // network_config -> Item, hashed by the hash precomputed in the config
+    std::unordered_map<NetworkConfig, Item> invokers;
+    // Items of the convolutions which have been looked up by their key. Items are never erased
+    // and nodes of an unordered_map do not move, so the pointers stay valid.
+    mutable std::unordered_map<conv::ProblemKey, const Item*> conv_items;
+};
+
+// Invokers of compiled fusion plans, shared by all the plans with the same description. Unlike
+// the invoker cache, it is shared by all the handles of the process and may be used from multiple
+// threads. Plans are kept apart by the device key of the handle, see Handle::GetDeviceKey(), as
+// kernels can only be run on the device they have been loaded to.
+class FusionPlanCache
+{
+public:
+    static FusionPlanCache& Instance();
+
+    boost::optional<std::vector<Invoker>> Get(const std::string& device_key,
+                                              const NetworkConfig& plan_config) const;
+    void Register(const std::string& device_key,
+                  const NetworkConfig& plan_config,
+                  const std::vector<Invoker>& plan_invokers);
+
+private:
+    mutable std::mutex mutex;
+    // device key -> plan config -> invokers of the plan
+    std::unordered_map<std::string, std::unordered_map<NetworkConfig, std::vector<Invoker>>> plans;
 };
 
 } // namespace miopen
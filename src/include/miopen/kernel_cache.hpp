@@ -86,12 +86,16 @@ public:
     void ClearProgram(const std::string& name, const std::string& params);
 
     void AddProgram(Program prog, const std::string& program_name, std::string params);
+    Program GetProgram(const std::string& name, const std::string& params) const;
+    /// Number of programs AddKernel had to load or compile since they were not cached.
+    std::size_t GetProgramLoadCount() const { return program_loads; }
 
     KernelCache();
 
 private:
     KernelMap kernel_map;
     ProgramMap program_map;
+    std::size_t program_loads = 0;
 };
 
 } // namespace miopen
@@ -0,0 +1,91 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/solver_id.hpp>
+#include <miopen/tensor.hpp>
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct ExecutionContext;
+
+namespace conv {
+struct ProblemDescription;
+} // namespace conv
+
+/// An op of a chain where every op consumes the output of the previous one.
+struct LayoutPlanStep
+{
+    /// Layouts the op runs in without transposing its tensors, e.g. "NCHW" and "NHWC". Input and
+    /// output of the op share the layout. Empty for layout agnostic ops, such as activations.
+    std::vector<std::string> native_layouts;
+    std::size_t input_bytes  = 0;
+    std::size_t output_bytes = 0;
+
+    LayoutPlanStep() = default;
+    LayoutPlanStep(std::vector<std::string> native_layouts_,
+                   std::size_t input_bytes_,
+                   std::size_t output_bytes_);
+    LayoutPlanStep(std::vector<std::string> native_layouts_,
+                   const TensorDescriptor& input,
+                   const TensorDescriptor& output);
+    /// Step of a forward or backward data convolution run by the solver picked by Find. The
+    /// native layouts are the ones among the default and the channels last layouts, in which the
+    /// solver is applicable and needs the least workspace.
+    LayoutPlanStep(const ExecutionContext& ctx,
+                   const conv::ProblemDescription& problem,
+                   const solver::Id& solver_id);
+};
+
+struct LayoutPlan
+{
+    /// Layouts of the tensors of the chain: the input of the first op, the output of every op.
+    std::vector<std::string> tensor_layouts;
+    /// Layout every op is executed in. Tensors not in this layout are transposed by the op.
+    std::vector<std::string> op_layouts;
+    /// Transpose traffic, reads and writes, when intermediate tensors keep the network layout.
+    std::size_t bytes_before = 0;
+    /// Transpose traffic of the plan.
+    std::size_t bytes_after = 0;
+
+    /// Descriptor of the tensor with the given index with the strides of the planned layout, to
+    /// be used when the tensor is allocated.
+    TensorDescriptor GetTensorDescriptor(std::size_t tensor, const TensorDescriptor& desc) const;
+
+    friend std::ostream& operator<<(std::ostream& stream, const LayoutPlan& plan);
+};
+
+/// Picks layouts of the intermediate tensors of the chain to minimize the total amount of bytes
+/// moved by transposes. The input of the chain and its output are kept in the given layouts.
+MIOPEN_EXPORT LayoutPlan PlanLayouts(const std::vector<LayoutPlanStep>& steps,
+                                     const std::string& input_layout,
+                                     const std::string& output_layout);
+
+} // namespace miopen
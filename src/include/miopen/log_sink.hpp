@@ -0,0 +1,124 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_LOG_SINK_HPP
+#define GUARD_MIOPEN_LOG_SINK_HPP
+
+#include <miopen/logger.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace log_sink {
+
+/// Asynchronous log sink. With MIOPEN_LOG_ASYNC, log lines are pushed into a lock-free ring of
+/// the logging thread and a background thread adds their prefixes and writes them in batches,
+/// instead of every thread formatting the prefix and writing into stderr on its own.
+/// MIOPEN_LOG_BINARY_FILE=<path> makes the background thread write the binary records below into
+/// the file instead; utils/miopen_log_decode.py turns them back into text.
+
+struct Record
+{
+    std::uint64_t timestamp_ns = 0; // Since the epoch
+    std::int32_t thread_id     = 0;
+    LoggingLevel level         = LoggingLevel::Default;
+    std::string message;
+};
+
+/// Single producer (the owning thread), single consumer (the writer) ring of records.
+class Ring
+{
+public:
+    explicit Ring(std::size_t capacity_pow2);
+
+    bool TryPush(Record&& record);
+    /// Called by the producer when it will push no more.
+    void Close() { closed.store(true, std::memory_order_release); }
+    bool IsClosed() const { return closed.load(std::memory_order_acquire); }
+
+    template <class TConsumer>
+    std::size_t PopAll(TConsumer&& consumer)
+    {
+        auto head       = read.load(std::memory_order_relaxed);
+        const auto tail = write.load(std::memory_order_acquire);
+        const auto size = tail - head;
+        for(; head != tail; ++head)
+            consumer(std::move(records[head & mask]));
+        read.store(head, std::memory_order_release);
+        return size;
+    }
+
+private:
+    std::vector<Record> records;
+    std::size_t mask;
+    std::atomic<std::size_t> read{0};
+    std::atomic<std::size_t> write{0};
+    std::atomic<bool> closed{false};
+};
+
+/// File starts with the magic, followed by the records: timestamp_ns (u64), thread_id (i32),
+/// level (u8), message size (u32) and the message, integers are little endian.
+constexpr const char binary_magic[] = "MIOPENLOG1";
+
+MIOPEN_EXPORT void WriteBinaryHeader(std::ostream& stream);
+MIOPEN_EXPORT void WriteBinary(std::ostream& stream, const Record& record);
+MIOPEN_EXPORT bool ReadBinaryHeader(std::istream& stream);
+MIOPEN_EXPORT bool ReadBinary(std::istream& stream, Record& record);
+
+/// Rate limiting (at most rate_limit messages a second, 0 for no limit) and sampling (one message
+/// of every sampling, 0 or 1 to keep all) of messages. Lock-free, the limit may be slightly
+/// exceeded at the turn of a second.
+class MIOPEN_EXPORT Admission
+{
+public:
+    Admission(std::uint64_t rate_limit_, std::uint64_t sampling_);
+
+    bool Admit(std::uint64_t timestamp_ns);
+
+    /// Returns the number of messages rejected since the previous call.
+    std::uint64_t TakeDropped()
+    {
+        if(dropped.load(std::memory_order_relaxed) == 0)
+            return 0;
+        return dropped.exchange(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::uint64_t rate_limit;
+    std::uint64_t sampling;
+    std::atomic<std::uint64_t> sampled{0};
+    std::atomic<std::uint64_t> second{0};
+    std::atomic<std::uint64_t> in_second{0};
+    std::atomic<std::uint64_t> dropped{0};
+};
+
+} // namespace log_sink
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_LOG_SINK_HPP
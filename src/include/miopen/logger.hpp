@@ -38,6 +38,8 @@
 #include <miopen/object.hpp>
 #include <miopen/config.h>
 #include <miopen/export.h>
+#include <miopen/tracer.hpp>
+#include <miopen/workload_capture.hpp>
 
 #if MIOPEN_USE_ROCTRACER
 #include <roctracer/roctx.h>
@@ -220,6 +222,17 @@ MIOPEN_EXPORT extern bool
 
 MIOPEN_EXPORT const char* LoggingLevelToCString(LoggingLevel level);
 MIOPEN_EXPORT std::string LoggingPrefix();
+/// Prefix of a line logged by the given thread time_diff_ms after the previous one.
+std::string LoggingPrefix(int thread_id, float time_diff_ms);
+/// \return value which uniquely identifies current process/thread in the log.
+int LoggingThreadId();
+
+/// Writes message as a separate log line. The prefix is added here, either immediately or by the
+/// asynchronous sink (see log_sink.hpp).
+MIOPEN_EXPORT void LogMessage(LoggingLevel level, std::string message);
+/// \return false if a message of the given level shall be skipped due to MIOPEN_LOG_RATE_LIMIT or
+/// MIOPEN_LOG_SAMPLING. Expected to be called before formatting, which is the expensive part.
+MIOPEN_EXPORT bool IsLogAdmitted(LoggingLevel level);
 
 /// \return true if level is enabled.
 /// \param level - one of the values defined in LoggingLevel.
@@ -291,16 +304,15 @@ LogParam(std::ostream& os, std::string name, const std::vector<T>& vec, bool ind
     return os;
 }
 
-#define MIOPEN_LOG_FUNCTION_EACH(param)                                         \
-    do                                                                          \
-    {                                                                           \
-        /* Clear temp stringstream & reset its state: */                        \
-        std::ostringstream().swap(miopen_log_func_ss);                          \
-        /* Use stringstram as ostream to engage existing template functions: */ \
-        std::ostream& miopen_log_func_ostream = miopen_log_func_ss;             \
-        miopen_log_func_ostream << miopen::LoggingPrefix();                     \
-        miopen::LogParam(miopen_log_func_ostream, #param, param) << std::endl;  \
-        std::cerr << miopen_log_func_ss.str();                                  \
+#define MIOPEN_LOG_FUNCTION_EACH(param)                                           \
+    do                                                                            \
+    {                                                                             \
+        /* Clear temp stringstream & reset its state: */                          \
+        std::ostringstream().swap(miopen_log_func_ss);                            \
+        /* Use stringstram as ostream to engage existing template functions: */   \
+        std::ostream& miopen_log_func_ostream = miopen_log_func_ss;               \
+        miopen::LogParam(miopen_log_func_ostream, #param, param);                 \
+        miopen::LogMessage(miopen::LoggingLevel::Info, miopen_log_func_ss.str()); \
     } while(false);
 
 #define MIOPEN_LOG_FUNCTION_EACH_ROCTX(param)                                     \
@@ -327,24 +339,26 @@ LogParam(std::ostream& os, std::string name, const std::vector<T>& vec, bool ind
 #endif
 
 #define MIOPEN_LOG_FUNCTION(...)                                                        \
+    MIOPEN_TRACE_FUNCTION("api");                                                       \
+    const miopen::capture::ApiScope miopen_capture_scope;                               \
     MIOPEN_LOG_ROCTX_DEFINE_OBJECT                                                      \
     do                                                                                  \
     {                                                                                   \
-        if(miopen::IsLoggingFunctionCalls())                                            \
+        if(miopen::IsLoggingFunctionCalls() &&                                          \
+           miopen::IsLogAdmitted(miopen::LoggingLevel::Info))                           \
         {                                                                               \
             std::ostringstream miopen_log_func_ss;                                      \
-            miopen_log_func_ss << miopen::LoggingPrefix() << __PRETTY_FUNCTION__ << "{" \
-                               << std::endl;                                            \
-            std::cerr << miopen_log_func_ss.str();                                      \
+            miopen::LogMessage(miopen::LoggingLevel::Info,                              \
+                               std::string{__PRETTY_FUNCTION__} + "{");                 \
             MIOPEN_PP_EACH_ARGS(MIOPEN_LOG_FUNCTION_EACH, __VA_ARGS__)                  \
-            std::ostringstream().swap(miopen_log_func_ss);                              \
-            miopen_log_func_ss << miopen::LoggingPrefix() << "}" << std::endl;          \
-            std::cerr << miopen_log_func_ss.str();                                      \
+            miopen::LogMessage(miopen::LoggingLevel::Info, "}");                        \
         }                                                                               \
         MIOPEN_LOG_ROCTX_DO_LOGGING(__VA_ARGS__)                                        \
     } while(false)
 #else
-#define MIOPEN_LOG_FUNCTION(...)
+#define MIOPEN_LOG_FUNCTION(...)  \
+    MIOPEN_TRACE_FUNCTION("api"); \
+    const miopen::capture::ApiScope miopen_capture_scope
 #endif
 
 MIOPEN_EXPORT
@@ -356,12 +370,11 @@ std::string LoggingParseFunction(const char* func, const char* pretty_func);
 #define MIOPEN_LOG_XQ_CUSTOM(level, disableQuieting, category, fn_name, ...)                \
     do                                                                                      \
     {                                                                                       \
-        if(miopen::IsLogging(level, disableQuieting))                                       \
+        if(miopen::IsLogging(level, disableQuieting) && miopen::IsLogAdmitted(level))       \
         {                                                                                   \
             std::ostringstream miopen_log_ss;                                               \
-            miopen_log_ss << miopen::LoggingPrefix() << category << " [" << fn_name << "] " \
-                          << __VA_ARGS__ << std::endl;                                      \
-            std::cerr << miopen_log_ss.str();                                               \
+            miopen_log_ss << category << " [" << fn_name << "] " << __VA_ARGS__;            \
+            miopen::LogMessage(level, miopen_log_ss.str());                                 \
         }                                                                                   \
     } while(false)
 
@@ -389,16 +402,18 @@ std::string LoggingParseFunction(const char* func, const char* pretty_func);
 // Warnings in installable builds, errors otherwise.
 #define MIOPEN_LOG_WE(...) MIOPEN_LOG(LogWELevel, __VA_ARGS__)
 
-#define MIOPEN_LOG_DRIVER_CMD(...)                                                             \
-    do                                                                                         \
-    {                                                                                          \
-        std::ostringstream miopen_driver_cmd_ss;                                               \
-        miopen_driver_cmd_ss << miopen::LoggingPrefix() << "Command"                           \
-                             << " ["                                                           \
-                             << miopen::LoggingParseFunction(__func__,                         \
-                                                             __PRETTY_FUNCTION__) /* NOLINT */ \
-                             << "] ./bin/MIOpenDriver " << __VA_ARGS__ << std::endl;           \
-        std::cerr << miopen_driver_cmd_ss.str();                                               \
+MIOPEN_EXPORT
+void LogDriverCommand(const char* func, const char* pretty_func, const std::string& args);
+
+/// Prints the command when MIOPEN_ENABLE_LOGGING_CMD is set and records the problem when the
+/// workload is being captured. Guard with IsLoggingCmd(), which is true in both cases.
+#define MIOPEN_LOG_DRIVER_CMD(...)                                                         \
+    do                                                                                     \
+    {                                                                                      \
+        std::ostringstream miopen_driver_cmd_ss;                                           \
+        miopen_driver_cmd_ss << __VA_ARGS__;                                               \
+        miopen::LogDriverCommand(                                                          \
+            __func__, __PRETTY_FUNCTION__ /* NOLINT */, miopen_driver_cmd_ss.str());       \
     } while(false)
 
 #if MIOPEN_LOG_FUNC_TIME_ENABLE
@@ -65,6 +65,11 @@ extern "C" {
  * compilation time.slow-compiling kernels. Faster start-up times than Hybrid Find, but GPU
  * performance may be a bit worse.
  *
+ * * Async Hybrid: Checks the Find-db for an entry. If there is a hit, uses that entry. If there is
+ * a miss, uses the Immediate mode fallback at once and queues the existing Find machinery to a
+ * background thread. Once the background search is stored to the Find-db, subsequent calls use
+ * its result. Fast start-up times without a lasting GPU performance drop.
+ *
  * * The default find mode may be queried by using the miopenGetConvolutionFindMode API described
  * below
  */
@@ -75,6 +80,7 @@ typedef enum
     miopenConvolutionFindModeHybrid        = 3, /*!< Hybrid mode */
     miopenConvolutionFindModeReserved_4    = 4, /*!< Reserved - do not use */
     miopenConvolutionFindModeDynamicHybrid = 5, /*!< Dynamic Hybrid mode */
+    miopenConvolutionFindModeAsyncHybrid   = 6, /*!< Async Hybrid mode */
 } miopenConvolutionFindMode_t;
 
 /*! @brief Sets the Find Mode attribute in the convolution descriptor.
@@ -104,6 +110,31 @@ MIOPEN_EXPORT miopenStatus_t miopenGetConvolutionFindMode(
 
 /* End of Find Mode API */
 
+/*! @brief Writes the events recorded by the built-in tracer as a Chrome trace.
+ *
+ * Tracing is enabled by setting the MIOPEN_TRACE environment variable to the path of the file
+ * the trace is written to at exit. This call writes the events recorded so far to another file,
+ * e.g. after the first iterations of a service.
+ *
+ * @param path       Path of the JSON file to write (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenWriteTrace(const char* path);
+
+/*! @brief Runs the kernels of the handle on the host.
+ *
+ * Only available on HIPNOGPU builds, where it does the same as setting the
+ * MIOPEN_NOGPU_HOST_EXECUTION environment variable but for a single handle. The handle allocates
+ * host memory and buffers passed to MIOpen are host pointers. Kernels without a host
+ * implementation throw miopenStatusNotImplemented when run. Call it before anything is allocated
+ * or built on the handle, kernels and invokers prepared before are dropped.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param enable     Whether to run the kernels on the host (input)
+ * @return           miopenStatus_t, miopenStatusNotImplemented on builds with a device backend
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetHostExecution(miopenHandle_t handle, bool enable);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,19 +26,32 @@
 
 #pragma once
 
+#include <miopen/simple_hash.hpp>
+
+#include <cstdint>
+#include <functional>
 #include <string>
 
 namespace miopen {
 
 struct NetworkConfig
 {
-    NetworkConfig() = default;
-    explicit NetworkConfig(const std::string& value_) : value(value_) {}
+    NetworkConfig() : hash(Hash64(value)) {}
+    explicit NetworkConfig(const std::string& value_) : value(value_), hash(Hash64(value)) {}
     operator std::string() const { return value; }
     const std::string& ToString() const { return value; }
+    // Computed once, so that lookups by the config don't hash the string again
+    std::uint64_t GetHash() const { return hash; }
+
+    friend bool operator==(const NetworkConfig& l, const NetworkConfig& r)
+    {
+        return l.hash == r.hash && l.value == r.value;
+    }
+    friend bool operator!=(const NetworkConfig& l, const NetworkConfig& r) { return !(l == r); }
 
 private:
     std::string value;
+    std::uint64_t hash;
 };
 
 struct AlgorithmName
@@ -55,3 +68,13 @@ private:
 };
 
 } // namespace miopen
+
+namespace std {
+
+template <>
+struct hash<miopen::NetworkConfig>
+{
+    std::size_t operator()(const miopen::NetworkConfig& config) const { return config.GetHash(); }
+};
+
+} // namespace std
@@ -27,6 +27,14 @@
 #define GUARD_MIOPEN_NOGPU_HANDLE_IMPL_HPP_
 namespace miopen {
 
+/// Profiling state of the handle. It is shared with the host functions of the kernels run in the
+/// host execution mode, which may be kept in invokers and execution plans outliving the handle.
+struct HostProfiling
+{
+    bool enabled = false;
+    float result = 0.0;
+};
+
 struct HandleImpl
 {
     using StreamPtr = std::shared_ptr<typename std::remove_pointer<hipStream_t>::type>;
@@ -35,8 +43,8 @@ struct HandleImpl
 
     void elapsed_time(hipEvent_t start, hipEvent_t stop)
     {
-        if(enable_profiling)
-            hipEventElapsedTime(&this->profiling_result, start, stop);
+        if(profiling->enabled)
+            hipEventElapsedTime(&profiling->result, start, stop);
     }
 
     std::function<void(hipEvent_t, hipEvent_t)> elapsed_time_handler()
@@ -45,11 +53,11 @@ struct HandleImpl
             &HandleImpl::elapsed_time, this, std::placeholders::_1, std::placeholders::_2);
     }
 
-    bool enable_profiling = false;
-    StreamPtr stream      = nullptr;
+    std::shared_ptr<HostProfiling> profiling = std::make_shared<HostProfiling>();
+    bool host_execution                      = false;
+    StreamPtr stream                         = nullptr;
     rocblas_handle_ptr rhandle_;
-    float profiling_result = 0.0;
-    int device             = -1;
+    int device = -1;
     std::string device_name;
     std::size_t num_cu             = 0;
     std::size_t local_mem_size     = 0;
@@ -58,6 +66,9 @@ struct HandleImpl
     std::size_t warp_size          = 64;
     std::size_t max_mem_alloc_size = 0;
     Allocator allocator{};
+    CachingAllocator::Ptr caching_allocator;
+    WorkspaceArena workspace;
+    std::unique_ptr<ExecutionPlanRecorder> recorder;
     KernelCache cache;
     std::int64_t ctx;
     TargetProperties target_properties;
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_NOGPU_HOST_KERNELS_HPP_
+#define GUARD_MIOPEN_NOGPU_HOST_KERNELS_HPP_
+
+#include <miopen/errors.hpp>
+#include <miopen/export.h>
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace miopen {
+namespace host {
+
+/// Reads kernel arguments back from the block packed by HIPOCKernelInvoke::operator()(Ts...),
+/// where every argument is placed at the next offset aligned to its own alignment.
+class KernelArgsReader
+{
+public:
+    KernelArgsReader(const void* args_, std::size_t size_)
+        : args(static_cast<const char*>(args_)), size(size_)
+    {
+    }
+
+    template <class T>
+    T Next()
+    {
+        offset = (offset + alignof(T) - 1) / alignof(T) * alignof(T);
+        if(offset + sizeof(T) > size)
+            MIOPEN_THROW("Host kernel argument block is too small");
+        T result;
+        std::memcpy(&result, args + offset, sizeof(T));
+        offset += sizeof(T);
+        return result;
+    }
+
+private:
+    const char* args;
+    std::size_t size;
+    std::size_t offset = 0;
+};
+
+/// Launch configuration of a kernel run on the host. Build options stand in for the macros the
+/// device kernel would be compiled with, e.g. the data type or the operation.
+struct MIOPEN_EXPORT KernelLaunch
+{
+    std::string params;
+    std::array<std::size_t, 3> ldims = {1, 1, 1};
+    std::array<std::size_t, 3> gdims = {1, 1, 1};
+
+    /// Returns the value of the last -D<name>[=<value>] option, "1" if it has no value, or
+    /// fallback if the macro is not defined.
+    std::string GetDefine(const std::string& name, const std::string& fallback = {}) const;
+    long long GetDefineInt(const std::string& name, long long fallback = 0) const;
+};
+
+using KernelFunction = void (*)(const KernelLaunch&, KernelArgsReader&);
+
+/// Returns the host implementation of the kernel or nullptr if there is none.
+MIOPEN_EXPORT KernelFunction GetKernel(const std::string& kernel_name);
+
+} // namespace host
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_NOGPU_HOST_KERNELS_HPP_
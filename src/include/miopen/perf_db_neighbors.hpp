@@ -0,0 +1,166 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/config.h>
+#include <miopen/db_record.hpp>
+#include <miopen/export.h>
+#include <miopen/logger.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+struct ExecutionContext;
+
+namespace debug {
+
+/// Overrides MIOPEN_DEBUG_PERFDB_NEIGHBORS, so that both modes can be compared in one process.
+MIOPEN_EXPORT boost::optional<bool>& perf_db_neighbors_override();
+
+} // namespace debug
+
+/// Numeric view of a perf-db problem for the nearest neighbor lookup. Only problems of the same
+/// category are compared. It holds all the non-numeric fields, such as the layout, data type and
+/// direction, so that configs are never transferred between those.
+struct PerfDbFeatures
+{
+    std::string category;
+    std::vector<double> values;
+
+    // Schema of the problem table, only used by the SQLite perf-db.
+    std::string table;
+    std::vector<std::string> category_names;
+    std::vector<std::string> value_names;
+
+    /// Splits a text perf-db key like "64-56-56-3x3-64-56-56-1-1x1-1x1-1x1-0-NCHW-FP32-F".
+    static PerfDbFeatures FromKey(const std::string& key);
+};
+
+template <class Problem>
+PerfDbFeatures GetPerfDbFeatures(const Problem& problem)
+{
+#if MIOPEN_ENABLE_SQLITE
+    auto features  = PerfDbFeatures{};
+    features.table = Problem::table_name();
+    Problem::Visit(problem, [&](const std::string& value, const std::string& name) {
+        features.category += value + "-";
+        features.category_names.push_back(name);
+    });
+    Problem::Visit(problem, [&](const int value, const std::string name) {
+        features.values.push_back(value);
+        features.value_names.push_back(name);
+    });
+    return features;
+#else
+    return PerfDbFeatures::FromKey(DbRecord{problem}.GetKey());
+#endif
+}
+
+/// Tuned perf-db records grouped by category.
+class PerfDbNeighborIndex
+{
+public:
+    void Add(const PerfDbFeatures& features, std::unordered_map<std::string, std::string> configs);
+
+    /// Returns the configs of the solver from up to k nearest records which have one, nearest
+    /// first. Distances are measured between logarithms of the values, so doubling a size counts
+    /// the same for small and large sizes.
+    std::vector<std::string>
+    FindNearest(const PerfDbFeatures& problem, const std::string& solver, std::size_t k) const;
+
+    std::size_t GetSize() const { return size; }
+
+    /// Parses the "solver:config;solver:config" contents of a text perf-db record.
+    static std::unordered_map<std::string, std::string> ParseContents(const std::string& contents);
+
+private:
+    struct Entry
+    {
+        std::vector<double> values;
+        std::unordered_map<std::string, std::string> configs;
+    };
+
+    std::unordered_map<std::string, std::vector<Entry>> categories;
+    std::size_t size = 0;
+};
+
+struct PerfDbNeighborStatistics
+{
+    /// Perf-db misses the lookup has been tried for.
+    std::size_t lookups = 0;
+    /// Misses served with a config of a neighbor.
+    std::size_t transfers = 0;
+    /// Neighbor configs which the solver has found invalid for the problem.
+    std::size_t rejected = 0;
+};
+
+bool IsPerfDbNeighborsEnabled();
+
+/// Returns the configs of the solver tuned for the installed perf-db problems nearest to the
+/// given one, nearest first.
+std::vector<std::string> FindPerfDbNeighbors(const ExecutionContext& ctx,
+                                             const PerfDbFeatures& problem,
+                                             const std::string& solver);
+
+MIOPEN_EXPORT void RecordPerfDbNeighborLookup(bool transferred, std::size_t rejected);
+
+MIOPEN_EXPORT PerfDbNeighborStatistics GetPerfDbNeighborStatistics();
+
+/// Takes the first of the neighbor configs, nearest first, which is valid for this problem.
+template <class Solver, class Context, class Problem, class PerformanceConfig>
+bool ApplyPerfDbNeighbor(const Solver& s,
+                         const Context& context,
+                         const Problem& problem,
+                         const std::vector<std::string>& neighbors,
+                         PerformanceConfig& config)
+{
+    auto rejected = std::size_t{0};
+    for(const auto& neighbor : neighbors)
+    {
+        auto candidate = PerformanceConfig{};
+        if(candidate.Deserialize(neighbor) &&
+           s.IsValidPerformanceConfig(context, problem, candidate))
+        {
+            config = candidate;
+            MIOPEN_LOG_I("Perf Db: neighbor record used: " << s.SolverDbId() << ": " << config);
+            RecordPerfDbNeighborLookup(true, rejected);
+            return true;
+        }
+        ++rejected;
+    }
+
+    RecordPerfDbNeighborLookup(false, rejected);
+    return false;
+}
+
+} // namespace miopen
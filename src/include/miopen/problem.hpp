@@ -217,6 +217,15 @@ struct ProblemContainer : miopenProblem
     friend void from_json(const nlohmann::json& j, ProblemContainer& problem);
 };
 
+/// Finds solutions to all the problems. Problems with equal network configs are searched once and
+/// share the results. Kernels of the remaining convolution problems are compiled together first.
+/// Problems differing only in the batch size are still searched one by one.
+std::vector<std::vector<Solution>>
+FindSolutions(Handle& handle,
+              const std::vector<const ProblemContainer*>& problems,
+              const FindOptions& options,
+              std::size_t max_solutions);
+
 } // namespace miopen
 
 inline std::ostream& operator<<(std::ostream& stream, const miopen::Problem& problem)
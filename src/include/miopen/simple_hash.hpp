@@ -27,9 +27,46 @@
 #ifndef GUARD_MLOPEN_SIMPLE_HASH_HPP
 #define GUARD_MLOPEN_SIMPLE_HASH_HPP
 
+#include <cstdint>
+#include <cstring>
 #include <string>
 
 namespace miopen {
+
+/// Finalizer of splitmix64: a bijection, so distinct words never collide, with full avalanche.
+constexpr std::uint64_t Mix64(std::uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+constexpr std::uint64_t HashCombine64(std::uint64_t seed, std::uint64_t value)
+{
+    return Mix64(seed ^ (value + 0x9e3779b97f4a7c15ULL));
+}
+
+/// 64-bit hash of a byte range, consumed a word at a time.
+inline std::uint64_t Hash64(const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const char*>(data);
+    auto hash         = Mix64(size);
+    for(; size >= sizeof(std::uint64_t); size -= sizeof(std::uint64_t))
+    {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        hash = HashCombine64(hash, word);
+        bytes += sizeof(word);
+    }
+    std::uint64_t tail = 0;
+    std::memcpy(&tail, bytes, size);
+    return HashCombine64(hash, tail);
+}
+
+inline std::uint64_t Hash64(const std::string& value) { return Hash64(value.data(), value.size()); }
 struct SimpleHash
 {
     size_t operator()(const std::pair<std::string, std::string>& p) const
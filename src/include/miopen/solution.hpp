@@ -29,6 +29,8 @@
 #include <miopen/miopen.h>
 
 #include <miopen/errors.hpp>
+#include <miopen/invoke_params.hpp>
+#include <miopen/invoker.hpp>
 #include <miopen/object.hpp>
 #include <miopen/problem.hpp>
 #include <miopen/solver_id.hpp>
@@ -38,6 +40,9 @@
 
 #include <boost/optional.hpp>
 
+#include <array>
+#include <atomic>
+#include <memory>
 #include <optional>
 #include <unordered_map>
 
@@ -64,15 +69,16 @@ struct Solution : miopenSolution
 
     struct RunInput
     {
-        boost::optional<TensorDescriptor> descriptor;
-        Data_t buffer = nullptr;
+        // Not owned, must outlive the run
+        const TensorDescriptor* descriptor = nullptr;
+        Data_t buffer                      = nullptr;
 
         inline RunInput() = default;
 
         inline RunInput(miopenTensorArgument_t argument) : buffer(DataCast(argument.buffer))
         {
             if(argument.descriptor != nullptr)
-                descriptor = miopen::deref(*argument.descriptor);
+                descriptor = &miopen::deref(*argument.descriptor);
         }
 
         inline RunInput(Data_t buffer_) : buffer(buffer_) {}
@@ -83,27 +89,108 @@ struct Solution : miopenSolution
     std::size_t GetWorkspaceSize() const { return workspace_required; }
     void SetWorkspaceSize(std::size_t value) { workspace_required = value; }
     const solver::Id& GetSolver() const { return solver; }
-    void SetSolver(solver::Id value) { solver = value; }
-    void SetPerfConfig(const std::optional<std::string>& cfg) { perf_cfg = cfg; }
+    void SetSolver(solver::Id value)
+    {
+        solver = value;
+        std::atomic_store(&bound_invoker, {});
+    }
+    void SetPerfConfig(const std::optional<std::string>& cfg)
+    {
+        perf_cfg = cfg;
+        std::atomic_store(&bound_invoker, {});
+    }
     const ProblemContainer& GetProblem() const { return problem; }
-    void SetProblem(ProblemContainer value) { problem = std::move(value); }
+    void SetProblem(ProblemContainer value)
+    {
+        problem = std::move(value);
+        std::atomic_store(&bound_invoker, {});
+    }
 
     void Run(Handle& handle,
              const std::unordered_map<miopenTensorArgumentId_t, RunInput>& inputs,
              Data_t workspace,
              size_t workspace_size);
 
+    /// Same as above, except that a bound solution runs without building the map of the inputs.
+    void Run(Handle& handle,
+             const miopenTensorArgument_t* tensors,
+             std::size_t count,
+             Data_t workspace,
+             size_t workspace_size);
+
     void LogDriverCommand() const;
 
+    /// Stores the code objects of the solution kernels in it to be serialized along with it. A
+    /// deserialized solution then runs on a matching device and library build without compiling
+    /// the kernels or looking them up in the kernel cache.
+    void EmbedCodeObjects(Handle& handle);
+
     friend void to_json(nlohmann::json& json, const Solution& solution);
     friend void from_json(const nlohmann::json& json, Solution& solution);
 
 private:
+    // The invoker obtained by the last full run and what it has been obtained for. Following runs
+    // on the same handle with the same tensor descriptors call it directly instead of rebuilding
+    // the problem, formatting its network config and looking the invoker up by it.
+    // A binding is never changed once published. Runs on several threads may share it: the one
+    // holding the busy flag patches invoke_params in place, the others patch a copy of them.
+    struct BoundInvoker
+    {
+        BoundInvoker(std::uint64_t handle_id_,
+                     Invoker invoker_,
+                     AnyInvokeParams invoke_params_             = {},
+                     miopenProblemDirection_t direction_        = miopenProblemDirectionForward,
+                     std::vector<TensorDescriptor> descriptors_ = {})
+            : handle_id(handle_id_),
+              invoker(std::move(invoker_)),
+              invoke_params(std::move(invoke_params_)),
+              direction(direction_),
+              descriptors(std::move(descriptors_))
+        {
+        }
+
+        const std::uint64_t handle_id;
+        const Invoker invoker;
+        // Convolution only: parameters of the binding run, the direction after transposition and
+        // x, w and y as passed to the run, before it
+        AnyInvokeParams invoke_params;
+        const miopenProblemDirection_t direction;
+        const std::vector<TensorDescriptor> descriptors;
+        std::atomic_flag busy = ATOMIC_FLAG_INIT;
+    };
+
+    using ConvolutionInputs = std::array<std::optional<RunInput>, 3>;
+
+    struct CodeObject
+    {
+        std::string program_name;
+        std::string params;
+        std::string binary;
+    };
+
     float time                     = 0;
     std::size_t workspace_required = 0;
     solver::Id solver;
     ProblemContainer problem;
     std::optional<std::string> perf_cfg = std::nullopt;
+    // Only accessed through std::atomic_load and std::atomic_store
+    std::shared_ptr<BoundInvoker> bound_invoker;
+    // Only used if the fingerprint matches the handle running the solution
+    std::string code_objects_fingerprint;
+    std::vector<CodeObject> code_objects;
+
+    void CheckWorkspaceSize(std::size_t workspace_size) const;
+    void Bind(const Handle& handle,
+              const Invoker& invoker,
+              AnyInvokeParams invoke_params             = {},
+              miopenProblemDirection_t direction        = miopenProblemDirectionForward,
+              std::vector<TensorDescriptor> descriptors = {});
+
+    bool RunBound(Handle& handle,
+                  ConvolutionInputs args,
+                  Data_t workspace,
+                  std::size_t workspace_size,
+                  const ConvolutionDescriptor& conv_desc);
 
     void RunImpl(Handle& handle,
                  const std::unordered_map<miopenTensorArgumentId_t, RunInput>& inputs,
@@ -117,6 +204,10 @@ private:
                  std::size_t workspace_size,
                  const FusedProblem& problem_);
 
+    void EmbedCodeObjects(Handle& handle, const ConvolutionDescriptor& conv_desc);
+    void LoadCodeObjects(const Handle& handle) const;
+    static std::string GetCodeObjectsFingerprint(const Handle& handle);
+
     static Problem Transpose(const Problem& problem, RunInput* x, const RunInput& w, RunInput* y);
 
     void LogDriverCommand(const ConvolutionDescriptor& desc) const;
@@ -116,6 +116,7 @@ ConvSolution MakeInvokerFactory(const ProblemDescriptionType& problem, const std
                 auto argument_ptr    = ck_args.MakeArgPtr(sh_conv_ptr, data_ctx.tensors);
                 auto invoker_ptr     = sh_conv_ptr->MakeInvokerPointer();
 
+                handle.MarkCaptureUnsupported("Composable kernel launch");
                 const auto enable_profiling = handle.IsProfilingEnabled();
                 float elapsed_time =
                     invoker_ptr->Run(argument_ptr.get(), {handle.GetStream(), enable_profiling});
@@ -152,6 +153,7 @@ ConvSolution InitAnyInvokerFactory(const ProblemDescriptionType& problem,
                 auto argument_ptr    = ck_args.MakeArgPtr(sh_conv_ptr, data_ctx);
                 auto invoker_ptr     = sh_conv_ptr->MakeInvokerPointer();
 
+                handle.MarkCaptureUnsupported("Composable kernel launch");
                 const auto enable_profiling = handle.IsProfilingEnabled();
                 float elapsed_time =
                     invoker_ptr->Run(argument_ptr.get(), {handle.GetStream(), enable_profiling});
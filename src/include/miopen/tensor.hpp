@@ -38,7 +38,9 @@
 #include <nlohmann/json_fwd.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
 #include <numeric>
 #include <vector>
 #include <optional>
@@ -239,8 +241,7 @@ struct MIOPEN_EXPORT TensorDescriptor : miopenTensorDescriptor
             // Copy construct the result string from labels. This allocates the space at one go
             // and is faster than calling push_back in transform.
             auto result = labels;
-            auto p      = find_permutation(lens, strides);
-            std::transform(p.begin(), p.end(), result.begin(), [&](auto i) { return labels[i]; });
+            PermuteLabels(labels, result);
             return result;
         }
         else
@@ -252,8 +253,7 @@ struct MIOPEN_EXPORT TensorDescriptor : miopenTensorDescriptor
                     "Invalid labels size. Layout labels size must be equavalent to stride size");
             }
             auto result = base_label;
-            auto p      = find_permutation(lens, strides);
-            std::transform(p.begin(), p.end(), result.begin(), [&](auto i) { return labels[i]; });
+            PermuteLabels(labels, result);
             return result + 'c';
         }
     }
@@ -275,6 +275,20 @@ private:
 
     void CalculateStrides();
     void CalculateVectorLength();
+    // Everything below depends only on lens and strides, so it is computed once they are set
+    void CalculateCachedProperties();
+
+    void PermuteLabels(const std::string& labels, std::string& result) const
+    {
+        if(lens.size() <= layout_permutation.size())
+        {
+            for(std::size_t i = 0; i < lens.size(); ++i)
+                result[i] = labels[layout_permutation[i]];
+            return;
+        }
+        auto p = find_permutation(lens, strides);
+        std::transform(p.begin(), p.end(), result.begin(), [&](auto i) { return labels[i]; });
+    }
 
     static miopenTensorLayout_t GetDefaultLayout() { return miopenTensorNCHW; };
 
@@ -283,6 +297,10 @@ private:
 
     bool packed;
     std::size_t vector_length = 1;
+    std::size_t element_size  = 1;
+    std::size_t element_space = 1;
+    // find_permutation(lens, strides), if there are few enough dimensions to keep it inline
+    std::array<std::uint8_t, 8> layout_permutation = {};
 
     miopenDataType_t type = miopenFloat;
     std::optional<miopenDataType_t> cast_type;
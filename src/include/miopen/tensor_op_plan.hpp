@@ -0,0 +1,84 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/tensor.hpp>
+
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace miopen {
+
+/// Execution shapes the canonical form of C = op(alpha0 * A, alpha1 * B) + beta * C falls into.
+enum class TensorOpShape
+{
+    /// A single dimension, all the tensors are contiguous.
+    Packed1d,
+    /// A single dimension, B is one value broadcast over the whole C.
+    Broadcast1d,
+    /// A single dimension with arbitrary strides.
+    Strided1d,
+    /// Two or more dimensions remain after coalescing.
+    Generic,
+};
+
+/// Canonical form of a binary tensor op where C dims of length 1 are dropped, and every run of
+/// dims which is contiguous in A, B and C and is broadcast in B either everywhere or nowhere, is
+/// merged into a single dim. The rank never grows, so the plan fits the kernels of the original op.
+struct TensorOpPlan
+{
+    std::vector<std::size_t> lengths;
+    std::vector<std::size_t> a_strides;
+    /// Zero on the dims B is broadcast along.
+    std::vector<std::size_t> b_strides;
+    std::vector<std::size_t> c_strides;
+    TensorOpShape shape = TensorOpShape::Generic;
+
+    std::size_t GetSize() const { return lengths.size(); }
+
+    /// Lengths of B, i.e. 1 on broadcast dims.
+    std::vector<std::size_t> GetBLengths() const;
+
+    /// Whether the kernels of the op can run the plan. The kernels of rank 2 and more assume unit
+    /// innermost strides, which are lost when e.g. lengths {2, 3, 4, 1} with strides
+    /// {100, 8, 2, 1} drop the innermost dim.
+    bool FitsKernels() const;
+
+    /// Descriptors of A, B and C with the coalesced layout. B strides on broadcast dims are
+    /// replaced with the packed ones, since descriptors do not allow zero strides.
+    std::tuple<TensorDescriptor, TensorDescriptor, TensorDescriptor>
+    GetDescriptors(miopenDataType_t a_type,
+                   miopenDataType_t b_type,
+                   miopenDataType_t c_type) const;
+};
+
+/// Returns an empty optional if A lengths differ from C ones, or B is not broadcastable to C.
+MIOPEN_EXPORT std::optional<TensorOpPlan> PlanTensorOp(const TensorDescriptor& aDesc,
+                                                       const TensorDescriptor& bDesc,
+                                                       const TensorDescriptor& cDesc);
+
+} // namespace miopen
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TRACER_HPP
+#define GUARD_MIOPEN_TRACER_HPP
+
+#include <miopen/config.h>
+#include <miopen/export.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#define MIOPEN_TRACE_CAT(x, y) MIOPEN_TRACE_PRIMITIVE_CAT(x, y)
+#define MIOPEN_TRACE_PRIMITIVE_CAT(x, y) x##y
+
+namespace miopen {
+namespace trace {
+
+/// Built-in tracer. When enabled with MIOPEN_TRACE=<path> (or Enable()), timestamped begin/end
+/// events and counters are recorded into per-thread ring buffers and written as a Chrome trace
+/// (chrome://tracing, ui.perfetto.dev) at exit or on a WriteChromeTrace() call.
+///
+/// Events only store pointers to their category and name, which therefore have to live until the
+/// trace is written: string literals, __func__ or the result of Intern(). Nothing is formatted
+/// while recording.
+
+enum class Phase : std::uint8_t
+{
+    Begin,
+    End,
+    Counter,
+};
+
+struct Event
+{
+    const char* category;
+    const char* name;
+    std::int64_t value; // Counters only
+    std::uint64_t timestamp_ns;
+    Phase phase;
+};
+
+MIOPEN_EXPORT std::atomic<bool>& EnabledFlag();
+
+inline bool IsEnabled() { return EnabledFlag().load(std::memory_order_relaxed); }
+
+MIOPEN_EXPORT void Enable(bool enabled = true);
+
+/// Returns a pointer to a copy of the string which lives as long as the process.
+MIOPEN_EXPORT const char* Intern(const std::string& str);
+
+MIOPEN_EXPORT void Record(Phase phase, const char* category, const char* name, std::int64_t value);
+
+inline void Counter(const char* category, const char* name, std::int64_t value)
+{
+    if(IsEnabled())
+        Record(Phase::Counter, category, name, value);
+}
+
+/// Writes all the recorded events. Events stay recorded.
+MIOPEN_EXPORT bool WriteChromeTrace(const std::string& path);
+
+/// Drops all the recorded events.
+MIOPEN_EXPORT void Clear();
+
+class Scope
+{
+public:
+    Scope(const char* category_, const char* name_) : category(category_), name(name_)
+    {
+        if(IsEnabled())
+            Begin();
+    }
+
+    /// For names which are not known at compile time. Interned only when tracing is enabled.
+    Scope(const char* category_, const std::string& name_) : category(category_)
+    {
+        if(!IsEnabled())
+            return;
+        name = Intern(name_);
+        Begin();
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ~Scope()
+    {
+        if(active)
+            Record(Phase::End, category, name, 0);
+    }
+
+private:
+    const char* category;
+    const char* name = nullptr;
+    bool active      = false;
+
+    void Begin()
+    {
+        active = true;
+        Record(Phase::Begin, category, name, 0);
+    }
+};
+
+} // namespace trace
+} // namespace miopen
+
+#define MIOPEN_TRACE_SCOPE(category, name) \
+    const miopen::trace::Scope MIOPEN_TRACE_CAT(miopen_trace_scope_, __LINE__){category, name}
+
+#define MIOPEN_TRACE_FUNCTION(category) MIOPEN_TRACE_SCOPE(category, __func__)
+
+#endif // GUARD_MIOPEN_TRACER_HPP
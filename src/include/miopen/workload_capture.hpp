@@ -0,0 +1,102 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_WORKLOAD_CAPTURE_HPP
+#define GUARD_MIOPEN_WORKLOAD_CAPTURE_HPP
+
+#include <miopen/config.h>
+#include <miopen/export.h>
+
+#include <boost/optional.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+
+namespace miopen {
+
+namespace debug {
+
+/// For unit tests. Overrides MIOPEN_CAPTURE_WORKLOAD.
+MIOPEN_EXPORT boost::optional<std::string>& workload_capture_path_override();
+
+} // namespace debug
+
+namespace capture {
+
+/// Workload capture. With MIOPEN_CAPTURE_WORKLOAD=<path>, every problem issued to the library is
+/// recorded once, as the MIOpenDriver command line which reproduces it (the one printed by
+/// MIOPEN_ENABLE_LOGGING_CMD), along with the number of API calls made for it and their host
+/// time. The records are merged into the manifest file in the background and at exit, under a
+/// file lock, so that several processes can capture into the same manifest.
+///
+/// Manifest lines are "<count> <host_ms> ./bin/MIOpenDriver <args>", so that the manifest can be
+/// passed to "MIOpenDriver batch" as is.
+
+struct ManifestEntry
+{
+    std::uint64_t count = 0;
+    double host_ms      = 0.0;
+};
+
+/// Driver arguments, without "./bin/MIOpenDriver", to their entry
+using Manifest = std::map<std::string, ManifestEntry>;
+
+MIOPEN_EXPORT bool IsEnabled();
+
+/// Records a problem by the driver arguments reproducing it.
+MIOPEN_EXPORT void Record(const std::string& driver_args);
+
+/// Merges the problems recorded since the previous flush into the manifest file.
+MIOPEN_EXPORT bool Flush();
+
+MIOPEN_EXPORT Manifest ReadManifest(std::istream& stream);
+MIOPEN_EXPORT void WriteManifest(std::ostream& stream, const Manifest& manifest);
+MIOPEN_EXPORT void MergeManifest(Manifest& into, const Manifest& from);
+
+/// Measures the host time of an API call. The problem recorded first during the call is charged
+/// with it.
+class MIOPEN_EXPORT ApiScope
+{
+public:
+    ApiScope();
+    ApiScope(const ApiScope&) = delete;
+    ApiScope& operator=(const ApiScope&) = delete;
+    ~ApiScope();
+
+    std::string problem;
+
+private:
+    bool active     = false;
+    ApiScope* outer = nullptr;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace capture
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_WORKLOAD_CAPTURE_HPP
@@ -25,34 +25,44 @@
  *******************************************************************************/
 
 #include <miopen/invoker_cache.hpp>
+#include <miopen/conv/problem_description.hpp>
 #include <miopen/logger.hpp>
 
+#include <atomic>
+
 namespace miopen {
 
-boost::optional<const Invoker&> InvokerCache::operator[](const Key& key) const
+InvokerCache::InvokerCache()
 {
-    const auto item = invokers.find(key.first);
+    static std::atomic<std::uint64_t> next_id{1};
+    id = next_id++;
+}
+
+boost::optional<const Invoker&> InvokerCache::Get(const NetworkConfig& network_config,
+                                                  const std::string& solver_id) const
+{
+    const auto item = invokers.find(network_config);
     if(item == invokers.end())
         return boost::none;
     const auto& item_invokers = item->second.invokers;
-    const auto invoker        = item_invokers.find(key.second);
+    const auto invoker        = item_invokers.find(solver_id);
     if(invoker == item_invokers.end())
         return boost::none;
     return invoker->second;
 }
 
-boost::optional<const Invoker&> InvokerCache::GetFound1_0(const std::string& network_config,
+boost::optional<const Invoker&> InvokerCache::GetFound1_0(const NetworkConfig& network_config,
                                                           const std::string& algorithm) const
 {
     const auto item = invokers.find(network_config);
     if(item == invokers.end())
     {
-        MIOPEN_LOG_I2("No invokers found for " << network_config);
+        MIOPEN_LOG_I2("No invokers found for " << network_config.ToString());
         return boost::none;
     }
     if(item->second.found_1_0.empty())
     {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
+        MIOPEN_LOG_I2("Invokers found for " << network_config.ToString()
                                             << " but there is no find 1.0 result.");
         return boost::none;
     }
@@ -61,32 +71,33 @@ boost::optional<const Invoker&> InvokerCache::GetFound1_0(const std::string& net
     const auto found_1_0_id   = found_1_0_ids.find(algorithm);
     if(found_1_0_id == found_1_0_ids.end())
     {
-        MIOPEN_LOG_I2("Invokers found for "
-                      << network_config << " but there is no one with an algorithm " << algorithm);
+        MIOPEN_LOG_I2("Invokers found for " << network_config.ToString()
+                                            << " but there is no one with an algorithm "
+                                            << algorithm);
         return boost::none;
     }
     const auto invoker = item_invokers.find(found_1_0_id->second);
     if(invoker == item_invokers.end())
     {
         MIOPEN_THROW("No invoker with solver_id of " + found_1_0_id->second +
-                     " was registered for " + network_config);
+                     " was registered for " + network_config.ToString());
     }
     return invoker->second;
 }
 
 boost::optional<const std::string&>
-InvokerCache::GetFound1_0SolverId(const std::string& network_config,
+InvokerCache::GetFound1_0SolverId(const NetworkConfig& network_config,
                                   const std::string& algorithm) const
 {
     const auto item = invokers.find(network_config);
     if(item == invokers.end())
     {
-        MIOPEN_LOG_I2("No invokers found for " << network_config);
+        MIOPEN_LOG_I2("No invokers found for " << network_config.ToString());
         return boost::none;
     }
     if(item->second.found_1_0.empty())
     {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
+        MIOPEN_LOG_I2("Invokers found for " << network_config.ToString()
                                             << " but there is no find 1.0 result.");
         return boost::none;
     }
@@ -94,13 +105,57 @@ InvokerCache::GetFound1_0SolverId(const std::string& network_config,
     const auto found_1_0_id   = found_1_0_ids.find(algorithm);
     if(found_1_0_id == found_1_0_ids.end())
     {
-        MIOPEN_LOG_I2("Invokers found for "
-                      << network_config << " but there is no one with an algorithm " << algorithm);
+        MIOPEN_LOG_I2("Invokers found for " << network_config.ToString()
+                                            << " but there is no one with an algorithm "
+                                            << algorithm);
         return boost::none;
     }
     return found_1_0_id->second;
 }
 
+const InvokerCache::Item* InvokerCache::FindItem(const conv::ProblemDescription& problem) const
+{
+    const auto key     = problem.MakeKey();
+    const auto indexed = conv_items.find(key);
+    if(indexed != conv_items.end())
+        return indexed->second;
+
+    // Invokers are registered by the network config, so the first lookup of a problem goes
+    // through it. Misses are not remembered, since the invokers may be registered later.
+    const auto item = invokers.find(problem.MakeNetworkConfig());
+    if(item == invokers.end())
+        return nullptr;
+    conv_items.emplace(key, &item->second);
+    return &item->second;
+}
+
+boost::optional<const Invoker&> InvokerCache::Get(const conv::ProblemDescription& problem,
+                                                  const std::string& solver_id) const
+{
+    const auto item = FindItem(problem);
+    if(item == nullptr)
+        return boost::none;
+    const auto invoker = item->invokers.find(solver_id);
+    if(invoker == item->invokers.end())
+        return boost::none;
+    return invoker->second;
+}
+
+boost::optional<const Invoker&> InvokerCache::GetFound1_0(const conv::ProblemDescription& problem,
+                                                          const std::string& algorithm) const
+{
+    const auto item = FindItem(problem);
+    if(item == nullptr)
+        return boost::none;
+    const auto found_1_0_id = item->found_1_0.find(algorithm);
+    if(found_1_0_id == item->found_1_0.end())
+        return boost::none;
+    const auto invoker = item->invokers.find(found_1_0_id->second);
+    if(invoker == item->invokers.end())
+        MIOPEN_THROW("No invoker with solver_id of " + found_1_0_id->second + " was registered");
+    return invoker->second;
+}
+
 void InvokerCache::Register(const Key& key, const Invoker& invoker)
 {
     auto it = invokers.find(key.first);
@@ -113,16 +168,17 @@ void InvokerCache::Register(const Key& key, const Invoker& invoker)
         auto& item = invokers.insert({key.first, Item{}}).first->second;
         item.invokers.insert({key.second, invoker});
     }
-    MIOPEN_LOG_I2("Invoker registered for algorithm " << key.first << " and solver " << key.second);
+    MIOPEN_LOG_I2("Invoker registered for algorithm " << key.first.ToString() << " and solver "
+                                                      << key.second);
 }
 
-void InvokerCache::SetAsFound1_0(const std::string& network_config,
+void InvokerCache::SetAsFound1_0(const NetworkConfig& network_config,
                                  const std::string& algorithm,
                                  const std::string& solver_id)
 {
     const auto item = invokers.find(network_config);
     if(item == invokers.end())
-        MIOPEN_THROW("No invoker was registered for " + network_config);
+        MIOPEN_THROW("No invoker was registered for " + network_config.ToString());
 
     {
         // Validating at find time
@@ -131,13 +187,43 @@ void InvokerCache::SetAsFound1_0(const std::string& network_config,
         if(invoker == item_invokers.end())
         {
             MIOPEN_THROW("No invoker with solver_id of " + solver_id + " was registered for " +
-                         network_config);
+                         network_config.ToString());
         }
     }
 
     item->second.found_1_0[algorithm] = solver_id;
     MIOPEN_LOG_I2("Solver " << solver_id << " registered as find 1.0 best for " << algorithm
-                            << " in " << network_config);
+                            << " in " << network_config.ToString());
+}
+
+FusionPlanCache& FusionPlanCache::Instance()
+{
+    static FusionPlanCache cache;
+    return cache;
+}
+
+boost::optional<std::vector<Invoker>> FusionPlanCache::Get(const std::string& device_key,
+                                                           const NetworkConfig& plan_config) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto device = plans.find(device_key);
+    if(device == plans.end())
+        return boost::none;
+    const auto item = device->second.find(plan_config);
+    if(item == device->second.end())
+        return boost::none;
+    return item->second;
+}
+
+void FusionPlanCache::Register(const std::string& device_key,
+                               const NetworkConfig& plan_config,
+                               const std::vector<Invoker>& plan_invokers)
+{
+    // Plans missed concurrently are compiled by each of the callers, the last one is kept.
+    std::lock_guard<std::mutex> lock(mutex);
+    plans[device_key][plan_config] = plan_invokers;
+    MIOPEN_LOG_I2("Fusion plan registered for " << plan_config.ToString() << " on "
+                                                << device_key);
 }
 
 } // namespace miopen
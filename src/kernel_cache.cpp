@@ -91,6 +91,14 @@ void KernelCache::AddProgram(Program prog, const std::string& program_name, std:
     program_map[std::make_pair(program_name, params)] = prog;
 }
 
+Program KernelCache::GetProgram(const std::string& name, const std::string& params) const
+{
+    const auto program_it = program_map.find(std::make_pair(name, params));
+    if(program_it == program_map.end())
+        return {};
+    return program_it->second;
+}
+
 Kernel KernelCache::AddKernel(const Handle& h,
                               const std::string& algorithm,
                               const std::string& network_config,
@@ -117,6 +125,7 @@ Kernel KernelCache::AddKernel(const Handle& h,
     {
         program = h.LoadProgram(program_name, params, kernel_src);
         program_map[std::make_pair(program_name, params)] = program;
+        ++program_loads;
     }
 
     Kernel kernel{};
@@ -0,0 +1,237 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/layout_plan.hpp>
+
+#include <miopen/any_solver.hpp>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/tensor_layout.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <ostream>
+#include <utility>
+
+namespace miopen {
+
+namespace {
+
+constexpr std::size_t no_path = std::numeric_limits<std::size_t>::max();
+
+/// Returns the transpose traffic of the step and the layout it is executed in.
+std::pair<std::size_t, std::string>
+StepCost(const LayoutPlanStep& step, const std::string& in, const std::string& out)
+{
+    // A layout agnostic op runs either in the layout of its input or in the one of its output
+    const auto& layouts = step.native_layouts.empty() ? std::vector<std::string>{in, out}
+                                                      : step.native_layouts;
+
+    auto best = std::make_pair(no_path, std::string{});
+    for(const auto& layout : layouts)
+    {
+        const auto cost = (in != layout ? 2 * step.input_bytes : 0) +
+                          (out != layout ? 2 * step.output_bytes : 0);
+        if(cost < best.first)
+            best = {cost, layout};
+    }
+    return best;
+}
+
+TensorDescriptor InLayout(const TensorDescriptor& desc, miopenTensorLayout_t layout)
+{
+    auto result = TensorDescriptor{desc.GetType(), layout, desc.GetLengths()};
+    if(const auto cast_type = desc.GetCastType())
+        result.SetCastType(*cast_type);
+    return result;
+}
+
+} // namespace
+
+LayoutPlanStep::LayoutPlanStep(std::vector<std::string> native_layouts_,
+                               std::size_t input_bytes_,
+                               std::size_t output_bytes_)
+    : native_layouts(std::move(native_layouts_)),
+      input_bytes(input_bytes_),
+      output_bytes(output_bytes_)
+{
+}
+
+LayoutPlanStep::LayoutPlanStep(std::vector<std::string> native_layouts_,
+                               const TensorDescriptor& input,
+                               const TensorDescriptor& output)
+    : LayoutPlanStep(std::move(native_layouts_), input.GetNumBytes(), output.GetNumBytes())
+{
+}
+
+LayoutPlanStep::LayoutPlanStep(const ExecutionContext& ctx,
+                               const conv::ProblemDescription& problem,
+                               const solver::Id& solver_id)
+    : input_bytes(problem.GetIn().GetNumBytes()), output_bytes(problem.GetOut().GetNumBytes())
+{
+    if(problem.GetDirection() == conv::Direction::BackwardWeights)
+        MIOPEN_THROW(miopenStatusBadParm, "Backward weights convolutions are not chain ops");
+    if(!solver_id.IsValid() || solver_id.GetPrimitive() != solver::Primitive::Convolution)
+        MIOPEN_THROW(miopenStatusBadParm, "Not a convolution solver: " + solver_id.ToString());
+
+    const auto solver  = solver_id.GetSolver();
+    const auto layouts = problem.GetSpatialDims() == 2
+                             ? std::vector<miopenTensorLayout_t>{miopenTensorNCHW, miopenTensorNHWC}
+                             : std::vector<miopenTensorLayout_t>{miopenTensorNCDHW,
+                                                                 miopenTensorNDHWC};
+
+    // Solvers which transpose the tensors are applicable in every layout, but need a workspace
+    // for the transposed copies outside of their native one.
+    auto min_workspace = std::numeric_limits<std::size_t>::max();
+    for(const auto layout : layouts)
+    {
+        const auto in_layout = conv::ProblemDescription{InLayout(problem.GetIn(), layout),
+                                                        InLayout(problem.GetWeights(), layout),
+                                                        InLayout(problem.GetOut(), layout),
+                                                        problem.GetConv(),
+                                                        problem.GetDirection(),
+                                                        problem.GetBias()};
+        if(!solver.IsApplicable(ctx, in_layout))
+            continue;
+
+        const auto workspace = solver.GetWorkspaceSize(ctx, in_layout);
+        if(workspace < min_workspace)
+        {
+            min_workspace = workspace;
+            native_layouts.clear();
+        }
+        if(workspace == min_workspace)
+            native_layouts.push_back(in_layout.GetInLayout());
+    }
+
+    if(native_layouts.empty())
+        MIOPEN_THROW(miopenStatusBadParm,
+                     solver_id.ToString() + " is not applicable to the problem in any layout");
+}
+
+TensorDescriptor LayoutPlan::GetTensorDescriptor(std::size_t tensor,
+                                                 const TensorDescriptor& desc) const
+{
+    const auto labels = tensor_layout_get_default(desc.GetSize());
+    if(labels.empty())
+        MIOPEN_THROW(miopenStatusBadParm, "Only 4d and 5d tensors have planned layouts");
+
+    auto layout = tensor_layouts.at(tensor);
+    if(desc.GetSize() < 5)
+        layout.erase(std::remove(layout.begin(), layout.end(), 'D'), layout.end());
+
+    auto strides = std::vector<std::size_t>{};
+    tensor_layout_to_strides(desc.GetLengths(), labels, layout, strides);
+    return {desc.GetType(), desc.GetLengths(), strides};
+}
+
+std::ostream& operator<<(std::ostream& stream, const LayoutPlan& plan)
+{
+    stream << "layouts:";
+    for(const auto& layout : plan.tensor_layouts)
+        stream << ' ' << layout;
+    stream << ", transposed bytes: " << plan.bytes_before << " -> " << plan.bytes_after;
+    return stream;
+}
+
+LayoutPlan PlanLayouts(const std::vector<LayoutPlanStep>& steps,
+                       const std::string& input_layout,
+                       const std::string& output_layout)
+{
+    if(steps.empty())
+    {
+        auto plan           = LayoutPlan{};
+        plan.tensor_layouts = {input_layout};
+        return plan;
+    }
+
+    // Candidate layouts of the tensors. The input layout goes first, so that it wins ties and
+    // intermediate tensors are not transposed without a gain.
+    auto layouts = std::vector<std::string>{input_layout, output_layout};
+    for(const auto& step : steps)
+        layouts.insert(layouts.end(), step.native_layouts.begin(), step.native_layouts.end());
+    for(auto it = layouts.begin(); it != layouts.end(); ++it)
+        layouts.erase(std::remove(std::next(it), layouts.end(), *it), layouts.end());
+
+    const auto n_tensors = steps.size() + 1;
+    const auto n_layouts = layouts.size();
+    const auto out_idx   = static_cast<std::size_t>(
+        std::distance(layouts.begin(), std::find(layouts.begin(), layouts.end(), output_layout)));
+
+    // Shortest path over the layouts of the tensors, the i-th step connects tensors i and i + 1
+    auto cost = std::vector<std::vector<std::size_t>>(n_tensors,
+                                                      std::vector<std::size_t>(n_layouts, no_path));
+    auto from =
+        std::vector<std::vector<std::size_t>>(n_tensors, std::vector<std::size_t>(n_layouts));
+    cost[0][0] = 0;
+
+    for(std::size_t i = 0; i < steps.size(); ++i)
+    {
+        for(std::size_t k = 0; k < n_layouts; ++k)
+        {
+            if(cost[i][k] == no_path)
+                continue;
+
+            for(std::size_t m = 0; m < n_layouts; ++m)
+            {
+                if(i + 1 == steps.size() && m != out_idx)
+                    continue;
+
+                const auto step_cost = StepCost(steps[i], layouts[k], layouts[m]).first;
+                if(cost[i][k] + step_cost < cost[i + 1][m])
+                {
+                    cost[i + 1][m] = cost[i][k] + step_cost;
+                    from[i + 1][m] = k;
+                }
+            }
+        }
+    }
+
+    auto indices   = std::vector<std::size_t>(n_tensors);
+    indices.back() = out_idx;
+    for(auto i = n_tensors - 1; i > 0; --i)
+        indices[i - 1] = from[i][indices[i]];
+
+    auto plan = LayoutPlan{};
+    for(const auto idx : indices)
+        plan.tensor_layouts.push_back(layouts[idx]);
+
+    for(std::size_t i = 0; i < steps.size(); ++i)
+    {
+        const auto& in  = plan.tensor_layouts[i];
+        const auto& out = plan.tensor_layouts[i + 1];
+        plan.op_layouts.push_back(StepCost(steps[i], in, out).second);
+
+        // Baseline: every op gets and produces its tensors in the network layout
+        const auto& out_before = i + 1 == steps.size() ? output_layout : input_layout;
+        plan.bytes_before += StepCost(steps[i], input_layout, out_before).first;
+    }
+
+    plan.bytes_after = cost.back()[out_idx];
+    return plan;
+}
+
+} // namespace miopen
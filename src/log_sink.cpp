@@ -0,0 +1,419 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/log_sink.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+/// Log through a background thread which adds the prefixes and writes the log in batches.
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_LOG_ASYNC)
+
+/// Write the log as binary records into the given file (implies MIOPEN_LOG_ASYNC).
+/// Use utils/miopen_log_decode.py to read it.
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_LOG_BINARY_FILE)
+
+/// Maximum number of Info and more detailed messages logged a second, 0 for no limit.
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_LOG_RATE_LIMIT)
+
+/// Log only one of every N Info2 and Trace messages.
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_LOG_SAMPLING)
+
+namespace miopen {
+namespace log_sink {
+
+Ring::Ring(std::size_t capacity_pow2) : records(capacity_pow2), mask(capacity_pow2 - 1)
+{
+    if(capacity_pow2 == 0 || (capacity_pow2 & mask) != 0)
+        MIOPEN_THROW(miopenStatusInternalError, "Ring capacity must be a power of 2");
+}
+
+bool Ring::TryPush(Record&& record)
+{
+    const auto tail = write.load(std::memory_order_relaxed);
+    if(tail - read.load(std::memory_order_acquire) == records.size())
+        return false;
+    records[tail & mask] = std::move(record);
+    write.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+namespace {
+
+template <class T>
+void WriteLE(std::ostream& stream, T value)
+{
+    char bytes[sizeof(T)];
+    for(std::size_t i = 0; i < sizeof(T); ++i)
+        bytes[i] = static_cast<char>(static_cast<std::uint64_t>(value) >> (8 * i));
+    stream.write(bytes, sizeof(T));
+}
+
+template <class T>
+bool ReadLE(std::istream& stream, T& value)
+{
+    unsigned char bytes[sizeof(T)];
+    if(!stream.read(reinterpret_cast<char*>(bytes), sizeof(T)))
+        return false;
+    std::uint64_t result = 0;
+    for(std::size_t i = 0; i < sizeof(T); ++i)
+        result |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+    value = static_cast<T>(result);
+    return true;
+}
+
+} // namespace
+
+void WriteBinaryHeader(std::ostream& stream)
+{
+    stream.write(binary_magic, sizeof(binary_magic) - 1);
+}
+
+void WriteBinary(std::ostream& stream, const Record& record)
+{
+    WriteLE<std::uint64_t>(stream, record.timestamp_ns);
+    WriteLE<std::uint32_t>(stream, static_cast<std::uint32_t>(record.thread_id));
+    WriteLE<std::uint8_t>(stream, static_cast<std::uint8_t>(record.level));
+    WriteLE<std::uint32_t>(stream, static_cast<std::uint32_t>(record.message.size()));
+    stream.write(record.message.data(), record.message.size());
+}
+
+bool ReadBinaryHeader(std::istream& stream)
+{
+    char magic[sizeof(binary_magic) - 1];
+    return stream.read(magic, sizeof(magic)) &&
+           std::equal(std::begin(magic), std::end(magic), binary_magic);
+}
+
+bool ReadBinary(std::istream& stream, Record& record)
+{
+    std::uint32_t thread_id;
+    std::uint8_t level;
+    std::uint32_t size;
+    if(!ReadLE(stream, record.timestamp_ns) || !ReadLE(stream, thread_id) ||
+       !ReadLE(stream, level) || !ReadLE(stream, size))
+        return false;
+    record.thread_id = static_cast<std::int32_t>(thread_id);
+    record.level     = static_cast<LoggingLevel>(level);
+    record.message.resize(size);
+    return static_cast<bool>(stream.read(&record.message[0], size));
+}
+
+Admission::Admission(std::uint64_t rate_limit_, std::uint64_t sampling_)
+    : rate_limit(rate_limit_), sampling(sampling_)
+{
+}
+
+bool Admission::Admit(std::uint64_t timestamp_ns)
+{
+    // Sampled out messages are not reported as dropped, that would defeat the purpose.
+    if(sampling > 1 && sampled.fetch_add(1, std::memory_order_relaxed) % sampling != 0)
+        return false;
+    if(rate_limit == 0)
+        return true;
+
+    const auto now = timestamp_ns / 1000000000;
+    auto current   = second.load(std::memory_order_relaxed);
+    if(current != now && second.compare_exchange_strong(current, now, std::memory_order_relaxed))
+        in_second.store(0, std::memory_order_relaxed);
+    if(in_second.fetch_add(1, std::memory_order_relaxed) < rate_limit)
+        return true;
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+namespace {
+
+constexpr std::size_t ring_capacity = 4096;
+
+// Set when the sink is destroyed at exit, later messages are written directly.
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<bool> sink_destroyed{false};
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<std::uint64_t> overflows{0};
+
+std::uint64_t Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+Admission& GetLimiter()
+{
+    static Admission limiter{Value(ENV(MIOPEN_LOG_RATE_LIMIT)), 0};
+    return limiter;
+}
+
+Admission& GetSampler()
+{
+    static Admission sampler{0, Value(ENV(MIOPEN_LOG_SAMPLING))};
+    return sampler;
+}
+
+std::uint64_t TakeDropped()
+{
+    // Avoid writing into the shared counter on every message.
+    const auto overflown = overflows.load(std::memory_order_relaxed) == 0
+                               ? 0
+                               : overflows.exchange(0, std::memory_order_relaxed);
+    return GetLimiter().TakeDropped() + overflown;
+}
+
+std::string DroppedMessage(std::uint64_t dropped)
+{
+    return "Warning [LogMessage] " + std::to_string(dropped) + " log messages dropped";
+}
+
+const std::string& GetBinaryPath()
+{
+    static const auto path = GetStringEnv(ENV(MIOPEN_LOG_BINARY_FILE));
+    return path;
+}
+
+bool IsAsync()
+{
+    static const auto async = IsEnabled(ENV(MIOPEN_LOG_ASYNC)) || !GetBinaryPath().empty();
+    return async && !sink_destroyed.load(std::memory_order_acquire);
+}
+
+class AsyncSink
+{
+public:
+    static AsyncSink& Get()
+    {
+        static AsyncSink sink;
+        return sink;
+    }
+
+    AsyncSink(const AsyncSink&) = delete;
+    AsyncSink& operator=(const AsyncSink&) = delete;
+
+    void Push(Record&& record)
+    {
+        auto& ring = LocalRing();
+        if(const auto dropped = TakeDropped())
+        {
+            if(!ring.TryPush({record.timestamp_ns,
+                              record.thread_id,
+                              LoggingLevel::Warning,
+                              DroppedMessage(dropped)}))
+                overflows.fetch_add(dropped, std::memory_order_relaxed);
+        }
+        if(!ring.TryPush(std::move(record)))
+            overflows.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Drain()
+    {
+        std::lock_guard<std::mutex> drain_lock(drain_mutex);
+        Collect();
+        WriteCollected();
+    }
+
+    /// Writes the record right away, after everything queued before it. The record does not go
+    /// through the ring, so it is not lost when the ring is full.
+    void WriteNow(Record&& record)
+    {
+        std::lock_guard<std::mutex> drain_lock(drain_mutex);
+        Collect();
+        if(const auto dropped = TakeDropped())
+        {
+            records.push_back({record.timestamp_ns,
+                               record.thread_id,
+                               LoggingLevel::Warning,
+                               DroppedMessage(dropped)});
+        }
+        records.push_back(std::move(record));
+        WriteCollected();
+    }
+
+private:
+    AsyncSink()
+    {
+        if(!GetBinaryPath().empty())
+        {
+            binary.open(GetBinaryPath(), std::ios::binary | std::ios::trunc);
+            if(binary)
+                WriteBinaryHeader(binary);
+            else
+                std::cerr << LoggingPrefix() << "Warning [AsyncSink] Unable to open "
+                          << GetBinaryPath() << ", logging to stderr" << std::endl;
+        }
+        writer = std::thread([this]() {
+            std::unique_lock<std::mutex> lock(stop_mutex);
+            while(!stop_cv.wait_for(lock, std::chrono::milliseconds{10}, [&]() { return stop; }))
+            {
+                lock.unlock();
+                Drain();
+                lock.lock();
+            }
+        });
+    }
+
+    ~AsyncSink()
+    {
+        {
+            std::lock_guard<std::mutex> lock(stop_mutex);
+            stop = true;
+        }
+        stop_cv.notify_one();
+        writer.join();
+        sink_destroyed.store(true, std::memory_order_release);
+        Drain();
+    }
+
+    // Moves the records of all rings to records, drain_mutex must be held.
+    void Collect()
+    {
+        std::lock_guard<std::mutex> rings_lock(rings_mutex);
+        const auto collect = [&](Record&& record) { records.push_back(std::move(record)); };
+        for(auto it = rings.begin(); it != rings.end();)
+        {
+            // Check before popping, a thread may push right before it exits.
+            const auto closed = (*it)->IsClosed();
+            (*it)->PopAll(collect);
+            it = closed ? rings.erase(it) : std::next(it);
+        }
+    }
+
+    // drain_mutex must be held.
+    void WriteCollected()
+    {
+        if(records.empty())
+            return;
+
+        // Rings are drained one after another, restore the order of messages.
+        std::stable_sort(records.begin(), records.end(), [](const auto& l, const auto& r) {
+            return l.timestamp_ns < r.timestamp_ns;
+        });
+
+        if(binary.is_open())
+        {
+            for(const auto& record : records)
+                WriteBinary(binary, record);
+            binary.flush();
+        }
+        else
+        {
+            std::ostringstream ss;
+            for(const auto& record : records)
+            {
+                const auto diff = prev_timestamp_ns == 0 || record.timestamp_ns < prev_timestamp_ns
+                                      ? 0.0f
+                                      : (record.timestamp_ns - prev_timestamp_ns) * 1e-6f;
+                prev_timestamp_ns = record.timestamp_ns;
+                ss << LoggingPrefix(record.thread_id, diff) << record.message << '\n';
+            }
+            std::cerr << ss.str() << std::flush;
+        }
+        records.clear();
+    }
+
+    Ring& LocalRing()
+    {
+        struct Owner
+        {
+            std::shared_ptr<Ring> ring;
+            ~Owner()
+            {
+                if(ring)
+                    ring->Close();
+            }
+        };
+
+        thread_local Owner owner;
+        if(!owner.ring)
+        {
+            owner.ring = std::make_shared<Ring>(ring_capacity);
+            std::lock_guard<std::mutex> lock(rings_mutex);
+            rings.push_back(owner.ring);
+        }
+        return *owner.ring;
+    }
+
+    std::mutex rings_mutex;
+    std::vector<std::shared_ptr<Ring>> rings;
+
+    std::mutex drain_mutex;
+    std::vector<Record> records;
+    std::ofstream binary;
+    std::uint64_t prev_timestamp_ns = 0;
+
+    std::mutex stop_mutex;
+    std::condition_variable stop_cv;
+    bool stop = false;
+    std::thread writer;
+};
+
+} // namespace
+} // namespace log_sink
+
+bool IsLogAdmitted(const LoggingLevel level)
+{
+    // Errors and warnings are never dropped.
+    if(static_cast<int>(level) < static_cast<int>(LoggingLevel::Info))
+        return true;
+    const auto now = log_sink::Now();
+    if(level != LoggingLevel::Info && !log_sink::GetSampler().Admit(now))
+        return false;
+    return log_sink::GetLimiter().Admit(now);
+}
+
+void LogMessage(const LoggingLevel level, std::string message)
+{
+    using namespace log_sink;
+
+    if(!IsAsync())
+    {
+        std::ostringstream ss;
+        if(const auto dropped = TakeDropped())
+            ss << LoggingPrefix() << DroppedMessage(dropped) << '\n';
+        ss << LoggingPrefix() << message << std::endl;
+        std::cerr << ss.str();
+        return;
+    }
+
+    thread_local const auto thread_id = LoggingThreadId();
+    auto& sink                        = AsyncSink::Get();
+    // Errors are often followed by an exception or abort, do not hold them back.
+    if(level == LoggingLevel::Fatal || level == LoggingLevel::Error)
+        sink.WriteNow({Now(), thread_id, level, std::move(message)});
+    else
+        sink.Push({Now(), thread_id, level, std::move(message)});
+}
+
+} // namespace miopen
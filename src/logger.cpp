@@ -92,18 +92,6 @@ inline bool operator>(const int& lhs, const LoggingLevel& rhs)
     return lhs > static_cast<int>(rhs);
 }
 
-/// Returns value which uniquiely identifies current process/thread
-/// and can be printed into logs for MP/MT environments.
-inline int GetProcessAndThreadId()
-{
-#ifdef __linux__
-    // LWP is fine for identifying both processes and threads.
-    return syscall(SYS_gettid); // NOLINT
-#else
-    return 0; // Not implemented.
-#endif
-}
-
 inline float GetTimeDiff()
 {
     // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
@@ -117,6 +105,18 @@ inline float GetTimeDiff()
 
 } // namespace
 
+/// Returns value which uniquiely identifies current process/thread
+/// and can be printed into logs for MP/MT environments.
+int LoggingThreadId()
+{
+#ifdef __linux__
+    // LWP is fine for identifying both processes and threads.
+    return syscall(SYS_gettid); // NOLINT
+#else
+    return 0; // Not implemented.
+#endif
+}
+
 bool IsLoggingDebugQuiet()
 {
     return debug::LoggingQuiet && !miopen::IsEnabled(ENV(MIOPEN_DEBUG_LOGGING_QUIETING_DISABLE));
@@ -165,17 +165,37 @@ const char* LoggingLevelToCString(const LoggingLevel level)
     default: return "<Unknown>";
     }
 }
-bool IsLoggingCmd()
+static bool IsPrintingCmd()
 {
     return miopen::IsEnabled(ENV(MIOPEN_ENABLE_LOGGING_CMD)) && !IsLoggingDebugQuiet();
 }
 
+bool IsLoggingCmd() { return IsPrintingCmd() || capture::IsEnabled(); }
+
+void LogDriverCommand(const char* func, const char* pretty_func, const std::string& args)
+{
+    if(IsPrintingCmd())
+    {
+        std::ostringstream ss;
+        ss << "Command [" << LoggingParseFunction(func, pretty_func) << "] ./bin/MIOpenDriver "
+           << args;
+        LogMessage(LoggingLevel::Info, ss.str());
+    }
+    capture::Record(args);
+}
+
 std::string LoggingPrefix()
+{
+    const auto elapsed_time = miopen::IsEnabled(ENV(MIOPEN_ENABLE_LOGGING_ELAPSED_TIME));
+    return LoggingPrefix(LoggingThreadId(), elapsed_time ? GetTimeDiff() : 0.0f);
+}
+
+std::string LoggingPrefix(const int thread_id, const float time_diff_ms)
 {
     std::stringstream ss;
     if(miopen::IsEnabled(ENV(MIOPEN_ENABLE_LOGGING_MPMT)))
     {
-        ss << GetProcessAndThreadId() << ' ';
+        ss << thread_id << ' ';
     }
     ss << "MIOpen";
 #if MIOPEN_BACKEND_OPENCL
@@ -185,7 +205,7 @@ std::string LoggingPrefix()
 #endif
     if(miopen::IsEnabled(ENV(MIOPEN_ENABLE_LOGGING_ELAPSED_TIME)))
     {
-        ss << std::fixed << std::setprecision(3) << std::setw(8) << GetTimeDiff();
+        ss << std::fixed << std::setprecision(3) << std::setw(8) << time_diff_ms;
     }
     ss << ": ";
     return ss.str();
@@ -28,7 +28,9 @@
 #include <miopen/config.h>
 #include <miopen/handle.hpp>
 #include <miopen/binary_cache.hpp>
+#include <miopen/conv/async_find.hpp>
 #include <miopen/target_properties.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle_lock.hpp>
 #include <miopen/invoker.hpp>
@@ -51,20 +53,71 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <thread>
 #include <miopen/nogpu/handle_impl.hpp>
+#include <miopen/nogpu/host_kernels.hpp>
+
+/// Executes kernels on the host instead of only building them. Memory is allocated in the host
+/// memory and only kernels having host implementations (see host_kernels.hpp) can be run.
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_NOGPU_HOST_EXECUTION)
 
 namespace miopen {
 
+namespace {
+
+void* host_allocator(void*, size_t sz) { return std::malloc(sz); }
+
+void host_deallocator(void*, void* mem) { std::free(mem); }
+
+std::size_t GetHostMemorySize()
+{
+#ifndef _WIN32
+    return static_cast<std::size_t>(sysconf(_SC_PHYS_PAGES)) *
+           static_cast<std::size_t>(sysconf(_SC_PAGE_SIZE));
+#else
+    return 0;
+#endif
+}
+
+// Kernels are not built in the host execution mode. Only the name, the build options and the
+// launch dimensions are kept, the name is used to find the host implementation when the kernel is
+// run and the rest is passed to it.
+Kernel MakeHostKernel(const std::string& kernel_name,
+                      const std::string& params,
+                      const std::vector<size_t>& vld,
+                      const std::vector<size_t>& vgd)
+{
+    assert(!vld.empty() && vld.size() <= 3);
+    assert(!vgd.empty() && vgd.size() <= 3);
+    if(host::GetKernel(kernel_name) == nullptr)
+        MIOPEN_LOG_W("No host implementation of kernel: " << kernel_name);
+    auto kernel        = Kernel{};
+    kernel.name        = kernel_name;
+    kernel.trace_name  = trace::Intern(kernel_name);
+    kernel.host_params = params;
+    kernel.ldims.fill(1);
+    kernel.gdims.fill(1);
+    std::copy(vld.begin(), vld.end(), kernel.ldims.begin());
+    std::copy(vgd.begin(), vgd.end(), kernel.gdims.begin());
+    return kernel;
+}
+
+} // namespace
+
 Handle::Handle(miopenAcceleratorQueue_t /* stream */) : Handle::Handle() {}
 
 Handle::Handle() : impl(new HandleImpl())
 {
-    this->impl->target_properties.Init(this);
+    if(miopen::IsEnabled(ENV(MIOPEN_NOGPU_HOST_EXECUTION)))
+        this->SetHostExecution(true);
+    else
+        this->impl->target_properties.Init(this);
     MIOPEN_LOG_NQI(*this);
 }
 
-Handle::~Handle() {}
+Handle::~Handle() { conv::ReleaseAsyncFinds(*this); }
 
 void Handle::SetStream(miopenAcceleratorQueue_t /* streamID */) const {}
 
@@ -73,33 +126,134 @@ void Handle::ReserveExtraStreamsInPool(int) const {}
 
 miopenAcceleratorQueue_t Handle::GetStream() const { return {}; }
 
-void Handle::SetAllocator(miopenAllocatorFunction /* allocator */,
-                          miopenDeallocatorFunction /* deallocator */,
-                          void* /* allocatorContext */) const
+void Handle::SetAllocator(miopenAllocatorFunction allocator,
+                          miopenDeallocatorFunction deallocator,
+                          void* allocatorContext) const
+{
+    if(!this->impl->host_execution)
+        return;
+
+    if(allocator == nullptr)
+        allocator = host_allocator;
+    if(deallocator == nullptr)
+        deallocator = host_deallocator;
+
+    this->impl->workspace.Release();
+    this->impl->caching_allocator =
+        CachingAllocator::CreateIfEnabled(allocator, deallocator, allocatorContext);
+
+    if(this->impl->caching_allocator)
+        this->impl->allocator = this->impl->caching_allocator->AsAllocator();
+    else
+        this->impl->allocator = Allocator{allocator, deallocator, allocatorContext};
+}
+
+void Handle::SetHostExecution(bool enable)
 {
+    if(this->impl->host_execution == enable)
+        return;
+
+    // Kernels prepared in one mode can not be run in the other one.
+    this->impl->cache = KernelCache{};
+    this->invokers    = InvokerCache{};
+    this->impl->workspace.Release();
+
+    this->impl->host_execution       = enable;
+    this->impl->device_name          = enable ? "cpu" : "";
+    this->impl->num_cu               = enable ? std::thread::hardware_concurrency() : 0;
+    this->impl->local_mem_size       = enable ? static_cast<std::size_t>(64) * 1024 : 0;
+    this->impl->global_mem_size      = enable ? GetHostMemorySize() : 0;
+    this->m_MaxMemoryAllocSizeCached = 0;
+    if(enable)
+    {
+        this->SetAllocator(nullptr, nullptr, nullptr);
+    }
+    else
+    {
+        this->impl->caching_allocator = nullptr;
+        this->impl->allocator         = Allocator{};
+    }
+    this->impl->target_properties.Init(this);
 }
 
-void Handle::EnableProfiling(bool enable) const { this->impl->enable_profiling = enable; }
+void Handle::EnableProfiling(bool enable) const { this->impl->profiling->enabled = enable; }
 
-float Handle::GetKernelTime() const { return this->impl->profiling_result; }
+float Handle::GetKernelTime() const { return this->impl->profiling->result; }
 
 Allocator::ManageDataPtr Handle::Create(std::size_t sz) const { return this->impl->allocator(sz); }
 
+Data_t Handle::GetWorkspace(std::size_t sz) const
+{
+    return this->impl->workspace.Get(this->impl->allocator, sz);
+}
+
+void Handle::TrimMemory() const
+{
+    this->impl->workspace.Release();
+    if(this->impl->caching_allocator)
+        this->impl->caching_allocator->Trim();
+}
+
+bool Handle::IsAllocatorCaching() const { return this->impl->caching_allocator != nullptr; }
+
+CachingAllocator::Statistics Handle::GetAllocatorStatistics() const
+{
+    if(this->impl->caching_allocator)
+        return this->impl->caching_allocator->GetStatistics();
+    return {};
+}
+
+void Handle::BeginCapture(std::vector<ExecutionPlan::Binding> bindings) const
+{
+    if(this->impl->recorder)
+        MIOPEN_THROW(miopenStatusBadParm, "The handle is already capturing");
+    this->impl->recorder = std::make_unique<ExecutionPlanRecorder>(std::move(bindings));
+}
+
+ExecutionPlan Handle::EndCapture() const
+{
+    if(!this->impl->recorder)
+        MIOPEN_THROW(miopenStatusBadParm, "The handle is not capturing");
+    const auto recorder = std::move(this->impl->recorder);
+    return recorder->Finish();
+}
+
+void Handle::MarkCaptureUnsupported(const char* operation) const
+{
+    if(this->impl->recorder)
+        this->impl->recorder->MarkUnsupported(operation);
+}
+
 Allocator::ManageDataPtr&
-Handle::WriteTo(const void* /* data */, Allocator::ManageDataPtr& ddata, std::size_t /* sz */) const
+Handle::WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t sz) const
 {
+    if(this->impl->recorder)
+        this->impl->recorder->MarkUnsupported("Buffer write");
+    if(this->impl->host_execution)
+        std::memcpy(ddata.get(), data, sz);
     return ddata;
 }
 
-void Handle::ReadTo(void* /* data */,
-                    const Allocator::ManageDataPtr& /* ddata */,
-                    std::size_t /* sz */) const
+void Handle::ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size_t sz) const
 {
+    this->ReadTo(data, ddata.get(), sz);
 }
 
-void Handle::ReadTo(void* /* data */, ConstData_t /* ddata */, std::size_t /* sz */) const {}
+void Handle::ReadTo(void* data, ConstData_t ddata, std::size_t sz) const
+{
+    if(this->impl->recorder)
+        this->impl->recorder->MarkUnsupported("Buffer read");
+    if(this->impl->host_execution)
+        std::memcpy(data, ddata, sz);
+}
 
-void Handle::Copy(ConstData_t /* src */, Data_t /* dest */, std::size_t /* size */) const {}
+void Handle::Copy(ConstData_t src, Data_t dest, std::size_t size) const
+{
+    if(this->impl->recorder)
+        this->impl->recorder->MarkUnsupported("Buffer copy");
+    if(this->impl->host_execution)
+        std::memcpy(dest, src, size);
+}
 
 KernelInvoke Handle::AddKernel(const std::string& algorithm,
                                const std::string& network_config,
@@ -111,6 +265,14 @@ KernelInvoke Handle::AddKernel(const std::string& algorithm,
                                std::size_t cache_index,
                                const std::string& kernel_src) const
 {
+    if(this->impl->host_execution)
+    {
+        const auto kernel = MakeHostKernel(kernel_name, params, vld, vgd);
+        if(!network_config.empty() && !algorithm.empty())
+            this->impl->cache.AddKernel({algorithm, network_config}, kernel, cache_index);
+        return this->Run(kernel);
+    }
+
     auto obj = this->impl->cache.AddKernel(*this,
                                            algorithm,
                                            network_config,
@@ -131,6 +293,11 @@ Invoker Handle::PrepareInvoker(const InvokerFactory& factory,
     for(auto& k : kernels)
     {
         MIOPEN_LOG_I2("Preparing kernel: " << k.kernel_name);
+        if(this->impl->host_execution)
+        {
+            built.push_back(MakeHostKernel(k.kernel_name, k.comp_options, k.l_wk, k.g_wk));
+            continue;
+        }
         const auto kernel = this->impl->cache.AddKernel(*this,
                                                         "",
                                                         "",
@@ -160,7 +327,38 @@ const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
 
-KernelInvoke Handle::Run(Kernel /* k */) const { return {}; }
+KernelInvoke Handle::Run(const Kernel& k) const
+{
+    if(!this->impl->host_execution)
+        return {};
+
+    auto invoke =
+        KernelInvoke{nullptr, nullptr, k.ldims, k.gdims, k.name, k.trace_name, nullptr};
+    const auto host_kernel = host::GetKernel(k.name);
+    invoke.recorder        = this->impl->recorder.get();
+    if(invoke.recorder != nullptr)
+        invoke.kernel = std::make_shared<const Kernel>(k);
+
+    invoke.host_fun = [profiling = this->impl->profiling,
+                       host_kernel,
+                       name   = k.name,
+                       launch = host::KernelLaunch{k.host_params, k.ldims, k.gdims}](
+                          const void* args, std::size_t size) {
+        if(host_kernel == nullptr)
+            MIOPEN_THROW(miopenStatusNotImplemented, "No host implementation of kernel: " + name);
+
+        const auto start = std::chrono::steady_clock::now();
+        auto reader      = host::KernelArgsReader{args, size};
+        host_kernel(launch, reader);
+        if(profiling->enabled)
+        {
+            profiling->result = std::chrono::duration<float, std::milli>(
+                                    std::chrono::steady_clock::now() - start)
+                                    .count();
+        }
+    };
+    return invoke;
+}
 
 Program Handle::LoadProgram(const std::string& program_name,
                             std::string params,
@@ -215,6 +413,8 @@ bool Handle::HasProgram(const std::string& program_name, const std::string& para
     return this->impl->cache.HasProgram(program_name, params);
 }
 
+std::size_t Handle::GetProgramLoadCount() const { return this->impl->cache.GetProgramLoadCount(); }
+
 void Handle::AddProgram(Program prog,
                         const std::string& program_name,
                         const std::string& params) const
@@ -222,13 +422,41 @@ void Handle::AddProgram(Program prog,
     this->impl->cache.AddProgram(prog, program_name, params);
 }
 
+std::string Handle::GetProgramBinary(const std::string& program_name,
+                                     const std::string& params) const
+{
+    auto program = this->impl->cache.GetProgram(program_name, params);
+    if(program.impl == nullptr)
+    {
+        program = this->LoadProgram(program_name, params, "");
+        this->impl->cache.AddProgram(program, program_name, params);
+    }
+    if(program.IsCodeObjectInMemory())
+        return program.GetCodeObjectBlob();
+    return miopen::LoadFile(program.GetCodeObjectPathname());
+}
+
+void Handle::AddProgramBinary(const std::string& program_name,
+                              const std::string& params,
+                              const std::string& binary) const
+{
+    // avoid the constructor since it implicitly calls the HIP API
+    auto pgmImpl     = std::make_shared<HIPOCProgramImpl>();
+    pgmImpl->program = program_name;
+    pgmImpl->target  = this->GetTargetProperties();
+    pgmImpl->binary  = std::vector<char>(binary.begin(), binary.end());
+    auto p           = HIPOCProgram{};
+    p.impl           = pgmImpl;
+    this->impl->cache.AddProgram(p, program_name, params);
+}
+
 void Handle::Finish() const {}
 void Handle::Flush() const {}
 
-bool Handle::IsProfilingEnabled() const { return this->impl->enable_profiling; }
+bool Handle::IsProfilingEnabled() const { return this->impl->profiling->enabled; }
 
-void Handle::ResetKernelTime() const { this->impl->profiling_result = 0.0; }
-void Handle::AccumKernelTime(float curr_time) const { this->impl->profiling_result += curr_time; }
+void Handle::ResetKernelTime() const { this->impl->profiling->result = 0.0; }
+void Handle::AccumKernelTime(float curr_time) const { this->impl->profiling->result += curr_time; }
 
 std::size_t Handle::GetLocalMemorySize() const { return this->impl->local_mem_size; }
 
@@ -258,6 +486,11 @@ const TargetProperties& Handle::GetTargetProperties() const
 std::string Handle::GetDeviceNameImpl() const { return this->impl->device_name; }
 std::string Handle::GetDeviceName() const { return this->impl->target_properties.Name(); }
 
+std::string Handle::GetDeviceKey() const
+{
+    return this->impl->host_execution ? "host" : "nogpu";
+}
+
 std::ostream& Handle::Print(std::ostream& os) const
 {
     os << "stream: " << this->impl->stream << ", device_id: " << this->impl->device;
@@ -278,7 +511,12 @@ shared<ConstData_t> Handle::CreateSubBuffer(ConstData_t data, std::size_t offset
 
 #if MIOPEN_USE_ROCBLAS
 
-const rocblas_handle_ptr& Handle::rhandle() const { return this->impl->rhandle_; }
+const rocblas_handle_ptr& Handle::rhandle() const
+{
+    if(this->impl->recorder)
+        this->impl->recorder->MarkUnsupported("rocBLAS call");
+    return this->impl->rhandle_;
+}
 
 rocblas_handle_ptr Handle::CreateRocblasHandle(miopenAcceleratorQueue_t) const
 {
@@ -0,0 +1,1349 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/nogpu/host_kernels.hpp>
+#include <miopen/miopen.h>
+#include <miopen/par_for.hpp>
+#include <miopen/bfloat16.hpp>
+
+#if !defined(_WIN32) && (HIP_PACKAGE_VERSION_FLAT >= 5006000000ULL)
+#include <half/half.hpp>
+#else
+#include <half.hpp>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+#include <unordered_map>
+
+namespace miopen {
+namespace host {
+namespace {
+
+// Host counterparts of the naive convolution kernels (gpu_reference_kernel/naive_conv.cpp).
+// They take exactly the same arguments, so ConvDirectNaiveConv{Fwd,Bwd,Wrw} invokers run
+// unchanged. 2D problems are handled as 3D ones with unit depth.
+
+enum class ConvDirection
+{
+    Fwd,
+    Bwd,
+    Wrw,
+};
+
+/// Strides of a tensor split into (N, G, C, D, H, W). For weights N and C stand for
+/// K_per_group and C_per_group respectively, for the output C stands for K_per_group.
+struct ConvStrides
+{
+    std::size_t batch   = 0;
+    std::size_t group   = 0;
+    std::size_t channel = 0;
+    std::array<std::size_t, 3> spatial{};
+};
+
+struct ConvArgs
+{
+    void* in  = nullptr;
+    void* wei = nullptr;
+    void* out = nullptr;
+    ConvStrides in_strides;
+    ConvStrides wei_strides;
+    ConvStrides out_strides;
+    int n           = 0;
+    int k_per_group = 0;
+    int c_per_group = 0;
+    int group       = 0;
+    std::array<int, 3> in_len{1, 1, 1};
+    std::array<int, 3> out_len{1, 1, 1};
+    std::array<int, 3> fil_len{1, 1, 1};
+    std::array<int, 3> stride{1, 1, 1};
+    std::array<int, 3> dilation{1, 1, 1};
+    std::array<int, 3> pad{0, 0, 0};
+};
+
+// The kernels receive strides right to left, see conv_internal::MakeStrideArray():
+// [W, H, (D), C, G, N] for NCHW, [C, G, W, H, (D), N] for NHWC,
+// [X, Y, (Z), C, K, G] and [C, X, Y, (Z), K, G] for the respective weights.
+template <std::size_t N>
+ConvStrides DecodeDataStrides(const std::array<std::size_t, N>& s, bool nhwc)
+{
+    constexpr std::size_t spatial_dims = N - 3;
+    ConvStrides result;
+    for(std::size_t i = 0; i < spatial_dims; ++i)
+        result.spatial[3 - spatial_dims + i] = s[(nhwc ? 2 : 0) + spatial_dims - 1 - i];
+    result.channel = nhwc ? s[0] : s[spatial_dims];
+    result.group   = nhwc ? s[1] : s[spatial_dims + 1];
+    result.batch   = s[spatial_dims + 2];
+    return result;
+}
+
+template <std::size_t N>
+ConvStrides DecodeWeiStrides(const std::array<std::size_t, N>& s, bool nhwc)
+{
+    constexpr std::size_t spatial_dims = N - 3;
+    ConvStrides result;
+    for(std::size_t i = 0; i < spatial_dims; ++i)
+        result.spatial[3 - spatial_dims + i] = s[(nhwc ? 1 : 0) + spatial_dims - 1 - i];
+    result.channel = nhwc ? s[0] : s[spatial_dims];
+    result.batch   = s[spatial_dims + 1];
+    result.group   = s[spatial_dims + 2];
+    return result;
+}
+
+template <std::size_t N>
+ConvArgs ReadConvArgs(KernelArgsReader& args, bool nhwc)
+{
+    static_assert(N == 5 || N == 6, "Only 2D and 3D convolutions are supported");
+    constexpr std::size_t first = 3 - (N - 3);
+
+    ConvArgs result;
+    result.in          = args.Next<void*>();
+    result.wei         = args.Next<void*>();
+    result.out         = args.Next<void*>();
+    result.in_strides  = DecodeDataStrides(args.Next<std::array<std::size_t, N>>(), nhwc);
+    result.wei_strides = DecodeWeiStrides(args.Next<std::array<std::size_t, N>>(), nhwc);
+    result.out_strides = DecodeDataStrides(args.Next<std::array<std::size_t, N>>(), nhwc);
+
+    const auto read_spatial = [&](std::array<int, 3>& dst) {
+        for(std::size_t i = first; i < 3; ++i)
+            dst[i] = args.Next<int>();
+    };
+
+    read_spatial(result.in_len);
+    result.n           = args.Next<int>();
+    result.k_per_group = args.Next<int>();
+    result.c_per_group = args.Next<int>();
+    read_spatial(result.out_len);
+    read_spatial(result.stride);
+    read_spatial(result.dilation);
+    read_spatial(result.pad);
+    read_spatial(result.fil_len);
+    result.group = args.Next<int>();
+    return result;
+}
+
+inline std::size_t SpatialOffset(const ConvStrides& strides, int d, int h, int w)
+{
+    return static_cast<std::size_t>(d) * strides.spatial[0] +
+           static_cast<std::size_t>(h) * strides.spatial[1] +
+           static_cast<std::size_t>(w) * strides.spatial[2];
+}
+
+/// Position in the input that corresponds to the output position o and the filter tap f,
+/// or -1 if the tap falls into the padding.
+inline int FwdInputPos(const ConvArgs& c, int dim, int o, int f)
+{
+    const auto pos = c.stride[dim] * o - c.pad[dim] + c.dilation[dim] * f;
+    return (pos < 0 || pos >= c.in_len[dim]) ? -1 : pos;
+}
+
+/// Position in the output that reads the input position i through the filter tap f,
+/// or -1 if there is none.
+inline int BwdOutputPos(const ConvArgs& c, int dim, int i, int f)
+{
+    const auto pos = i + c.pad[dim] - c.dilation[dim] * f;
+    if(pos < 0 || pos % c.stride[dim] != 0)
+        return -1;
+    return (pos / c.stride[dim] >= c.out_len[dim]) ? -1 : pos / c.stride[dim];
+}
+
+template <class TIn, class TAcc, class TOut>
+void ConvFwd(const ConvArgs& c)
+{
+    const auto& si = c.in_strides;
+    const auto& sw = c.wei_strides;
+    const auto& so = c.out_strides;
+
+    // One work item computes the whole output image of a single (g, n, k).
+    const auto items = static_cast<std::size_t>(c.group) * c.n * c.k_per_group;
+    par_for(items, 1, [&](std::size_t item) {
+        const auto ik = item % c.k_per_group;
+        const auto in = (item / c.k_per_group) % c.n;
+        const auto ig = item / (static_cast<std::size_t>(c.k_per_group) * c.n);
+
+        const auto* p_in  = static_cast<const TIn*>(c.in) + in * si.batch + ig * si.group;
+        const auto* p_wei = static_cast<const TIn*>(c.wei) + ig * sw.group + ik * sw.batch;
+        auto* p_out = static_cast<TOut*>(c.out) + in * so.batch + ig * so.group + ik * so.channel;
+
+        for(int od = 0; od < c.out_len[0]; ++od)
+        {
+            for(int oh = 0; oh < c.out_len[1]; ++oh)
+            {
+                for(int ow = 0; ow < c.out_len[2]; ++ow)
+                {
+                    TAcc value = 0;
+                    for(int iz = 0; iz < c.fil_len[0]; ++iz)
+                    {
+                        const auto cur_d = FwdInputPos(c, 0, od, iz);
+                        if(cur_d < 0)
+                            continue;
+                        for(int iy = 0; iy < c.fil_len[1]; ++iy)
+                        {
+                            const auto cur_h = FwdInputPos(c, 1, oh, iy);
+                            if(cur_h < 0)
+                                continue;
+                            for(int ix = 0; ix < c.fil_len[2]; ++ix)
+                            {
+                                const auto cur_w = FwdInputPos(c, 2, ow, ix);
+                                if(cur_w < 0)
+                                    continue;
+                                const auto* i_ptr =
+                                    p_in + SpatialOffset(si, cur_d, cur_h, cur_w);
+                                const auto* f_ptr = p_wei + SpatialOffset(sw, iz, iy, ix);
+                                for(int ic = 0; ic < c.c_per_group; ++ic)
+                                {
+                                    value += static_cast<TAcc>(i_ptr[ic * si.channel]) *
+                                             static_cast<TAcc>(f_ptr[ic * sw.channel]);
+                                }
+                            }
+                        }
+                    }
+                    p_out[SpatialOffset(so, od, oh, ow)] = static_cast<TOut>(value);
+                }
+            }
+        }
+    });
+}
+
+template <class TIn, class TAcc, class TOut>
+void ConvBwd(const ConvArgs& c)
+{
+    const auto& si = c.in_strides;
+    const auto& sw = c.wei_strides;
+    const auto& so = c.out_strides;
+
+    // One work item computes the whole input gradient image of a single (g, n, c).
+    const auto items = static_cast<std::size_t>(c.group) * c.n * c.c_per_group;
+    par_for(items, 1, [&](std::size_t item) {
+        const auto ic = item % c.c_per_group;
+        const auto in = (item / c.c_per_group) % c.n;
+        const auto ig = item / (static_cast<std::size_t>(c.c_per_group) * c.n);
+
+        auto* p_in = static_cast<TOut*>(c.in) + in * si.batch + ig * si.group + ic * si.channel;
+        const auto* p_wei = static_cast<const TIn*>(c.wei) + ig * sw.group + ic * sw.channel;
+        const auto* p_out = static_cast<const TIn*>(c.out) + in * so.batch + ig * so.group;
+
+        for(int id = 0; id < c.in_len[0]; ++id)
+        {
+            for(int ih = 0; ih < c.in_len[1]; ++ih)
+            {
+                for(int iw = 0; iw < c.in_len[2]; ++iw)
+                {
+                    TAcc value = 0;
+                    for(int iz = 0; iz < c.fil_len[0]; ++iz)
+                    {
+                        const auto cur_d = BwdOutputPos(c, 0, id, iz);
+                        if(cur_d < 0)
+                            continue;
+                        for(int iy = 0; iy < c.fil_len[1]; ++iy)
+                        {
+                            const auto cur_h = BwdOutputPos(c, 1, ih, iy);
+                            if(cur_h < 0)
+                                continue;
+                            for(int ix = 0; ix < c.fil_len[2]; ++ix)
+                            {
+                                const auto cur_w = BwdOutputPos(c, 2, iw, ix);
+                                if(cur_w < 0)
+                                    continue;
+                                const auto* o_ptr =
+                                    p_out + SpatialOffset(so, cur_d, cur_h, cur_w);
+                                const auto* f_ptr = p_wei + SpatialOffset(sw, iz, iy, ix);
+                                for(int ik = 0; ik < c.k_per_group; ++ik)
+                                {
+                                    value += static_cast<TAcc>(o_ptr[ik * so.channel]) *
+                                             static_cast<TAcc>(f_ptr[ik * sw.batch]);
+                                }
+                            }
+                        }
+                    }
+                    p_in[SpatialOffset(si, id, ih, iw)] = static_cast<TOut>(value);
+                }
+            }
+        }
+    });
+}
+
+template <class TIn, class TAcc, class TOut>
+void ConvWrw(const ConvArgs& c)
+{
+    const auto& si = c.in_strides;
+    const auto& sw = c.wei_strides;
+    const auto& so = c.out_strides;
+
+    // One work item computes all filter taps of a single (g, k, c).
+    const auto items = static_cast<std::size_t>(c.group) * c.k_per_group * c.c_per_group;
+    par_for(items, 1, [&](std::size_t item) {
+        const auto ic = item % c.c_per_group;
+        const auto ik = (item / c.c_per_group) % c.k_per_group;
+        const auto ig = item / (static_cast<std::size_t>(c.c_per_group) * c.k_per_group);
+
+        const auto* p_in  = static_cast<const TIn*>(c.in) + ig * si.group + ic * si.channel;
+        const auto* p_out = static_cast<const TIn*>(c.out) + ig * so.group + ik * so.channel;
+        auto* p_wei = static_cast<TOut*>(c.wei) + ig * sw.group + ik * sw.batch + ic * sw.channel;
+
+        for(int iz = 0; iz < c.fil_len[0]; ++iz)
+        {
+            for(int iy = 0; iy < c.fil_len[1]; ++iy)
+            {
+                for(int ix = 0; ix < c.fil_len[2]; ++ix)
+                {
+                    TAcc value = 0;
+                    for(int in = 0; in < c.n; ++in)
+                    {
+                        for(int od = 0; od < c.out_len[0]; ++od)
+                        {
+                            const auto cur_d = FwdInputPos(c, 0, od, iz);
+                            if(cur_d < 0)
+                                continue;
+                            for(int oh = 0; oh < c.out_len[1]; ++oh)
+                            {
+                                const auto cur_h = FwdInputPos(c, 1, oh, iy);
+                                if(cur_h < 0)
+                                    continue;
+                                const auto* i_ptr =
+                                    p_in + in * si.batch + SpatialOffset(si, cur_d, cur_h, 0);
+                                const auto* o_ptr =
+                                    p_out + in * so.batch + SpatialOffset(so, od, oh, 0);
+                                for(int ow = 0; ow < c.out_len[2]; ++ow)
+                                {
+                                    const auto cur_w = FwdInputPos(c, 2, ow, ix);
+                                    if(cur_w < 0)
+                                        continue;
+                                    value += static_cast<TAcc>(i_ptr[cur_w * si.spatial[2]]) *
+                                             static_cast<TAcc>(o_ptr[ow * so.spatial[2]]);
+                                }
+                            }
+                        }
+                    }
+                    p_wei[SpatialOffset(sw, iz, iy, ix)] = static_cast<TOut>(value);
+                }
+            }
+        }
+    });
+}
+
+template <ConvDirection direction, bool nhwc, std::size_t N, class TIn, class TAcc, class TOut>
+void NaiveConv(const KernelLaunch&, KernelArgsReader& args)
+{
+    const auto conv = ReadConvArgs<N>(args, nhwc);
+    if constexpr(direction == ConvDirection::Fwd)
+        ConvFwd<TIn, TAcc, TOut>(conv);
+    else if constexpr(direction == ConvDirection::Bwd)
+        ConvBwd<TIn, TAcc, TOut>(conv);
+    else
+        ConvWrw<TIn, TAcc, TOut>(conv);
+}
+
+/// Calls f with a value of the element type selected by the MIOPEN_USE_* build options.
+template <bool with_integers = false, class F>
+void VisitDataType(const KernelLaunch& launch, F&& f)
+{
+    if(launch.GetDefineInt("MIOPEN_USE_FP32") != 0)
+        return f(float{});
+    if(launch.GetDefineInt("MIOPEN_USE_FP16") != 0)
+        return f(half_float::half{});
+    if(launch.GetDefineInt("MIOPEN_USE_BFP16") != 0)
+        return f(bfloat16{});
+    if constexpr(with_integers)
+    {
+        if(launch.GetDefineInt("MIOPEN_USE_INT8") != 0)
+            return f(int8_t{});
+        if(launch.GetDefineInt("MIOPEN_USE_INT32") != 0)
+            return f(int32_t{});
+    }
+    MIOPEN_THROW(miopenStatusNotImplemented,
+                 "Host kernels do not support the data type: " + launch.params);
+}
+
+template <class T>
+T* NextPointer(KernelArgsReader& args)
+{
+    return static_cast<T*>(args.Next<void*>());
+}
+
+// Host counterparts of MIOpenActiveFwdLite and MIOpenActiveFwd2DLite (MIOpenNeuron.cl).
+
+float Activate(int mode, float x, float gamma, float beta, float alpha, float eps)
+{
+    switch(mode)
+    {
+    case miopenActivationPASTHRU: return x;
+    case miopenActivationLOGISTIC: return 1.f / (1.f + std::exp(-x));
+    case miopenActivationTANH: return beta * std::tanh(alpha * x);
+    case miopenActivationRELU: return x * static_cast<float>(x > 0);
+    case miopenActivationSOFTRELU:
+        return x > 0 ? x + std::log(1.f + std::exp(-x)) : std::log(1.f + std::exp(x));
+    case miopenActivationABS: return std::fabs(x);
+    case miopenActivationPOWER: {
+        const auto arg = alpha + x * beta;
+        return arg <= eps ? 0.f : std::pow(arg, gamma);
+    }
+    case miopenActivationCLIPPEDRELU: return std::fmin(alpha, std::fmax(x, 0.f));
+    case miopenActivationLEAKYRELU: return x * (x > 0 ? 1.f : alpha);
+    case miopenActivationELU: return x > 0 ? x : alpha * (std::exp(x) - 1.f);
+    default: return x;
+    }
+}
+
+template <bool is2d>
+void ActivationFwd(const KernelLaunch& launch, KernelArgsReader& args)
+{
+    const auto mode = static_cast<int>(launch.GetDefineInt("MIOPEN_NRN_OP_ID", -1));
+    if(mode < miopenActivationPASTHRU || mode > miopenActivationELU)
+        MIOPEN_THROW(miopenStatusNotImplemented, "Unsupported activation mode on the host");
+
+    VisitDataType(launch, [&](auto type) {
+        using T        = decltype(type);
+        const auto* x  = NextPointer<const T>(args);
+        auto* y        = NextPointer<T>(args);
+        const auto gamma = static_cast<float>(args.Next<T>());
+        const auto beta  = static_cast<float>(args.Next<T>());
+        const auto alpha = static_cast<float>(args.Next<T>());
+        x += args.Next<long long>();
+        y += args.Next<long long>();
+        const auto x_stride = is2d ? args.Next<unsigned int>() : 0U;
+        const auto y_stride = is2d ? args.Next<unsigned int>() : 0U;
+
+        const auto eps    = std::is_same<T, half_float::half>{} ? 1e-4f : 1e-6f;
+        const auto width  = launch.gdims[0] * launch.GetDefineInt("MIOPEN_READ_UNIT", 1);
+        const auto height = is2d ? launch.gdims[1] : 1;
+        par_for(width * height, [&](std::size_t i) {
+            const auto row = i / width;
+            const auto col = i % width;
+            const auto value = Activate(
+                mode, static_cast<float>(x[row * x_stride + col]), gamma, beta, alpha, eps);
+            y[row * y_stride + col] = static_cast<T>(value);
+        });
+    });
+}
+
+// Host counterparts of MIOpenActiveBwdLite and MIOpenActiveBwd2DLite (activation_functions.h).
+
+float ActivateDiff(int mode,
+                   float dy,
+                   float x,
+                   float y,
+                   float diff_scale,
+                   float beta,
+                   float alpha,
+                   float eps)
+{
+    switch(mode)
+    {
+    case miopenActivationPASTHRU: return dy;
+    case miopenActivationLOGISTIC: return dy * y * (1.f - y);
+    case miopenActivationTANH:
+        return std::fabs(beta) <= eps ? 0.f : dy * alpha * (beta - y * y / beta);
+    case miopenActivationRELU: return dy * static_cast<float>(x > 0);
+    case miopenActivationSOFTRELU: {
+        const auto expval = std::exp(std::fmin(x, 50.f));
+        return dy * expval / (expval + 1.f);
+    }
+    case miopenActivationABS: return dy * (x > 0 ? 1.f : -1.f);
+    case miopenActivationPOWER: {
+        // The device kernel scales y instead of dy, mirror it.
+        const auto arg = alpha + x * beta;
+        return arg <= eps ? 0.f : diff_scale * y / arg;
+    }
+    case miopenActivationCLIPPEDRELU: return dy * (x > 0 && x <= alpha ? 1.f : 0.f);
+    case miopenActivationLEAKYRELU: return dy * (x > 0 ? 1.f : alpha);
+    case miopenActivationELU: return dy * (x > 0 ? 1.f : y + alpha);
+    default: return dy;
+    }
+}
+
+template <bool is2d>
+void ActivationBwd(const KernelLaunch& launch, KernelArgsReader& args)
+{
+    const auto mode = static_cast<int>(launch.GetDefineInt("MIOPEN_NRN_OP_ID", -1));
+    if(mode < miopenActivationPASTHRU || mode > miopenActivationELU)
+        MIOPEN_THROW(miopenStatusNotImplemented, "Unsupported activation mode on the host");
+
+    VisitDataType(launch, [&](auto type) {
+        using T               = decltype(type);
+        auto* dx              = NextPointer<T>(args);
+        const auto* dy        = NextPointer<const T>(args);
+        const auto* x         = NextPointer<const T>(args);
+        const auto* y         = NextPointer<const T>(args);
+        const auto diff_scale = static_cast<float>(args.Next<T>());
+        args.Next<T>(); // gamma only matters through diff_scale
+        const auto beta  = static_cast<float>(args.Next<T>());
+        const auto alpha = static_cast<float>(args.Next<T>());
+        dx += args.Next<long long>();
+        dy += args.Next<long long>();
+        x += args.Next<long long>();
+        y += args.Next<long long>();
+        const auto dx_stride = is2d ? args.Next<unsigned int>() : 0U;
+        const auto dy_stride = is2d ? args.Next<unsigned int>() : 0U;
+        const auto x_stride  = is2d ? args.Next<unsigned int>() : 0U;
+        const auto y_stride  = is2d ? args.Next<unsigned int>() : 0U;
+
+        const auto eps    = std::is_same<T, half_float::half>{} ? 1e-4f : 1e-6f;
+        const auto width  = launch.gdims[0] * launch.GetDefineInt("MIOPEN_READ_UNIT", 1);
+        const auto height = is2d ? launch.gdims[1] : 1;
+        par_for(width * height, [&](std::size_t i) {
+            const auto row   = i / width;
+            const auto col   = i % width;
+            const auto value = ActivateDiff(mode,
+                                            static_cast<float>(dy[row * dy_stride + col]),
+                                            static_cast<float>(x[row * x_stride + col]),
+                                            static_cast<float>(y[row * y_stride + col]),
+                                            diff_scale,
+                                            beta,
+                                            alpha,
+                                            eps);
+            dx[row * dx_stride + col] = static_cast<T>(value);
+        });
+    });
+}
+
+// Host counterparts of the generic tensor operation kernels (MIOpenTensorKernels.cl and
+// MIOpenTensorKernelsHip.cpp). The N-dimensional kernels are emulated work group by work group,
+// so the bitmap and the broadcasting of B are interpreted exactly as on the device.
+
+enum class TensorOp
+{
+    Add,
+    Mul,
+    Min,
+    Max,
+};
+
+TensorOp GetTensorOp(const KernelLaunch& launch)
+{
+    const auto op = launch.GetDefine("MIOPEN_TENSOR_OP");
+    if(op == "miopenAdd")
+        return TensorOp::Add;
+    if(op == "miopenMul")
+        return TensorOp::Mul;
+    if(op == "miopenMin")
+        return TensorOp::Min;
+    if(op == "miopenMax")
+        return TensorOp::Max;
+    MIOPEN_THROW(miopenStatusNotImplemented, "Unsupported tensor operation on the host: " + op);
+}
+
+inline float ApplyTensorOp(TensorOp op, float a, float b)
+{
+    switch(op)
+    {
+    case TensorOp::Add: return a + b;
+    case TensorOp::Mul: return a * b;
+    case TensorOp::Min: return a < b ? a : b;
+    case TensorOp::Max: return a > b ? a : b;
+    }
+    return a;
+}
+
+void Op1dTensorGeneric(const KernelLaunch& launch, KernelArgsReader& args)
+{
+    const auto op = GetTensorOp(launch);
+    VisitDataType(launch, [&](auto type) {
+        using T         = decltype(type);
+        const auto* a   = NextPointer<const T>(args);
+        const auto* b   = NextPointer<const T>(args);
+        auto* c         = NextPointer<T>(args);
+        a += args.Next<uint64_t>();
+        b += args.Next<uint64_t>();
+        c += args.Next<uint64_t>();
+        const auto a_stride   = args.Next<uint32_t>();
+        const auto b_stride   = args.Next<uint32_t>();
+        const auto c_stride   = args.Next<uint32_t>();
+        const auto alpha0     = static_cast<float>(args.Next<T>());
+        const auto alpha1     = static_cast<float>(args.Next<T>());
+        const auto beta       = static_cast<float>(args.Next<T>());
+        const auto total_work = args.Next<uint32_t>();
+        const auto use_beta   = args.Next<bool>();
+
+        par_for(total_work, [&](std::size_t i) {
+            auto& dst       = c[i * c_stride];
+            const auto res  = ApplyTensorOp(op,
+                                           static_cast<float>(a[i * a_stride]) * alpha0,
+                                           static_cast<float>(b[i * b_stride]) * alpha1);
+            dst             = static_cast<T>(use_beta ? static_cast<float>(dst) * beta + res : res);
+        });
+    });
+}
+
+/// The kernel for packed tensors of equal lengths. Each work item handles RD_BLCK elements.
+void Op4dTensorLite(const KernelLaunch& launch, KernelArgsReader& args)
+{
+    const auto op      = GetTensorOp(launch);
+    const auto rd_blck = launch.GetDefineInt("RD_BLCK", 1);
+    VisitDataType(launch, [&](auto type) {
+        using T               = decltype(type);
+        const auto* a         = NextPointer<const T>(args);
+        const auto* b         = NextPointer<const T>(args);
+        auto* c               = NextPointer<T>(args);
+        const auto alpha0     = static_cast<float>(args.Next<T>());
+        const auto alpha1     = static_cast<float>(args.Next<T>());
+        const auto beta       = static_cast<float>(args.Next<T>());
+        a += args.Next<int64_t>();
+        b += args.Next<int64_t>();
+        c += args.Next<int64_t>();
+        const auto total_work = args.Next<int64_t>();
+        const auto use_beta   = args.Next<int>() == 1;
+
+        par_for(static_cast<std::size_t>(std::max(total_work * rd_blck, 0LL)),
+                [&](std::size_t i) {
+                    const auto res = ApplyTensorOp(op,
+                                                   static_cast<float>(a[i]) * alpha0,
+                                                   static_cast<float>(b[i]) * alpha1);
+                    c[i] = static_cast<T>(use_beta ? static_cast<float>(c[i]) * beta + res : res);
+                });
+    });
+}
+
+/// Op2dTensorGeneric ... Op5dTensorGeneric. All of them receive the strides of A, the lengths and
+/// the strides of B, the lengths and the strides of C except the batch length and the innermost
+/// stride, which is 1.
+template <std::size_t N>
+void OpNdTensorGeneric(const KernelLaunch& launch, KernelArgsReader& args)
+{
+    const auto op = GetTensorOp(launch);
+    VisitDataType(launch, [&](auto type) {
+        using T = decltype(type);
+
+        std::array<int, N> a_strides{}, b_lens{}, b_strides{}, c_lens{}, c_strides{};
+        const auto read = [&](std::array<int, N>& dst, std::size_t first, std::size_t last) {
+            for(auto i = first; i < last; ++i)
+                dst[i] = args.Next<int>();
+        };
+
+        const auto* a = NextPointer<const T>(args);
+        read(a_strides, 0, N - 1);
+        const auto* b = NextPointer<const T>(args);
+        read(b_lens, 1, N);
+        read(b_strides, 0, N - 1);
+        auto* c = NextPointer<T>(args);
+        read(c_lens, 1, N);
+        read(c_strides, 0, N - 1);
+        a_strides[N - 1] = b_strides[N - 1] = c_strides[N - 1] = 1;
+
+        const auto alpha0      = static_cast<float>(args.Next<T>());
+        const auto alpha1      = static_cast<float>(args.Next<T>());
+        const auto beta        = static_cast<float>(args.Next<T>());
+        const auto bitmap      = args.Next<unsigned int>();
+        const auto work_per_wg = args.Next<int>();
+        a += args.Next<int64_t>();
+        b += args.Next<int64_t>();
+        c += args.Next<int64_t>();
+        const auto num_wg = args.Next<int>();
+
+        par_for(static_cast<std::size_t>(std::max(num_wg, 0)), [&](std::size_t gid) {
+            // Position of the B element handled by the work group, dim 0 takes the rest.
+            std::array<int, N> gid_pos{};
+            auto rest = static_cast<int>(gid);
+            for(auto d = N - 1; d > 0; --d)
+            {
+                gid_pos[d] = rest % b_lens[d];
+                rest /= b_lens[d];
+            }
+            gid_pos[0] = rest;
+
+            auto b_index = std::size_t{0};
+            for(std::size_t d = 0; d < N; ++d)
+                b_index += static_cast<std::size_t>(gid_pos[d]) * b_strides[d];
+            const auto operand = static_cast<float>(b[b_index]) * alpha1;
+
+            for(int lid = 0; lid < work_per_wg; ++lid)
+            {
+                auto a_index = std::size_t{0};
+                auto c_index = std::size_t{0};
+                auto div     = 1;
+                for(auto d = N; d-- > 0;)
+                {
+                    auto pos = 0;
+                    if((bitmap & (1U << (N - 1 - d))) != 0)
+                    {
+                        pos = gid_pos[d];
+                    }
+                    else
+                    {
+                        pos = d == 0 ? lid / div : (lid / div) % c_lens[d];
+                        div *= c_lens[d];
+                    }
+                    a_index += static_cast<std::size_t>(pos) * a_strides[d];
+                    c_index += static_cast<std::size_t>(pos) * c_strides[d];
+                }
+
+                const auto res =
+                    ApplyTensorOp(op, static_cast<float>(a[a_index]) * alpha0, operand);
+                c[c_index] = static_cast<T>(
+                    beta == 0.f ? res : res + beta * static_cast<float>(c[c_index]));
+            }
+        });
+    });
+}
+
+// Host counterparts of SubTensorOpWithScalar{1..5}d and SubTensorOpWithSubTensor{1..5}d used by
+// SetTensor, ScaleTensor and CopyTensor.
+
+template <std::size_t N>
+std::size_t ElementCount(const std::array<int, N>& lens)
+{
+    auto count = std::size_t{1};
+    for(const auto len : lens)
+        count *= std::max(len, 0);
+    return count;
+}
+
+template <std::size_t N>
+std::size_t
+StridedOffset(std::size_t i, const std::array<int, N>& lens, const std::array<int, N>& strides)
+{
+    auto offset = std::size_t{0};
+    for(auto d = N; d-- > 0;)
+    {
+        offset += (i % lens[d]) * strides[d];
+        i /= lens[d];
+    }
+    return offset;
+}
+
+template <std::size_t N>
+void SubTensorOpWithScalar(const KernelLaunch& launch, KernelArgsReader& args)
+{
+    const auto op = launch.GetDefine("SUBTENSOR_OP_WITH_SCALAR");
+    const auto multiply = op == "SUBTENSOR_OP_WITH_SCALAR_MULTIPLY";
+    if(!multiply && op != "SUBTENSOR_OP_WITH_SCALAR_SET")
+        MIOPEN_THROW(miopenStatusNotImplemented, "Unsupported sub-tensor operation: " + op);
+
+    VisitDataType<true>(launch, [&](auto type) {
+        using T           = decltype(type);
+        auto* dst         = NextPointer<T>(args);
+        const auto alpha  = args.Next<T>();
+        dst += args.Next<int>();
+        const auto strides = args.Next<std::array<int, N>>();
+        const auto lens    = args.Next<std::array<int, N>>();
+
+        par_for(ElementCount(lens), [&](std::size_t i) {
+            auto& value = dst[StridedOffset(i, lens, strides)];
+            if(!multiply)
+                value = alpha;
+            else if constexpr(std::is_integral<T>{})
+                value = static_cast<T>(value * alpha);
+            else
+                value = static_cast<T>(static_cast<float>(value) * static_cast<float>(alpha));
+        });
+    });
+}
+
+template <std::size_t N>
+void SubTensorOpWithSubTensor(const KernelLaunch& launch, KernelArgsReader& args)
+{
+    const auto op = launch.GetDefine("SUBTENSOR_OP_WITH_SUBTENSOR");
+    if(op != "SUBTENSOR_OP_WITH_SUBTENSOR_COPY")
+        MIOPEN_THROW(miopenStatusNotImplemented, "Unsupported sub-tensor operation: " + op);
+
+    VisitDataType<true>(launch, [&](auto type) {
+        using T                = decltype(type);
+        const auto* src        = NextPointer<const T>(args);
+        src += args.Next<int>();
+        const auto src_strides = args.Next<std::array<int, N>>();
+        const auto lens        = args.Next<std::array<int, N>>();
+        auto* dst              = NextPointer<T>(args);
+        dst += args.Next<int>();
+        const auto dst_strides = args.Next<std::array<int, N>>();
+
+        par_for(ElementCount(lens), [&](std::size_t i) {
+            dst[StridedOffset(i, lens, dst_strides)] = src[StridedOffset(i, lens, src_strides)];
+        });
+    });
+}
+
+// Host counterparts of SoftmaxForward and SoftmaxBackward (MIOpenSoftmax.cl). One work item
+// handles one softmax vector, i.e. one image in the instance mode and one pixel in the channel
+// mode.
+
+struct SoftmaxShape
+{
+    int vector_size;
+    int grid_size;
+    int spatial_dim;
+    int h;
+    int w;
+    bool instance;
+
+    std::size_t Index(int g, int i, bool packed, const std::array<int, 3>& strides) const
+    {
+        const auto n = g / spatial_dim;
+        const auto s = g % spatial_dim;
+        if(packed)
+            return static_cast<std::size_t>(n * vector_size + i) * spatial_dim + s;
+        if(instance)
+            return static_cast<std::size_t>(n) * strides[0] +
+                   static_cast<std::size_t>(i / (w * h)) * strides[1] +
+                   static_cast<std::size_t>((i % (w * h)) / w) * strides[2] + i % w;
+        return static_cast<std::size_t>(n) * strides[0] + static_cast<std::size_t>(i) * strides[1] +
+               static_cast<std::size_t>(s / w) * strides[2] + s % w;
+    }
+};
+
+SoftmaxShape NextSoftmaxShape(KernelArgsReader& args, bool instance)
+{
+    auto shape        = SoftmaxShape{};
+    shape.vector_size = args.Next<int>();
+    shape.grid_size   = args.Next<int>();
+    shape.spatial_dim = args.Next<int>();
+    shape.h           = args.Next<int>();
+    shape.w           = args.Next<int>();
+    shape.instance    = instance;
+    return shape;
+}
+
+inline float LogAddExp(float x, float y, float cutoff)
+{
+    const auto a = std::max(x, y);
+    if(a <= cutoff)
+        return cutoff;
+    const auto b = std::min(x, y);
+    if(b <= cutoff)
+        return a;
+    const auto c = b - a;
+    return c <= cutoff ? a : a + std::log(std::exp(c) + 1);
+}
+
+void SoftmaxForward(const KernelLaunch& launch, KernelArgsReader& args)
+{
+    const auto use_log   = launch.GetDefineInt("USE_SOFTMAX_LOG") != 0;
+    const auto fast      = launch.GetDefineInt("USE_SOFTMAX_FAST") != 0;
+    const auto instance  = launch.GetDefineInt("USE_SOFTMAX_MODE_INSTANCE") != 0;
+    const auto x_packed  = launch.GetDefineInt("IS_INPUT_PACKED", 1) != 0;
+    const auto y_packed  = launch.GetDefineInt("IS_OUTPUT_PACKED", 1) != 0;
+    const auto use_alpha = launch.GetDefineInt("USE_ALPHA") != 0;
+    const auto use_beta  = launch.GetDefineInt("USE_BETA") != 0;
+
+    VisitDataType(launch, [&](auto type) {
+        using T                = decltype(type);
+        const auto* x          = NextPointer<const T>(args);
+        auto* y                = NextPointer<T>(args);
+        const auto shape       = NextSoftmaxShape(args, instance);
+        const auto x_strides   = args.Next<std::array<int, 3>>();
+        const auto y_strides   = args.Next<std::array<int, 3>>();
+        x += args.Next<int>();
+        y += args.Next<int>();
+        const auto alpha = args.Next<float>();
+        const auto beta  = args.Next<float>();
+
+        const auto cutoff      = std::is_same<T, half_float::half>{} ? -1e4f : -1e20f;
+        const auto vector_size = shape.vector_size;
+
+        par_for(static_cast<std::size_t>(std::max(shape.grid_size, 0)), [&](std::size_t g) {
+            const auto index = [&](int i, bool packed, const std::array<int, 3>& strides) {
+                return shape.Index(static_cast<int>(g), i, packed, strides);
+            };
+            const auto x_at = [&](int i) {
+                return static_cast<float>(x[index(i, x_packed, x_strides)]);
+            };
+
+            auto channel_max = std::numeric_limits<float>::lowest();
+            if(!fast)
+            {
+                for(int i = 0; i < vector_size; ++i)
+                    channel_max = std::max(channel_max, x_at(i));
+            }
+
+            auto channel_sum = use_log ? cutoff : 0.f;
+            for(int i = 0; i < vector_size; ++i)
+            {
+                if(use_log)
+                    channel_sum = LogAddExp(x_at(i) - channel_max, channel_sum, cutoff);
+                else
+                    channel_sum += std::exp(fast ? x_at(i) : x_at(i) - channel_max);
+            }
+
+            for(int i = 0; i < vector_size; ++i)
+            {
+                auto value = fast ? x_at(i) : x_at(i) - channel_max;
+                value      = use_log ? value - channel_sum : std::exp(value) / channel_sum;
+                if(use_alpha)
+                    value *= alpha;
+                auto& dst = y[index(i, y_packed, y_strides)];
+                if(use_beta)
+                    value += static_cast<float>(dst) * beta;
+                dst = static_cast<T>(value);
+            }
+        });
+    });
+}
+
+void SoftmaxBackward(const KernelLaunch& launch, KernelArgsReader& args)
+{
+    const auto use_log   = launch.GetDefineInt("USE_SOFTMAX_LOG") != 0;
+    const auto instance  = launch.GetDefineInt("USE_SOFTMAX_MODE_INSTANCE") != 0;
+    const auto y_packed  = launch.GetDefineInt("IS_OUTPUT_PACKED", 1) != 0;
+    const auto dy_packed = launch.GetDefineInt("IS_DOUTPUT_PACKED", 1) != 0;
+    const auto dx_packed = launch.GetDefineInt("IS_DINPUT_PACKED", 1) != 0;
+    const auto use_alpha = launch.GetDefineInt("USE_ALPHA") != 0;
+    const auto use_beta  = launch.GetDefineInt("USE_BETA") != 0;
+
+    VisitDataType(launch, [&](auto type) {
+        using T                = decltype(type);
+        const auto* y          = NextPointer<const T>(args);
+        const auto* dy         = NextPointer<const T>(args);
+        auto* dx               = NextPointer<T>(args);
+        const auto shape       = NextSoftmaxShape(args, instance);
+        const auto y_strides   = args.Next<std::array<int, 3>>();
+        const auto dy_strides  = args.Next<std::array<int, 3>>();
+        const auto dx_strides  = args.Next<std::array<int, 3>>();
+        y += args.Next<int>();
+        dy += args.Next<int>();
+        dx += args.Next<int>();
+        const auto alpha = args.Next<float>();
+        const auto beta  = args.Next<float>();
+
+        const auto vector_size = shape.vector_size;
+
+        par_for(static_cast<std::size_t>(std::max(shape.grid_size, 0)), [&](std::size_t g) {
+            const auto index = [&](int i, bool packed, const std::array<int, 3>& strides) {
+                return shape.Index(static_cast<int>(g), i, packed, strides);
+            };
+            const auto y_at = [&](int i) {
+                return static_cast<float>(y[index(i, y_packed, y_strides)]);
+            };
+            const auto dy_at = [&](int i) {
+                return static_cast<float>(dy[index(i, dy_packed, dy_strides)]);
+            };
+
+            auto channel_dot = 0.f;
+            for(int i = 0; i < vector_size; ++i)
+                channel_dot += use_log ? dy_at(i) : y_at(i) * dy_at(i);
+
+            for(int i = 0; i < vector_size; ++i)
+            {
+                auto value = use_log ? dy_at(i) - channel_dot * std::exp(y_at(i))
+                                     : (dy_at(i) - channel_dot) * y_at(i);
+                if(use_alpha)
+                    value *= alpha;
+                auto& dst = dx[index(i, dx_packed, dx_strides)];
+                if(use_beta)
+                    value += static_cast<float>(dst) * beta;
+                dst = static_cast<T>(value);
+            }
+        });
+    });
+}
+
+// Host counterparts of MIOpenBatchNormFwdInferSpatialEst and
+// MIOpenBatchNormFwdInferPerActivationEst.
+
+template <bool spatial>
+void BatchNormFwdInfer(const KernelLaunch& launch, KernelArgsReader& args)
+{
+    const auto run = [&](auto in_type, auto param_type) {
+        using TIn           = decltype(in_type);
+        using TParam        = decltype(param_type);
+        const auto* x       = NextPointer<const TIn>(args);
+        auto* y             = NextPointer<TIn>(args);
+        const auto* mean    = NextPointer<const TParam>(args);
+        const auto* var     = NextPointer<const TParam>(args);
+        const auto* scale   = NextPointer<const TParam>(args);
+        const auto* bias    = NextPointer<const TParam>(args);
+        const auto epsilon  = args.Next<double>();
+        const auto batch    = args.Next<unsigned int>();
+        const auto image    = args.Next<unsigned int>();
+        const auto n_stride = args.Next<unsigned int>();
+        const auto channels = launch.gdims[0];
+
+        par_for(channels, [&](std::size_t c) {
+            for(std::size_t i = 0; i < image; ++i)
+            {
+                const auto p       = spatial ? c : c * image + i;
+                const auto mean_p  = static_cast<double>(mean[p]);
+                const auto scale_p = static_cast<double>(scale[p]);
+                const auto bias_p  = static_cast<double>(bias[p]);
+                const auto inv_std =
+                    1. / std::sqrt(std::fabs(static_cast<double>(var[p]) + epsilon));
+                for(std::size_t n = 0; n < batch; ++n)
+                {
+                    const auto index = n * n_stride + c * image + i;
+                    const auto value = (static_cast<double>(x[index]) - mean_p) * inv_std;
+                    y[index]         = static_cast<TIn>(scale_p * value + bias_p);
+                }
+            }
+        });
+    };
+
+    using half = half_float::half;
+    if(launch.GetDefineInt("MIOPEN_USE_FPMIX") != 0)
+        run(half{}, float{});
+    else if(launch.GetDefineInt("MIOPEN_USE_FP16") != 0)
+        run(half{}, half{});
+    else if(launch.GetDefineInt("MIOPEN_USE_FP32") != 0)
+        run(float{}, float{});
+    else
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Host kernels do not support the data type: " + launch.params);
+}
+
+// Host counterparts of the forward pooling kernels mloPoolingG (MIOpenPooling.cl) and
+// mloPoolingForwardNaive (MIOpenPoolingForwardNaive.cl).
+
+constexpr int PoolingOpAve          = 0;
+constexpr int PoolingOpMax          = 1;
+constexpr int PoolingOpAveInclusive = 3;
+
+/// Calls f with a value of the index type selected by MLO_POOLING_INDEX_TYPE.
+template <class F>
+void VisitPoolingIndexType(const KernelLaunch& launch, F&& f)
+{
+    const auto type = launch.GetDefine("MLO_POOLING_INDEX_TYPE", "uint");
+    if(type == "uchar")
+        return f(uint8_t{});
+    if(type == "ushort")
+        return f(uint16_t{});
+    if(type == "uint")
+        return f(uint32_t{});
+    if(type == "ulong")
+        return f(uint64_t{});
+    MIOPEN_THROW(miopenStatusNotImplemented, "Unsupported pooling index type: " + type);
+}
+
+void PoolingForward2d(const KernelLaunch& launch, KernelArgsReader& args)
+{
+    const auto op          = static_cast<int>(launch.GetDefineInt("MLO_POOLING_OP_ID", -1));
+    const auto kernel_w    = static_cast<int>(launch.GetDefineInt("MLO_POOLING_KERNEL_SZ0"));
+    const auto kernel_h    = static_cast<int>(launch.GetDefineInt("MLO_POOLING_KERNEL_SZ1"));
+    const auto stride_w    = static_cast<int>(launch.GetDefineInt("MLO_POOLING_STRIDE0"));
+    const auto stride_h    = static_cast<int>(launch.GetDefineInt("MLO_POOLING_STRIDE1"));
+    const auto image_index = launch.GetDefineInt("USE_IMG_INDEX", 1) != 0;
+    const auto use_mask =
+        op == PoolingOpMax && !launch.GetDefine("MLO_POOLING_SAVE_INDEX").empty();
+    if(op != PoolingOpAve && op != PoolingOpMax && op != PoolingOpAveInclusive)
+        MIOPEN_THROW(miopenStatusNotImplemented, "Unsupported pooling operation on the host");
+
+    VisitDataType(launch, [&](auto type) {
+        VisitPoolingIndexType(launch, [&](auto index_type) {
+            using T     = decltype(type);
+            using Index = decltype(index_type);
+
+            const auto* bot       = NextPointer<const T>(args);
+            auto* top             = NextPointer<T>(args);
+            auto* mask            = NextPointer<Index>(args);
+            const auto pad_h      = args.Next<int>();
+            const auto pad_w      = args.Next<int>();
+            const auto channels   = args.Next<int>();
+            const auto bot_h      = args.Next<int>();
+            const auto bot_w      = args.Next<int>();
+            const auto top_h      = args.Next<int>();
+            const auto top_w      = args.Next<int>();
+            const auto bot_stride = args.Next<std::array<int, 3>>();
+            const auto top_stride = args.Next<std::array<int, 3>>();
+            const auto batch      = launch.gdims[2] / std::max(channels, 1);
+            const auto lowest     = static_cast<float>(std::numeric_limits<T>::lowest());
+
+            const auto plane = static_cast<std::size_t>(top_h) * top_w;
+            par_for(batch * channels * plane, [&](std::size_t item) {
+                const auto b      = item / plane / channels;
+                const auto o      = item / plane % channels;
+                const auto y      = static_cast<int>(item % plane / top_w);
+                const auto x      = static_cast<int>(item % top_w);
+                const auto hstart = y * stride_h - pad_h;
+                const auto wstart = x * stride_w - pad_w;
+                const auto* p_bot = bot + b * bot_stride[0] + o * bot_stride[1];
+
+                auto res       = op == PoolingOpMax ? lowest : 0.f;
+                auto res_index = Index{0};
+                for(int j = 0; j < kernel_h; ++j)
+                {
+                    for(int i = 0; i < kernel_w; ++i)
+                    {
+                        const auto h       = hstart + j;
+                        const auto w       = wstart + i;
+                        const auto visible = h >= 0 && h < bot_h && w >= 0 && w < bot_w;
+                        if(op != PoolingOpMax)
+                        {
+                            res += visible ? static_cast<float>(p_bot[h * bot_stride[2] + w]) : 0.f;
+                            continue;
+                        }
+                        const auto value =
+                            visible ? static_cast<float>(p_bot[h * bot_stride[2] + w]) : lowest;
+                        if(!use_mask)
+                        {
+                            res = std::fmax(res, value);
+                        }
+                        else if(value > res)
+                        {
+                            res       = value;
+                            res_index = static_cast<Index>(image_index ? h * bot_w + w
+                                                                       : i + kernel_w * j);
+                        }
+                    }
+                }
+
+                if(op != PoolingOpMax)
+                {
+                    auto pool_size = kernel_w * kernel_h;
+                    if(op == PoolingOpAve)
+                        pool_size = (std::min(hstart + kernel_h, bot_h) - std::max(hstart, 0)) *
+                                    (std::min(wstart + kernel_w, bot_w) - std::max(wstart, 0));
+                    res *= 1.f / static_cast<float>(pool_size == 0 ? 1 : pool_size);
+                }
+
+                const auto index =
+                    b * top_stride[0] + o * top_stride[1] + y * top_stride[2] + x;
+                top[index] = static_cast<T>(res);
+                if(use_mask)
+                    mask[index] = res_index;
+            });
+        });
+    });
+}
+
+void PoolingForwardNaive(const KernelLaunch& launch, KernelArgsReader& args)
+{
+    const auto op = static_cast<int>(launch.GetDefineInt("MLO_POOLING_OP_ID", -1));
+    if(op != PoolingOpAve && op != PoolingOpMax && op != PoolingOpAveInclusive)
+        MIOPEN_THROW(miopenStatusNotImplemented, "Unsupported pooling operation on the host");
+
+    VisitDataType(launch, [&](auto type) {
+        VisitPoolingIndexType(launch, [&](auto index_type) {
+            using T     = decltype(type);
+            using Index = decltype(index_type);
+            using Dims  = std::array<uint32_t, 3>;
+
+            const auto* bot       = NextPointer<const T>(args);
+            auto* top             = NextPointer<T>(args);
+            auto* mask            = NextPointer<Index>(args);
+            const auto save_index = args.Next<bool>() && op == PoolingOpMax;
+            const auto index_mode = args.Next<int>();
+            const auto filter     = args.Next<Dims>();
+            const auto stride     = args.Next<Dims>();
+            const auto pad        = args.Next<Dims>();
+            const auto all_n      = args.Next<uint32_t>();
+            const auto all_c      = args.Next<uint32_t>();
+            const auto bot_len    = args.Next<Dims>();
+            const auto bot_n_str  = args.Next<std::size_t>();
+            const auto bot_c_str  = args.Next<std::size_t>();
+            const auto bot_str    = args.Next<Dims>();
+            const auto top_len    = args.Next<Dims>();
+            const auto top_n_str  = args.Next<std::size_t>();
+            const auto top_c_str  = args.Next<std::size_t>();
+            const auto top_str    = args.Next<Dims>();
+            const auto mask_n_str = args.Next<std::size_t>();
+            const auto mask_c_str = args.Next<std::size_t>();
+            const auto mask_str   = args.Next<Dims>();
+            const auto lowest     = static_cast<float>(std::numeric_limits<T>::lowest());
+
+            const auto offset = [](const Dims& strides, const Dims& pos) {
+                return static_cast<std::size_t>(pos[0]) * strides[0] +
+                       static_cast<std::size_t>(pos[1]) * strides[1] +
+                       static_cast<std::size_t>(pos[2]) * strides[2];
+            };
+
+            const auto plane    = static_cast<std::size_t>(top_len[1]) * top_len[2];
+            const auto top_size = top_len[0] * plane;
+            par_for(static_cast<std::size_t>(all_n) * all_c * top_size, [&](std::size_t item) {
+                const auto b = item / top_size / all_c;
+                const auto o = item / top_size % all_c;
+                const auto out =
+                    Dims{static_cast<uint32_t>(item % top_size / plane),
+                         static_cast<uint32_t>(item % plane / top_len[2]),
+                         static_cast<uint32_t>(item % top_len[2])};
+
+                Dims first{}, last{};
+                for(std::size_t dim = 0; dim < 3; ++dim)
+                {
+                    const auto start = static_cast<int>(out[dim] * stride[dim] - pad[dim]);
+                    first[dim]       = static_cast<uint32_t>(std::max(start, 0));
+                    last[dim]        = static_cast<uint32_t>(std::min(
+                        start + static_cast<int>(filter[dim]), static_cast<int>(bot_len[dim])));
+                }
+
+                auto res   = op == PoolingOpMax ? lowest : 0.f;
+                auto found = false;
+                auto saved = Dims{};
+                for(auto d = first[0]; d < last[0]; ++d)
+                {
+                    for(auto h = first[1]; h < last[1]; ++h)
+                    {
+                        for(auto w = first[2]; w < last[2]; ++w)
+                        {
+                            const auto value = static_cast<float>(
+                                bot[b * bot_n_str + o * bot_c_str + offset(bot_str, {d, h, w})]);
+                            if(op != PoolingOpMax)
+                            {
+                                res += value;
+                            }
+                            else if(value > res)
+                            {
+                                res   = value;
+                                found = true;
+                                saved = {d, h, w};
+                            }
+                        }
+                    }
+                }
+
+                if(op != PoolingOpMax)
+                {
+                    auto pool_size = filter[0] * filter[1] * filter[2];
+                    if(op == PoolingOpAve)
+                        pool_size = (last[0] - first[0]) * (last[1] - first[1]) *
+                                    (last[2] - first[2]);
+                    res *= 1.f / static_cast<float>(pool_size == 0 ? 1 : pool_size);
+                }
+                else if(save_index)
+                {
+                    // Either the position in the image or the position in the filter window.
+                    auto res_index = Index{0};
+                    if(found && index_mode == 1)
+                        res_index = static_cast<Index>(
+                            (saved[0] * bot_len[1] + saved[1]) * bot_len[2] + saved[2]);
+                    else if(found)
+                        res_index = static_cast<Index>(
+                            ((saved[0] - out[0] * stride[0] + pad[0]) * filter[1] +
+                             (saved[1] - out[1] * stride[1] + pad[1])) *
+                                filter[2] +
+                            (saved[2] - out[2] * stride[2] + pad[2]));
+                    mask[b * mask_n_str + o * mask_c_str + offset(mask_str, out)] = res_index;
+                }
+
+                top[b * top_n_str + o * top_c_str + offset(top_str, out)] = static_cast<T>(res);
+            });
+        });
+    });
+}
+
+using KernelMap = std::unordered_map<std::string, KernelFunction>;
+
+template <ConvDirection direction, class TIn, class TAcc, class TOut>
+void AddNaiveConvKernels(KernelMap& kernels, const std::string& types)
+{
+    const auto direction_name = direction == ConvDirection::Fwd   ? std::string{"fwd_"}
+                                : direction == ConvDirection::Bwd ? std::string{"bwd_"}
+                                                                  : std::string{"wrw_"};
+
+    for(const auto& prefix : {"naive_conv_packed_", "naive_conv_nonpacked_"})
+    {
+        const auto name = prefix + direction_name;
+        kernels[name + "nchw_" + types]  = &NaiveConv<direction, false, 5, TIn, TAcc, TOut>;
+        kernels[name + "ncdhw_" + types] = &NaiveConv<direction, false, 6, TIn, TAcc, TOut>;
+        kernels[name + "nhwc_" + types]  = &NaiveConv<direction, true, 5, TIn, TAcc, TOut>;
+        kernels[name + "ndhwc_" + types] = &NaiveConv<direction, true, 6, TIn, TAcc, TOut>;
+    }
+}
+
+KernelMap MakeKernels()
+{
+    using half = half_float::half;
+
+    KernelMap kernels;
+    AddNaiveConvKernels<ConvDirection::Fwd, float, double, float>(kernels, "float_double_float");
+    AddNaiveConvKernels<ConvDirection::Fwd, half, double, half>(kernels, "half_double_half");
+    AddNaiveConvKernels<ConvDirection::Fwd, bfloat16, double, bfloat16>(kernels,
+                                                                         "ushort_double_ushort");
+    AddNaiveConvKernels<ConvDirection::Fwd, int8_t, int32_t, int32_t>(kernels,
+                                                                       "int8_t_int32_t_int32_t");
+    AddNaiveConvKernels<ConvDirection::Fwd, int8_t, int32_t, float>(kernels,
+                                                                     "int8_t_int32_t_float");
+
+    AddNaiveConvKernels<ConvDirection::Bwd, float, double, float>(kernels, "float_double_float");
+    AddNaiveConvKernels<ConvDirection::Bwd, half, double, half>(kernels, "half_double_half");
+    AddNaiveConvKernels<ConvDirection::Bwd, bfloat16, double, bfloat16>(kernels,
+                                                                         "ushort_double_ushort");
+
+    AddNaiveConvKernels<ConvDirection::Wrw, float, double, float>(kernels, "float_double_float");
+    AddNaiveConvKernels<ConvDirection::Wrw, half, double, half>(kernels, "half_double_half");
+    AddNaiveConvKernels<ConvDirection::Wrw, bfloat16, double, bfloat16>(kernels,
+                                                                         "ushort_double_ushort");
+
+    kernels["MIOpenActiveFwdLite"]   = &ActivationFwd<false>;
+    kernels["MIOpenActiveFwd2DLite"] = &ActivationFwd<true>;
+    kernels["MIOpenActiveBwdLite"]   = &ActivationBwd<false>;
+    kernels["MIOpenActiveBwd2DLite"] = &ActivationBwd<true>;
+
+    kernels["Op1dTensorGeneric"] = &Op1dTensorGeneric;
+    kernels["Op2dTensorGeneric"] = &OpNdTensorGeneric<2>;
+    kernels["Op3dTensorGeneric"] = &OpNdTensorGeneric<3>;
+    kernels["Op4dTensorGeneric"] = &OpNdTensorGeneric<4>;
+    kernels["Op5dTensorGeneric"] = &OpNdTensorGeneric<5>;
+    kernels["Op4dTensorLite"]    = &Op4dTensorLite;
+
+    kernels["SubTensorOpWithScalar1d"]    = &SubTensorOpWithScalar<1>;
+    kernels["SubTensorOpWithScalar2d"]    = &SubTensorOpWithScalar<2>;
+    kernels["SubTensorOpWithScalar3d"]    = &SubTensorOpWithScalar<3>;
+    kernels["SubTensorOpWithScalar4d"]    = &SubTensorOpWithScalar<4>;
+    kernels["SubTensorOpWithScalar5d"]    = &SubTensorOpWithScalar<5>;
+    kernels["SubTensorOpWithSubTensor1d"] = &SubTensorOpWithSubTensor<1>;
+    kernels["SubTensorOpWithSubTensor2d"] = &SubTensorOpWithSubTensor<2>;
+    kernels["SubTensorOpWithSubTensor3d"] = &SubTensorOpWithSubTensor<3>;
+    kernels["SubTensorOpWithSubTensor4d"] = &SubTensorOpWithSubTensor<4>;
+    kernels["SubTensorOpWithSubTensor5d"] = &SubTensorOpWithSubTensor<5>;
+
+    kernels["SoftmaxForward"]  = &SoftmaxForward;
+    kernels["SoftmaxBackward"] = &SoftmaxBackward;
+
+    kernels["MIOpenBatchNormFwdInferSpatialEst"]       = &BatchNormFwdInfer<true>;
+    kernels["MIOpenBatchNormFwdInferPerActivationEst"] = &BatchNormFwdInfer<false>;
+
+    kernels["mloPoolingG"]            = &PoolingForward2d;
+    kernels["mloPoolingForwardNaive"] = &PoolingForwardNaive;
+    return kernels;
+}
+
+} // namespace
+
+std::string KernelLaunch::GetDefine(const std::string& name, const std::string& fallback) const
+{
+    const auto prefix = "-D" + name;
+    auto result       = fallback;
+    auto options      = std::istringstream{params};
+    auto option       = std::string{};
+    while(options >> option)
+    {
+        if(option.compare(0, prefix.size(), prefix) != 0)
+            continue;
+        if(option.size() == prefix.size())
+            result = "1";
+        else if(option[prefix.size()] == '=')
+            result = option.substr(prefix.size() + 1);
+    }
+    return result;
+}
+
+long long KernelLaunch::GetDefineInt(const std::string& name, long long fallback) const
+{
+    const auto value = GetDefine(name);
+    return value.empty() ? fallback : std::stoll(value);
+}
+
+KernelFunction GetKernel(const std::string& kernel_name)
+{
+    static const auto kernels = MakeKernels();
+
+    const auto it = kernels.find(kernel_name);
+    return it != kernels.end() ? it->second : nullptr;
+}
+
+} // namespace host
+} // namespace miopen
@@ -41,10 +41,12 @@
 #include <miopen/solver.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/tensor.hpp>
+#include <miopen/tracer.hpp>
 #include <miopen/util.hpp>
 #include <miopen/visit_float.hpp>
 #include <miopen/datatype.hpp>
 #include <miopen/any_solver.hpp>
+#include <miopen/conv/async_find.hpp>
 #include <miopen/conv/tensors.hpp>
 #include <miopen/conv/compiled_in_parameters.hpp>
 #include <miopen/conv/data_invoke_params.hpp>
@@ -168,11 +170,10 @@ Invoker LoadOrPrepareInvoker(const ExecutionContext& ctx,
                              solver::Id solver_id)
 {
     const auto& handle = ctx.GetStream();
-    const auto config  = problem.MakeNetworkConfig();
-    auto invoker       = handle.GetInvoker(config, solver_id);
+    auto invoker       = handle.GetInvoker(problem, solver_id);
     if(invoker)
         return *invoker;
-    return PrepareInvoker(ctx, problem, config, solver_id);
+    return PrepareInvoker(ctx, problem, problem.MakeNetworkConfig(), solver_id);
 }
 
 static void
@@ -206,15 +207,19 @@ static inline std::vector<PerfField> FindConvolution(const ExecutionContext& ctx
                                                      const conv::ProblemDescription& problem,
                                                      const AnyInvokeParams& invoke_ctx)
 {
+    MIOPEN_TRACE_SCOPE("find", "FindConvolution");
     auto results         = std::vector<PerfField>{};
     auto sol             = boost::optional<miopenConvSolution_t>{};
     const auto& conv     = problem.GetConv();
     const auto& findMode = conv.findMode;
 
-    if(findMode.IsFast(ctx) || findMode.IsHybrid(ctx))
+    if(findMode.IsFast(ctx) || findMode.IsHybrid(ctx) || findMode.IsAsyncHybrid(ctx))
     {
         auto fallback = bool{};
         auto sols     = conv.GetSolutions(ctx, problem, 1, &fallback);
+        // Use the fallback for now and let the background search fill the find-db.
+        if(!sols.empty() && fallback && findMode.IsAsyncHybrid(ctx))
+            conv::QueueAsyncFind(ctx, problem);
         // override the normal find with immed mode with env var
         if(!sols.empty() && (!(findMode.IsHybrid(ctx) && fallback) ||
                              miopen::IsEnabled(ENV(MIOPEN_DEBUG_FORCE_IMMED_MODE_FALLBACK))))
@@ -523,8 +528,7 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
 
         const auto problem =
             conv::ProblemDescription{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
-        const auto network_config = problem.MakeNetworkConfig();
-        const auto& invoker       = handle.GetInvoker(network_config, {}, algorithm_name);
+        const auto& invoker = handle.GetInvoker(problem, {}, algorithm_name);
 
         if(invoker)
         {
@@ -980,8 +984,7 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
 
         const auto problem =
             conv::ProblemDescription{dyDesc, wDesc, dxDesc, *this, conv::Direction::BackwardData};
-        const auto network_config = problem.MakeNetworkConfig();
-        const auto& invoker       = handle.GetInvoker(network_config, {}, algorithm_name);
+        const auto& invoker = handle.GetInvoker(problem, {}, algorithm_name);
 
         if(!invoker)
             MIOPEN_THROW("No invoker was registered for convolution backward. Was find executed?");
@@ -1186,8 +1189,7 @@ void ConvolutionDescriptor::ConvolutionBackwardWeights(const Handle& handle,
         decltype(auto) algorithm_name = AlgorithmName{ConvolutionAlgoToDirectionalString(
             static_cast<miopenConvAlgorithm_t>(algo), direction)};
         decltype(auto) problem = conv::ProblemDescription{dyDesc, dwDesc, xDesc, *this, direction};
-        decltype(auto) network_config = problem.MakeNetworkConfig();
-        decltype(auto) invoker = handle.GetInvoker(network_config, boost::none, algorithm_name);
+        decltype(auto) invoker = handle.GetInvoker(problem, boost::none, algorithm_name);
 
         if(!invoker)
             MIOPEN_THROW("No invoker was registered for convolution weights. Was find executed?");
@@ -159,6 +159,7 @@ void CTCLossDescriptor::CTCLoss(const Handle& handle,
 
 #elif MIOPEN_BACKEND_HIP
 
+    handle.MarkCaptureUnsupported("Memory copy");
     hipMemcpy(static_cast<int*>(workSpace), inputLengths, batch_bytes, hipMemcpyHostToDevice);
     hipMemcpy(static_cast<int*>(workSpace) + batch_size,
               labelLengths,
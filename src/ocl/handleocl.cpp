@@ -27,6 +27,7 @@
 #include <miopen/handle.hpp>
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/conv/async_find.hpp>
 #include <miopen/config.h>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
@@ -78,6 +79,8 @@ struct HandleImpl
     AqPtr queue         = nullptr;
     cl_device_id device = nullptr; // NOLINT
     Allocator allocator{};
+    CachingAllocator::Ptr caching_allocator;
+    WorkspaceArena workspace;
     KernelCache cache;
     bool enable_profiling  = false;
     float profiling_result = 0.0;
@@ -267,7 +270,7 @@ Handle::Handle() : impl(new HandleImpl())
 }
 
 Handle::Handle(Handle&&) noexcept = default;
-Handle::~Handle()                 = default;
+Handle::~Handle() { conv::ReleaseAsyncFinds(*this); }
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -298,11 +301,27 @@ void Handle::SetAllocator(miopenAllocatorFunction allocator,
     {
         MIOPEN_THROW("Allocator context can not be used with the default allocator");
     }
-    this->impl->allocator.allocator   = allocator == nullptr ? default_allocator : allocator;
-    this->impl->allocator.deallocator = deallocator == nullptr ? default_deallocator : deallocator;
+    if(allocator == nullptr)
+        allocator = default_allocator;
+    if(deallocator == nullptr)
+        deallocator = default_deallocator;
+    if(allocatorContext == nullptr)
+        allocatorContext = this->impl->context.get();
+
+    this->impl->workspace.Release();
+    this->impl->caching_allocator =
+        CachingAllocator::CreateIfEnabled(allocator, deallocator, allocatorContext);
+
+    if(this->impl->caching_allocator)
+        this->impl->allocator = this->impl->caching_allocator->AsAllocator();
+    else
+        this->impl->allocator = Allocator{allocator, deallocator, allocatorContext};
+}
 
-    this->impl->allocator.context =
-        allocatorContext == nullptr ? this->impl->context.get() : allocatorContext;
+void Handle::SetHostExecution(bool enable)
+{
+    if(enable)
+        MIOPEN_THROW(miopenStatusNotImplemented, "Host execution requires a HIPNOGPU build");
 }
 
 void Handle::EnableProfiling(bool enable) const { this->impl->enable_profiling = enable; }
@@ -368,7 +387,7 @@ const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
 
-KernelInvoke Handle::Run(Kernel k) const
+KernelInvoke Handle::Run(const Kernel& k) const
 {
     auto q = this->GetStream();
     if(this->impl->enable_profiling || MIOPEN_GPU_SYNC)
@@ -436,6 +455,8 @@ bool Handle::HasProgram(const std::string& program_name, const std::string& para
     return this->impl->cache.HasProgram(program_name, params);
 }
 
+std::size_t Handle::GetProgramLoadCount() const { return this->impl->cache.GetProgramLoadCount(); }
+
 void Handle::AddProgram(Program prog,
                         const std::string& program_name,
                         const std::string& params) const
@@ -443,6 +464,16 @@ void Handle::AddProgram(Program prog,
     this->impl->cache.AddProgram(prog, program_name, params);
 }
 
+std::string Handle::GetProgramBinary(const std::string&, const std::string&) const
+{
+    MIOPEN_THROW(miopenStatusNotImplemented);
+}
+
+void Handle::AddProgramBinary(const std::string&, const std::string&, const std::string&) const
+{
+    MIOPEN_THROW(miopenStatusNotImplemented);
+}
+
 void Handle::Finish() const { clFinish(this->GetStream()); }
 
 void Handle::Flush() const { clFlush(this->GetStream()); }
@@ -463,6 +494,15 @@ std::string Handle::GetDeviceNameImpl() const { return this->impl->get_device_na
 
 std::string Handle::GetDeviceName() const { return this->impl->target_properties.Name(); }
 
+std::string Handle::GetDeviceKey() const
+{
+    // Programs belong to a context. The programs retain it, so its address is not reused while
+    // any of their kernels are cached.
+    std::ostringstream ss;
+    ss << "ocl:" << this->impl->context.get();
+    return ss.str();
+}
+
 const TargetProperties& Handle::GetTargetProperties() const
 {
     return this->impl->target_properties;
@@ -505,6 +545,45 @@ Allocator::ManageDataPtr Handle::Create(std::size_t sz) const
     return this->impl->allocator(sz);
 }
 
+Data_t Handle::GetWorkspace(std::size_t sz) const
+{
+    MIOPEN_HANDLE_LOCK
+    if(sz > this->impl->workspace.GetCapacity())
+        this->Finish();
+    return this->impl->workspace.Get(this->impl->allocator, sz);
+}
+
+void Handle::TrimMemory() const
+{
+    MIOPEN_HANDLE_LOCK
+    this->Finish();
+    this->impl->workspace.Release();
+    if(this->impl->caching_allocator)
+        this->impl->caching_allocator->Trim();
+}
+
+void Handle::BeginCapture(std::vector<ExecutionPlan::Binding>) const
+{
+    MIOPEN_THROW(miopenStatusNotImplemented, "Execution plans are not supported on OpenCL");
+}
+
+ExecutionPlan Handle::EndCapture() const
+{
+    MIOPEN_THROW(miopenStatusNotImplemented, "Execution plans are not supported on OpenCL");
+}
+
+// BeginCapture() fails on OpenCL, so there is never a capture to fail
+void Handle::MarkCaptureUnsupported(const char*) const {}
+
+bool Handle::IsAllocatorCaching() const { return this->impl->caching_allocator != nullptr; }
+
+CachingAllocator::Statistics Handle::GetAllocatorStatistics() const
+{
+    if(this->impl->caching_allocator)
+        return this->impl->caching_allocator->GetStatistics();
+    return {};
+}
+
 Allocator::ManageDataPtr&
 Handle::WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t sz) const
 {
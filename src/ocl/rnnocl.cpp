@@ -750,6 +750,7 @@ void RNNDescriptor::RNNForwardTraining_MS(Handle& handle,
     { // reserveSpace clean set 0
         const int fill_val = 0;
         // if(biasMode == 0u) req
+        handle.MarkCaptureUnsupported("Memory set");
         hipMemsetAsync(reserveSpace, fill_val, reserveSpaceSize, handle.GetStream());
     }
 
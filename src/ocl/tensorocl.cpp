@@ -28,17 +28,24 @@
 #include <miopen/float_equal.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/tensor_ops.hpp>
+#include <miopen/tensor_op_plan.hpp>
 #include <miopen/datatype.hpp>
+#include <miopen/env.hpp>
 #include <miopen/visit_float.hpp>
 #include <miopen/util.hpp>
 #include <miopen/logger.hpp>
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <numeric>
+#include <optional>
+#include <tuple>
 #include <boost/range/combine.hpp>
 
 #define MIO_TENSOROCL_DEBUG 0
 
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_TENSOR_OP_COALESCE)
+
 namespace miopen {
 
 TensorDescriptor GetFlattenedTensorDescriptor(const TensorDescriptor& desc)
@@ -1239,6 +1246,156 @@ void OpTensorOther(const Handle& handle,
     });
 }
 
+static void OpTensorDispatch(const Handle& handle,
+                             miopenTensorOp_t tensorOp,
+                             const void* alpha0,
+                             const TensorDescriptor& aTensorDesc,
+                             ConstData_t ATensor,
+                             const void* alpha1,
+                             const TensorDescriptor& bTensorDesc,
+                             ConstData_t BTensor,
+                             const void* beta,
+                             const TensorDescriptor& cTensorDesc,
+                             Data_t CTensor,
+                             const size_t Aoffset,
+                             const size_t Boffset,
+                             const size_t Coffset,
+                             const bool nonStandardSquash)
+{
+    auto bsize = bTensorDesc.GetSize();
+    if(bsize == 3)
+    {
+        OpTensor3d(handle,
+                   tensorOp,
+                   alpha0,
+                   aTensorDesc,
+                   ATensor,
+                   alpha1,
+                   bTensorDesc,
+                   BTensor,
+                   beta,
+                   cTensorDesc,
+                   CTensor,
+                   Aoffset,
+                   Boffset,
+                   Coffset,
+                   nonStandardSquash);
+    }
+    else if(bsize == 4)
+    {
+        OpTensor4d(handle,
+                   tensorOp,
+                   alpha0,
+                   aTensorDesc,
+                   ATensor,
+                   alpha1,
+                   bTensorDesc,
+                   BTensor,
+                   beta,
+                   cTensorDesc,
+                   CTensor,
+                   Aoffset,
+                   Boffset,
+                   Coffset);
+    }
+    else
+    {
+        OpTensorOther(handle,
+                      tensorOp,
+                      alpha0,
+                      aTensorDesc,
+                      ATensor,
+                      alpha1,
+                      bTensorDesc,
+                      BTensor,
+                      beta,
+                      cTensorDesc,
+                      CTensor,
+                      Aoffset,
+                      Boffset,
+                      Coffset);
+    }
+}
+
+// Whether every element of a tensor, and for the 1d kernel also the one a full grid step past
+// it, is addressed by the index type of the kernel the plan runs with.
+static bool FitsIndexType(const std::vector<std::size_t>& lengths,
+                          const std::vector<std::size_t>& strides,
+                          std::size_t max_index)
+{
+    if(lengths.size() == 1)
+    {
+        // Op1dTensorGeneric computes total_work * stride and grid_size * stride in uint32, the
+        // grid is at least one work group of 256 and never more work items than elements.
+        const auto steps = std::max(lengths[0], std::size_t{256});
+        return strides[0] == 0 || steps <= max_index / strides[0];
+    }
+
+    std::size_t offset = 0;
+    for(std::size_t i = 0; i < lengths.size(); ++i)
+    {
+        if(lengths[i] > max_index || (strides[i] != 0 && lengths[i] - 1 > max_index / strides[i]))
+            return false;
+        offset += (lengths[i] - 1) * strides[i];
+        if(offset > max_index)
+            return false;
+    }
+    return true;
+}
+
+// The descriptors of the coalesced op, when they are run by a kernel at least as fast as the one
+// the original descriptors get. Packed tensors of any rank are run by the vectorized Op4dTensorLite
+// as a {1, 1, 1, N} problem. Other plans are only used for the ops which would run a generic kernel
+// anyway: 4d ops keep OpTensorFwdBias, OpTensorLeadingOnes and Op4dTensorLite, and 3d ops keep
+// Op2dTensorLite.
+static std::optional<std::tuple<TensorDescriptor, TensorDescriptor, TensorDescriptor>>
+GetCoalescedDescriptors(const TensorDescriptor& aTensorDesc,
+                        const TensorDescriptor& bTensorDesc,
+                        const TensorDescriptor& cTensorDesc,
+                        const size_t Aoffset,
+                        const size_t Boffset,
+                        const size_t Coffset)
+{
+    const auto& alens = aTensorDesc.GetLengths();
+    const auto& blens = bTensorDesc.GetLengths();
+    const auto& clens = cTensorDesc.GetLengths();
+
+    const auto plan = PlanTensorOp(aTensorDesc, bTensorDesc, cTensorDesc);
+    if(!plan || plan->GetSize() >= clens.size() || !plan->FitsKernels())
+        return std::nullopt;
+
+    if(plan->shape == TensorOpShape::Packed1d)
+    {
+        const auto len = plan->lengths[0];
+        // Op4dTensorLite reads whole vectors of RD_BLCK elements at int indices.
+        const std::size_t rd_blck = (len % 4 == 0) ? 4 : (len % 2 == 0) ? 2 : 1;
+        if(clens.size() == 4 || len > static_cast<std::size_t>(std::numeric_limits<int>::max()) ||
+           Aoffset % rd_blck != 0 || Boffset % rd_blck != 0 || Coffset % rd_blck != 0)
+            return std::nullopt;
+
+        const auto lengths = std::vector<std::size_t>{1, 1, 1, len};
+        return std::make_tuple(TensorDescriptor{aTensorDesc.GetType(), lengths},
+                               TensorDescriptor{bTensorDesc.GetType(), lengths},
+                               TensorDescriptor{cTensorDesc.GetType(), lengths});
+    }
+
+    const bool lite_3d = clens.size() == 3 && clens[0] == 1 && blens[0] == 1 && alens[0] == 1 &&
+                         (blens[1] == clens[1] || blens[1] == 1) && blens[2] == clens[2];
+    if(clens.size() == 4 || lite_3d)
+        return std::nullopt;
+
+    const auto max_index = plan->GetSize() == 1
+                               ? static_cast<std::size_t>(std::numeric_limits<uint32_t>::max())
+                               : static_cast<std::size_t>(std::numeric_limits<int>::max());
+    if(!FitsIndexType(plan->lengths, plan->a_strides, max_index) ||
+       !FitsIndexType(plan->lengths, plan->b_strides, max_index) ||
+       !FitsIndexType(plan->lengths, plan->c_strides, max_index))
+        return std::nullopt;
+
+    return plan->GetDescriptors(
+        aTensorDesc.GetType(), bTensorDesc.GetType(), cTensorDesc.GetType());
+}
+
 void OpTensor(const Handle& handle,
               miopenTensorOp_t tensorOp,
               const void* alpha0,
@@ -1314,59 +1471,46 @@ void OpTensor(const Handle& handle,
         }
     }
 
-    auto bsize = blens.size();
-    if(bsize == 3)
-    {
-        OpTensor3d(handle,
-                   tensorOp,
-                   alpha0,
-                   aTensorDesc,
-                   ATensor,
-                   alpha1,
-                   bTensorDesc,
-                   BTensor,
-                   beta,
-                   cTensorDesc,
-                   CTensor,
-                   Aoffset,
-                   Boffset,
-                   Coffset,
-                   nonStandardSquash);
-    }
-    else if(bsize == 4)
+    if(!nonStandardSquash && !miopen::IsDisabled(ENV(MIOPEN_DEBUG_TENSOR_OP_COALESCE)))
     {
-        OpTensor4d(handle,
-                   tensorOp,
-                   alpha0,
-                   aTensorDesc,
-                   ATensor,
-                   alpha1,
-                   bTensorDesc,
-                   BTensor,
-                   beta,
-                   cTensorDesc,
-                   CTensor,
-                   Aoffset,
-                   Boffset,
-                   Coffset);
-    }
-    else
-    {
-        OpTensorOther(handle,
-                      tensorOp,
-                      alpha0,
-                      aTensorDesc,
-                      ATensor,
-                      alpha1,
-                      bTensorDesc,
-                      BTensor,
-                      beta,
-                      cTensorDesc,
-                      CTensor,
-                      Aoffset,
-                      Boffset,
-                      Coffset);
+        const auto descs = GetCoalescedDescriptors(
+            aTensorDesc, bTensorDesc, cTensorDesc, Aoffset, Boffset, Coffset);
+        if(descs)
+        {
+            OpTensorDispatch(handle,
+                             tensorOp,
+                             alpha0,
+                             std::get<0>(*descs),
+                             ATensor,
+                             alpha1,
+                             std::get<1>(*descs),
+                             BTensor,
+                             beta,
+                             std::get<2>(*descs),
+                             CTensor,
+                             Aoffset,
+                             Boffset,
+                             Coffset,
+                             false);
+            return;
+        }
     }
+
+    OpTensorDispatch(handle,
+                     tensorOp,
+                     alpha0,
+                     aTensorDesc,
+                     ATensor,
+                     alpha1,
+                     bTensorDesc,
+                     BTensor,
+                     beta,
+                     cTensorDesc,
+                     CTensor,
+                     Aoffset,
+                     Boffset,
+                     Coffset,
+                     nonStandardSquash);
 }
 
 struct two_exp_ceiling_t
@@ -0,0 +1,271 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/perf_db_neighbors.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/readonlyramdb.hpp>
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_PERFDB_NEIGHBORS)
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_DEBUG_PERFDB_NEIGHBORS_COUNT)
+
+namespace miopen {
+
+namespace debug {
+
+boost::optional<bool>& perf_db_neighbors_override()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static boost::optional<bool> data = boost::none;
+    return data;
+}
+
+} // namespace debug
+
+PerfDbFeatures PerfDbFeatures::FromKey(const std::string& key)
+{
+    auto features = PerfDbFeatures{};
+    auto token    = std::string{};
+
+    const auto flush = [&]() {
+        if(token.empty())
+            return;
+        if(std::all_of(token.begin(), token.end(), [](char c) { return std::isdigit(c) != 0; }))
+            features.values.push_back(std::stod(token));
+        else
+            features.category += token + "-";
+        token.clear();
+    };
+
+    for(const auto c : key)
+    {
+        if(c == '-' || c == 'x')
+            flush();
+        else
+            token += c;
+    }
+    flush();
+
+    // Keys of different dimensionality never match.
+    features.category += std::to_string(features.values.size());
+    return features;
+}
+
+void PerfDbNeighborIndex::Add(const PerfDbFeatures& features,
+                              std::unordered_map<std::string, std::string> configs)
+{
+    categories[features.category].push_back({features.values, std::move(configs)});
+    ++size;
+}
+
+std::vector<std::string> PerfDbNeighborIndex::FindNearest(const PerfDbFeatures& problem,
+                                                          const std::string& solver,
+                                                          std::size_t k) const
+{
+    const auto category = categories.find(problem.category);
+    if(category == categories.end())
+        return {};
+
+    auto candidates = std::vector<std::pair<double, const std::string*>>{};
+
+    for(const auto& entry : category->second)
+    {
+        const auto config = entry.configs.find(solver);
+        if(config == entry.configs.end() || entry.values.size() != problem.values.size())
+            continue;
+
+        auto distance = 0.0;
+        for(auto i = 0; i < entry.values.size(); ++i)
+        {
+            const auto diff = std::log2(1.0 + entry.values[i]) - std::log2(1.0 + problem.values[i]);
+            distance += diff * diff;
+        }
+        candidates.emplace_back(distance, &config->second);
+    }
+
+    const auto count = std::min(k, candidates.size());
+    std::partial_sort(candidates.begin(),
+                      candidates.begin() + count,
+                      candidates.end(),
+                      [](const auto& l, const auto& r) { return l.first < r.first; });
+
+    auto ret = std::vector<std::string>{};
+    ret.reserve(count);
+    for(auto i = 0; i < count; ++i)
+        ret.push_back(*candidates[i].second);
+    return ret;
+}
+
+std::unordered_map<std::string, std::string>
+PerfDbNeighborIndex::ParseContents(const std::string& contents)
+{
+    auto configs = std::unordered_map<std::string, std::string>{};
+    auto stream  = std::istringstream{contents};
+    auto item    = std::string{};
+
+    while(std::getline(stream, item, ';'))
+    {
+        const auto id_size = item.find(':');
+        if(id_size == std::string::npos)
+            continue;
+        configs.emplace(item.substr(0, id_size), item.substr(id_size + 1));
+    }
+
+    return configs;
+}
+
+bool IsPerfDbNeighborsEnabled()
+{
+    if(debug::perf_db_neighbors_override())
+        return *debug::perf_db_neighbors_override();
+    return miopen::IsEnabled(ENV(MIOPEN_DEBUG_PERFDB_NEIGHBORS));
+}
+
+namespace {
+
+#if MIOPEN_ENABLE_SQLITE
+PerfDbNeighborIndex BuildIndex(const std::string& path, const PerfDbFeatures& schema)
+{
+    auto index = PerfDbNeighborIndex{};
+    auto sql   = SQLite{path, true};
+    if(!sql.Valid())
+        return index;
+
+    auto columns = std::string{"perf_db.config, perf_db.solver, perf_db.params"};
+    for(const auto& name : schema.category_names)
+        columns += ", " + schema.table + "." + name;
+    for(const auto& name : schema.value_names)
+        columns += ", " + schema.table + "." + name;
+
+    const auto rows =
+        sql.Exec("SELECT " + columns + " FROM perf_db INNER JOIN " + schema.table + " ON " +
+                 "perf_db.config = " + schema.table + ".id;");
+
+    struct Record
+    {
+        PerfDbFeatures features;
+        std::unordered_map<std::string, std::string> configs;
+    };
+
+    // Rows hold one solver each, records are put together by the config id.
+    auto records = std::map<std::string, Record>{};
+    for(const auto& row : rows)
+    {
+        auto& record = records[row.at("config")];
+        if(record.configs.empty())
+        {
+            for(const auto& name : schema.category_names)
+                record.features.category += row.at(name) + "-";
+            for(const auto& name : schema.value_names)
+                record.features.values.push_back(std::stod(row.at(name)));
+        }
+        record.configs.emplace(row.at("solver"), row.at("params"));
+    }
+
+    for(auto& record : records)
+        index.Add(record.second.features, std::move(record.second.configs));
+    return index;
+}
+#else
+PerfDbNeighborIndex BuildIndex(const std::string& path, const PerfDbFeatures& /*schema*/)
+{
+    auto index = PerfDbNeighborIndex{};
+    for(const auto& item : ReadonlyRamDb::GetCached(path, false).GetCacheMap())
+    {
+        index.Add(PerfDbFeatures::FromKey(item.first),
+                  PerfDbNeighborIndex::ParseContents(item.second.content));
+    }
+    return index;
+}
+#endif
+
+const PerfDbNeighborIndex& GetIndex(const std::string& path, const PerfDbFeatures& schema)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto indices = std::map<std::string, std::unique_ptr<PerfDbNeighborIndex>>{};
+
+    const std::lock_guard<std::mutex> lock{mutex};
+    auto& index = indices[path + ":" + schema.table];
+    if(!index)
+    {
+        index = std::make_unique<PerfDbNeighborIndex>(BuildIndex(path, schema));
+        MIOPEN_LOG_I("Perf Db: " << index->GetSize() << " records indexed for neighbor lookup: "
+                                 << path);
+    }
+    return *index;
+}
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<std::size_t> neighbor_lookups{0};
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<std::size_t> neighbor_transfers{0};
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<std::size_t> neighbor_rejected{0};
+
+} // namespace
+
+std::vector<std::string> FindPerfDbNeighbors(const ExecutionContext& ctx,
+                                             const PerfDbFeatures& problem,
+                                             const std::string& solver)
+{
+    const auto k = Value(ENV(MIOPEN_DEBUG_PERFDB_NEIGHBORS_COUNT));
+    return GetIndex(ctx.GetPerfDbPath(), problem).FindNearest(problem, solver, k != 0 ? k : 5);
+}
+
+void RecordPerfDbNeighborLookup(bool transferred, std::size_t rejected)
+{
+    ++neighbor_lookups;
+    if(transferred)
+        ++neighbor_transfers;
+    neighbor_rejected += rejected;
+}
+
+PerfDbNeighborStatistics GetPerfDbNeighborStatistics()
+{
+    auto statistics      = PerfDbNeighborStatistics{};
+    statistics.lookups   = neighbor_lookups;
+    statistics.transfers = neighbor_transfers;
+    statistics.rejected  = neighbor_rejected;
+    return statistics;
+}
+
+} // namespace miopen
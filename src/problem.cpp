@@ -29,6 +29,7 @@
 #include <miopen/activ/problem_description.hpp>
 #include <miopen/any_solver.hpp>
 #include <miopen/conv/problem_description.hpp>
+#include <miopen/conv/solver_finders.hpp>
 #include <miopen/convolution.hpp>
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/datatype.hpp>
@@ -40,6 +41,7 @@
 #include <miopen/solution.hpp>
 #include <miopen/search_options.hpp>
 #include <miopen/tensor_ops.hpp>
+#include <miopen/tracer.hpp>
 
 #include <nlohmann/json.hpp>
 
@@ -188,6 +190,73 @@ Problem::FindSolutions(Handle& handle, const FindOptions& options, std::size_t m
     return ret;
 }
 
+static std::optional<conv::ProblemDescription>
+AsConvolutionForFind(const ProblemContainer& container)
+{
+    const auto problem = boost::get<Problem>(&container.item);
+    if(problem == nullptr)
+        return std::nullopt;
+
+    const auto conv_desc = boost::get<ConvolutionDescriptor>(&problem->GetOperatorDescriptor());
+    if(conv_desc == nullptr)
+        return std::nullopt;
+
+    return conv_desc->mode == miopenTranspose ? problem->MakeTransposed().AsConvolution()
+                                              : problem->AsConvolution();
+}
+
+std::vector<std::vector<Solution>>
+FindSolutions(Handle& handle,
+              const std::vector<const ProblemContainer*>& problems,
+              const FindOptions& options,
+              std::size_t max_solutions)
+{
+    auto results = std::vector<std::vector<Solution>>(problems.size());
+    // Index of the problem whose results are reused, the own index for the first occurrence.
+    auto sources  = std::vector<std::size_t>(problems.size());
+    auto configs  = std::unordered_map<std::string, std::size_t>{};
+    auto to_build = std::vector<conv::ProblemDescription>{};
+
+    for(auto i = 0; i < problems.size(); ++i)
+    {
+        sources[i] = i;
+
+        auto conv_problem = AsConvolutionForFind(*problems[i]);
+        if(!conv_problem)
+            continue;
+
+        const auto inserted = configs.emplace(conv_problem->MakeNetworkConfig().ToString(), i);
+        if(inserted.second)
+            to_build.emplace_back(std::move(*conv_problem));
+        else
+            sources[i] = inserted.first->second;
+    }
+
+    MIOPEN_LOG_I("Batched find: " << problems.size() << " problems, " << to_build.size()
+                                  << " distinct convolutions");
+
+    // Tuning compiles its own kernels, so there is nothing to share in the exhaustive mode.
+    if(!options.exhaustive_search && to_build.size() > 1)
+        conv::PrecompileFind(handle, to_build);
+
+    for(auto i = 0; i < problems.size(); ++i)
+    {
+        if(sources[i] != i)
+        {
+            results[i] = results[sources[i]];
+            for(auto& solution : results[i])
+                solution.SetProblem(problems[i]->item);
+            continue;
+        }
+
+        results[i] = boost::apply_visitor(
+            [&](auto&& problem) { return problem.FindSolutions(handle, options, max_solutions); },
+            problems[i]->item);
+    }
+
+    return results;
+}
+
 const TensorDescriptor&
 Problem::GetTensorDescriptorChecked(miopenTensorArgumentId_t name,
                                     [[maybe_unused]] const std::string& name_str) const
@@ -283,6 +352,7 @@ std::vector<Solution> Problem::FindSolutionsImpl(Handle& handle,
                                                  const Buffers& buffers,
                                                  const ConvolutionDescriptor& conv_desc) const
 {
+    MIOPEN_TRACE_SCOPE("find", "Problem::FindSolutions");
     auto ret = std::vector<Solution>{};
 
     if(tensor_descriptors.size() != 3)
@@ -320,8 +390,21 @@ std::vector<Solution> Problem::FindSolutionsImpl(Handle& handle,
         auto tmp_ctx             = ExecutionContext{&handle};
         const auto workspace_max = conv_desc.GetWorkSpaceSize(tmp_ctx, conv_problem);
         workspace_size           = std::min(options.workspace_limit, workspace_max);
-        owned_workspace          = workspace_size != 0 ? handle.Create(workspace_size) : nullptr;
-        workspace                = owned_workspace.get();
+
+        if(workspace_size == 0)
+        {
+            workspace = nullptr;
+        }
+        else if(handle.IsAllocatorCaching())
+        {
+            // Repeated finds reuse the handle workspace instead of allocating one each time.
+            workspace = handle.GetWorkspace(workspace_size);
+        }
+        else
+        {
+            owned_workspace = handle.Create(workspace_size);
+            workspace       = owned_workspace.get();
+        }
     }
 
     auto find1_solutions = std::vector<miopenConvAlgoPerf_t>{};
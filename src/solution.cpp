@@ -28,8 +28,14 @@
 
 #include <miopen/any_solver.hpp>
 #include <miopen/check_numerics.hpp>
+#include <miopen/config.h>
 #include <miopen/conv/data_invoke_params.hpp>
 #include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/stringutils.hpp>
+#include <miopen/target_properties.hpp>
+#include <miopen/version.h>
 
 #include <nlohmann/json.hpp>
 
@@ -37,6 +43,11 @@
 #include "miopen/fusion/problem_description.hpp"
 #include "miopen/fusion/context.hpp"
 
+#include <algorithm>
+#include <iterator>
+
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_SOLUTION_BOUND_INVOKER)
+
 namespace miopen::debug {
 // Todo: This should be updated when a separate driver command is implemented
 void LogCmdConvolution(const miopen::TensorDescriptor& x,
@@ -49,10 +60,12 @@ void LogCmdConvolution(const miopen::TensorDescriptor& x,
 
 namespace miopen {
 
-void Solution::Run(Handle& handle,
-                   const std::unordered_map<miopenTensorArgumentId_t, RunInput>& inputs,
-                   Data_t workspace,
-                   std::size_t workspace_size)
+namespace {
+constexpr miopenTensorArgumentId_t convolution_ids[] = {
+    miopenTensorConvolutionX, miopenTensorConvolutionW, miopenTensorConvolutionY};
+} // namespace
+
+void Solution::CheckWorkspaceSize(std::size_t workspace_size) const
 {
     if(workspace_size < workspace_required)
     {
@@ -61,6 +74,47 @@ void Solution::Run(Handle& handle,
                          std::to_string(workspace_required) + " workspace, while " +
                          std::to_string(workspace_size) + " was provided");
     }
+}
+
+void Solution::Run(Handle& handle,
+                   const miopenTensorArgument_t* tensors,
+                   std::size_t count,
+                   Data_t workspace,
+                   std::size_t workspace_size)
+{
+    CheckWorkspaceSize(workspace_size);
+
+    const auto* problem_ = boost::get<Problem>(&problem.item);
+    const auto* conv_desc =
+        problem_ != nullptr ? boost::get<ConvolutionDescriptor>(&problem_->GetOperatorDescriptor())
+                            : nullptr;
+    if(conv_desc != nullptr)
+    {
+        auto args = ConvolutionInputs{};
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            const auto id = std::find(
+                std::begin(convolution_ids), std::end(convolution_ids), tensors[i].id);
+            if(id != std::end(convolution_ids))
+                args[id - std::begin(convolution_ids)] = RunInput{tensors[i]};
+        }
+        if(RunBound(handle, args, workspace, workspace_size, *conv_desc))
+            return;
+    }
+
+    auto inputs = std::unordered_map<miopenTensorArgumentId_t, RunInput>{};
+    inputs.reserve(count);
+    for(std::size_t i = 0; i < count; ++i)
+        inputs.emplace(tensors[i].id, RunInput{tensors[i]});
+    Run(handle, inputs, workspace, workspace_size);
+}
+
+void Solution::Run(Handle& handle,
+                   const std::unordered_map<miopenTensorArgumentId_t, RunInput>& inputs,
+                   Data_t workspace,
+                   std::size_t workspace_size)
+{
+    CheckWorkspaceSize(workspace_size);
 
     boost::apply_visitor(
         boost::hof::match(
@@ -68,7 +122,15 @@ void Solution::Run(Handle& handle,
                 boost::apply_visitor(
                     boost::hof::match(
                         [&](const ConvolutionDescriptor& op_desc) {
-                            RunImpl(handle, inputs, workspace, workspace_size, op_desc);
+                            auto args = ConvolutionInputs{};
+                            for(std::size_t i = 0; i < args.size(); ++i)
+                            {
+                                const auto found = inputs.find(convolution_ids[i]);
+                                if(found != inputs.end())
+                                    args[i] = found->second;
+                            }
+                            if(!RunBound(handle, args, workspace, workspace_size, op_desc))
+                                RunImpl(handle, inputs, workspace, workspace_size, op_desc);
                         },
                         [&](const ActivationDescriptor& /*op_desc*/) {
                             MIOPEN_THROW(miopenStatusNotImplemented);
@@ -91,7 +153,7 @@ void Solution::LogDriverCommand() const
 
 void Solution::LogDriverCommand(const ConvolutionDescriptor& desc) const
 {
-    auto problem_ = boost::get<const Problem&>(problem.item);
+    const auto& problem_ = boost::get<const Problem&>(problem.item);
     const auto& x_desc =
         problem_.GetTensorDescriptorChecked(miopenTensorConvolutionX, "miopenTensorConvolutionX");
     const auto& w_desc =
@@ -124,6 +186,189 @@ void Solution::LogDriverCommand(const FusedProblem& problem_) const
     /// \todo: add logging of some command to reproduce current solution or at least problem
 }
 
+void Solution::EmbedCodeObjects(Handle& handle)
+{
+    boost::apply_visitor(
+        boost::hof::match(
+            [&](const Problem& problem_) {
+                boost::apply_visitor(
+                    boost::hof::match(
+                        [&](const ConvolutionDescriptor& op_desc) {
+                            EmbedCodeObjects(handle, op_desc);
+                        },
+                        [&](const auto& /*op_desc*/) {
+                            MIOPEN_THROW(miopenStatusNotImplemented);
+                        }),
+                    problem_.GetOperatorDescriptor());
+            },
+            [&](const FusedProblem& /*problem_*/) {
+                MIOPEN_THROW(miopenStatusNotImplemented,
+                             "Embedding code objects into fused solutions is not supported.");
+            }),
+        problem.item);
+
+    serialization_cache = {};
+}
+
+void Solution::EmbedCodeObjects(Handle& handle, const ConvolutionDescriptor& conv_desc)
+{
+    const auto& problem_casted = boost::get<const Problem&>(problem.item);
+    const auto conv_problem    = conv_desc.mode == miopenTranspose
+                                     ? problem_casted.MakeTransposed().AsConvolution()
+                                     : problem_casted.AsConvolution();
+
+    auto conv_ctx = ExecutionContext{&handle};
+    conv_problem.SetupFloats(conv_ctx);
+
+    decltype(auto) db        = GetDb(conv_ctx);
+    const auto conv_solution = GetSolver().GetSolver().FindSolution(
+        conv_ctx, conv_problem, db, AnyInvokeParams{}, perf_cfg.value_or(""));
+
+    auto embedded = std::vector<CodeObject>{};
+    for(const auto& kernel : conv_solution.construction_params)
+    {
+        const auto same_program = [&](const CodeObject& code_object) {
+            return code_object.program_name == kernel.kernel_file &&
+                   code_object.params == kernel.comp_options;
+        };
+        if(std::any_of(embedded.begin(), embedded.end(), same_program))
+            continue;
+
+        embedded.push_back({kernel.kernel_file,
+                            kernel.comp_options,
+                            handle.GetProgramBinary(kernel.kernel_file, kernel.comp_options)});
+    }
+
+    code_objects_fingerprint = GetCodeObjectsFingerprint(handle);
+    code_objects             = std::move(embedded);
+}
+
+void Solution::LoadCodeObjects(const Handle& handle) const
+{
+    if(code_objects.empty())
+        return;
+
+    if(code_objects_fingerprint != GetCodeObjectsFingerprint(handle))
+    {
+        MIOPEN_LOG_I("Embedded code objects have been built for " << code_objects_fingerprint
+                                                                  << ", ignoring them.");
+        return;
+    }
+
+    for(const auto& code_object : code_objects)
+    {
+        if(!handle.HasProgram(code_object.program_name, code_object.params))
+        {
+            handle.AddProgramBinary(
+                code_object.program_name, code_object.params, code_object.binary);
+        }
+    }
+}
+
+std::string Solution::GetCodeObjectsFingerprint(const Handle& handle)
+{
+    // Code objects depend on the exact target, including its features, on the sources and
+    // compilation options of the library and on the compiler
+    return handle.GetTargetProperties().DbId() + "-" +    //
+           std::to_string(MIOPEN_VERSION_MAJOR) + "." +   //
+           std::to_string(MIOPEN_VERSION_MINOR) + "." +   //
+           std::to_string(MIOPEN_VERSION_PATCH) + "." +   //
+           MIOPEN_STRINGIZE(MIOPEN_VERSION_TWEAK) + "-" + //
+           std::to_string(HIP_PACKAGE_VERSION_FLAT);
+}
+
+void Solution::Bind(const Handle& handle,
+                    const Invoker& invoker,
+                    AnyInvokeParams invoke_params,
+                    miopenProblemDirection_t direction,
+                    std::vector<TensorDescriptor> descriptors)
+{
+    std::atomic_store(&bound_invoker,
+                      std::make_shared<BoundInvoker>(handle.GetInvokerCacheId(),
+                                                     invoker,
+                                                     std::move(invoke_params),
+                                                     direction,
+                                                     std::move(descriptors)));
+}
+
+bool Solution::RunBound(Handle& handle,
+                        ConvolutionInputs args,
+                        Data_t workspace,
+                        std::size_t workspace_size,
+                        const ConvolutionDescriptor& conv_desc)
+{
+    const auto bound = std::atomic_load(&bound_invoker);
+    if(!bound || bound->handle_id != handle.GetInvokerCacheId() ||
+       miopen::IsDisabled(ENV(MIOPEN_DEBUG_SOLUTION_BOUND_INVOKER)) ||
+       miopen::CheckNumericsEnabled())
+        return false;
+
+    const auto& problem_casted = boost::get<const Problem&>(problem.item);
+
+    static const TensorDescriptor missing;
+
+    // Anything unusual, including errors, is left to RunImpl
+    for(std::size_t i = 0; i < args.size(); ++i)
+    {
+        if(!args[i])
+            return false;
+        if(args[i]->descriptor == nullptr)
+            args[i]->descriptor = &problem_casted.GetTensorDescriptor(convolution_ids[i], missing);
+        if(args[i]->descriptor == &missing || *args[i]->descriptor != bound->descriptors[i])
+            return false;
+    }
+
+    auto* x = &*args[0];
+    auto* w = &*args[1];
+    auto* y = &*args[2];
+    if(conv_desc.mode == miopenTranspose)
+        std::swap(x, y);
+
+    // The descriptors are the same, so only the buffers of the bound parameters need updating.
+    // Concurrent runs of the solution can't share them, all but one patch a copy.
+    struct BusyGuard
+    {
+        std::atomic_flag* flag;
+        ~BusyGuard()
+        {
+            if(flag != nullptr)
+                flag->clear(std::memory_order_release);
+        }
+    };
+    const auto exclusive = !bound->busy.test_and_set(std::memory_order_acquire);
+    const auto guard     = BusyGuard{exclusive ? &bound->busy : nullptr};
+    auto copy            = std::optional<AnyInvokeParams>{};
+    auto& invoke_ctx     = exclusive ? bound->invoke_params : copy.emplace(bound->invoke_params);
+
+    switch(bound->direction)
+    {
+    case miopenProblemDirectionForward:
+    case miopenProblemDirectionBackward: {
+        const auto forward   = bound->direction == miopenProblemDirectionForward;
+        auto& params         = invoke_ctx.CastTo<conv::DataInvokeParams>();
+        params.tensors.in    = forward ? x->buffer : y->buffer;
+        params.tensors.w     = w->buffer;
+        params.tensors.out   = forward ? y->buffer : x->buffer;
+        params.workSpace     = workspace;
+        params.workSpaceSize = workspace_size;
+        break;
+    }
+    case miopenProblemDirectionBackwardWeights: {
+        auto& params         = invoke_ctx.CastTo<conv::WrWInvokeParams>();
+        params.tensors.dy    = y->buffer;
+        params.tensors.x     = x->buffer;
+        params.tensors.dw    = w->buffer;
+        params.workSpace     = workspace;
+        params.workSpaceSize = workspace_size;
+        break;
+    }
+    default: return false;
+    }
+
+    bound->invoker(handle, invoke_ctx);
+    return true;
+}
+
 void Solution::RunImpl(Handle& handle,
                        const std::unordered_map<miopenTensorArgumentId_t, RunInput>& inputs,
                        Data_t workspace,
@@ -140,8 +385,8 @@ void Solution::RunImpl(Handle& handle,
                          "Problem is missing " + name_str + " tensor descriptor.");
         }
         auto ret = found->second;
-        if(!ret.descriptor.has_value())
-            ret.descriptor = problem_casted.GetTensorDescriptorChecked(name, name_str);
+        if(ret.descriptor == nullptr)
+            ret.descriptor = &problem_casted.GetTensorDescriptorChecked(name, name_str);
         return ret;
     };
 
@@ -149,8 +394,14 @@ void Solution::RunImpl(Handle& handle,
     const auto w = get_input_checked(miopenTensorConvolutionW, "miopenTensorConvolutionW");
     auto y       = get_input_checked(miopenTensorConvolutionY, "miopenTensorConvolutionY");
 
-    const auto problem_ =
-        conv_desc.mode == miopenTranspose ? Transpose(problem_casted, &x, w, &y) : problem_casted;
+    auto bound_descriptors =
+        std::vector<TensorDescriptor>{*x.descriptor, *w.descriptor, *y.descriptor};
+
+    // Only transposed convolutions need a problem of their own
+    auto transposed      = std::optional<Problem>{};
+    const auto& problem_ = conv_desc.mode == miopenTranspose
+                               ? transposed.emplace(Transpose(problem_casted, &x, w, &y))
+                               : problem_casted;
 
     if(problem_.GetDirection() == miopenProblemDirectionBackward &&
        y.descriptor->GetLengths()[1] != w.descriptor->GetLengths()[0])
@@ -214,11 +465,18 @@ void Solution::RunImpl(Handle& handle,
 
     if(found_invoker)
     {
+        Bind(handle,
+             *found_invoker,
+             invoke_ctx,
+             problem_.GetDirection(),
+             std::move(bound_descriptors));
         (*found_invoker)(handle, invoke_ctx);
         checkNumericsOutput_();
         return;
     }
 
+    LoadCodeObjects(handle);
+
     auto conv_ctx = ExecutionContext{&handle};
     conv_problem.SetupFloats(conv_ctx);
 
@@ -228,6 +486,7 @@ void Solution::RunImpl(Handle& handle,
     decltype(auto) invoker =
         handle.PrepareInvoker(*conv_solution.invoker_factory, conv_solution.construction_params);
     handle.RegisterInvoker(invoker, net_cfg, GetSolver().ToString());
+    Bind(handle, invoker, invoke_ctx, problem_.GetDirection(), std::move(bound_descriptors));
     invoker(handle, invoke_ctx);
     checkNumericsOutput_();
 }
@@ -243,7 +502,7 @@ void Solution::RunImpl(Handle& handle,
         if(found == inputs.end())
             MIOPEN_THROW(miopenStatusInvalidValue,
                          "Problem is missing " + std::to_string(id) + " tensor descriptor.");
-        if(found->second.descriptor.has_value() && *found->second.descriptor != descriptor)
+        if(found->second.descriptor != nullptr && *found->second.descriptor != descriptor)
             MIOPEN_THROW(miopenStatusNotImplemented,
                          "Providing new descriptors for a fused solution is not supported.");
         return found->second.buffer;
@@ -252,6 +511,14 @@ void Solution::RunImpl(Handle& handle,
     OperatorArgs op_args;
     const auto invoke_params = problem_.MakeInvokeParams(buffer_getter, op_args);
 
+    const auto bound = std::atomic_load(&bound_invoker);
+    if(bound && bound->handle_id == handle.GetInvokerCacheId() &&
+       !miopen::IsDisabled(ENV(MIOPEN_DEBUG_SOLUTION_BOUND_INVOKER)))
+    {
+        bound->invoker(handle, invoke_params);
+        return;
+    }
+
     const auto plan           = problem_.AsFusionPlan();
     const auto fusion_problem = FusionDescription{&plan};
     const auto net_cfg        = fusion_problem.MakeNetworkConfig();
@@ -260,6 +527,7 @@ void Solution::RunImpl(Handle& handle,
 
     if(found_invoker)
     {
+        Bind(handle, *found_invoker);
         (*found_invoker)(handle, invoke_params);
         return;
     }
@@ -269,6 +537,7 @@ void Solution::RunImpl(Handle& handle,
     decltype(auto) invoker =
         handle.PrepareInvoker(*solution.invoker_factory, solution.construction_params);
     handle.RegisterInvoker(invoker, net_cfg, GetSolver().ToString());
+    Bind(handle, invoker);
     invoker(handle, invoke_params);
 }
 
@@ -313,6 +582,25 @@ void to_json(nlohmann::json& json, const Solution& solution)
 
     if(solution.perf_cfg.has_value())
         json["perf_cfg"] = *solution.perf_cfg;
+
+    if(!solution.code_objects.empty())
+    {
+        auto programs = nlohmann::json::array();
+        for(const auto& code_object : solution.code_objects)
+        {
+            const auto& binary = code_object.binary;
+            programs.push_back(nlohmann::json{
+                {"name", code_object.program_name},
+                {"params", code_object.params},
+                {"binary", nlohmann::json::binary({binary.begin(), binary.end()})},
+            });
+        }
+
+        json["code_objects"] = nlohmann::json{
+            {"fingerprint", solution.code_objects_fingerprint},
+            {"programs", std::move(programs)},
+        };
+    }
 }
 
 void from_json(const nlohmann::json& json, Solution& solution)
@@ -343,5 +631,22 @@ void from_json(const nlohmann::json& json, Solution& solution)
     solution.perf_cfg        = perf_cfg_json != json.end()
                                    ? std::optional{perf_cfg_json->get<std::string>()}
                                    : std::nullopt;
+
+    solution.code_objects_fingerprint.clear();
+    solution.code_objects.clear();
+
+    // Older solutions and ones without embedded code objects don't have this section
+    const auto code_objects_json = json.find("code_objects");
+    if(code_objects_json != json.end())
+    {
+        code_objects_json->at("fingerprint").get_to(solution.code_objects_fingerprint);
+        for(const auto& program : code_objects_json->at("programs"))
+        {
+            const auto& binary = program.at("binary").get_binary();
+            solution.code_objects.push_back({program.at("name").get<std::string>(),
+                                             program.at("params").get<std::string>(),
+                                             {binary.begin(), binary.end()}});
+        }
+    }
 }
 } // namespace miopen
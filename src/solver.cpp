@@ -44,6 +44,7 @@
 
 #include <boost/range/adaptor/transformed.hpp>
 #include <ostream>
+#include <set>
 
 MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_ENABLE_DEPRECATED_SOLVERS)
 
@@ -82,6 +83,7 @@ void PrecompileSolutions(const Handle& h, const std::vector<const ConvSolution*>
 {
     // Find all kernels that need to be compiled from the solutions
     std::vector<KernelInfo> kernels;
+    std::set<std::pair<std::string, std::string>> programs_to_build;
     for(auto&& sol : sols)
     {
         if(!sol->Succeeded())
@@ -90,6 +92,9 @@ void PrecompileSolutions(const Handle& h, const std::vector<const ConvSolution*>
         {
             if(h.HasProgram(kernel.kernel_file, kernel.comp_options))
                 continue;
+            // Several solutions may use the same program
+            if(!programs_to_build.emplace(kernel.kernel_file, kernel.comp_options).second)
+                continue;
             kernels.push_back(kernel);
         }
     }
@@ -165,6 +165,7 @@ static void RunCKSolution(const Handle& handle,
     auto invoker_ptr            = bn_ptr->MakeInvokerPointer();
     const auto enable_profiling = handle.IsProfilingEnabled();
 
+    handle.MarkCaptureUnsupported("Composable kernel launch");
     float elapsed_time =
         invoker_ptr->Run(argument_ptr.get(), {handle.GetStream(), enable_profiling});
     if(enable_profiling)
@@ -271,6 +271,7 @@ void RunCKSolution(const Handle& handle,
     auto invoker_ptr            = conv_ck->MakeInvokerPointer();
     const auto enable_profiling = handle.IsProfilingEnabled();
 
+    handle.MarkCaptureUnsupported("Composable kernel launch");
     float elapsed_time =
         invoker_ptr->Run(argument_ptr.get(), {handle.GetStream(), enable_profiling});
     if(enable_profiling)
@@ -197,6 +197,7 @@ ConvSolution MakeInvokerFactory([[maybe_unused]] const ExecutionContext& context
                                                        data_ctx.rstd);
                 auto invoker_ptr     = sh_ln_ptr->MakeInvokerPointer();
 
+                handle.MarkCaptureUnsupported("Composable kernel launch");
                 const auto enable_profiling = handle.IsProfilingEnabled();
                 float elapsed_time =
                     invoker_ptr->Run(argument_ptr.get(), {handle.GetStream(), enable_profiling});
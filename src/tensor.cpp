@@ -218,13 +218,15 @@ TensorDescriptor::TensorDescriptor(miopenDataType_t t,
             MIOPEN_THROW(miopenStatusBadParm, "Strides must be > 0");
 
         strides = strides_in;
-        packed  = (this->GetElementSize() == this->GetElementSpace());
+        this->CalculateCachedProperties();
+        packed = (this->GetElementSize() == this->GetElementSpace());
     }
     else
     {
         packed = true;
         // Since strides is not passed it is computed based on tensorLayout.
         SetStrideNd(GetLayout_str());
+        this->CalculateCachedProperties();
     }
 }
 
@@ -320,6 +322,31 @@ void TensorDescriptor::CalculateVectorLength()
                                                                                            : 1));
 }
 
+void TensorDescriptor::CalculateCachedProperties()
+{
+    assert(lens.size() == strides.size());
+
+    element_size =
+        std::accumulate(lens.begin(), lens.end(), vector_length, std::multiplies<std::size_t>());
+    element_space = vector_length;
+    for(std::size_t i = 0; i < lens.size(); ++i)
+        element_space += (lens[i] - 1) * strides[i];
+
+    if(lens.size() > layout_permutation.size())
+        return;
+
+    // Insertion sort matching the stable_sort of find_permutation: dimensions by descending
+    // stride, then length, equal ones keeping their order.
+    const auto key = [&](std::size_t i) { return std::make_tuple(strides[i], lens[i]); };
+    for(std::size_t i = 0; i < lens.size(); ++i)
+    {
+        auto j = i;
+        for(; j > 0 && key(i) > key(layout_permutation[j - 1]); --j)
+            layout_permutation[j] = layout_permutation[j - 1];
+        layout_permutation[j] = static_cast<std::uint8_t>(i);
+    }
+}
+
 bool TensorDescriptor::IsVectorized() const { return vector_length > 1; }
 
 const std::vector<std::size_t>& TensorDescriptor::GetLengths() const { return lens; }
@@ -332,11 +359,7 @@ int TensorDescriptor::GetSize() const
     return lens.size();
 }
 
-std::size_t TensorDescriptor::GetElementSize() const
-{
-    assert(lens.size() == strides.size());
-    return std::accumulate(lens.begin(), lens.end(), vector_length, std::multiplies<std::size_t>());
-}
+std::size_t TensorDescriptor::GetElementSize() const { return element_size; }
 
 miopenDataType_t TensorDescriptor::GetType() const { return this->type; }
 
@@ -397,24 +420,31 @@ std::size_t TensorDescriptor::GetIndex(std::initializer_list<int> l) const
     }
 }
 
-std::size_t TensorDescriptor::GetElementSpace() const
-{
-    std::vector<std::size_t> maxIndices(lens.size());
-    std::transform(lens.begin(),
-                   lens.end(),
-                   std::vector<std::size_t>(lens.size(), 1).begin(),
-                   maxIndices.begin(),
-                   std::minus<std::size_t>());
-    return std::inner_product(
-               maxIndices.begin(), maxIndices.end(), strides.begin(), std::size_t{0}) +
-           vector_length;
-}
+std::size_t TensorDescriptor::GetElementSpace() const { return element_space; }
 
 bool TensorDescriptor::IsPossibleLayout(const std::string& labels, const std::string& layout) const
 {
-    std::vector<size_t> derived_strides;
-    tensor_layout_to_strides(lens, labels, layout, derived_strides);
-    return derived_strides == strides;
+    // Same as comparing with tensor_layout_to_strides(lens, labels, layout), without building
+    // the strides
+    if(labels.size() != strides.size())
+        return false;
+
+    for(std::size_t i = 0; i < labels.size(); ++i)
+    {
+        const auto pos = layout.find(labels[i]);
+        if(pos == std::string::npos)
+            MIOPEN_THROW(std::string("mismatched layout string - ").append(layout));
+
+        std::size_t derived_stride = 1;
+        for(auto dim = layout.begin() + pos + 1; dim != layout.end(); ++dim)
+        {
+            const auto len_index = labels.find(*dim);
+            derived_stride *= len_index == std::string::npos ? 0 : lens[len_index];
+        }
+        if(derived_stride != strides[i])
+            return false;
+    }
+    return true;
 }
 
 std::size_t TensorDescriptor::GetNumBytes() const
@@ -498,6 +528,7 @@ void from_json(const nlohmann::json& j, TensorDescriptor& descriptor)
     j.at("strides").get_to(descriptor.strides);
     j.at("packed").get_to(descriptor.packed);
     j.at("type").get_to(descriptor.type);
+    descriptor.CalculateCachedProperties();
 }
 
 } // namespace miopen
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/tensor_op_plan.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace miopen {
+
+std::vector<std::size_t> TensorOpPlan::GetBLengths() const
+{
+    std::vector<std::size_t> b_lengths(lengths.size());
+    for(std::size_t i = 0; i < lengths.size(); ++i)
+        b_lengths[i] = b_strides[i] == 0 ? 1 : lengths[i];
+    return b_lengths;
+}
+
+bool TensorOpPlan::FitsKernels() const
+{
+    if(GetSize() == 1)
+        return true;
+    // B strides of broadcast dims are zero here, but packed in the descriptor.
+    return a_strides.back() == 1 && b_strides.back() <= 1 && c_strides.back() == 1;
+}
+
+std::tuple<TensorDescriptor, TensorDescriptor, TensorDescriptor>
+TensorOpPlan::GetDescriptors(miopenDataType_t a_type,
+                             miopenDataType_t b_type,
+                             miopenDataType_t c_type) const
+{
+    const auto b_lengths = GetBLengths();
+    auto b_desc_strides  = b_strides;
+
+    std::size_t packed_stride = 1;
+    for(auto i = b_lengths.size(); i-- > 0;)
+    {
+        if(b_desc_strides[i] == 0)
+            b_desc_strides[i] = packed_stride;
+        packed_stride = b_desc_strides[i] * b_lengths[i];
+    }
+
+    return std::make_tuple(TensorDescriptor{a_type, lengths, a_strides},
+                           TensorDescriptor{b_type, b_lengths, b_desc_strides},
+                           TensorDescriptor{c_type, lengths, c_strides});
+}
+
+std::optional<TensorOpPlan> PlanTensorOp(const TensorDescriptor& aDesc,
+                                         const TensorDescriptor& bDesc,
+                                         const TensorDescriptor& cDesc)
+{
+    const auto& alens = aDesc.GetLengths();
+    const auto& blens = bDesc.GetLengths();
+    const auto& clens = cDesc.GetLengths();
+
+    if(alens != clens || blens.size() != clens.size())
+        return std::nullopt;
+
+    for(std::size_t i = 0; i < clens.size(); ++i)
+    {
+        if(blens[i] != 1 && blens[i] != clens[i])
+            return std::nullopt;
+    }
+
+    const auto& astrides = aDesc.GetStrides();
+    const auto& bstrides = bDesc.GetStrides();
+    const auto& cstrides = cDesc.GetStrides();
+
+    TensorOpPlan plan;
+
+    for(std::size_t i = 0; i < clens.size(); ++i)
+    {
+        const auto len = clens[i];
+        if(len == 1)
+            continue;
+
+        const std::size_t bstride = blens[i] == 1 ? 0 : bstrides[i];
+
+        // The previous kept dim is the outer one. Broadcast dims of B have zero strides, so
+        // they merge with each other, but never with a dim B is not broadcast along.
+        if(!plan.lengths.empty() && plan.a_strides.back() == astrides[i] * len &&
+           plan.b_strides.back() == bstride * len && plan.c_strides.back() == cstrides[i] * len)
+        {
+            plan.lengths.back() *= len;
+            plan.a_strides.back() = astrides[i];
+            plan.b_strides.back() = bstride;
+            plan.c_strides.back() = cstrides[i];
+            continue;
+        }
+
+        plan.lengths.push_back(len);
+        plan.a_strides.push_back(astrides[i]);
+        plan.b_strides.push_back(bstride);
+        plan.c_strides.push_back(cstrides[i]);
+    }
+
+    if(plan.lengths.empty())
+    {
+        // Single element, B is broadcast trivially.
+        plan.lengths   = {1};
+        plan.a_strides = {1};
+        plan.b_strides = {0};
+        plan.c_strides = {1};
+    }
+
+    if(plan.GetSize() > 1)
+        plan.shape = TensorOpShape::Generic;
+    else if(plan.b_strides[0] == 0)
+        plan.shape = TensorOpShape::Broadcast1d;
+    else if(plan.a_strides[0] == 1 && plan.b_strides[0] == 1 && plan.c_strides[0] == 1)
+        plan.shape = TensorOpShape::Packed1d;
+    else
+        plan.shape = TensorOpShape::Strided1d;
+
+    assert(plan.a_strides.size() == plan.GetSize() && plan.c_strides.size() == plan.GetSize());
+    return plan;
+}
+
+} // namespace miopen
@@ -0,0 +1,257 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/tracer.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/miopen_internal.h>
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+/// Enables the built-in tracer and sets the file the Chrome trace is written to at exit.
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_TRACE)
+
+/// Number of events kept per thread. Older events are overwritten. 65536 by default.
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_TRACE_BUFFER_SIZE)
+
+namespace miopen {
+namespace trace {
+
+namespace {
+
+std::uint64_t Now()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                start)
+        .count();
+}
+
+class ThreadBuffer
+{
+public:
+    ThreadBuffer(std::uint32_t tid_, std::size_t capacity) : tid(tid_) { events.reserve(capacity); }
+
+    std::uint32_t GetTid() const { return tid; }
+
+    // Only contended while the trace is being written
+    void Push(const Event& event)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(events.size() < events.capacity())
+        {
+            events.push_back(event);
+            return;
+        }
+        events[next] = event;
+        next         = (next + 1) % events.size();
+    }
+
+    std::vector<Event> Snapshot() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto ordered = std::vector<Event>{};
+        ordered.reserve(events.size());
+        ordered.insert(ordered.end(), events.begin() + next, events.end());
+        ordered.insert(ordered.end(), events.begin(), events.begin() + next);
+        return ordered;
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.clear();
+        next = 0;
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::vector<Event> events;
+    std::size_t next = 0;
+    std::uint32_t tid;
+};
+
+struct Registry
+{
+    std::mutex mutex;
+    // Buffers of exited threads are kept, their events are still to be written
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::unordered_set<std::string> interned;
+
+    static Registry& Get()
+    {
+        static Registry registry;
+        return registry;
+    }
+};
+
+ThreadBuffer& GetThreadBuffer()
+{
+    thread_local const auto buffer = []() {
+        auto& registry      = Registry::Get();
+        const auto size_env = Value(ENV(MIOPEN_TRACE_BUFFER_SIZE));
+        const auto capacity = size_env != 0 ? size_env : 65536;
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        const auto tid = static_cast<std::uint32_t>(registry.buffers.size() + 1);
+        registry.buffers.push_back(std::make_shared<ThreadBuffer>(tid, capacity));
+        return registry.buffers.back();
+    }();
+    return *buffer;
+}
+
+void WriteString(std::ostream& os, const char* str)
+{
+    os << '"';
+    for(; *str != '\0'; ++str)
+    {
+        if(*str == '"' || *str == '\\')
+            os << '\\';
+        os << *str;
+    }
+    os << '"';
+}
+
+// Writes the trace at exit when it has been requested with MIOPEN_TRACE
+struct ExitWriter
+{
+    ExitWriter() { Registry::Get(); } // Has to be destroyed after this
+
+    ~ExitWriter()
+    {
+        const auto& path = GetStringEnv(ENV(MIOPEN_TRACE));
+        if(!path.empty())
+            WriteChromeTrace(path);
+    }
+};
+
+} // namespace
+
+std::atomic<bool>& EnabledFlag()
+{
+    static std::atomic<bool> enabled{[]() {
+        if(GetStringEnv(ENV(MIOPEN_TRACE)).empty())
+            return false;
+        static const ExitWriter exit_writer;
+        return true;
+    }()};
+    return enabled;
+}
+
+void Enable(bool enabled) { EnabledFlag().store(enabled, std::memory_order_relaxed); }
+
+const char* Intern(const std::string& str)
+{
+    auto& registry = Registry::Get();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.interned.insert(str).first->c_str();
+}
+
+void Record(Phase phase, const char* category, const char* name, std::int64_t value)
+{
+    GetThreadBuffer().Push({category, name, value, Now(), phase});
+}
+
+bool WriteChromeTrace(const std::string& path)
+{
+    auto buffers = std::vector<std::shared_ptr<ThreadBuffer>>{};
+    {
+        auto& registry = Registry::Get();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        buffers = registry.buffers;
+    }
+
+    auto file = std::ofstream{path};
+    if(!file)
+    {
+        MIOPEN_LOG_E("Unable to write the trace to " << path);
+        return false;
+    }
+
+#ifdef __linux__
+    const auto pid = getpid();
+#else
+    const auto pid = 0;
+#endif
+
+    file << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+    auto first = true;
+    for(const auto& buffer : buffers)
+    {
+        for(const auto& event : buffer->Snapshot())
+        {
+            file << (first ? "\n" : ",\n") << "{\"name\":";
+            WriteString(file, event.name);
+            file << ",\"cat\":";
+            WriteString(file, event.category);
+            file << ",\"ph\":\""
+                 << (event.phase == Phase::Begin ? 'B' : event.phase == Phase::End ? 'E' : 'C')
+                 << "\",\"ts\":" << static_cast<double>(event.timestamp_ns) * .001
+                 << ",\"pid\":" << pid << ",\"tid\":" << buffer->GetTid();
+            if(event.phase == Phase::Counter)
+                file << ",\"args\":{\"value\":" << event.value << "}";
+            file << "}";
+            first = false;
+        }
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    MIOPEN_LOG_I("Trace written to " << path);
+    return static_cast<bool>(file);
+}
+
+void Clear()
+{
+    auto& registry = Registry::Get();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for(const auto& buffer : registry.buffers)
+        buffer->Clear();
+}
+
+} // namespace trace
+} // namespace miopen
+
+extern "C" miopenStatus_t miopenWriteTrace(const char* path)
+{
+    return miopen::try_([&] {
+        if(path == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "No trace file path");
+        if(!miopen::trace::WriteChromeTrace(path))
+            MIOPEN_THROW(miopenStatusInternalError, "Unable to write the trace");
+    });
+}
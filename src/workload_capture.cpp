@@ -0,0 +1,286 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/workload_capture.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+/// Path of the workload manifest to capture the problems into. Capture is disabled when unset.
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_CAPTURE_WORKLOAD)
+
+namespace miopen {
+
+namespace debug {
+
+boost::optional<std::string>& workload_capture_path_override()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static boost::optional<std::string> data = boost::none;
+    return data;
+}
+
+} // namespace debug
+
+namespace capture {
+
+namespace {
+
+constexpr const char* driver_prefix = "./bin/MIOpenDriver ";
+constexpr auto flush_interval       = std::chrono::seconds{10};
+
+const std::string& GetPath()
+{
+    if(debug::workload_capture_path_override())
+        return *debug::workload_capture_path_override();
+    return GetStringEnv(ENV(MIOPEN_CAPTURE_WORKLOAD));
+}
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+thread_local ApiScope* current_scope = nullptr;
+
+// Problems recorded since the last flush and the thread flushing them
+class Recorder
+{
+public:
+    static Recorder& Get()
+    {
+        static Recorder recorder;
+        return recorder;
+    }
+
+    void Add(const std::string& driver_args, std::uint64_t count, double host_ms)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& entry = pending[driver_args];
+        entry.count += count;
+        entry.host_ms += host_ms;
+
+        if(!flusher.joinable())
+            flusher = std::thread([this]() { Run(); });
+    }
+
+    bool Flush()
+    {
+        const auto& path = GetPath();
+        if(path.empty())
+            return false;
+
+        auto recorded = Manifest{};
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            recorded.insert(pending.begin(), pending.end());
+            pending.clear();
+        }
+        if(recorded.empty())
+            return true;
+
+        // Merged into what the other processes have written
+        auto& lock_file = LockFile::Get(LockFilePath(path).c_str());
+        std::lock_guard<LockFile> file_lock(lock_file);
+
+        auto manifest = Manifest{};
+        {
+            auto file = std::ifstream{path};
+            if(file)
+                manifest = ReadManifest(file);
+        }
+        MergeManifest(manifest, recorded);
+
+#ifdef __linux__
+        const auto temp_path = path + "." + std::to_string(getpid()) + ".tmp";
+#else
+        const auto temp_path = path + ".tmp";
+#endif
+        {
+            auto file = std::ofstream{temp_path};
+            WriteManifest(file, manifest);
+            if(!file)
+            {
+                MIOPEN_LOG_E("Unable to write the workload manifest to " << temp_path);
+                return false;
+            }
+        }
+
+        boost::system::error_code error;
+        boost::filesystem::rename(temp_path, path, error);
+        if(error)
+        {
+            MIOPEN_LOG_E("Unable to write the workload manifest to " << path << ": "
+                                                                      << error.message());
+            return false;
+        }
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable stop_condition;
+    bool stop = false;
+    std::unordered_map<std::string, ManifestEntry> pending;
+    std::thread flusher;
+
+    Recorder()
+    {
+        // Initializes the lock files registry before this, so that it is still there at exit.
+        const auto& path = GetPath();
+        if(!path.empty())
+            LockFile::Get(LockFilePath(path).c_str());
+    }
+
+    ~Recorder()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        stop_condition.notify_all();
+        if(flusher.joinable())
+            flusher.join();
+        Flush();
+    }
+
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while(!stop_condition.wait_for(lock, flush_interval, [&]() { return stop; }))
+        {
+            lock.unlock();
+            Flush();
+            lock.lock();
+        }
+    }
+};
+
+} // namespace
+
+bool IsEnabled() { return !GetPath().empty(); }
+
+void Record(const std::string& driver_args)
+{
+    if(!IsEnabled())
+        return;
+
+    // The time of the call is added to the problem when the API call returns
+    if(current_scope != nullptr && current_scope->problem.empty())
+        current_scope->problem = driver_args;
+    Recorder::Get().Add(driver_args, 1, 0.0);
+}
+
+bool Flush() { return Recorder::Get().Flush(); }
+
+Manifest ReadManifest(std::istream& stream)
+{
+    auto manifest = Manifest{};
+    std::string line;
+    while(std::getline(stream, line))
+    {
+        if(line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream fields(line);
+        auto entry = ManifestEntry{};
+        std::string command;
+        fields >> entry.count >> entry.host_ms >> std::ws;
+        std::getline(fields, command);
+
+        const auto prefix_pos = command.find(driver_prefix);
+        if(prefix_pos != 0)
+        {
+            MIOPEN_LOG_W("Skipping a malformed workload manifest line: " << line);
+            continue;
+        }
+
+        auto& merged = manifest[command.substr(std::string{driver_prefix}.size())];
+        merged.count += entry.count;
+        merged.host_ms += entry.host_ms;
+    }
+    return manifest;
+}
+
+void WriteManifest(std::ostream& stream, const Manifest& manifest)
+{
+    stream << "# count host_ms command" << std::endl;
+    stream << std::fixed << std::setprecision(3);
+    for(const auto& entry : manifest)
+    {
+        stream << entry.second.count << ' ' << entry.second.host_ms << ' ' << driver_prefix
+               << entry.first << '\n';
+    }
+    stream.flush();
+}
+
+void MergeManifest(Manifest& into, const Manifest& from)
+{
+    for(const auto& entry : from)
+    {
+        auto& merged = into[entry.first];
+        merged.count += entry.second.count;
+        merged.host_ms += entry.second.host_ms;
+    }
+}
+
+ApiScope::ApiScope()
+{
+    if(!IsEnabled())
+        return;
+    active        = true;
+    outer         = current_scope;
+    current_scope = this;
+    start         = std::chrono::steady_clock::now();
+}
+
+ApiScope::~ApiScope()
+{
+    if(!active)
+        return;
+    current_scope = outer;
+    if(problem.empty())
+        return;
+
+    const auto host_ms = std::chrono::duration<double, std::milli>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+    Recorder::Get().Add(problem, 0, host_ms);
+}
+
+} // namespace capture
+} // namespace miopen
@@ -26,6 +26,8 @@
 
 #pragma once
 
+#include "../driver/host_parallel.hpp"
+
 /**********************************************
  * LSTM CPU verification functions
  **********************************************/
@@ -451,171 +453,58 @@ void LSTMFwdCPUVerify(miopen::Handle& handle,
                 }
             }
 
-            for(int bs = 0; bs < in_n.at(ti); bs++)
-            {
-                for(int h = 0; h < hy_h; h++)
+            par_for(in_n.at(ti), 4, [&](int bs) {
+                T* row          = &rsvspace[hid_shift + (bacc + bs) * hy_stride];
+                const T* c_prev = nullptr;
+                if(ti == 0)
                 {
-                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h) +=
-                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + h), 2) *
-                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + 3 * hy_h + h),
-                                  1);
-                    if(ti == 0)
-                    {
-                        if(!cx_is_null)
-                        {
-                            rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h) +=
-                                activfunc(
-                                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + hy_h + h),
-                                    2) *
-                                cx.at(hx_shift + bs * uni_stride + h);
-                        }
-                    }
-                    else
-                    {
-                        int prec_shift = li * batch_n_cpu * hy_stride +
-                                         (bacc - in_n.at(ti - 1)) * hy_stride + bi * 4 * hy_h;
-
-                        rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h) +=
-                            activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + hy_h + h),
-                                      2) *
-                            rsvspace.at(prec_shift + bs * hy_stride + h);
-                    }
-
-                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 5 * hy_h + h) +=
-                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h),
-                                  2) *
-                        activfunc(
-                            rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h),
-                            1);
-
-                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + h +
-                                numlayer * batch_n_cpu * hy_stride) =
-                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + h), 2);
-                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + hy_h + h +
-                                numlayer * batch_n_cpu * hy_stride) =
-                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + hy_h + h), 2);
-                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h +
-                                numlayer * batch_n_cpu * hy_stride) =
-                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h),
-                                  2);
-                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + 3 * hy_h + h +
-                                numlayer * batch_n_cpu * hy_stride) =
-                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + 3 * hy_h + h),
-                                  1);
-                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h +
-                                numlayer * batch_n_cpu * hy_stride) =
-                        activfunc(
-                            rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h),
-                            1);
+                    if(!cx_is_null)
+                        c_prev = &cx[hx_shift + bs * uni_stride];
+                }
+                else
+                {
+                    const int prev_row = bacc - in_n.at(ti - 1) + bs;
 
-                    cy_host.at(hx_shift + bs * uni_stride + h) =
-                        rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h);
-                    hy_host.at(hx_shift + bs * uni_stride + h) =
-                        rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 5 * hy_h + h);
+                    c_prev = &rsvspace[hid_shift + prev_row * hy_stride + bi * 4 * hy_h];
                 }
-            }
+
+                LSTMFwdCellCPU(row,
+                               row + numlayer * batch_n_cpu * hy_stride,
+                               c_prev,
+                               &cy_host[hx_shift + bs * uni_stride],
+                               &hy_host[hx_shift + bs * uni_stride],
+                               hy_h,
+                               0,
+                               bi * 4 * hy_h,
+                               bi * 5 * hy_h);
+            });
 
             if(bidirection == 1)
             {
-                for(int bs = 0; bs < in_n.at(seqLength_cpu - 1 - ti); bs++)
-                {
-                    for(int h = 0; h < hy_h; h++)
+                par_for(in_n.at(seqLength_cpu - 1 - ti), 4, [&](int bs) {
+                    T* row          = &rsvspace[hid_shift + (baccbi + bs) * hy_stride];
+                    const T* c_prev = nullptr;
+                    if(ti > 0 && bs < in_n.at(seqLength_cpu - ti))
                     {
-                        rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h + hy_h +
-                                    h) +=
-                            activfunc(
-                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h),
-                                2) *
-                            activfunc(
-                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 7 * hy_h + h),
-                                1);
-                        if(ti == 0)
-                        {
-                            if(!cx_is_null)
-                            {
-                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h +
-                                            hy_h + h) +=
-                                    activfunc(rsvspace.at(hid_shift + (baccbi + bs) * hy_stride +
-                                                          5 * hy_h + h),
-                                              2) *
-                                    cx.at(hx_shift + bs * uni_stride + hy_n * hy_h + h);
-                            }
-                        }
-                        else
-                        {
-
-                            if(!cx_is_null &&
-                               in_n.at(seqLength_cpu - 1 - ti) > in_n.at(seqLength_cpu - ti))
-                            {
-                                if(bs >= in_n.at(seqLength_cpu - ti))
-                                {
-                                    rsvspace.at(hid_shift + (baccbi + bs) * hy_stride +
-                                                bi * 4 * hy_h + hy_h + h) +=
-                                        activfunc(rsvspace.at(hid_shift +
-                                                              (baccbi + bs) * hy_stride + 5 * hy_h +
-                                                              h),
-                                                  2) *
-                                        cx.at(hx_shift + bs * uni_stride + hy_n * hy_h + h);
-                                }
-                            }
-
-                            if(bs < in_n.at(seqLength_cpu - ti))
-                            {
-                                int prec_shift =
-                                    li * batch_n_cpu * hy_stride +
-                                    (baccbi + in_n.at(seqLength_cpu - 1 - ti)) * hy_stride +
-                                    bi * 4 * hy_h + hy_h;
-
-                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h +
-                                            hy_h + h) +=
-                                    activfunc(rsvspace.at(hid_shift + (baccbi + bs) * hy_stride +
-                                                          5 * hy_h + h),
-                                              2) *
-                                    rsvspace.at(prec_shift + bs * hy_stride + h);
-                            }
-                        }
-
-                        rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 5 * hy_h + hy_h +
-                                    h) +=
-                            activfunc(
-                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 6 * hy_h + h),
-                                2) *
-                            activfunc(rsvspace.at(hid_shift + (baccbi + bs) * hy_stride +
-                                                  bi * 4 * hy_h + hy_h + h),
-                                      1);
+                        const int prev_row = baccbi + in_n.at(seqLength_cpu - 1 - ti) + bs;
 
-                        rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h +
-                                    numlayer * batch_n_cpu * hy_stride) =
-                            activfunc(
-                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h),
-                                2);
-                        rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h +
-                                    numlayer * batch_n_cpu * hy_stride) =
-                            activfunc(
-                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h),
-                                2);
-                        rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 6 * hy_h + h +
-                                    numlayer * batch_n_cpu * hy_stride) =
-                            activfunc(
-                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 6 * hy_h + h),
-                                2);
-                        rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 7 * hy_h + h +
-                                    numlayer * batch_n_cpu * hy_stride) =
-                            activfunc(
-                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 7 * hy_h + h),
-                                1);
-                        rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h + hy_h +
-                                    h + numlayer * batch_n_cpu * hy_stride) =
-                            activfunc(rsvspace.at(hid_shift + (baccbi + bs) * hy_stride +
-                                                  bi * 4 * hy_h + hy_h + h),
-                                      1);
-
-                        cy_host.at(hx_shift + bs * uni_stride + hy_n * hy_h + h) = rsvspace.at(
-                            hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h + hy_h + h);
-                        hy_host.at(hx_shift + bs * uni_stride + hy_n * hy_h + h) = rsvspace.at(
-                            hid_shift + (baccbi + bs) * hy_stride + bi * 5 * hy_h + hy_h + h);
+                        c_prev = &rsvspace[hid_shift + prev_row * hy_stride + bi * 4 * hy_h + hy_h];
                     }
-                }
+                    else if(!cx_is_null)
+                    {
+                        c_prev = &cx[hx_shift + bs * uni_stride + hy_n * hy_h];
+                    }
+
+                    LSTMFwdCellCPU(row,
+                                   row + numlayer * batch_n_cpu * hy_stride,
+                                   c_prev,
+                                   &cy_host[hx_shift + bs * uni_stride + hy_n * hy_h],
+                                   &hy_host[hx_shift + bs * uni_stride + hy_n * hy_h],
+                                   hy_h,
+                                   4 * hy_h,
+                                   bi * 4 * hy_h + hy_h,
+                                   bi * 5 * hy_h + hy_h);
+                });
             }
 
             bacc += in_n.at(ti);
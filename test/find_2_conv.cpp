@@ -118,7 +118,8 @@ private:
 
         AddConvTensorDescriptors(problem);
 
-        std::ignore          = TestFindSolutions(handle, problem);
+        std::ignore = TestFindSolutions(handle, problem);
+        TestFindSolutionsBatch(handle, problem);
         const auto solutions = TestFindSolutionsWithOptions(handle, problem);
 
         TestSolutionAttributes(solutions);
@@ -164,6 +165,58 @@ private:
         return solutions;
     }
 
+    void TestFindSolutionsBatch(miopenHandle_t handle, miopenProblem_t problem)
+    {
+        std::cerr << "Testing miopenFindSolutionsBatch..." << std::endl;
+
+        constexpr std::size_t max_solutions = 100;
+
+        // A problem in another direction makes two distinct convolutions, so their kernels are
+        // compiled together before the search.
+        const auto other_direction = direction == miopenProblemDirectionForward
+                                         ? miopenProblemDirectionBackward
+                                         : miopenProblemDirectionForward;
+        miopenProblem_t other;
+        EXPECT_EQUAL(miopenCreateConvProblem(&other, &filter, other_direction),
+                     miopenStatusSuccess);
+        AddConvTensorDescriptors(other);
+
+        const auto problems = std::vector<miopenProblem_t>{problem, other, problem};
+        auto solutions      = std::vector<miopenSolution_t>(problems.size() * max_solutions);
+        auto found          = std::vector<std::size_t>(problems.size());
+
+        EXPECT_EQUAL(miopenFindSolutionsBatch(handle,
+                                              problems.size(),
+                                              problems.data(),
+                                              nullptr,
+                                              solutions.data(),
+                                              found.data(),
+                                              max_solutions),
+                     miopenStatusSuccess);
+
+        // Duplicates share the results of the first occurrence.
+        EXPECT_EQUAL(found[0], found[2]);
+        EXPECT_OP(found[1], >, 0);
+
+        for(auto i = 0; i < found[0]; ++i)
+        {
+            uint64_t first_id, second_id;
+            EXPECT_EQUAL(miopenGetSolutionSolverId(solutions[i], &first_id), miopenStatusSuccess);
+            EXPECT_EQUAL(miopenGetSolutionSolverId(solutions[2 * max_solutions + i], &second_id),
+                         miopenStatusSuccess);
+            EXPECT_EQUAL(first_id, second_id);
+        }
+
+        for(auto i = 0; i < problems.size(); ++i)
+            for(auto j = 0; j < found[i]; ++j)
+                EXPECT_EQUAL(miopenDestroySolution(solutions[i * max_solutions + j]),
+                             miopenStatusSuccess);
+
+        EXPECT_EQUAL(miopenDestroyProblem(other), miopenStatusSuccess);
+
+        std::cerr << "Finished testing miopenFindSolutionsBatch." << std::endl;
+    }
+
     std::vector<miopenSolution_t> TestFindSolutionsWithOptions(miopenHandle_t handle,
                                                                miopenProblem_t problem)
     {
@@ -296,6 +349,33 @@ private:
                 miopenStatusSuccess);
 
             TestRunSolution(handle, read_solution, 3, names, descriptors, buffers);
+
+            // Save-load cycle with embedded code objects
+            EXPECT_EQUAL(miopenEmbedSolutionCodeObjects(handle, read_solution),
+                         miopenStatusSuccess);
+            EXPECT_EQUAL(miopenGetSolutionSize(read_solution, &solution_size),
+                         miopenStatusSuccess);
+
+            solution_binary.resize(solution_size);
+
+            EXPECT_EQUAL(miopenSaveSolution(read_solution, solution_binary.data()),
+                         miopenStatusSuccess);
+            EXPECT_EQUAL(miopenDestroySolution(read_solution), miopenStatusSuccess);
+
+            EXPECT_EQUAL(
+                miopenLoadSolution(&read_solution, solution_binary.data(), solution_binary.size()),
+                miopenStatusSuccess);
+
+            TestRunSolution(handle, read_solution, 3, names, descriptors, buffers);
+
+            // A new handle has no programs cached. Running the solution with embedded code
+            // objects on it must neither compile kernels nor look them up in the kernel cache.
+            miopenHandle_t new_handle;
+            EXPECT_EQUAL(miopenCreate(&new_handle), miopenStatusSuccess);
+            TestRunSolution(new_handle, read_solution, 3, names, descriptors, buffers);
+            EXPECT_EQUAL(miopen::deref(new_handle).GetProgramLoadCount(), 0);
+            EXPECT_EQUAL(miopenDestroy(new_handle), miopenStatusSuccess);
+
             EXPECT_EQUAL(miopenDestroySolution(read_solution), miopenStatusSuccess);
         }
 
@@ -0,0 +1,137 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/async_find.hpp>
+
+#include <miopen/convolution.hpp>
+#include <miopen/find_db.hpp>
+#include <miopen/temp_file.hpp>
+#include <miopen/conv/problem_description.hpp>
+
+#include <gtest/gtest.h>
+
+#include "get_handle.hpp"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+
+using miopen::conv::AsyncFindQueue;
+
+TEST(AsyncFindQueue, RunsEachKeyOnce)
+{
+    auto runs  = std::atomic<int>{0};
+    auto queue = AsyncFindQueue{};
+
+    EXPECT_TRUE(queue.Submit("a", [&]() { ++runs; }));
+    EXPECT_TRUE(queue.Submit("b", [&]() { ++runs; }));
+    EXPECT_FALSE(queue.Submit("a", [&]() { ++runs; }));
+
+    queue.Wait();
+    EXPECT_EQ(runs, 2);
+    EXPECT_EQ(queue.GetPendingCount(), 0u);
+
+    // Finished keys are not queued again either.
+    EXPECT_FALSE(queue.Submit("b", [&]() { ++runs; }));
+    queue.Wait();
+    EXPECT_EQ(runs, 2);
+}
+
+TEST(AsyncFindQueue, DoesNotBlockSubmitter)
+{
+    auto release  = std::promise<void>{};
+    auto released = release.get_future().share();
+    auto queue    = AsyncFindQueue{};
+
+    EXPECT_TRUE(queue.Submit("slow", [released]() { released.wait(); }));
+    EXPECT_TRUE(queue.Submit("next", []() {}));
+    EXPECT_EQ(queue.GetPendingCount(), 2u);
+
+    release.set_value();
+    queue.Wait();
+    EXPECT_EQ(queue.GetPendingCount(), 0u);
+}
+
+TEST(AsyncFindQueue, SurvivesFailedJobs)
+{
+    auto runs  = std::atomic<int>{0};
+    auto queue = AsyncFindQueue{};
+
+    EXPECT_TRUE(queue.Submit("bad", []() { throw std::runtime_error("search failed"); }));
+    EXPECT_TRUE(queue.Submit("good", [&]() { ++runs; }));
+
+    queue.Wait();
+    EXPECT_EQ(runs, 1);
+    EXPECT_FALSE(queue.Submit("bad", [&]() { ++runs; }));
+}
+
+TEST(AsyncFind, AsyncHybridFillsFindDb)
+{
+    auto&& handle = get_handle();
+
+    const miopen::TempFile find_db{"miopen.test.async_find"};
+    miopen::debug::testing_find_db_path_override() = find_db.Path();
+
+    auto conv = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+    conv.findMode.Set(miopen::FindMode::Values::AsyncHybrid);
+
+    const auto x = miopen::TensorDescriptor{miopenFloat, {2, 8, 13, 11}};
+    const auto w = miopen::TensorDescriptor{miopenFloat, {16, 8, 3, 3}};
+    const auto y = conv.GetForwardOutputTensor(x, w);
+
+    const auto problem =
+        miopen::conv::ProblemDescription{x, w, y, conv, miopen::conv::Direction::Forward};
+
+    ASSERT_TRUE(miopen::FindDbRecord(handle, problem).empty());
+
+    const auto x_dev = handle.Create(x.GetElementSpace() * sizeof(float));
+    const auto w_dev = handle.Create(w.GetElementSpace() * sizeof(float));
+    const auto y_dev = handle.Create(y.GetElementSpace() * sizeof(float));
+
+    auto perf  = miopenConvAlgoPerf_t{};
+    auto found = 0;
+
+    // A miss returns the immediate mode fallback and leaves the search to the background worker.
+    conv.FindConvFwdAlgorithm(handle,
+                              x,
+                              x_dev.get(),
+                              w,
+                              w_dev.get(),
+                              y,
+                              y_dev.get(),
+                              1,
+                              &found,
+                              &perf,
+                              nullptr,
+                              0,
+                              false);
+    EXPECT_EQ(found, 1);
+
+    miopen::conv::WaitForAsyncFinds();
+    EXPECT_FALSE(miopen::FindDbRecord(handle, problem).empty());
+
+    miopen::debug::testing_find_db_path_override() = boost::none;
+}
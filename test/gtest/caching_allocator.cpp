@@ -0,0 +1,207 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/caching_allocator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+/// Host memory standing in for the device one. Allocations fail once more than capacity bytes
+/// would be held at a time.
+struct HostMemory
+{
+    std::size_t capacity = static_cast<std::size_t>(-1);
+    std::size_t held     = 0;
+    std::size_t mallocs  = 0;
+    std::size_t frees    = 0;
+};
+
+void* HostAllocate(void* context, std::size_t size)
+{
+    auto& memory = *static_cast<HostMemory*>(context);
+    if(memory.held + size > memory.capacity)
+        return nullptr;
+    auto mem = std::malloc(size + sizeof(std::size_t));
+    *static_cast<std::size_t*>(mem) = size;
+    memory.held += size;
+    ++memory.mallocs;
+    return static_cast<std::size_t*>(mem) + 1;
+}
+
+void HostDeallocate(void* context, void* mem)
+{
+    auto& memory = *static_cast<HostMemory*>(context);
+    auto header  = static_cast<std::size_t*>(mem) - 1;
+    memory.held -= *header;
+    ++memory.frees;
+    std::free(header);
+}
+
+} // namespace
+
+using miopen::CachingAllocator;
+
+TEST(CachingAllocator, SizeClasses)
+{
+    EXPECT_EQ(CachingAllocator::GetSizeClass(1u), 256u);
+    EXPECT_EQ(CachingAllocator::GetSizeClass(256u), 256u);
+    EXPECT_EQ(CachingAllocator::GetSizeClass(257u), 512u);
+    EXPECT_EQ(CachingAllocator::GetSizeClass(1000u), 1024u);
+    EXPECT_EQ(CachingAllocator::GetSizeClass(1025u), 1280u);
+    EXPECT_EQ(CachingAllocator::GetSizeClass(3u << 20), 3u << 20);
+    EXPECT_EQ(CachingAllocator::GetSizeClass((3u << 20) + 1u), (7u << 19));
+
+    for(std::size_t size = 1; size < (1 << 24); size = size * 3 / 2 + 1)
+    {
+        const auto size_class = CachingAllocator::GetSizeClass(size);
+        EXPECT_GE(size_class, size);
+        EXPECT_LE(size_class, std::max<std::size_t>(256, size + size / 4 + 255));
+    }
+}
+
+TEST(CachingAllocator, Reuse)
+{
+    auto memory    = HostMemory{};
+    auto caching   = CachingAllocator::Create(&HostAllocate, &HostDeallocate, &memory);
+    auto allocator = caching->AsAllocator();
+
+    for(auto i = 0; i < 10; ++i)
+    {
+        auto a = allocator(1000);
+        auto b = allocator(900);
+        EXPECT_NE(a.get(), b.get());
+    }
+
+    auto stats = caching->GetStatistics();
+    EXPECT_EQ(memory.mallocs, 2u);
+    EXPECT_EQ(stats.allocations, 20);
+    EXPECT_EQ(stats.cache_hits, 18u);
+    EXPECT_EQ(stats.bytes_in_use, 0u);
+    EXPECT_EQ(stats.bytes_cached, 2048u);
+    EXPECT_EQ(stats.peak_bytes_in_use, 2048u);
+
+    caching->Trim();
+    stats = caching->GetStatistics();
+    EXPECT_EQ(memory.frees, 2u);
+    EXPECT_EQ(memory.held, 0u);
+    EXPECT_EQ(stats.bytes_cached, 0u);
+    EXPECT_EQ(stats.trims, 1u);
+}
+
+TEST(CachingAllocator, StreamOrderedReuse)
+{
+    auto memory    = HostMemory{};
+    auto caching   = CachingAllocator::Create(&HostAllocate, &HostDeallocate, &memory);
+    auto allocator = caching->AsAllocator();
+    int streams[2];
+
+    caching->SetStream(&streams[0]);
+    allocator(4096).reset();
+    caching->SetStream(&streams[1]);
+    auto on_second = allocator(4096);
+    EXPECT_EQ(memory.mallocs, 2u);
+
+    caching->SetStream(&streams[0]);
+    auto on_first = allocator(4096);
+    EXPECT_EQ(memory.mallocs, 2u);
+    EXPECT_EQ(caching->GetStatistics().cache_hits, 1u);
+}
+
+TEST(CachingAllocator, TrimOnPressure)
+{
+    auto memory     = HostMemory{};
+    memory.capacity = 8192;
+    auto caching    = CachingAllocator::Create(&HostAllocate, &HostDeallocate, &memory);
+    auto allocator  = caching->AsAllocator();
+
+    allocator(4096).reset();
+    allocator(2048).reset();
+    EXPECT_EQ(memory.held, 6144u);
+
+    // Does not fit next to the cached blocks, which have to be released first.
+    auto big = allocator(8192);
+    EXPECT_NE(big.get(), nullptr);
+    EXPECT_EQ(memory.held, 8192u);
+    EXPECT_EQ(caching->GetStatistics().trims, 1u);
+
+    EXPECT_ANY_THROW(allocator(256));
+}
+
+TEST(CachingAllocator, CacheLimit)
+{
+    auto memory    = HostMemory{};
+    auto caching   = CachingAllocator::Create(&HostAllocate, &HostDeallocate, &memory, 4096);
+    auto allocator = caching->AsAllocator();
+
+    {
+        auto a = allocator(4096);
+        auto b = allocator(4096);
+    }
+
+    EXPECT_EQ(caching->GetStatistics().bytes_cached, 4096u);
+    EXPECT_EQ(memory.frees, 1u);
+}
+
+TEST(CachingAllocator, OutlivedByBlocks)
+{
+    auto memory = HostMemory{};
+    auto block  = miopen::Allocator::ManageDataPtr{};
+
+    {
+        auto caching   = CachingAllocator::Create(&HostAllocate, &HostDeallocate, &memory);
+        auto allocator = caching->AsAllocator();
+        allocator(512).reset();
+        block = allocator(1024);
+    }
+
+    EXPECT_EQ(memory.frees, 1u);
+    block.reset();
+    EXPECT_EQ(memory.frees, 2u);
+    EXPECT_EQ(memory.held, 0u);
+}
+
+TEST(WorkspaceArena, HighWaterMark)
+{
+    auto memory    = HostMemory{};
+    auto allocator = miopen::Allocator{&HostAllocate, &HostDeallocate, &memory};
+    auto arena     = miopen::WorkspaceArena{};
+
+    const auto first = arena.Get(allocator, 1024);
+    EXPECT_EQ(arena.Get(allocator, 512), first);
+    EXPECT_EQ(arena.Get(allocator, 1024), first);
+    arena.Get(allocator, 4096);
+    arena.Get(allocator, 2048);
+
+    EXPECT_EQ(arena.GetCapacity(), 4096u);
+    EXPECT_EQ(memory.mallocs, 2u);
+
+    arena.Release();
+    EXPECT_EQ(memory.held, 0u);
+}
@@ -28,6 +28,7 @@
 #include <miopen/solver_id.hpp>
 #include <serialize.hpp>
 #include <fusionHost.hpp>
+#include <miopen/find_controls.hpp>
 #include <miopen/fusion.hpp>
 #include <miopen/fusion/solvers.hpp>
 #include <miopen/fusion/fusion_invoke_params.hpp>
@@ -37,8 +38,26 @@
 #include "cba.hpp"
 #include "../env_utils.hpp"
 
+#include <cstdlib>
+#include <limits>
+#include <new>
+
 namespace cba_infer {
 
+// Heap allocations made by the calling thread while a CountAllocations call is running.
+thread_local bool count_allocations        = false;
+thread_local std::size_t allocation_count = 0;
+
+template <class F>
+std::size_t CountAllocations(const F& f)
+{
+    allocation_count  = 0;
+    count_allocations = true;
+    f();
+    count_allocations = false;
+    return allocation_count;
+}
+
 struct ConvBiasActivInferTestFloat : ConvBiasActivInferTest<float>
 {
 };
@@ -101,6 +120,21 @@ void RunTunableSolver(miopen::FusionPlanDescriptor& fusePlanDesc,
 } // namespace cba_infer
 using namespace cba_infer;
 
+void* operator new(std::size_t size)
+{
+    if(cba_infer::count_allocations)
+        ++cba_infer::allocation_count;
+    if(auto* ptr = std::malloc(size == 0 ? 1 : size)) // NOLINT (cppcoreguidelines-no-malloc)
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); } // NOLINT (cppcoreguidelines-no-malloc)
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr); // NOLINT (cppcoreguidelines-no-malloc)
+}
+
 TEST_P(ConvBiasActivInferTestFloat, ConvBiasActivAsm1x1UFloat)
 {
     const auto plan_params = std::make_unique<miopen::fusion::FusionInvokeParams>(
@@ -130,6 +164,146 @@ TEST_P(ConvBiasActivInferTestFloat, ConvBinWinogradRxSf2x3g1Fused)
         fusePlanDesc, plan_params, conv_config, test_skipped);
 }
 
+TEST_P(ConvBiasActivInferTestFloat, BoundFusionPlan)
+{
+    auto& handle = get_handle();
+    if(fusePlanDesc.Compile(handle) != miopenStatusSuccess)
+    {
+        test_skipped = true;
+        GTEST_SKIP() << "Fusion plan is not supported" << conv_config;
+    }
+
+    auto& conv_op  = dynamic_cast<miopen::ConvForwardOpDescriptor&>(*fusePlanDesc.op_map[0]);
+    auto& bias_op  = dynamic_cast<miopen::BiasFusionOpDescriptor&>(*fusePlanDesc.op_map[1]);
+    auto& activ_op = dynamic_cast<miopen::ActivFwdFusionOpDescriptor&>(*fusePlanDesc.op_map[2]);
+
+    miopen::BoundFusionPlan bound{fusePlanDesc};
+    const auto set_args = [&]() {
+        conv_op.SetArgs(bound.GetArgs(), &alpha, &beta, wei_dev.get());
+        bias_op.SetArgs(bound.GetArgs(), &alpha, &beta, bias_dev.get());
+        activ_op.SetArgs(bound.GetArgs(), &alpha, &beta, activ_alpha, activ_beta, activ_gamma);
+    };
+    const auto execute = [&]() { bound.Execute(handle, in_dev.get(), out_dev.get()); };
+
+    set_args();
+    execute();
+    const auto first_output = handle.Read<float>(out_dev, output.data.size());
+
+    // Whatever the invoker allocates on its own, e.g. for the kernel launch.
+    const auto invoker_params = miopen::AnyInvokeParams{miopen::fusion::FusionInvokeParams{
+        bound.GetArgs(), input.desc, in_dev.get(), output.desc, out_dev.get(), false}};
+    const auto invoker_allocations =
+        CountAllocations([&]() { fusePlanDesc.invokers[0](handle, invoker_params); });
+
+    // The second execution updates the arguments in place and overwrites the output, which
+    // TearDown checks against the reference.
+    std::fill(output.data.begin(), output.data.end(), std::numeric_limits<float>::quiet_NaN());
+    handle.WriteTo(output.data.data(), out_dev, output.data.size() * sizeof(float));
+
+    EXPECT_EQ(CountAllocations(set_args), 0u);
+    EXPECT_LE(CountAllocations(execute), invoker_allocations);
+    EXPECT_EQ(handle.Read<float>(out_dev, output.data.size()), first_output);
+}
+
+TEST_P(ConvBiasActivInferTestFloat, ExecuteReusesBoundPlan)
+{
+    auto& handle = get_handle();
+    if(fusePlanDesc.Compile(handle) != miopenStatusSuccess)
+    {
+        test_skipped = true;
+        GTEST_SKIP() << "Fusion plan is not supported" << conv_config;
+    }
+
+    const auto execute = [&](const miopen::OperatorArgs& args) {
+        const auto status = fusePlanDesc.Execute(
+            handle, input.desc, in_dev.get(), output.desc, out_dev.get(), args);
+        ASSERT_EQ(status, miopenStatusSuccess);
+    };
+
+    execute(params);
+    const auto bound = fusePlanDesc.bound;
+    ASSERT_TRUE(bound);
+
+    const auto invoker_params = miopen::AnyInvokeParams{miopen::fusion::FusionInvokeParams{
+        params, input.desc, in_dev.get(), output.desc, out_dev.get(), false}};
+    const auto invoker_allocations =
+        CountAllocations([&]() { fusePlanDesc.invokers[0](handle, invoker_params); });
+
+    EXPECT_LE(CountAllocations([&]() { execute(params); }), invoker_allocations);
+    EXPECT_EQ(fusePlanDesc.bound.get(), bound.get());
+
+    // Other arguments get a plan of their own, and recompiling drops it.
+    const auto other_params = params;
+    execute(other_params);
+    EXPECT_NE(fusePlanDesc.bound.get(), bound.get());
+    ASSERT_EQ(fusePlanDesc.Compile(handle), miopenStatusSuccess);
+    EXPECT_FALSE(fusePlanDesc.bound);
+
+    execute(params);
+    handle.Finish();
+}
+
+TEST_P(ConvBiasActivInferTestFloat, CompiledPlanCache)
+{
+    auto& handle = get_handle();
+    if(fusePlanDesc.Compile(handle) != miopenStatusSuccess)
+    {
+        test_skipped = true;
+        GTEST_SKIP() << "Fusion plan is not supported" << conv_config;
+    }
+    if(miopen::FindEnforce{}.IsSomethingEnforced(miopen::ExecutionContext{&handle}))
+    {
+        test_skipped = true;
+        GTEST_SKIP() << "The plan cache is bypassed when find is enforced";
+    }
+
+    const auto& ops      = fusePlanDesc.op_map;
+    const auto& conv_op  = dynamic_cast<const miopen::ConvForwardOpDescriptor&>(*ops[0]);
+    const auto& bias_op  = dynamic_cast<const miopen::BiasFusionOpDescriptor&>(*ops[1]);
+    const auto& activ_op = dynamic_cast<const miopen::ActivFwdFusionOpDescriptor&>(*ops[2]);
+
+    auto plan = miopen::FusionPlanDescriptor(miopenVerticalFusion, input.desc);
+    plan.AddOp(std::make_shared<miopen::ConvForwardOpDescriptor>(conv_op.base_desc,
+                                                                 conv_op.filter_desc));
+    plan.AddOp(std::make_shared<miopen::BiasFusionOpDescriptor>(bias_op.base_desc));
+    plan.AddOp(std::make_shared<miopen::ActivFwdFusionOpDescriptor>(activ_op.activMode));
+
+    const auto plan_config = fusePlanDesc.GetPlanConfig();
+    ASSERT_EQ(plan.GetPlanConfig().ToString(), plan_config.ToString());
+
+    // Replace the cached invokers with a marker to see that an identical plan takes them from the
+    // cache instead of compiling its own.
+    auto marker_calls = 0;
+    const auto marker = miopen::Invoker{
+        [&](const miopen::Handle&, const miopen::AnyInvokeParams&) { ++marker_calls; }};
+    handle.RegisterFusionPlanInvokers(plan_config, {marker});
+    const auto compiled = plan.Compile(handle);
+    // The cache is shared by the handles on the same device, so compiling through another handle
+    // on the same stream also takes the marker.
+    auto other_handle = miopen::Handle{handle.GetStream()};
+    auto other_plan   = miopen::FusionPlanDescriptor(miopenVerticalFusion, input.desc);
+    for(const auto& op : plan.op_map)
+        other_plan.AddOp(op);
+    const auto other_compiled = other_plan.Compile(other_handle);
+    handle.RegisterFusionPlanInvokers(plan_config, fusePlanDesc.invokers);
+
+    ASSERT_EQ(other_handle.GetDeviceKey(), handle.GetDeviceKey());
+    ASSERT_EQ(compiled, miopenStatusSuccess);
+    ASSERT_EQ(other_compiled, miopenStatusSuccess);
+    ASSERT_EQ(plan.invokers.size(), 1u);
+    ASSERT_EQ(other_plan.invokers.size(), 1u);
+    plan.invokers.front()(handle, {});
+    other_plan.invokers.front()(other_handle, {});
+    ASSERT_EQ(marker_calls, 2);
+
+    // With the real invokers restored, the plan from the cache shall produce the same result.
+    ASSERT_EQ(plan.Compile(handle), miopenStatusSuccess);
+    ASSERT_EQ(plan.invokers.size(), fusePlanDesc.invokers.size());
+
+    plan.Execute(handle, input.desc, in_dev.get(), output.desc, out_dev.get(), params);
+    handle.Finish();
+}
+
 TEST_P(ConvBiasActivInferTestHalf, ConvCKIgemmFwdBiasActivFused)
 {
     const auto plan_params = std::make_unique<miopen::fusion::FusionInvokeParams>(
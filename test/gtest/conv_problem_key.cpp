@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/invoker_cache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+namespace {
+
+miopen::conv::ProblemDescription MakeProblem(miopenTensorLayout_t layout, int group_count)
+{
+    const auto x = miopen::TensorDescriptor{miopenFloat, layout, {2, 16, 14, 14}};
+    const auto w = miopen::TensorDescriptor{miopenFloat, layout, {32, 16 / group_count, 3, 3}};
+    const auto y = miopen::TensorDescriptor{miopenFloat, layout, {2, 32, 14, 14}};
+    const auto conv = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}, {0, 0}, group_count};
+    return {x, w, y, conv, miopen::conv::Direction::Forward};
+}
+
+std::string SerializeProblem(const miopen::conv::ProblemDescription& problem)
+{
+    std::ostringstream ss;
+    problem.Serialize(ss);
+    return ss.str();
+}
+
+} // namespace
+
+TEST(ConvProblemKey, TextFormats)
+{
+    const auto nchw = MakeProblem(miopenTensorNCHW, 1);
+    EXPECT_EQ(nchw.MakeNetworkConfig().ToString(),
+              "16x14x14x3x3x32x14x14x2xNCHWxFP32x1x1x1x1x1x1x1xF");
+    EXPECT_EQ(SerializeProblem(nchw), "16-14-14-3x3-32-14-14-2-1x1-1x1-1x1-0-NCHW-FP32-F");
+
+    const auto nhwc = MakeProblem(miopenTensorNHWC, 1);
+    EXPECT_EQ(nhwc.MakeNetworkConfig().ToString(),
+              "16x14x14x3x3x32x14x14x2xNHWCxNHWCxNHWCxFP32x1x1x1x1x1x1x1xF");
+    EXPECT_EQ(SerializeProblem(nhwc),
+              "16-14-14-3x3-32-14-14-2-1x1-1x1-1x1-0-NHWC-NHWC-NHWC-FP32-F");
+
+    const auto grouped = MakeProblem(miopenTensorNCHW, 2);
+    EXPECT_EQ(grouped.MakeNetworkConfig().ToString(),
+              "16x14x14x3x3x32x14x14x2xNCHWxFP32x1x1x1x1x1x1x2xF");
+    EXPECT_EQ(SerializeProblem(grouped), "16-14-14-3x3-32-14-14-2-1x1-1x1-1x1-0-NCHW-FP32-F_g2");
+}
+
+TEST(ConvProblemKey, Identity)
+{
+    const auto key = MakeProblem(miopenTensorNCHW, 1).MakeKey();
+
+    EXPECT_EQ(key, MakeProblem(miopenTensorNCHW, 1).MakeKey());
+    EXPECT_EQ(key.Hash(), MakeProblem(miopenTensorNCHW, 1).MakeKey().Hash());
+
+    for(const auto& other : {MakeProblem(miopenTensorNHWC, 1), MakeProblem(miopenTensorNCHW, 2)})
+    {
+        EXPECT_NE(key, other.MakeKey());
+        EXPECT_NE(key.Hash(), other.MakeKey().Hash());
+    }
+}
+
+TEST(ConvProblemKey, LongLayouts)
+{
+    using miopen::conv::ProblemKey;
+
+    // Layouts too long to be stored are told apart by their hash
+    const auto layout = ProblemKey::MakeLayout("NCDHWc16");
+    EXPECT_EQ(layout[0], '\0');
+    EXPECT_EQ(layout, ProblemKey::MakeLayout("NCDHWc16"));
+    EXPECT_NE(layout, ProblemKey::MakeLayout("NDHWCc16"));
+    EXPECT_NE(layout, ProblemKey::MakeLayout(""));
+
+    // and formatted from their text
+    auto key           = MakeProblem(miopenTensorNCHW, 1).MakeKey();
+    key.in_layout      = layout;
+    key.weights_layout = layout;
+    key.out_layout     = layout;
+    auto conf_key      = std::string{};
+    key.MakeNetworkConfig(conf_key, {"NCDHWc16", "NCDHWc16", "NCDHWc16"});
+    EXPECT_EQ(conf_key,
+              "16x14x14x3x3x32x14x14x2xNCDHWc16xNCDHWc16xNCDHWc16xFP32x1x1x1x1x1x1x1xF");
+}
+
+TEST(ConvProblemKey, InvokerCacheLookup)
+{
+    const auto problem = MakeProblem(miopenTensorNCHW, 1);
+    const auto other   = MakeProblem(miopenTensorNCHW, 2);
+
+    const auto invoker =
+        miopen::Invoker{[](const miopen::Handle&, const miopen::AnyInvokeParams&) {}};
+
+    auto cache = miopen::InvokerCache{};
+    EXPECT_FALSE(cache.Get(problem, "solver"));
+
+    // Invokers registered by the text config after a miss are found by the key.
+    cache.Register({problem.MakeNetworkConfig(), "solver"}, invoker);
+    cache.SetAsFound1_0(problem.MakeNetworkConfig(), "algo", "solver");
+
+    for(auto i = 0; i < 2; ++i)
+    {
+        const auto by_solver = cache.Get(problem, "solver");
+        ASSERT_TRUE(by_solver);
+        const auto by_algo = cache.GetFound1_0(problem, "algo");
+        ASSERT_TRUE(by_algo);
+        EXPECT_EQ(&by_solver.get(), &by_algo.get());
+    }
+
+    EXPECT_FALSE(cache.Get(problem, "other_solver"));
+    EXPECT_FALSE(cache.GetFound1_0(problem, "other_algo"));
+    EXPECT_FALSE(cache.Get(other, "solver"));
+
+    // Moving the cache keeps the items the key index points to.
+    const auto& registered = cache.Get(problem, "solver").get();
+    const auto moved       = std::move(cache);
+    const auto found       = moved.Get(problem, "solver");
+    ASSERT_TRUE(found);
+    EXPECT_EQ(&found.get(), &registered);
+}
@@ -0,0 +1,187 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+
+#if MIOPEN_BACKEND_HIP
+
+#include <miopen/execution_plan.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/nogpu/host_kernels.hpp>
+#include <miopen/tensor.hpp>
+#include <miopen/tensor_ops.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+struct Call
+{
+    const float* x;
+    int n;
+    float* y;
+    const void* w;
+};
+
+/// Kernel invoke executed on the host the same way as with the HIPNOGPU handle, calls are
+/// appended to the trace.
+miopen::KernelInvoke MakeInvoke(std::vector<Call>& trace)
+{
+    auto kernel     = miopen::Kernel{};
+    kernel.name     = "k";
+    auto invoke     = miopen::KernelInvoke{nullptr, nullptr, {64, 1, 1}, {256, 1, 1}, "k", "k", {}};
+    invoke.kernel   = std::make_shared<const miopen::Kernel>(kernel);
+    invoke.host_fun = [&trace](const void* args, std::size_t size) {
+        auto reader = miopen::host::KernelArgsReader{args, size};
+        auto call   = Call{};
+        call.x      = reader.Next<const float*>();
+        call.n      = reader.Next<int>();
+        call.y      = reader.Next<float*>();
+        call.w      = reader.Next<const void*>();
+        trace.push_back(call);
+    };
+    return invoke;
+}
+
+} // namespace
+
+TEST(ExecutionPlan, CapturePatchSites)
+{
+    auto x      = std::array<float, 16>{};
+    auto y      = std::array<float, 16>{};
+    auto w      = std::array<float, 4>{};
+    auto trace  = std::vector<Call>{};
+    auto invoke = MakeInvoke(trace);
+
+    const float* x_offset = x.data() + 4;
+    const float* y_input  = y.data();
+    const void* weights   = w.data();
+    const void* none      = nullptr;
+
+    auto recorder   = miopen::ExecutionPlanRecorder{{{x.data(), sizeof(x)}, {y.data(), sizeof(y)}}};
+    invoke.recorder = &recorder;
+    invoke(x_offset, 7, y.data(), weights);
+    invoke(y_input, 3, y.data(), none);
+
+    const auto plan = recorder.Finish();
+    ASSERT_EQ(trace.size(), 2u);
+    ASSERT_EQ(plan.GetLaunches().size(), 2u);
+    EXPECT_EQ(plan.GetBindingCount(), 2u);
+
+    const auto& first = plan.GetLaunches()[0];
+    EXPECT_EQ(first.kernel, invoke.kernel);
+    ASSERT_EQ(first.patches.size(), 2u);
+    EXPECT_EQ(first.patches[0].offset, 0u);
+    EXPECT_EQ(first.patches[0].binding, 0u);
+    EXPECT_EQ(first.patches[0].delta, 4 * static_cast<std::ptrdiff_t>(sizeof(float)));
+    EXPECT_EQ(first.patches[1].offset, 16u);
+    EXPECT_EQ(first.patches[1].binding, 1u);
+    EXPECT_EQ(first.patches[1].delta, 0);
+
+    const auto& second = plan.GetLaunches()[1];
+    ASSERT_EQ(second.patches.size(), 2u);
+    EXPECT_EQ(second.patches[0].binding, 1u);
+    EXPECT_EQ(second.patches[1].binding, 1u);
+}
+
+TEST(ExecutionPlan, IntegerArgumentsAreNotPatched)
+{
+    auto x      = std::array<float, 16>{};
+    auto trace  = std::vector<Call>{};
+    auto invoke = MakeInvoke(trace);
+
+    const float* x_input = x.data();
+    const auto address   = reinterpret_cast<std::uint64_t>(x.data());
+
+    auto recorder   = miopen::ExecutionPlanRecorder{{{x.data(), sizeof(x)}}};
+    invoke.recorder = &recorder;
+    invoke.host_fun = [](const void*, std::size_t) {};
+    invoke(x_input, address);
+
+    const auto plan = recorder.Finish();
+    ASSERT_EQ(plan.GetLaunches().size(), 1u);
+    ASSERT_EQ(plan.GetLaunches()[0].patches.size(), 1u);
+    EXPECT_EQ(plan.GetLaunches()[0].patches[0].offset, 0u);
+}
+
+TEST(ExecutionPlan, UnsupportedOperation)
+{
+    auto recorder = miopen::ExecutionPlanRecorder{{}};
+    recorder.MarkUnsupported("Buffer read");
+    EXPECT_ANY_THROW(recorder.Finish());
+}
+
+TEST(ExecutionPlan, LaunchWithoutKernelIsUnsupported)
+{
+    auto trace    = std::vector<Call>{};
+    auto invoke   = MakeInvoke(trace);
+    auto recorder = miopen::ExecutionPlanRecorder{{}};
+    invoke.kernel = nullptr;
+    recorder.Record(invoke, nullptr, 0, nullptr, 0);
+    EXPECT_ANY_THROW(recorder.Finish());
+}
+
+#if MIOPEN_MODE_NOGPU
+
+// The plan is captured on a handle which is destroyed before the plan is replayed on another one.
+// The replay writes the rebound buffer and reports the kernel time to the replaying handle.
+TEST(ExecutionPlan, ReplayOnAnotherHandle)
+{
+    const auto desc = miopen::TensorDescriptor{miopenFloat, std::vector<std::size_t>{1 << 20}};
+    auto x          = std::vector<float>(desc.GetElementSize());
+
+    const auto plan = [&]() {
+        auto capturing = miopen::Handle{};
+        capturing.SetHostExecution(true);
+        capturing.EnableProfiling(true);
+        capturing.BeginCapture({{x.data(), x.size() * sizeof(float)}});
+        const auto value = 1.f;
+        miopen::SetTensor(capturing, desc, x.data(), &value);
+        return capturing.EndCapture();
+    }();
+    ASSERT_EQ(plan.GetLaunches().size(), 1u);
+    EXPECT_TRUE(std::all_of(x.begin(), x.end(), [](auto v) { return v == 1.f; }));
+
+    auto replaying = miopen::Handle{};
+    replaying.SetHostExecution(true);
+    replaying.EnableProfiling(true);
+    auto y       = std::vector<float>(x.size());
+    auto buffers = std::array<void*, 1>{y.data()};
+    plan.Run(replaying, buffers.data(), buffers.size());
+
+    EXPECT_TRUE(std::all_of(y.begin(), y.end(), [](auto v) { return v == 1.f; }));
+    EXPECT_GT(replaying.GetKernelTime(), 0.f);
+    EXPECT_ANY_THROW(plan.Run(replaying, buffers.data(), 0));
+}
+
+#endif
+
+#endif
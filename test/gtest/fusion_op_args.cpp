@@ -0,0 +1,55 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/fusion.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(FusionOpArgs, EmplaceArgReusesParamOfSameType)
+{
+    miopen::OperatorArgs args;
+    const int buffers[2] = {};
+    const auto weights   = DataCast(&buffers[0]);
+    const auto weights_2 = DataCast(&buffers[1]);
+
+    args.EmplaceArg<miopen::fusion::ConvolutionOpInvokeParam>(1, 1.0f, 0.0f, weights);
+    ASSERT_EQ(args.params.size(), 2);
+    ASSERT_EQ(args.params[0], nullptr);
+    const auto* conv = args.params[1].get();
+
+    args.EmplaceArg<miopen::fusion::ConvolutionOpInvokeParam>(1, 2.0f, 1.0f, weights_2);
+    ASSERT_EQ(args.params[1].get(), conv);
+    const auto& updated = dynamic_cast<const miopen::fusion::ConvolutionOpInvokeParam&>(*conv);
+    ASSERT_EQ(updated.alpha, 2.0f);
+    ASSERT_EQ(updated.beta, 1.0f);
+    ASSERT_EQ(updated.weights, weights_2);
+
+    args.EmplaceArg<miopen::fusion::ActivationOpInvokeParam>(1, 0.5, 0.25, 0.125);
+    const auto& activ =
+        dynamic_cast<const miopen::fusion::ActivationOpInvokeParam&>(*args.params[1]);
+    ASSERT_EQ(activ.activAlpha, 0.5);
+    ASSERT_EQ(activ.activBeta, 0.25);
+    ASSERT_EQ(activ.activGamma, 0.125);
+}
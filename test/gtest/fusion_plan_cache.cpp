@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include <miopen/invoker_cache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::vector<miopen::Invoker> MakeInvokers(std::size_t count)
+{
+    const auto invoker =
+        miopen::Invoker{[](const miopen::Handle&, const miopen::AnyInvokeParams&) {}};
+    return std::vector<miopen::Invoker>(count, invoker);
+}
+
+} // namespace
+
+TEST(FusionPlanCache, KeptApartByDevice)
+{
+    auto& cache       = miopen::FusionPlanCache::Instance();
+    const auto config = miopen::NetworkConfig{"fusion_plan_cache_test"};
+
+    cache.Register("test:first", config, MakeInvokers(1));
+    EXPECT_FALSE(cache.Get("test:second", config));
+    cache.Register("test:second", config, MakeInvokers(2));
+
+    // Handles with the same device key share the plan, others get their own.
+    const auto first = cache.Get("test:first", config);
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first->size(), 1u);
+    const auto second = cache.Get("test:second", config);
+    ASSERT_TRUE(second);
+    EXPECT_EQ(second->size(), 2u);
+}
+
+TEST(FusionPlanCache, ConcurrentUse)
+{
+    auto& cache                  = miopen::FusionPlanCache::Instance();
+    const auto device_key        = std::string{"test:concurrent"};
+    constexpr auto threads_count = 8;
+    constexpr auto plans_count   = 64;
+
+    auto threads = std::vector<std::thread>{};
+    for(auto t = 0; t < threads_count; ++t)
+    {
+        threads.emplace_back([&]() {
+            // Every thread compiles the plans it has not found, as Compile() does.
+            for(auto p = 0; p < plans_count; ++p)
+            {
+                const auto config = miopen::NetworkConfig{"plan" + std::to_string(p)};
+                if(!cache.Get(device_key, config))
+                    cache.Register(device_key, config, MakeInvokers(1));
+            }
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    for(auto p = 0; p < plans_count; ++p)
+    {
+        const auto found = cache.Get(device_key, miopen::NetworkConfig{"plan" + std::to_string(p)});
+        ASSERT_TRUE(found);
+        EXPECT_EQ(found->size(), 1u);
+    }
+}
@@ -0,0 +1,154 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/fusion/planner.hpp>
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+namespace {
+
+using miopen::fusion::Graph;
+using miopen::fusion::GraphNode;
+using miopen::fusion::Partition;
+
+const miopen::TensorDescriptor input_desc{miopenFloat, {1, 16, 8, 8}};
+const miopen::TensorDescriptor bias_desc{miopenFloat, {1, 16, 1, 1}};
+
+GraphNode Conv(int input)
+{
+    const auto filter = miopen::TensorDescriptor{miopenFloat, {16, 16, 1, 1}};
+    return {std::make_shared<miopen::ConvForwardOpDescriptor>(miopen::ConvolutionDescriptor{},
+                                                               filter),
+            input};
+}
+
+GraphNode Bias(int input)
+{
+    return {std::make_shared<miopen::BiasFusionOpDescriptor>(bias_desc), input};
+}
+
+GraphNode Activ(int input)
+{
+    return {std::make_shared<miopen::ActivFwdFusionOpDescriptor>(miopenActivationRELU), input};
+}
+
+GraphNode Add(int input, int side_input)
+{
+    return {std::make_shared<miopen::TensorScaleAddOpDescriptor>(input_desc), input, side_input};
+}
+
+std::string Kinds(const miopen::FusionPlanDescriptor& plan)
+{
+    std::string kinds;
+    for(const auto& op : plan.op_map)
+    {
+        switch(op->kind())
+        {
+        case miopen::miopenFusionOpConvForward: kinds += 'C'; break;
+        case miopen::miopenFusionOpBiasForward: kinds += 'B'; break;
+        case miopen::miopenFusionOpActivForward: kinds += 'A'; break;
+        case miopen::miopenFusionOpTensorScaleAdd: kinds += 'Z'; break;
+        default: kinds += '?'; break;
+        }
+    }
+    return kinds;
+}
+
+Partition PartitionOf(const Graph& graph,
+                      const std::set<std::string>& supported,
+                      const std::set<std::string>& failing = {})
+{
+    return miopen::fusion::PartitionGraph(
+        graph,
+        [&](const auto& plan) { return supported.count(Kinds(plan)) != 0; },
+        [&](auto& plan) { return failing.count(Kinds(plan)) == 0; });
+}
+
+std::vector<std::vector<int>> Groups(const Partition& partition)
+{
+    std::vector<std::vector<int>> groups;
+    for(const auto& group : partition.groups)
+    {
+        EXPECT_EQ(group.plan == nullptr, group.nodes.size() == 1);
+        groups.push_back(group.nodes);
+    }
+    return groups;
+}
+
+} // namespace
+
+TEST(FusionPlanner, LinearSequence)
+{
+    const auto graph = Graph{input_desc, {Conv(-1), Bias(0), Activ(1), Conv(2), Activ(3), Bias(4)}};
+
+    const auto partition = PartitionOf(graph, {"CBA", "CA"});
+
+    ASSERT_EQ(Groups(partition), (std::vector<std::vector<int>>{{0, 1, 2}, {3, 4}, {5}}));
+    ASSERT_EQ(partition.unfused, std::vector<int>{5});
+    ASSERT_EQ(Kinds(*partition.groups[0].plan), "CBA");
+    ASSERT_EQ(partition.groups[0].plan->input_desc, input_desc);
+}
+
+TEST(FusionPlanner, PrefersLongestCompilablePlan)
+{
+    const auto graph = Graph{input_desc, {Conv(-1), Bias(0), Activ(1)}};
+
+    ASSERT_EQ(Groups(PartitionOf(graph, {"CB", "CBA"})),
+              (std::vector<std::vector<int>>{{0, 1, 2}}));
+    ASSERT_EQ(Groups(PartitionOf(graph, {"CB", "CBA"}, {"CBA"})),
+              (std::vector<std::vector<int>>{{0, 1}, {2}}));
+    ASSERT_EQ(PartitionOf(graph, {}).unfused, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(FusionPlanner, ResidualBlock)
+{
+    // 0: conv -> 1: activ -> 2: conv -> 3: add(2, 1) -> 4: activ
+    //                     \----------------^
+    const auto graph     = Graph{input_desc, {Conv(-1), Activ(0), Conv(1), Add(2, 1), Activ(3)}};
+    const auto partition = PartitionOf(graph, {"CA", "CZA"});
+
+    ASSERT_EQ(Groups(partition), (std::vector<std::vector<int>>{{0, 1}, {2, 3, 4}}));
+    ASSERT_TRUE(partition.unfused.empty());
+}
+
+TEST(FusionPlanner, SharedOutputsAreNotFused)
+{
+    // Branches: 1 and 2 both consume 0, the output of 3 is used outside of the graph.
+    auto graph = Graph{input_desc, {Conv(-1), Activ(0), Activ(0), Conv(2), Activ(3)}};
+
+    graph.nodes[3].keep_output = true;
+    const auto partition       = PartitionOf(graph, {"CA", "A", "AC", "ACA"});
+
+    ASSERT_EQ(Groups(partition), (std::vector<std::vector<int>>{{0}, {1}, {2, 3}, {4}}));
+    ASSERT_EQ(partition.unfused, (std::vector<int>{0, 1, 4}));
+}
+
+TEST(FusionPlanner, RejectsUnorderedGraph)
+{
+    const auto graph = Graph{input_desc, {Activ(1), Conv(-1)}};
+    ASSERT_ANY_THROW(PartitionOf(graph, {"CA"}));
+}
@@ -117,3 +117,102 @@ INSTANTIATE_TEST_SUITE_P(ConvAsm1x1UParameterPredictionModelTest,
 INSTANTIATE_TEST_SUITE_P(ConvHipIgemmGroupFwdXdlopsParameterPredictionModelTest,
                          KernelTuningNetTestConvHipIgemmGroupFwdXdlops,
                          testing::ValuesIn(GetConvHipIgemmGroupFwdXdlopsTestCases()));
+
+#if MIOPEN_ENABLE_AI_KERNEL_TUNING
+struct KernelTuningNetPredictionCache : ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        auto test_case  = GetConvAsm1x1UTestCases().front();
+        const auto conv = test_case.conv.GetConv();
+
+        const auto input = miopen::TensorDescriptor(
+            test_case.data_type, test_case.layout, test_case.conv.GetInput());
+        const auto weights = miopen::TensorDescriptor(
+            test_case.data_type, test_case.layout, test_case.conv.GetWeights());
+        const auto output = conv.GetForwardOutputTensor(input, weights, test_case.data_type);
+
+        const auto problem =
+            miopen::conv::ProblemDescription(input, weights, output, conv, test_case.direction);
+
+        ctx.SetStream(&get_handle());
+        if(!miopen::solver::conv::PerformanceConfigConvAsm1x1U{}.IsModelApplicable(ctx, problem))
+            GTEST_SKIP();
+    }
+
+    /// Made up features, so that no other test has stored a prediction for them.
+    static std::vector<float> MakeFeatures(float seed)
+    {
+        auto features = std::vector<float>(n * n, 0.0f);
+        for(std::size_t i = 0; i < n; ++i)
+            features[i * n + i] = seed + i;
+        return features;
+    }
+
+    /// Stores the tokens accepted by the validator to accepted.
+    template <class Validator>
+    bool Predict(const std::vector<float>& features,
+                 Validator validator,
+                 std::vector<std::string>& accepted) const
+    {
+        accepted.clear();
+        return miopen::ai::tuning::ModelSetParams(
+            ctx.GetStream().GetDeviceName(),
+            "ConvAsm1x1U",
+            features,
+            true,
+            [&](std::size_t idx, const std::string& value) {
+                if(!validator(idx))
+                    return false;
+                accepted.push_back(value);
+                return true;
+            });
+    }
+
+    static constexpr std::size_t n = 8;
+    miopen::ExecutionContext ctx;
+};
+
+TEST_F(KernelTuningNetPredictionCache, ReplaysSuccesses)
+{
+    const auto features = MakeFeatures(3.0f);
+
+    // The first offered token of every parameter is rejected, so the prediction differs from the
+    // one the model makes for a validator accepting everything.
+    auto rejected_first = std::vector<bool>(n, false);
+    auto second_best    = std::vector<std::string>{};
+
+    const auto reject_first = [&](std::size_t idx) {
+        if(rejected_first[idx])
+            return true;
+        rejected_first[idx] = true;
+        return false;
+    };
+    if(!Predict(features, reject_first, second_best))
+        GTEST_SKIP() << "No second best prediction";
+
+    auto replayed = std::vector<std::string>{};
+    EXPECT_TRUE(Predict(features, [](std::size_t) { return true; }, replayed));
+    EXPECT_EQ(replayed, second_best);
+}
+
+TEST_F(KernelTuningNetPredictionCache, DoesNotStoreFailures)
+{
+    const auto features   = MakeFeatures(5.0f);
+    const auto accept_all = [](std::size_t) { return true; };
+
+    auto predicted = std::vector<std::string>{};
+    if(!Predict(features, accept_all, predicted))
+        GTEST_SKIP() << "No prediction";
+
+    // A validator rejecting everything fails the prediction. Another problem with the same
+    // features still gets the stored one.
+    auto none = std::vector<std::string>{};
+    EXPECT_FALSE(Predict(features, [](std::size_t) { return false; }, none));
+
+    auto again = std::vector<std::string>{};
+    EXPECT_TRUE(Predict(features, accept_all, again));
+    EXPECT_EQ(again, predicted);
+}
+#endif
@@ -0,0 +1,198 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/layout_plan.hpp>
+
+#include <gtest/gtest.h>
+
+#include "get_handle.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <sstream>
+
+namespace {
+
+using Layouts = std::vector<std::string>;
+
+const Layouts nchw{"NCHW"};
+const Layouts nhwc{"NHWC"};
+const Layouts any{};
+
+/// Transpose traffic of the chain with the given tensor layouts, every op picks its cheapest
+/// layout independently.
+std::size_t Cost(const std::vector<miopen::LayoutPlanStep>& steps, const Layouts& tensors)
+{
+    std::size_t total = 0;
+    for(std::size_t i = 0; i < steps.size(); ++i)
+    {
+        const auto& in      = tensors[i];
+        const auto& out     = tensors[i + 1];
+        const auto& layouts = steps[i].native_layouts.empty() ? Layouts{in, out}
+                                                              : steps[i].native_layouts;
+        auto best           = std::numeric_limits<std::size_t>::max();
+        for(const auto& layout : layouts)
+        {
+            best = std::min(best,
+                            (in != layout ? 2 * steps[i].input_bytes : 0) +
+                                (out != layout ? 2 * steps[i].output_bytes : 0));
+        }
+        total += best;
+    }
+    return total;
+}
+
+} // namespace
+
+TEST(LayoutPlan, NativeLayoutNeedsNoTransposes)
+{
+    const auto steps = std::vector<miopen::LayoutPlanStep>{{nchw, 100, 200}, {nchw, 200, 50}};
+    const auto plan  = miopen::PlanLayouts(steps, "NCHW", "NCHW");
+    ASSERT_EQ(plan.tensor_layouts, (Layouts{"NCHW", "NCHW", "NCHW"}));
+    ASSERT_EQ(plan.op_layouts, (Layouts{"NCHW", "NCHW"}));
+    ASSERT_EQ(plan.bytes_before, 0);
+    ASSERT_EQ(plan.bytes_after, 0);
+}
+
+TEST(LayoutPlan, TransposesOnlyAtChainBoundaries)
+{
+    const auto steps = std::vector<miopen::LayoutPlanStep>{
+        {nhwc, 100, 200}, {any, 200, 200}, {nhwc, 200, 50}, {nhwc, 50, 10}};
+    const auto plan = miopen::PlanLayouts(steps, "NCHW", "NCHW");
+
+    ASSERT_EQ(plan.tensor_layouts, (Layouts{"NCHW", "NHWC", "NHWC", "NHWC", "NCHW"}));
+    ASSERT_EQ(plan.op_layouts, (Layouts{"NHWC", "NHWC", "NHWC", "NHWC"}));
+    ASSERT_EQ(plan.bytes_before, 2 * (100 + 200) + 0 + 2 * (200 + 50) + 2 * (50 + 10));
+    ASSERT_EQ(plan.bytes_after, 2 * 100 + 2 * 10);
+
+    std::ostringstream report;
+    report << plan;
+    ASSERT_EQ(report.str(), "layouts: NCHW NHWC NHWC NHWC NCHW, transposed bytes: 1220 -> 220");
+}
+
+TEST(LayoutPlan, TransposesSmallestTensorBetweenLayouts)
+{
+    const auto steps = std::vector<miopen::LayoutPlanStep>{
+        {nhwc, 100, 100}, {any, 100, 30}, {any, 30, 100}, {nchw, 100, 100}};
+    const auto plan = miopen::PlanLayouts(steps, "NHWC", "NCHW");
+
+    ASSERT_EQ(plan.tensor_layouts, (Layouts{"NHWC", "NHWC", "NHWC", "NCHW", "NCHW"}));
+    ASSERT_EQ(plan.bytes_after, 2 * 30);
+}
+
+TEST(LayoutPlan, MatchesExhaustiveSearch)
+{
+    const auto candidates = std::vector<Layouts>{nchw, nhwc, any, {"NCHW", "NHWC"}};
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::size_t> pick(0, candidates.size() - 1);
+    std::uniform_int_distribution<std::size_t> bytes(1, 1000);
+
+    for(int test = 0; test < 100; ++test)
+    {
+        const auto n_steps = 1 + test % 6;
+        auto steps         = std::vector<miopen::LayoutPlanStep>{};
+        auto size          = bytes(gen);
+        for(std::size_t i = 0; i < n_steps; ++i)
+        {
+            const auto out_size = bytes(gen);
+            steps.emplace_back(candidates[pick(gen)], size, out_size);
+            size = out_size;
+        }
+
+        const auto plan = miopen::PlanLayouts(steps, "NCHW", test % 2 == 0 ? "NCHW" : "NHWC");
+        ASSERT_EQ(plan.tensor_layouts.size(), n_steps + 1);
+        ASSERT_EQ(plan.bytes_after, Cost(steps, plan.tensor_layouts));
+        ASSERT_LE(plan.bytes_after, plan.bytes_before);
+
+        auto best = std::numeric_limits<std::size_t>::max();
+        for(std::size_t mask = 0; mask < (1u << (n_steps - 1)); ++mask)
+        {
+            auto tensors = Layouts{plan.tensor_layouts.front()};
+            for(std::size_t i = 0; i + 1 < n_steps; ++i)
+                tensors.push_back((mask >> i) & 1 ? "NHWC" : "NCHW");
+            tensors.push_back(plan.tensor_layouts.back());
+            best = std::min(best, Cost(steps, tensors));
+        }
+        ASSERT_EQ(plan.bytes_after, best);
+    }
+}
+
+TEST(LayoutPlan, TensorDescriptorInPlannedLayout)
+{
+    const auto steps = std::vector<miopen::LayoutPlanStep>{{{"NDHWC"}, 100, 100}};
+    const auto plan  = miopen::PlanLayouts(steps, "NCDHW", "NDHWC");
+
+    const auto desc_4d = miopen::TensorDescriptor{miopenHalf, {2, 3, 4, 5}};
+    const auto nhwc_4d = plan.GetTensorDescriptor(1, desc_4d);
+    ASSERT_EQ(nhwc_4d.GetLengths(), desc_4d.GetLengths());
+    ASSERT_EQ(nhwc_4d.GetStrides(), (std::vector<std::size_t>{60, 1, 15, 3}));
+
+    const auto desc_5d = miopen::TensorDescriptor{miopenHalf, {2, 3, 4, 5, 6}};
+    ASSERT_EQ(plan.GetTensorDescriptor(0, desc_5d).GetStrides(), desc_5d.GetStrides());
+    ASSERT_EQ(plan.GetTensorDescriptor(1, desc_5d).GetStrides(),
+              (std::vector<std::size_t>{360, 1, 90, 18, 3}));
+}
+
+TEST(LayoutPlan, StepOfConvolutionSolver)
+{
+    using miopen::conv::Direction;
+    using miopen::conv::ProblemDescription;
+
+    const auto ctx       = miopen::ExecutionContext{&get_handle()};
+    const auto x         = miopen::TensorDescriptor{miopenFloat, miopenTensorNCHW, {2, 16, 14, 14}};
+    const auto w         = miopen::TensorDescriptor{miopenFloat, miopenTensorNCHW, {32, 16, 3, 3}};
+    const auto y         = miopen::TensorDescriptor{miopenFloat, miopenTensorNCHW, {2, 32, 12, 12}};
+    const auto conv      = miopen::ConvolutionDescriptor{{0, 0}, {1, 1}, {1, 1}};
+    const auto naive_fwd = miopen::solver::Id{"ConvDirectNaiveConvFwd"};
+
+    // The naive solvers run in both layouts without a workspace.
+    const auto fwd  = ProblemDescription{x, w, y, conv, Direction::Forward};
+    const auto step = miopen::LayoutPlanStep{ctx, fwd, naive_fwd};
+    ASSERT_EQ(step.native_layouts, (Layouts{"NCHW", "NHWC"}));
+    ASSERT_EQ(step.input_bytes, x.GetNumBytes());
+    ASSERT_EQ(step.output_bytes, y.GetNumBytes());
+
+    const auto bwd_data = ProblemDescription{y, w, x, conv, Direction::BackwardData};
+    const auto bwd_step =
+        miopen::LayoutPlanStep{ctx, bwd_data, miopen::solver::Id{"ConvDirectNaiveConvBwd"}};
+    ASSERT_EQ(bwd_step.native_layouts, (Layouts{"NCHW", "NHWC"}));
+    ASSERT_EQ(bwd_step.input_bytes, y.GetNumBytes());
+    ASSERT_EQ(bwd_step.output_bytes, x.GetNumBytes());
+
+    const auto plan = miopen::PlanLayouts({step, bwd_step}, "NHWC", "NHWC");
+    ASSERT_EQ(plan.tensor_layouts, (Layouts{"NHWC", "NHWC", "NHWC"}));
+    ASSERT_EQ(plan.bytes_after, 0);
+
+    // Not applicable in any layout
+    ASSERT_THROW(miopen::LayoutPlanStep(ctx, bwd_data, naive_fwd), miopen::Exception);
+    // Weights are not passed along the chain
+    const auto wrw = ProblemDescription{y, w, x, conv, Direction::BackwardWeights};
+    ASSERT_THROW(miopen::LayoutPlanStep(ctx, wrw, miopen::solver::Id{"ConvDirectNaiveConvWrw"}),
+                 miopen::Exception);
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/log_sink.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+using miopen::LoggingLevel;
+using miopen::log_sink::Admission;
+using miopen::log_sink::Record;
+using miopen::log_sink::Ring;
+
+TEST(LogSink, RingKeepsOrderAndRejectsWhenFull)
+{
+    Ring ring{4};
+    for(auto i = 0; i < 4; ++i)
+        ASSERT_TRUE(ring.TryPush({static_cast<std::uint64_t>(i), 1, LoggingLevel::Info, "m"}));
+    ASSERT_FALSE(ring.TryPush({4, 1, LoggingLevel::Info, "overflow"}));
+
+    std::vector<std::uint64_t> popped;
+    ASSERT_EQ(ring.PopAll([&](Record&& r) { popped.push_back(r.timestamp_ns); }), 4);
+    ASSERT_EQ(popped, (std::vector<std::uint64_t>{0, 1, 2, 3}));
+    ASSERT_TRUE(ring.TryPush({5, 1, LoggingLevel::Info, "again"}));
+    ASSERT_EQ(ring.PopAll([](Record&&) {}), 1);
+}
+
+TEST(LogSink, RingConcurrentProducerConsumer)
+{
+    constexpr std::uint64_t count = 10000;
+    Ring ring{64};
+    std::thread producer([&]() {
+        for(std::uint64_t i = 0; i < count;)
+        {
+            if(ring.TryPush({i, 1, LoggingLevel::Info, std::to_string(i)}))
+                ++i;
+            else
+                std::this_thread::yield();
+        }
+    });
+
+    std::uint64_t expected = 0;
+    while(expected < count)
+    {
+        const auto popped = ring.PopAll([&](Record&& r) {
+            ASSERT_EQ(r.timestamp_ns, expected);
+            ASSERT_EQ(r.message, std::to_string(expected));
+            ++expected;
+        });
+        if(popped == 0)
+            std::this_thread::yield();
+    }
+    producer.join();
+}
+
+TEST(LogSink, BinaryRoundTrip)
+{
+    const std::vector<Record> records = {
+        {1700000000123456789ull, 4242, LoggingLevel::Warning, "Warning [Foo] bar"},
+        {1700000000123456790ull, -1, LoggingLevel::Trace, ""},
+        {0, 0, LoggingLevel::Info, std::string("with\0zero\nand newline", 21)},
+    };
+
+    std::stringstream ss;
+    miopen::log_sink::WriteBinaryHeader(ss);
+    for(const auto& record : records)
+        miopen::log_sink::WriteBinary(ss, record);
+
+    ASSERT_TRUE(miopen::log_sink::ReadBinaryHeader(ss));
+    for(const auto& expected : records)
+    {
+        Record record;
+        ASSERT_TRUE(miopen::log_sink::ReadBinary(ss, record));
+        ASSERT_EQ(record.timestamp_ns, expected.timestamp_ns);
+        ASSERT_EQ(record.thread_id, expected.thread_id);
+        ASSERT_EQ(record.level, expected.level);
+        ASSERT_EQ(record.message, expected.message);
+    }
+    Record record;
+    ASSERT_FALSE(miopen::log_sink::ReadBinary(ss, record));
+}
+
+TEST(LogSink, RateLimitAndSampling)
+{
+    constexpr std::uint64_t second = 1000000000;
+
+    Admission limiter{3, 0};
+    auto admitted = 0;
+    for(auto i = 0; i < 10; ++i)
+        admitted += limiter.Admit(5 * second + i) ? 1 : 0;
+    ASSERT_EQ(admitted, 3);
+    ASSERT_EQ(limiter.TakeDropped(), 7);
+    ASSERT_EQ(limiter.TakeDropped(), 0);
+    ASSERT_TRUE(limiter.Admit(6 * second));
+
+    Admission sampler{0, 4};
+    admitted = 0;
+    for(auto i = 0; i < 100; ++i)
+        admitted += sampler.Admit(second) ? 1 : 0;
+    ASSERT_EQ(admitted, 25);
+    ASSERT_EQ(sampler.TakeDropped(), 0);
+
+    Admission everything{0, 0};
+    for(auto i = 0; i < 100; ++i)
+        ASSERT_TRUE(everything.Admit(second));
+}
@@ -0,0 +1,281 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+
+#if MIOPEN_MODE_NOGPU
+
+#include <miopen/miopen.h>
+#include <miopen/miopen_internal.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::vector<float> Random(std::size_t size)
+{
+    static auto gen = std::mt19937{7};
+    auto dist       = std::uniform_real_distribution<float>{-1.f, 1.f};
+    auto result     = std::vector<float>(size);
+    std::generate(result.begin(), result.end(), [&]() { return dist(gen); });
+    return result;
+}
+
+/// Handle running kernels on the host, created the way an application would.
+struct HostHandle
+{
+    HostHandle()
+    {
+        EXPECT_EQ(miopenCreate(&handle), miopenStatusSuccess);
+        EXPECT_EQ(miopenSetHostExecution(handle, true), miopenStatusSuccess);
+    }
+    ~HostHandle() { miopenDestroy(handle); }
+
+    miopenHandle_t handle = nullptr;
+};
+
+miopenTensorDescriptor_t MakeTensor(std::vector<int> lens)
+{
+    miopenTensorDescriptor_t desc;
+    EXPECT_EQ(miopenCreateTensorDescriptor(&desc), miopenStatusSuccess);
+    EXPECT_EQ(miopenSetTensorDescriptor(
+                  desc, miopenFloat, static_cast<int>(lens.size()), lens.data(), nullptr),
+              miopenStatusSuccess);
+    return desc;
+}
+
+} // namespace
+
+class NoGpuHostExecution : public testing::TestWithParam<miopenProblemDirection_t>
+{
+};
+
+// A 3x3 convolution with the padding of 1 found and run with the Find-2.0 API. Buffers are plain
+// host memory. The result is compared with a direct reference computed for the same direction.
+TEST_P(NoGpuHostExecution, FindAndRunConvolution)
+{
+    const int n = 2, c = 3, k = 4, h = 5, w = 6;
+    const auto direction = GetParam();
+    auto host            = HostHandle{};
+
+    const auto x_desc = MakeTensor({n, c, h, w});
+    const auto w_desc = MakeTensor({k, c, 3, 3});
+    const auto y_desc = MakeTensor({n, k, h, w});
+    miopenConvolutionDescriptor_t conv_desc;
+    ASSERT_EQ(miopenCreateConvolutionDescriptor(&conv_desc), miopenStatusSuccess);
+    ASSERT_EQ(miopenInitConvolutionDescriptor(conv_desc, miopenConvolution, 1, 1, 1, 1, 1, 1),
+              miopenStatusSuccess);
+
+    miopenProblem_t problem;
+    ASSERT_EQ(miopenCreateConvProblem(&problem, conv_desc, direction), miopenStatusSuccess);
+    ASSERT_EQ(miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionX, x_desc),
+              miopenStatusSuccess);
+    ASSERT_EQ(miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionW, w_desc),
+              miopenStatusSuccess);
+    ASSERT_EQ(miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionY, y_desc),
+              miopenStatusSuccess);
+
+    miopenSolution_t solution;
+    std::size_t found = 0;
+    ASSERT_EQ(miopenFindSolutions(host.handle, problem, nullptr, &solution, &found, 1),
+              miopenStatusSuccess);
+    ASSERT_EQ(found, 1);
+
+    // Inputs are random, the output starts from garbage which must be overwritten.
+    auto x  = Random(n * c * h * w);
+    auto wt = Random(k * c * 3 * 3);
+    auto y  = Random(n * k * h * w);
+
+    auto& output  = direction == miopenProblemDirectionForward    ? y
+                    : direction == miopenProblemDirectionBackward ? x
+                                                                  : wt;
+    auto expected = std::vector<double>(output.size());
+
+    for(int in = 0; in < n; ++in)
+        for(int ik = 0; ik < k; ++ik)
+            for(int ic = 0; ic < c; ++ic)
+                for(int oh = 0; oh < h; ++oh)
+                    for(int ow = 0; ow < w; ++ow)
+                        for(int r = 0; r < 3; ++r)
+                            for(int s = 0; s < 3; ++s)
+                            {
+                                const auto ih = oh + r - 1, iw = ow + s - 1;
+                                if(ih < 0 || ih >= h || iw < 0 || iw >= w)
+                                    continue;
+                                const auto xi = ((in * c + ic) * h + ih) * w + iw;
+                                const auto wi = ((ik * c + ic) * 3 + r) * 3 + s;
+                                const auto yi = ((in * k + ik) * h + oh) * w + ow;
+                                if(direction == miopenProblemDirectionForward)
+                                    expected[yi] += static_cast<double>(x[xi]) * wt[wi];
+                                else if(direction == miopenProblemDirectionBackward)
+                                    expected[xi] += static_cast<double>(y[yi]) * wt[wi];
+                                else
+                                    expected[wi] += static_cast<double>(y[yi]) * x[xi];
+                            }
+
+    std::size_t workspace_size = 0;
+    ASSERT_EQ(miopenGetSolutionWorkspaceSize(solution, &workspace_size), miopenStatusSuccess);
+    auto workspace = std::vector<char>(workspace_size);
+
+    const miopenTensorArgument_t arguments[] = {
+        {miopenTensorConvolutionX, nullptr, x.data()},
+        {miopenTensorConvolutionW, nullptr, wt.data()},
+        {miopenTensorConvolutionY, nullptr, y.data()},
+    };
+    ASSERT_EQ(miopenRunSolution(
+                  host.handle, solution, 3, arguments, workspace.data(), workspace_size),
+              miopenStatusSuccess);
+
+    for(std::size_t i = 0; i < output.size(); ++i)
+        EXPECT_NEAR(output[i], expected[i], 1e-4) << "at " << i;
+
+    miopenDestroySolution(solution);
+    miopenDestroyProblem(problem);
+    miopenDestroyConvolutionDescriptor(conv_desc);
+    miopenDestroyTensorDescriptor(x_desc);
+    miopenDestroyTensorDescriptor(w_desc);
+    miopenDestroyTensorDescriptor(y_desc);
+}
+
+INSTANTIATE_TEST_SUITE_P(Directions,
+                         NoGpuHostExecution,
+                         testing::Values(miopenProblemDirectionForward,
+                                         miopenProblemDirectionBackward,
+                                         miopenProblemDirectionBackwardWeights));
+
+// Training primitives have a host path as well, e.g. the activation backward.
+TEST(NoGpuHostExecutionTraining, ActivationBackward)
+{
+    auto host       = HostHandle{};
+    const auto desc = MakeTensor({2, 3, 4, 5});
+    miopenActivationDescriptor_t activ_desc;
+    ASSERT_EQ(miopenCreateActivationDescriptor(&activ_desc), miopenStatusSuccess);
+    ASSERT_EQ(miopenSetActivationDescriptor(activ_desc, miopenActivationLEAKYRELU, 0.1, 0., 0.),
+              miopenStatusSuccess);
+
+    const auto x  = Random(2 * 3 * 4 * 5);
+    const auto dy = Random(x.size());
+    auto y        = std::vector<float>(x.size());
+    auto dx       = std::vector<float>(x.size());
+
+    const auto alpha = 1.f, beta = 0.f;
+    ASSERT_EQ(miopenActivationForward(
+                  host.handle, activ_desc, &alpha, desc, x.data(), &beta, desc, y.data()),
+              miopenStatusSuccess);
+    ASSERT_EQ(miopenActivationBackward(host.handle,
+                                       activ_desc,
+                                       &alpha,
+                                       desc,
+                                       y.data(),
+                                       desc,
+                                       dy.data(),
+                                       desc,
+                                       x.data(),
+                                       &beta,
+                                       desc,
+                                       dx.data()),
+              miopenStatusSuccess);
+
+    for(std::size_t i = 0; i < x.size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(y[i], x[i] > 0 ? x[i] : 0.1f * x[i]) << "at " << i;
+        EXPECT_FLOAT_EQ(dx[i], x[i] > 0 ? dy[i] : 0.1f * dy[i]) << "at " << i;
+    }
+
+    miopenDestroyActivationDescriptor(activ_desc);
+    miopenDestroyTensorDescriptor(desc);
+}
+
+TEST(NoGpuHostExecutionTensorOp, AddMatchesReference)
+{
+    auto host = HostHandle{};
+
+    // Packed ops of ranks other than 4 run as {1, 1, 1, N} problems, the bias broadcast along a
+    // single dim of a 5D tensor as a coalesced 3D one.
+    const auto cases = std::vector<std::pair<std::vector<int>, std::vector<int>>>{
+        {{2, 3, 4, 5, 6}, {2, 3, 4, 5, 6}},
+        {{6, 10}, {6, 10}},
+        {{2, 3, 4, 5, 6}, {1, 3, 1, 1, 1}},
+    };
+
+    for(const auto& [clens, blens] : cases)
+    {
+        const auto c_desc = MakeTensor(clens);
+        const auto b_desc = MakeTensor(blens);
+
+        std::size_t size = 1, b_size = 1;
+        for(std::size_t d = 0; d < clens.size(); ++d)
+        {
+            size *= clens[d];
+            b_size *= blens[d];
+        }
+
+        const auto a = Random(size), b = Random(b_size);
+        auto c        = Random(size);
+        auto expected = c;
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            // Index of the B element broadcast to the C element i.
+            std::size_t b_index = 0, b_stride = 1, rest = i;
+            for(auto d = clens.size(); d-- > 0;)
+            {
+                if(blens[d] != 1)
+                    b_index += rest % clens[d] * b_stride;
+                b_stride *= blens[d];
+                rest /= clens[d];
+            }
+            expected[i] = a[i] * 2.f + b[b_index] * 3.f + c[i] * 0.5f;
+        }
+
+        const auto alpha0 = 2.f, alpha1 = 3.f, beta = .5f;
+        ASSERT_EQ(miopenOpTensor(host.handle,
+                                 miopenTensorOpAdd,
+                                 &alpha0,
+                                 c_desc,
+                                 a.data(),
+                                 &alpha1,
+                                 b_desc,
+                                 b.data(),
+                                 &beta,
+                                 c_desc,
+                                 c.data()),
+                  miopenStatusSuccess);
+
+        for(std::size_t i = 0; i < size; ++i)
+            EXPECT_NEAR(c[i], expected[i], 1e-5f) << "at " << i << " of rank " << clens.size();
+
+        miopenDestroyTensorDescriptor(b_desc);
+        miopenDestroyTensorDescriptor(c_desc);
+    }
+}
+
+#endif
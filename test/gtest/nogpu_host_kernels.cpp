@@ -0,0 +1,808 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/nogpu/host_kernels.hpp>
+
+#include <gtest/gtest.h>
+#include <fusionHost.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+/// Packs kernel arguments the way HIPOCKernelInvoke::operator()(Ts...) does.
+class ArgsBlock
+{
+public:
+    template <class... Ts>
+    explicit ArgsBlock(Ts... xs)
+    {
+        (Push(xs), ...);
+    }
+
+    const void* Data() const { return bytes.data(); }
+    std::size_t Size() const { return bytes.size(); }
+
+private:
+    template <class T>
+    void Push(T x)
+    {
+        const auto offset = (bytes.size() + alignof(T) - 1) / alignof(T) * alignof(T);
+        bytes.resize(offset + sizeof(T));
+        std::memcpy(bytes.data() + offset, &x, sizeof(T));
+    }
+
+    std::vector<char> bytes;
+};
+
+template <class... Ts>
+void RunHostKernel(const std::string& name,
+                   const std::string& params,
+                   const std::array<std::size_t, 3>& gdims,
+                   Ts... xs)
+{
+    const auto kernel = miopen::host::GetKernel(name);
+    ASSERT_NE(kernel, nullptr) << name;
+    const auto args = ArgsBlock{xs...};
+    auto reader     = miopen::host::KernelArgsReader{args.Data(), args.Size()};
+    kernel(miopen::host::KernelLaunch{params, {1, 1, 1}, gdims}, reader);
+}
+
+std::vector<float> Random(std::size_t size, float min = -2.f, float max = 2.f)
+{
+    static auto gen = std::mt19937{42};
+    auto dist       = std::uniform_real_distribution<float>{min, max};
+    auto result     = std::vector<float>(size);
+    std::generate(result.begin(), result.end(), [&]() { return dist(gen); });
+    return result;
+}
+
+void ExpectNear(const std::vector<float>& actual, const std::vector<float>& expected)
+{
+    ASSERT_EQ(actual.size(), expected.size());
+    for(std::size_t i = 0; i < actual.size(); ++i)
+        EXPECT_NEAR(actual[i], expected[i], 1e-5f * std::max(1.f, std::fabs(expected[i])))
+            << "at " << i;
+}
+
+std::size_t Offset(const std::vector<std::size_t>& strides, const std::vector<std::size_t>& pos)
+{
+    auto offset = std::size_t{0};
+    for(std::size_t i = 0; i < pos.size(); ++i)
+        offset += strides[i] * pos[i];
+    return offset;
+}
+
+/// Bitmap and grid of the Op{2..5}dTensorGeneric kernels computed the way OpTensor does.
+struct GenericGrid
+{
+    unsigned int bitmap = 0;
+    int num_wg          = 1;
+    int work_per_wg     = 1;
+};
+
+GenericGrid MakeGenericGrid(const std::vector<std::size_t>& blens,
+                            const std::vector<std::size_t>& clens)
+{
+    auto grid = GenericGrid{};
+    auto d    = blens.size();
+    while(d > 0 && blens[d - 1] == 1)
+        --d;
+    grid.num_wg = d > 0 ? static_cast<int>(blens[d - 1]) : 1;
+    for(auto i = d; i < clens.size(); ++i)
+        grid.work_per_wg *= static_cast<int>(clens[i]);
+    grid.bitmap |= 1U << (blens.size() - d);
+    for(auto i = static_cast<int>(d) - 2; i >= 0; --i)
+    {
+        if(blens[i] != 1)
+        {
+            grid.bitmap |= 1U << (blens.size() - (i + 1));
+            grid.num_wg *= static_cast<int>(blens[i]);
+        }
+        else
+        {
+            grid.work_per_wg *= static_cast<int>(clens[i]);
+        }
+    }
+    return grid;
+}
+
+const std::string fp32_params = " -DMIOPEN_USE_FP16=0 -DMIOPEN_USE_FP32=1";
+
+} // namespace
+
+TEST(NoGpuHostKernels, ActivationMatchesReference)
+{
+    const auto gamma = 1.5, beta = 0.5, alpha = 2.;
+    const auto x     = Random(4 * 16);
+
+    for(const auto mode : {miopenActivationPASTHRU,
+                           miopenActivationLOGISTIC,
+                           miopenActivationTANH,
+                           miopenActivationRELU,
+                           miopenActivationSOFTRELU,
+                           miopenActivationABS,
+                           miopenActivationPOWER,
+                           miopenActivationCLIPPEDRELU,
+                           miopenActivationLEAKYRELU,
+                           miopenActivationELU})
+    {
+        auto expected = std::vector<float>(x.size());
+        activationHostInfer(mode, gamma, beta, alpha, x, expected);
+
+        const auto params = "-DLITE -DMIOPEN_READ_UNIT=4 -DMIOPEN_NRN_OP_ID=" +
+                            std::to_string(static_cast<int>(mode)) + fp32_params;
+        auto y = std::vector<float>(x.size());
+        RunHostKernel("MIOpenActiveFwdLite",
+                      params,
+                      {16, 1, 1},
+                      x.data(),
+                      y.data(),
+                      static_cast<float>(gamma),
+                      static_cast<float>(beta),
+                      static_cast<float>(alpha),
+                      0LL,
+                      0LL);
+        SCOPED_TRACE(mode);
+        ExpectNear(y, expected);
+    }
+}
+
+TEST(NoGpuHostKernels, Activation2dMatchesReference)
+{
+    // 3 rows of 5 elements, the rows of x and y are padded to 8 and 7 elements.
+    const auto x  = Random(3 * 8);
+    auto y        = std::vector<float>(3 * 7, -1.f);
+    auto expected = y;
+    for(std::size_t row = 0; row < 3; ++row)
+        for(std::size_t col = 0; col < 5; ++col)
+            expected[row * 7 + col] = x[row * 8 + col] > 0 ? x[row * 8 + col] : 0.f;
+
+    RunHostKernel("MIOpenActiveFwd2DLite",
+                  "-DMIOPEN_READ_UNIT=1 -DMIOPEN_NRN_OP_ID=3" + fp32_params,
+                  {5, 3, 1},
+                  x.data(),
+                  y.data(),
+                  1.f,
+                  1.f,
+                  1.f,
+                  0LL,
+                  0LL,
+                  8U,
+                  7U);
+    ExpectNear(y, expected);
+}
+
+TEST(NoGpuHostKernels, ActivationBackwardMatchesReference)
+{
+    const auto gamma = 1.5, beta = 0.5, alpha = 2.;
+    const auto x     = Random(4 * 16);
+    const auto dy    = Random(x.size());
+
+    for(const auto mode : {miopenActivationPASTHRU,
+                           miopenActivationLOGISTIC,
+                           miopenActivationTANH,
+                           miopenActivationRELU,
+                           miopenActivationSOFTRELU,
+                           miopenActivationABS,
+                           miopenActivationPOWER,
+                           miopenActivationCLIPPEDRELU,
+                           miopenActivationLEAKYRELU,
+                           miopenActivationELU})
+    {
+        auto y = std::vector<float>(x.size());
+        activationHostInfer(mode, gamma, beta, alpha, x, y);
+        auto expected = std::vector<float>(x.size());
+        activationHostBwd(mode, gamma, beta, alpha, dy, x, y, expected);
+
+        const auto params = "-DLITE -DMIOPEN_READ_UNIT=4 -DMIOPEN_NRN_OP_ID=" +
+                            std::to_string(static_cast<int>(mode)) + fp32_params;
+        auto dx = std::vector<float>(x.size());
+        RunHostKernel("MIOpenActiveBwdLite",
+                      params,
+                      {16, 1, 1},
+                      dx.data(),
+                      dy.data(),
+                      x.data(),
+                      y.data(),
+                      static_cast<float>(gamma * beta),
+                      static_cast<float>(gamma),
+                      static_cast<float>(beta),
+                      static_cast<float>(alpha),
+                      0LL,
+                      0LL,
+                      0LL,
+                      0LL);
+        SCOPED_TRACE(mode);
+        ExpectNear(dx, expected);
+    }
+}
+
+TEST(NoGpuHostKernels, ActivationBackward2dMatchesReference)
+{
+    // 3 rows of 5 elements, the rows of dx are padded to 7 elements and the others to 8.
+    const auto x  = Random(3 * 8);
+    const auto y  = Random(3 * 8);
+    const auto dy = Random(3 * 8);
+    auto dx       = std::vector<float>(3 * 7, -1.f);
+    auto expected = dx;
+    for(std::size_t row = 0; row < 3; ++row)
+        for(std::size_t col = 0; col < 5; ++col)
+            expected[row * 7 + col] = x[row * 8 + col] > 0 ? dy[row * 8 + col] : 0.f;
+
+    RunHostKernel("MIOpenActiveBwd2DLite",
+                  "-DMIOPEN_READ_UNIT=1 -DMIOPEN_NRN_OP_ID=3" + fp32_params,
+                  {5, 3, 1},
+                  dx.data(),
+                  dy.data(),
+                  x.data(),
+                  y.data(),
+                  1.f,
+                  1.f,
+                  1.f,
+                  1.f,
+                  0LL,
+                  0LL,
+                  0LL,
+                  0LL,
+                  7U,
+                  8U,
+                  8U,
+                  8U);
+    ExpectNear(dx, expected);
+}
+
+TEST(NoGpuHostKernels, BatchNormInferenceMatchesReference)
+{
+    const auto n = 3, c = 4, h = 5, w = 6;
+    const auto epsilon = 1e-5;
+
+    for(const auto spatial : {true, false})
+    {
+        auto x = tensor<float>{std::vector<int>{n, c, h, w}};
+        auto params_lens = std::vector<int>{1, c, spatial ? 1 : h, spatial ? 1 : w};
+        auto scale = tensor<float>{params_lens}, bias = tensor<float>{params_lens};
+        auto mean = tensor<float>{params_lens}, var = tensor<float>{params_lens};
+        x.data     = Random(x.data.size());
+        scale.data = Random(scale.data.size());
+        bias.data  = Random(bias.data.size());
+        mean.data  = Random(mean.data.size());
+        var.data   = Random(var.data.size(), 0.5f, 2.f);
+
+        auto expected = tensor<float>{std::vector<int>{n, c, h, w}};
+        if(spatial)
+            batchNormSpatialHostInference(x, expected, scale, bias, epsilon, mean, var);
+        else
+            batchNormPerActivHostInference(x, expected, scale, bias, epsilon, mean, var);
+
+        auto y = std::vector<float>(x.data.size());
+        RunHostKernel(spatial ? "MIOpenBatchNormFwdInferSpatialEst"
+                              : "MIOpenBatchNormFwdInferPerActivationEst",
+                      "-DMIOPEN_USE_FPMIX=0" + fp32_params,
+                      {c, 256, 1},
+                      x.data.data(),
+                      y.data(),
+                      mean.data.data(),
+                      var.data.data(),
+                      scale.data.data(),
+                      bias.data.data(),
+                      epsilon,
+                      static_cast<unsigned int>(n),
+                      static_cast<unsigned int>(h * w),
+                      static_cast<unsigned int>(c * h * w));
+        SCOPED_TRACE(spatial);
+        ExpectNear(y, expected.data);
+    }
+}
+
+TEST(NoGpuHostKernels, SoftmaxMatchesReference)
+{
+    const int n = 2, c = 5, h = 3, w = 4;
+    // The input is padded along H, the output is packed.
+    const auto x_strides = std::vector<std::size_t>{c * h * 6, h * 6, 6, 1};
+    const auto y_strides = std::vector<std::size_t>{c * h * w, h * w, w, 1};
+    const auto x         = Random(n * c * h * 6);
+
+    for(const auto algo : {MIOPEN_SOFTMAX_FAST, MIOPEN_SOFTMAX_ACCURATE, MIOPEN_SOFTMAX_LOG})
+    {
+        for(const auto mode : {MIOPEN_SOFTMAX_MODE_INSTANCE, MIOPEN_SOFTMAX_MODE_CHANNEL})
+        {
+            const auto instance = mode == MIOPEN_SOFTMAX_MODE_INSTANCE;
+
+            // Reference: the softmax over C*H*W (instance) or C (channel) elements.
+            auto expected = std::vector<float>(n * c * h * w);
+            for(std::size_t in = 0; in < n; ++in)
+            {
+                for(std::size_t s = 0; s < (instance ? 1 : h * w); ++s)
+                {
+                    auto positions = std::vector<std::vector<std::size_t>>{};
+                    for(std::size_t i = 0; i < (instance ? c * h * w : c); ++i)
+                    {
+                        const auto pixel = instance ? i % (h * w) : s;
+                        const auto ic    = instance ? i / (h * w) : i;
+                        positions.push_back({in, ic, pixel / w, pixel % w});
+                    }
+                    auto max = std::numeric_limits<double>::lowest();
+                    for(const auto& pos : positions)
+                        max = std::max<double>(max, x[Offset(x_strides, pos)]);
+                    auto sum = 0.;
+                    for(const auto& pos : positions)
+                        sum += std::exp(x[Offset(x_strides, pos)] - max);
+                    for(const auto& pos : positions)
+                    {
+                        const auto v = x[Offset(x_strides, pos)] - max;
+                        expected[Offset(y_strides, pos)] = static_cast<float>(
+                            algo == MIOPEN_SOFTMAX_LOG ? v - std::log(sum) : std::exp(v) / sum);
+                    }
+                }
+            }
+
+            auto params = std::string{" -DNUM_BATCH=1"} + fp32_params +
+                          (algo == MIOPEN_SOFTMAX_LOG    ? " -DUSE_SOFTMAX_LOG=1"
+                           : algo == MIOPEN_SOFTMAX_FAST ? " -DUSE_SOFTMAX_FAST=1"
+                                                         : " -DUSE_SOFTMAX_ACCURATE=1") +
+                          (instance ? " -DUSE_SOFTMAX_MODE_INSTANCE=1"
+                                    : " -DUSE_SOFTMAX_MODE_CHANNEL=1") +
+                          " -DIS_INPUT_PACKED=0 -DIS_OUTPUT_PACKED=1";
+
+            auto y = std::vector<float>(expected.size());
+            RunHostKernel("SoftmaxForward",
+                          params,
+                          {256, 1, 1},
+                          x.data(),
+                          y.data(),
+                          instance ? c * h * w : c,
+                          instance ? n : n * h * w,
+                          instance ? 1 : h * w,
+                          h,
+                          w,
+                          static_cast<int>(x_strides[0]),
+                          static_cast<int>(x_strides[1]),
+                          static_cast<int>(x_strides[2]),
+                          static_cast<int>(y_strides[0]),
+                          static_cast<int>(y_strides[1]),
+                          static_cast<int>(y_strides[2]),
+                          0,
+                          0,
+                          1.f,
+                          0.f);
+            SCOPED_TRACE(std::to_string(algo) + " " + std::to_string(mode));
+            ExpectNear(y, expected);
+        }
+    }
+}
+
+TEST(NoGpuHostKernels, SoftmaxBackwardMatchesReference)
+{
+    const int n = 2, c = 5, h = 3, w = 4;
+    // dy is padded along H, y and dx are packed.
+    const auto dy_strides = std::vector<std::size_t>{c * h * 6, h * 6, 6, 1};
+    const auto strides    = std::vector<std::size_t>{c * h * w, h * w, w, 1};
+    const auto dy         = Random(n * c * h * 6);
+    const auto y          = Random(n * c * h * w, 0.f, 1.f);
+
+    for(const auto algo : {MIOPEN_SOFTMAX_ACCURATE, MIOPEN_SOFTMAX_LOG})
+    {
+        for(const auto mode : {MIOPEN_SOFTMAX_MODE_INSTANCE, MIOPEN_SOFTMAX_MODE_CHANNEL})
+        {
+            const auto instance = mode == MIOPEN_SOFTMAX_MODE_INSTANCE;
+
+            auto expected = std::vector<float>(n * c * h * w);
+            for(std::size_t in = 0; in < n; ++in)
+            {
+                for(std::size_t s = 0; s < (instance ? 1 : h * w); ++s)
+                {
+                    auto positions = std::vector<std::vector<std::size_t>>{};
+                    for(std::size_t i = 0; i < (instance ? c * h * w : c); ++i)
+                    {
+                        const auto pixel = instance ? i % (h * w) : s;
+                        const auto ic    = instance ? i / (h * w) : i;
+                        positions.push_back({in, ic, pixel / w, pixel % w});
+                    }
+                    auto dot = 0.;
+                    for(const auto& pos : positions)
+                        dot += dy[Offset(dy_strides, pos)] *
+                               (algo == MIOPEN_SOFTMAX_LOG ? 1.f : y[Offset(strides, pos)]);
+                    for(const auto& pos : positions)
+                    {
+                        const double dyv = dy[Offset(dy_strides, pos)];
+                        const double yv  = y[Offset(strides, pos)];
+                        expected[Offset(strides, pos)] = static_cast<float>(
+                            algo == MIOPEN_SOFTMAX_LOG ? dyv - dot * std::exp(yv)
+                                                       : (dyv - dot) * yv);
+                    }
+                }
+            }
+
+            auto params = std::string{" -DNUM_BATCH=1"} + fp32_params +
+                          (algo == MIOPEN_SOFTMAX_LOG ? " -DUSE_SOFTMAX_LOG=1"
+                                                      : " -DUSE_SOFTMAX_ACCURATE=1") +
+                          (instance ? " -DUSE_SOFTMAX_MODE_INSTANCE=1"
+                                    : " -DUSE_SOFTMAX_MODE_CHANNEL=1") +
+                          " -DRUN_FORWARD=0 -DIS_OUTPUT_PACKED=1 -DIS_DOUTPUT_PACKED=0"
+                          " -DIS_DINPUT_PACKED=1";
+
+            auto dx = std::vector<float>(expected.size());
+            RunHostKernel("SoftmaxBackward",
+                          params,
+                          {256, 1, 1},
+                          y.data(),
+                          dy.data(),
+                          dx.data(),
+                          instance ? c * h * w : c,
+                          instance ? n : n * h * w,
+                          instance ? 1 : h * w,
+                          h,
+                          w,
+                          static_cast<int>(strides[0]),
+                          static_cast<int>(strides[1]),
+                          static_cast<int>(strides[2]),
+                          static_cast<int>(dy_strides[0]),
+                          static_cast<int>(dy_strides[1]),
+                          static_cast<int>(dy_strides[2]),
+                          static_cast<int>(strides[0]),
+                          static_cast<int>(strides[1]),
+                          static_cast<int>(strides[2]),
+                          0,
+                          0,
+                          0,
+                          1.f,
+                          0.f);
+            SCOPED_TRACE(std::to_string(algo) + " " + std::to_string(mode));
+            ExpectNear(dx, expected);
+        }
+    }
+}
+
+TEST(NoGpuHostKernels, PoolingMatchesReference)
+{
+    const int n = 2, c = 3, in_h = 7, in_w = 6, kernel = 3, stride = 2, pad = 1;
+    const int out_h = (in_h + 2 * pad - kernel) / stride + 1;
+    const int out_w = (in_w + 2 * pad - kernel) / stride + 1;
+    const auto x    = Random(n * c * in_h * in_w);
+
+    for(const auto max_pooling : {true, false})
+    {
+        // Reference: max with the index in the image, or average over the pixels inside the image.
+        auto expected       = std::vector<float>(n * c * out_h * out_w);
+        auto expected_index = std::vector<uint32_t>(expected.size());
+        for(int b = 0; b < n * c; ++b)
+        {
+            for(int y = 0; y < out_h; ++y)
+            {
+                for(int x0 = 0; x0 < out_w; ++x0)
+                {
+                    auto res   = max_pooling ? std::numeric_limits<float>::lowest() : 0.f;
+                    auto count = 0;
+                    auto index = uint32_t{0};
+                    for(int h = std::max(y * stride - pad, 0);
+                        h < std::min(y * stride - pad + kernel, in_h);
+                        ++h)
+                    {
+                        for(int w = std::max(x0 * stride - pad, 0);
+                            w < std::min(x0 * stride - pad + kernel, in_w);
+                            ++w)
+                        {
+                            const auto v = x[(b * in_h + h) * in_w + w];
+                            ++count;
+                            if(!max_pooling)
+                            {
+                                res += v;
+                            }
+                            else if(v > res)
+                            {
+                                res   = v;
+                                index = h * in_w + w;
+                            }
+                        }
+                    }
+                    const auto out      = (b * out_h + y) * out_w + x0;
+                    expected[out]       = max_pooling ? res : res / count;
+                    expected_index[out] = index;
+                }
+            }
+        }
+
+        const auto op = std::to_string(max_pooling ? 1 : 0);
+        auto y        = std::vector<float>(expected.size());
+        auto mask     = std::vector<uint32_t>(expected.size());
+        RunHostKernel("mloPoolingG",
+                      "-DMLO_POOLING_OP_ID=" + op +
+                          " -DMLO_POOLING_KERNEL_SZ0=3 -DMLO_POOLING_KERNEL_SZ1=3"
+                          " -DMLO_POOLING_STRIDE0=2 -DMLO_POOLING_STRIDE1=2"
+                          " -DMLO_POOLING_INDEX_TYPE=uint -DMLO_POOLING_SAVE_INDEX"
+                          " -DUSE_IMG_INDEX=1" +
+                          fp32_params,
+                      {8, 8, n * c},
+                      x.data(),
+                      y.data(),
+                      mask.data(),
+                      pad,
+                      pad,
+                      c,
+                      in_h,
+                      in_w,
+                      out_h,
+                      out_w,
+                      c * in_h * in_w,
+                      in_h * in_w,
+                      in_w,
+                      c * out_h * out_w,
+                      out_h * out_w,
+                      out_w);
+        SCOPED_TRACE(max_pooling);
+        ExpectNear(y, expected);
+        if(max_pooling)
+        {
+            EXPECT_EQ(mask, expected_index);
+        }
+
+        auto y_naive    = std::vector<float>(expected.size());
+        auto mask_naive = std::vector<uint32_t>(expected.size());
+        using u32       = uint32_t;
+        RunHostKernel("mloPoolingForwardNaive",
+                      "-DMLO_POOLING_OP_ID=" + op +
+                          " -DMLO_POOLING_INDEX_TYPE=uint -DMLO_POOLING_IS2D_KERNEL=1" +
+                          fp32_params,
+                      {2, 4, 4},
+                      x.data(),
+                      y_naive.data(),
+                      mask_naive.data(),
+                      true,
+                      static_cast<int>(miopenPoolingWorkspaceIndexImage),
+                      u32{1},
+                      u32(kernel),
+                      u32(kernel),
+                      u32(stride),
+                      u32(stride),
+                      u32(stride),
+                      u32{0},
+                      u32(pad),
+                      u32(pad),
+                      u32(n),
+                      u32(c),
+                      u32{1},
+                      u32(in_h),
+                      u32(in_w),
+                      std::size_t(c * in_h * in_w),
+                      std::size_t(in_h * in_w),
+                      u32(in_h * in_w),
+                      u32(in_w),
+                      u32{1},
+                      u32{1},
+                      u32(out_h),
+                      u32(out_w),
+                      std::size_t(c * out_h * out_w),
+                      std::size_t(out_h * out_w),
+                      u32(out_h * out_w),
+                      u32(out_w),
+                      u32{1},
+                      std::size_t(c * out_h * out_w),
+                      std::size_t(out_h * out_w),
+                      u32(out_h * out_w),
+                      u32(out_w),
+                      u32{1});
+        ExpectNear(y_naive, expected);
+        if(max_pooling)
+        {
+            EXPECT_EQ(mask_naive, expected_index);
+        }
+    }
+}
+
+TEST(NoGpuHostKernels, TensorOpsMatchReference)
+{
+    const auto op_params = " -DMIOPEN_TYPE=float -DMIOPEN_TENSOR_OP=miopenAdd" + fp32_params;
+
+    // 1D: C = A * 2 + B * 3 + C * 0.5 with strided A and C.
+    {
+        const auto a = Random(2 * 10), b = Random(10);
+        auto c       = Random(3 * 10);
+        auto expected = c;
+        for(std::size_t i = 0; i < 10; ++i)
+            expected[i * 3] = a[i * 2] * 2.f + b[i] * 3.f + c[i * 3] * 0.5f;
+        RunHostKernel("Op1dTensorGeneric",
+                      op_params,
+                      {256, 1, 1},
+                      a.data(),
+                      b.data(),
+                      c.data(),
+                      uint64_t{0},
+                      uint64_t{0},
+                      uint64_t{0},
+                      uint32_t{2},
+                      uint32_t{1},
+                      uint32_t{3},
+                      2.f,
+                      3.f,
+                      0.5f,
+                      uint32_t{10},
+                      true);
+        ExpectNear(c, expected);
+    }
+
+    // Packed: 12 elements read by 3 work items of 4, A and B start at an offset.
+    {
+        const auto a = Random(4 + 12), b = Random(8 + 12);
+        auto c       = Random(12);
+        auto expected = c;
+        for(std::size_t i = 0; i < 12; ++i)
+            expected[i] = a[4 + i] * 2.f + b[8 + i] * 3.f + c[i] * 0.5f;
+        RunHostKernel("Op4dTensorLite",
+                      op_params + " -DRD_BLCK=4 -DREAD_TYPE=float4",
+                      {256, 1, 1},
+                      a.data(),
+                      b.data(),
+                      c.data(),
+                      2.f,
+                      3.f,
+                      0.5f,
+                      int64_t{4},
+                      int64_t{8},
+                      int64_t{0},
+                      int64_t{3},
+                      1);
+        ExpectNear(c, expected);
+    }
+
+    // 3D and 4D: bias broadcast along all dims but C, and no broadcast at all.
+    const auto clens = std::vector<std::size_t>{2, 3, 4, 5};
+    for(const auto& blens : {std::vector<std::size_t>{2, 3, 4}, std::vector<std::size_t>{1, 3, 1}})
+    {
+        const auto cl      = std::vector<std::size_t>(clens.begin(), clens.begin() + 3);
+        const auto grid    = MakeGenericGrid(blens, cl);
+        const auto bstr    = std::vector<std::size_t>{blens[1] * blens[2], blens[2], 1};
+        const auto a = Random(24), b = Random(blens[0] * blens[1] * blens[2]);
+        auto c        = std::vector<float>(24);
+        auto expected = c;
+        for(std::size_t i = 0; i < 24; ++i)
+        {
+            const auto pos  = std::vector<std::size_t>{i / 12, i / 4 % 3, i % 4};
+            auto bpos       = pos;
+            for(std::size_t d = 0; d < 3; ++d)
+                bpos[d] = blens[d] == 1 ? 0 : pos[d];
+            expected[i] = a[i] + b[Offset(bstr, bpos)];
+        }
+        RunHostKernel("Op3dTensorGeneric",
+                      op_params,
+                      {256, 1, 1},
+                      a.data(),
+                      12,
+                      4,
+                      b.data(),
+                      static_cast<int>(blens[1]),
+                      static_cast<int>(blens[2]),
+                      static_cast<int>(bstr[0]),
+                      static_cast<int>(bstr[1]),
+                      c.data(),
+                      3,
+                      4,
+                      12,
+                      4,
+                      1.f,
+                      1.f,
+                      0.f,
+                      grid.bitmap,
+                      grid.work_per_wg,
+                      int64_t{0},
+                      int64_t{0},
+                      int64_t{0},
+                      grid.num_wg);
+        SCOPED_TRACE(grid.bitmap);
+        ExpectNear(c, expected);
+    }
+}
+
+TEST(NoGpuHostKernels, SetScaleCopyMatchReference)
+{
+    const auto params = fp32_params;
+    // A 2x3x4 view with padded strides into a larger buffer.
+    const int lens[]    = {2, 3, 4};
+    const int strides[] = {20, 6, 1};
+    auto dst            = Random(40);
+    auto expected       = dst;
+
+    const auto for_each = [&](auto f) {
+        for(int i = 0; i < lens[0]; ++i)
+            for(int j = 0; j < lens[1]; ++j)
+                for(int k = 0; k < lens[2]; ++k)
+                    f(1 + i * strides[0] + j * strides[1] + k * strides[2]);
+    };
+
+    for_each([&](int i) { expected[i] *= 3.f; });
+    RunHostKernel("SubTensorOpWithScalar3d",
+                  "-DSUBTENSOR_OP_WITH_SCALAR=SUBTENSOR_OP_WITH_SCALAR_MULTIPLY" + params,
+                  {256, 1, 1},
+                  dst.data(),
+                  3.f,
+                  1,
+                  strides[0],
+                  strides[1],
+                  strides[2],
+                  lens[0],
+                  lens[1],
+                  lens[2]);
+    ExpectNear(dst, expected);
+
+    for_each([&](int i) { expected[i] = 7.f; });
+    RunHostKernel("SubTensorOpWithScalar3d",
+                  "-DSUBTENSOR_OP_WITH_SCALAR=SUBTENSOR_OP_WITH_SCALAR_SET" + params,
+                  {256, 1, 1},
+                  dst.data(),
+                  7.f,
+                  1,
+                  strides[0],
+                  strides[1],
+                  strides[2],
+                  lens[0],
+                  lens[1],
+                  lens[2]);
+    ExpectNear(dst, expected);
+
+    // Copy the view into a packed tensor.
+    const auto src = Random(40);
+    auto packed    = std::vector<float>(24);
+    auto copied    = std::vector<float>{};
+    for_each([&](int i) { copied.push_back(src[i]); });
+    RunHostKernel("SubTensorOpWithSubTensor3d",
+                  "-DSUBTENSOR_OP_WITH_SUBTENSOR=SUBTENSOR_OP_WITH_SUBTENSOR_COPY" + params,
+                  {256, 1, 1},
+                  src.data(),
+                  1,
+                  strides[0],
+                  strides[1],
+                  strides[2],
+                  lens[0],
+                  lens[1],
+                  lens[2],
+                  packed.data(),
+                  0,
+                  12,
+                  4,
+                  1);
+    ExpectNear(packed, copied);
+}
+
+TEST(NoGpuHostKernels, KernelLaunchReadsDefines)
+{
+    const auto launch =
+        miopen::host::KernelLaunch{"-DA=1 -DB -DMIOPEN_TYPE=float -DA=3", {1, 1, 1}, {1, 1, 1}};
+    EXPECT_EQ(launch.GetDefine("MIOPEN_TYPE"), "float");
+    EXPECT_EQ(launch.GetDefine("B"), "1");
+    EXPECT_EQ(launch.GetDefineInt("A"), 3);
+    EXPECT_EQ(launch.GetDefine("C", "none"), "none");
+    EXPECT_EQ(launch.GetDefineInt("C", 7), 7);
+}
+
+TEST(NoGpuHostKernels, MissingKernelIsNotRegistered)
+{
+    EXPECT_EQ(miopen::host::GetKernel("MIOpenBatchNormFwdTrainSpatial"), nullptr);
+}
@@ -0,0 +1,169 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/perf_db_neighbors.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cctype>
+#include <ostream>
+#include <string>
+
+using miopen::PerfDbFeatures;
+using miopen::PerfDbNeighborIndex;
+
+namespace {
+
+const auto key_56  = "64-56-56-3x3-64-56-56-32-1x1-1x1-1x1-0-NCHW-FP32-F";
+const auto key_28  = "64-28-28-3x3-64-28-28-32-1x1-1x1-1x1-0-NCHW-FP32-F";
+const auto key_112 = "64-112-112-3x3-64-112-112-32-1x1-1x1-1x1-0-NCHW-FP32-F";
+
+struct TileContext
+{
+};
+
+struct TileProblem
+{
+    int max_tile;
+};
+
+struct TileConfig
+{
+    int tile = 0;
+
+    bool Deserialize(const std::string& str)
+    {
+        if(str.empty() ||
+           !std::all_of(str.begin(), str.end(), [](char c) { return std::isdigit(c) != 0; }))
+            return false;
+        tile = std::stoi(str);
+        return true;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const TileConfig& config)
+    {
+        return os << config.tile;
+    }
+};
+
+// Accepts the tiles which fit the problem, like a solver rejecting a config tuned for a larger
+// problem.
+struct TileSolver
+{
+    std::string SolverDbId() const { return "TileSolver"; }
+
+    bool IsValidPerformanceConfig(const TileContext&,
+                                  const TileProblem& problem,
+                                  const TileConfig& config) const
+    {
+        return config.tile <= problem.max_tile;
+    }
+};
+
+} // namespace
+
+TEST(PerfDbNeighbors, FeaturesFromKey)
+{
+    const auto features = PerfDbFeatures::FromKey(key_56);
+
+    EXPECT_EQ(features.category, "NCHW-FP32-F-16");
+    EXPECT_EQ(features.values,
+              (std::vector<double>{64, 56, 56, 3, 3, 64, 56, 56, 32, 1, 1, 1, 1, 1, 1, 0}));
+}
+
+TEST(PerfDbNeighbors, ParseContents)
+{
+    const auto configs = PerfDbNeighborIndex::ParseContents("SolverA:1,2,3;SolverB:x;broken");
+
+    EXPECT_EQ(configs.size(), 2u);
+    EXPECT_EQ(configs.at("SolverA"), "1,2,3");
+    EXPECT_EQ(configs.at("SolverB"), "x");
+}
+
+TEST(PerfDbNeighbors, NearestFirst)
+{
+    auto index = PerfDbNeighborIndex{};
+    index.Add(PerfDbFeatures::FromKey(key_28), {{"Solver", "28"}});
+    index.Add(PerfDbFeatures::FromKey(key_112), {{"Solver", "112"}});
+    index.Add(PerfDbFeatures::FromKey(key_56), {{"Other", "56"}});
+
+    // Batch 16 instead of 32, 40x40 spatial size.
+    const auto problem =
+        PerfDbFeatures::FromKey("64-40-40-3x3-64-40-40-16-1x1-1x1-1x1-0-NCHW-FP32-F");
+
+    EXPECT_EQ(index.FindNearest(problem, "Solver", 5), (std::vector<std::string>{"28", "112"}));
+    EXPECT_EQ(index.FindNearest(problem, "Solver", 1), (std::vector<std::string>{"28"}));
+    EXPECT_EQ(index.FindNearest(problem, "Other", 5), (std::vector<std::string>{"56"}));
+    EXPECT_TRUE(index.FindNearest(problem, "Missing", 5).empty());
+}
+
+TEST(PerfDbNeighbors, CategoriesDoNotMix)
+{
+    auto index = PerfDbNeighborIndex{};
+    index.Add(PerfDbFeatures::FromKey(key_56), {{"Solver", "fp32"}});
+
+    const auto fp16 = PerfDbFeatures::FromKey("64-56-56-3x3-64-56-56-32-1x1-1x1-1x1-0-NCHW-FP16-F");
+    const auto bwd  = PerfDbFeatures::FromKey("64-56-56-3x3-64-56-56-32-1x1-1x1-1x1-0-NCHW-FP32-B");
+    const auto d3   = PerfDbFeatures::FromKey("64-8-56-56-3x3x3-64-8-56-56-32-1x1x1-1x1x1-1x1x1-0-"
+                                              "NCDHW-FP32-F");
+
+    EXPECT_TRUE(index.FindNearest(fp16, "Solver", 5).empty());
+    EXPECT_TRUE(index.FindNearest(bwd, "Solver", 5).empty());
+    EXPECT_TRUE(index.FindNearest(d3, "Solver", 5).empty());
+    EXPECT_EQ(index.GetSize(), 1u);
+}
+
+TEST(PerfDbNeighbors, AppliesNearestValidConfig)
+{
+    const auto before = miopen::GetPerfDbNeighborStatistics();
+
+    auto config = TileConfig{};
+    ASSERT_TRUE(miopen::ApplyPerfDbNeighbor(
+        TileSolver{}, TileContext{}, TileProblem{32}, {"64", "broken", "16", "8"}, config));
+    EXPECT_EQ(config.tile, 16);
+
+    const auto after = miopen::GetPerfDbNeighborStatistics();
+    EXPECT_EQ(after.lookups - before.lookups, 1u);
+    EXPECT_EQ(after.transfers - before.transfers, 1u);
+    EXPECT_EQ(after.rejected - before.rejected, 2u);
+}
+
+TEST(PerfDbNeighbors, RejectsInvalidConfigs)
+{
+    const auto before = miopen::GetPerfDbNeighborStatistics();
+
+    auto config = TileConfig{};
+    config.tile = 4;
+    ASSERT_FALSE(miopen::ApplyPerfDbNeighbor(
+        TileSolver{}, TileContext{}, TileProblem{32}, {"64", "128"}, config));
+    EXPECT_EQ(config.tile, 4);
+
+    const auto after = miopen::GetPerfDbNeighborStatistics();
+    EXPECT_EQ(after.lookups - before.lookups, 1u);
+    EXPECT_EQ(after.transfers, before.transfers);
+    EXPECT_EQ(after.rejected - before.rejected, 2u);
+}
@@ -0,0 +1,255 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/tensor_op_plan.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Problem
+{
+    std::vector<std::size_t> clens;
+    std::vector<std::size_t> blens;
+    /// Extra elements appended to each dim of the A and C layouts, zero for packed tensors.
+    std::size_t padding = 0;
+};
+
+std::vector<std::size_t> PaddedStrides(const std::vector<std::size_t>& lens, std::size_t padding)
+{
+    std::vector<std::size_t> strides(lens.size());
+    std::size_t stride = 1;
+    for(auto i = lens.size(); i-- > 0;)
+    {
+        strides[i] = stride;
+        stride *= lens[i] + padding;
+    }
+    return strides;
+}
+
+std::size_t ElementSpace(const std::vector<std::size_t>& lens,
+                         const std::vector<std::size_t>& strides)
+{
+    std::size_t space = 1;
+    for(std::size_t i = 0; i < lens.size(); ++i)
+        space += (lens[i] - 1) * strides[i];
+    return space;
+}
+
+float Apply(miopenTensorOp_t op, float a, float b)
+{
+    switch(op)
+    {
+    case miopenTensorOpAdd: return a + b;
+    case miopenTensorOpMul: return a * b;
+    case miopenTensorOpMin: return std::min(a, b);
+    case miopenTensorOpMax: return std::max(a, b);
+    }
+    return 0;
+}
+
+/// C = op(alpha0 * A, alpha1 * B) + beta * C, B is read with zero strides on dims of length 1.
+void Evaluate(miopenTensorOp_t op,
+              const miopen::TensorDescriptor& aDesc,
+              const std::vector<float>& a,
+              const miopen::TensorDescriptor& bDesc,
+              const std::vector<float>& b,
+              const miopen::TensorDescriptor& cDesc,
+              std::vector<float>& c)
+{
+    const auto& lens = cDesc.GetLengths();
+    std::vector<std::size_t> idx(lens.size(), 0);
+
+    for(std::size_t n = 0; n < cDesc.GetElementSize(); ++n)
+    {
+        std::size_t a_off = 0, b_off = 0, c_off = 0;
+        for(std::size_t i = 0; i < lens.size(); ++i)
+        {
+            a_off += idx[i] * aDesc.GetStrides()[i];
+            b_off += (bDesc.GetLengths()[i] == 1 ? 0 : idx[i]) * bDesc.GetStrides()[i];
+            c_off += idx[i] * cDesc.GetStrides()[i];
+        }
+        c[c_off] = Apply(op, 2.0f * a[a_off], 3.0f * b[b_off]) + 0.5f * c[c_off];
+
+        for(auto i = lens.size(); i-- > 0;)
+        {
+            if(++idx[i] < lens[i])
+                break;
+            idx[i] = 0;
+        }
+    }
+}
+
+std::vector<float> Random(std::size_t size, std::mt19937& gen)
+{
+    std::uniform_int_distribution<int> dist(-8, 8);
+    std::vector<float> data(size);
+    std::generate(data.begin(), data.end(), [&]() { return static_cast<float>(dist(gen)); });
+    return data;
+}
+
+void CheckAgainstReference(const Problem& problem)
+{
+    const auto astrides = PaddedStrides(problem.clens, problem.padding);
+    const auto cstrides = PaddedStrides(problem.clens, problem.padding);
+    const auto bstrides = PaddedStrides(problem.blens, 0);
+
+    const miopen::TensorDescriptor aDesc{miopenFloat, problem.clens, astrides};
+    const miopen::TensorDescriptor bDesc{miopenFloat, problem.blens, bstrides};
+    const miopen::TensorDescriptor cDesc{miopenFloat, problem.clens, cstrides};
+
+    const auto plan = miopen::PlanTensorOp(aDesc, bDesc, cDesc);
+    ASSERT_TRUE(plan);
+    ASSERT_LE(plan->GetSize(), problem.clens.size());
+    ASSERT_EQ(plan->GetBLengths().size(), plan->GetSize());
+
+    const auto descs = plan->GetDescriptors(miopenFloat, miopenFloat, miopenFloat);
+    ASSERT_EQ(std::get<2>(descs).GetElementSize(), cDesc.GetElementSize());
+
+    std::mt19937 gen(problem.clens.size() * 31 + problem.padding);
+    const auto a = Random(ElementSpace(aDesc.GetLengths(), astrides), gen);
+    const auto b = Random(ElementSpace(bDesc.GetLengths(), bstrides), gen);
+    auto c_ref   = Random(ElementSpace(cDesc.GetLengths(), cstrides), gen);
+    auto c_plan  = c_ref;
+
+    for(auto op : {miopenTensorOpAdd, miopenTensorOpMul, miopenTensorOpMin, miopenTensorOpMax})
+    {
+        Evaluate(op, aDesc, a, bDesc, b, cDesc, c_ref);
+        Evaluate(op, std::get<0>(descs), a, std::get<1>(descs), b, std::get<2>(descs), c_plan);
+        ASSERT_EQ(c_ref, c_plan) << "op: " << op;
+    }
+}
+
+} // namespace
+
+TEST(TensorOpPlan, PackedCollapsesTo1d)
+{
+    const miopen::TensorDescriptor desc{miopenFloat, {2, 3, 4, 5}};
+    const auto plan = miopen::PlanTensorOp(desc, desc, desc);
+    ASSERT_TRUE(plan);
+    ASSERT_EQ(plan->lengths, std::vector<std::size_t>{120});
+    ASSERT_EQ(plan->shape, miopen::TensorOpShape::Packed1d);
+}
+
+TEST(TensorOpPlan, ScalarBroadcast)
+{
+    const miopen::TensorDescriptor c{miopenFloat, {2, 3, 4, 5, 6}};
+    const miopen::TensorDescriptor b{miopenFloat, {1, 1, 1, 1, 1}};
+    const auto plan = miopen::PlanTensorOp(c, b, c);
+    ASSERT_TRUE(plan);
+    ASSERT_EQ(plan->lengths, std::vector<std::size_t>{720});
+    ASSERT_EQ(plan->b_strides, std::vector<std::size_t>{0});
+    ASSERT_EQ(plan->shape, miopen::TensorOpShape::Broadcast1d);
+}
+
+TEST(TensorOpPlan, BiasBroadcastFoldsSpatialDims)
+{
+    const miopen::TensorDescriptor c{miopenFloat, {2, 3, 1, 4, 5}};
+    const miopen::TensorDescriptor b{miopenFloat, {1, 3, 1, 1, 1}};
+    const auto plan = miopen::PlanTensorOp(c, b, c);
+    ASSERT_TRUE(plan);
+    ASSERT_EQ(plan->lengths, (std::vector<std::size_t>{2, 3, 20}));
+    ASSERT_EQ(plan->b_strides, (std::vector<std::size_t>{0, 1, 0}));
+    ASSERT_EQ(plan->GetBLengths(), (std::vector<std::size_t>{1, 3, 1}));
+    ASSERT_EQ(plan->shape, miopen::TensorOpShape::Generic);
+}
+
+TEST(TensorOpPlan, PaddedDimsAreNotMerged)
+{
+    const std::vector<std::size_t> lens{4, 5, 6};
+    const miopen::TensorDescriptor c{miopenFloat, lens, PaddedStrides(lens, 1)};
+    const auto plan = miopen::PlanTensorOp(c, c, c);
+    ASSERT_TRUE(plan);
+    ASSERT_EQ(plan->lengths, lens);
+    ASSERT_EQ(plan->shape, miopen::TensorOpShape::Generic);
+
+    const miopen::TensorDescriptor strided{miopenFloat, {1, 7}, {7, 2}};
+    const auto strided_plan = miopen::PlanTensorOp(strided, strided, strided);
+    ASSERT_TRUE(strided_plan);
+    ASSERT_EQ(strided_plan->shape, miopen::TensorOpShape::Strided1d);
+}
+
+TEST(TensorOpPlan, DroppedInnermostDimDoesNotFitKernels)
+{
+    const miopen::TensorDescriptor c{miopenFloat, {2, 3, 4, 1}, {100, 8, 2, 1}};
+    const auto plan = miopen::PlanTensorOp(c, c, c);
+    ASSERT_TRUE(plan);
+    ASSERT_EQ(plan->lengths, (std::vector<std::size_t>{2, 12}));
+    ASSERT_EQ(plan->c_strides, (std::vector<std::size_t>{100, 2}));
+    ASSERT_FALSE(plan->FitsKernels());
+
+    const miopen::TensorDescriptor packed{miopenFloat, {2, 3, 4, 1}, {100, 4, 1, 1}};
+    const miopen::TensorDescriptor bias{miopenFloat, {1, 3, 1, 1}};
+    const auto bias_plan = miopen::PlanTensorOp(packed, bias, packed);
+    ASSERT_TRUE(bias_plan);
+    ASSERT_EQ(bias_plan->lengths, (std::vector<std::size_t>{2, 3, 4}));
+    ASSERT_TRUE(bias_plan->FitsKernels());
+
+    const miopen::TensorDescriptor strided{miopenFloat, {1, 7}, {7, 2}};
+    const auto strided_plan = miopen::PlanTensorOp(strided, strided, strided);
+    ASSERT_TRUE(strided_plan);
+    ASSERT_TRUE(strided_plan->FitsKernels());
+}
+
+TEST(TensorOpPlan, NotBroadcastable)
+{
+    const miopen::TensorDescriptor c{miopenFloat, {2, 3, 4}};
+    const miopen::TensorDescriptor b{miopenFloat, {1, 2, 4}};
+    ASSERT_FALSE(miopen::PlanTensorOp(c, b, c));
+
+    const miopen::TensorDescriptor a{miopenFloat, {3, 2, 4}};
+    ASSERT_FALSE(miopen::PlanTensorOp(a, c, c));
+}
+
+TEST(TensorOpPlan, MatchesReference)
+{
+    const std::vector<Problem> problems = {
+        {{7}, {1}},
+        {{1, 1, 1}, {1, 1, 1}},
+        {{3, 4}, {3, 1}},
+        {{3, 4}, {1, 4}},
+        {{2, 3, 4, 5}, {1, 3, 1, 1}},
+        {{2, 3, 4, 5}, {2, 1, 4, 5}},
+        {{2, 3, 4, 5}, {2, 3, 1, 1}},
+        {{2, 3, 4, 5}, {1, 1, 4, 1}},
+        {{2, 1, 3, 4, 5}, {1, 1, 3, 4, 1}},
+        {{2, 3, 4, 5, 6}, {2, 3, 4, 5, 6}},
+        {{2, 3, 4, 5, 6}, {1, 3, 1, 5, 1}},
+    };
+
+    for(const auto& problem : problems)
+    {
+        for(std::size_t padding : {0, 2})
+        {
+            auto padded    = problem;
+            padded.padding = padding;
+            CheckAgainstReference(padded);
+        }
+    }
+}
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/tracer.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace {
+
+// Events of the category from the written trace
+std::vector<nlohmann::json> WriteAndRead(const std::string& category)
+{
+    const auto temp_file = miopen::TempFile{"tracer"};
+    EXPECT_TRUE(miopen::trace::WriteChromeTrace(temp_file));
+    auto file        = std::ifstream{temp_file.Path()};
+    const auto trace = nlohmann::json::parse(file);
+
+    auto events = std::vector<nlohmann::json>{};
+    for(const auto& event : trace.at("traceEvents"))
+    {
+        if(event.at("cat") == category)
+            events.push_back(event);
+    }
+    return events;
+}
+
+struct Tracer : testing::Test
+{
+    void SetUp() override
+    {
+        miopen::trace::Enable();
+        miopen::trace::Clear();
+    }
+
+    void TearDown() override
+    {
+        miopen::trace::Enable(false);
+        miopen::trace::Clear();
+    }
+};
+
+} // namespace
+
+TEST_F(Tracer, ScopesAndCounters)
+{
+    {
+        MIOPEN_TRACE_SCOPE("test", "outer");
+        miopen::trace::Counter("test", "count", 3);
+    }
+
+    const auto events = WriteAndRead("test");
+
+    ASSERT_EQ(events.size(), 3u);
+    EXPECT_EQ(events[0].at("name"), "outer");
+    EXPECT_EQ(events[0].at("ph"), "B");
+    EXPECT_EQ(events[1].at("ph"), "C");
+    EXPECT_EQ(events[1].at("args").at("value"), 3);
+    EXPECT_EQ(events[2].at("ph"), "E");
+    EXPECT_LE(events[0].at("ts").get<double>(), events[2].at("ts").get<double>());
+}
+
+TEST_F(Tracer, ThreadsAndDynamicNames)
+{
+    std::thread([]() {
+        const auto name = std::string{"kernel_"} + std::to_string(42);
+        const miopen::trace::Scope scope{"test", name};
+    }).join();
+    {
+        MIOPEN_TRACE_FUNCTION("test");
+    }
+
+    const auto events = WriteAndRead("test");
+
+    ASSERT_EQ(events.size(), 4u);
+    auto names = std::set<std::string>{};
+    auto tids  = std::set<int>{};
+    for(const auto& event : events)
+    {
+        names.insert(event.at("name").get<std::string>());
+        tids.insert(event.at("tid").get<int>());
+    }
+    EXPECT_EQ(names, (std::set<std::string>{"kernel_42", "TestBody"}));
+    EXPECT_EQ(tids.size(), 2u);
+}
+
+TEST_F(Tracer, Disabled)
+{
+    miopen::trace::Enable(false);
+    {
+        MIOPEN_TRACE_SCOPE("test", "hidden");
+    }
+
+    EXPECT_TRUE(WriteAndRead("test").empty());
+}
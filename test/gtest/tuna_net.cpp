@@ -131,3 +131,48 @@ INSTANTIATE_TEST_SUITE_P(Gfx908TestSolverPredictionModelHalfTest,
 INSTANTIATE_TEST_SUITE_P(Gfx908TestSolverPredictionModelBF16Test,
                          TunaNetTestBF16,
                          testing::ValuesIn(GetGfx908BF16TestCases()));
+
+TEST(TunaNet, Gfx908TestPredictSolvers)
+{
+#if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
+    auto&& handle      = get_handle();
+    std::string device = handle.GetDeviceName();
+    if(device != "gfx908")
+        GTEST_SKIP();
+    miopen::ExecutionContext ctx;
+    ctx.SetStream(&handle);
+
+    auto test_cases = GetGfx908FloatTestCases();
+    for(const auto& more : {GetGfx908HalfTestCases(), GetGfx908BF16TestCases()})
+        test_cases.insert(test_cases.end(), more.begin(), more.end());
+
+    auto problems = std::vector<miopen::conv::ProblemDescription>{};
+    for(auto& test_case : test_cases)
+    {
+        const auto conv  = test_case.conv.GetConv();
+        const auto input = miopen::TensorDescriptor(
+            test_case.data_type, test_case.layout, test_case.conv.GetInput());
+        const auto weights = miopen::TensorDescriptor(
+            test_case.data_type, test_case.layout, test_case.conv.GetWeights());
+        const auto output = conv.GetForwardOutputTensor(input, weights, test_case.data_type);
+        problems.emplace_back(input, weights, output, conv, test_case.direction);
+    }
+
+    // This test is registered before the parameterized ones, so the problems are not cached yet
+    // and are evaluated in one model call.
+    const auto batched = miopen::ai::immed_mode::PredictSolvers(problems, ctx, device);
+    ASSERT_EQ(batched.size(), problems.size());
+
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        const auto& solvers = batched[i];
+        std::size_t solver =
+            std::distance(solvers.begin(), std::max_element(solvers.begin(), solvers.end()));
+        EXPECT_EQ(solver, test_cases[i].expected_solver) << "Problem " << i;
+        // The batched results are cached for the single problem calls.
+        EXPECT_EQ(solvers, miopen::ai::immed_mode::PredictSolver(problems[i], ctx, device));
+    }
+#else
+    GTEST_SKIP();
+#endif
+}
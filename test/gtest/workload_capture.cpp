@@ -0,0 +1,104 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/temp_file.hpp>
+#include <miopen/workload_capture.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+
+using miopen::capture::Manifest;
+using miopen::capture::ManifestEntry;
+
+namespace {
+
+Manifest ReadFile(const std::string& path)
+{
+    auto file = std::ifstream{path};
+    return miopen::capture::ReadManifest(file);
+}
+
+} // namespace
+
+TEST(WorkloadCapture, ManifestRoundTrip)
+{
+    auto stream = std::istringstream{"# count host_ms command\n"
+                                     "3 1.500 ./bin/MIOpenDriver conv -n 1 -c 3\n"
+                                     "malformed\n"
+                                     "1 0.250 ./bin/MIOpenDriver pool -n 2\n"
+                                     "2 0.500 ./bin/MIOpenDriver conv -n 1 -c 3\n"};
+    auto manifest = miopen::capture::ReadManifest(stream);
+
+    ASSERT_EQ(manifest.size(), 2u);
+    EXPECT_EQ(manifest.at("conv -n 1 -c 3").count, 5u);
+    EXPECT_DOUBLE_EQ(manifest.at("conv -n 1 -c 3").host_ms, 2.0);
+
+    miopen::capture::MergeManifest(manifest, {{"pool -n 2", {4, 1.0}}, {"bnorm -n 8", {1, 0.5}}});
+    EXPECT_EQ(manifest.at("pool -n 2").count, 5u);
+    EXPECT_EQ(manifest.at("bnorm -n 8").count, 1u);
+
+    auto written = std::stringstream{};
+    miopen::capture::WriteManifest(written, manifest);
+    const auto reread = miopen::capture::ReadManifest(written);
+
+    ASSERT_EQ(reread.size(), 3u);
+    EXPECT_EQ(reread.at("pool -n 2").count, 5u);
+    EXPECT_DOUBLE_EQ(reread.at("pool -n 2").host_ms, 1.25);
+}
+
+TEST(WorkloadCapture, RecordAndFlush)
+{
+    const auto temp_file = miopen::TempFile{"workload"};
+    miopen::debug::workload_capture_path_override() = temp_file.Path();
+
+    ASSERT_TRUE(miopen::capture::IsEnabled());
+    {
+        const miopen::capture::ApiScope scope;
+        miopen::capture::Record("conv -n 1");
+    }
+    miopen::capture::Record("conv -n 1");
+    miopen::capture::Record("pool -n 1");
+    ASSERT_TRUE(miopen::capture::Flush());
+
+    auto manifest = ReadFile(temp_file.Path());
+    ASSERT_EQ(manifest.size(), 2u);
+    EXPECT_EQ(manifest.at("conv -n 1").count, 2u);
+    EXPECT_EQ(manifest.at("pool -n 1").count, 1u);
+    EXPECT_GE(manifest.at("conv -n 1").host_ms, 0.0);
+
+    // Flushing again adds to what is in the file, e.g. from another process
+    miopen::capture::Record("conv -n 1");
+    ASSERT_TRUE(miopen::capture::Flush());
+
+    manifest = ReadFile(temp_file.Path());
+    EXPECT_EQ(manifest.at("conv -n 1").count, 3u);
+    EXPECT_EQ(manifest.at("pool -n 1").count, 1u);
+
+    miopen::debug::workload_capture_path_override() = boost::none;
+    EXPECT_FALSE(miopen::capture::IsEnabled());
+}
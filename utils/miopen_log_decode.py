@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+###############################################################################
+#
+# MIT License
+#
+# Copyright (c) 2023 Advanced Micro Devices, Inc.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+#################################################################################
+"""Decodes binary logs written with MIOPEN_LOG_BINARY_FILE into text"""
+import argparse
+import datetime
+import struct
+import sys
+
+MAGIC = b'MIOPENLOG1'
+HEADER = struct.Struct('<QIBI')  # timestamp_ns, thread id, level, message size
+LEVELS = ['Default', 'Quiet', 'Fatal', 'Error', 'Warning', 'Info', 'Info2', 'Trace']
+
+
+def read_records(stream):
+  """Yields (timestamp_ns, thread_id, level, message) tuples"""
+  if stream.read(len(MAGIC)) != MAGIC:
+    raise ValueError('Not a MIOpen binary log')
+  while True:
+    header = stream.read(HEADER.size)
+    if len(header) < HEADER.size:
+      return
+    timestamp_ns, thread_id, level, size = HEADER.unpack(header)
+    message = stream.read(size)
+    if len(message) < size:
+      return  # Truncated by a crash
+    yield timestamp_ns, struct.unpack('<i', struct.pack('<I', thread_id))[0], \
+        level, message.decode('utf-8', errors='replace')
+
+
+def main():
+  """Entry point"""
+  parser = argparse.ArgumentParser(description=__doc__)
+  parser.add_argument('log', help='file written with MIOPEN_LOG_BINARY_FILE')
+  parser.add_argument('--level',
+                      type=int,
+                      default=len(LEVELS) - 1,
+                      help='skip messages more detailed than this MIOPEN_LOG_LEVEL')
+  parser.add_argument('--thread', type=int, help='print only messages of this thread')
+  args = parser.parse_args()
+
+  with open(args.log, 'rb') as stream:
+    for timestamp_ns, thread_id, level, message in read_records(stream):
+      if level > args.level or (args.thread is not None and thread_id != args.thread):
+        continue
+      time = datetime.datetime.fromtimestamp(timestamp_ns // 1000000000)
+      sys.stdout.write(f'{time:%Y-%m-%d %H:%M:%S}.{timestamp_ns % 1000000000:09d} '
+                       f'{thread_id} MIOpen: {message}\n')
+
+
+if __name__ == '__main__':
+  main()